@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stf/common.h>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Extract the k-th point from structure-of-arrays coordinate columns
+ *
+ * @param columns One span per coordinate
+ * @param k The index of the point to extract
+ * @return std::array<Scalar, dim> The k-th point
+ */
+template <typename Scalar, size_t dim>
+std::array<Scalar, dim> gather(const std::array<std::span<const Scalar>, dim>& columns, size_t k)
+{
+    std::array<Scalar, dim> p;
+    for (size_t i = 0; i < dim; ++i) p[i] = columns[i][k];
+    return p;
+}
+
+/**
+ * @brief Store a point as the k-th entry of structure-of-arrays coordinate columns
+ *
+ * @param columns One span per coordinate
+ * @param k The index of the point to store
+ * @param p The point to store
+ */
+template <typename Scalar, size_t dim>
+void scatter(
+    const std::array<std::span<Scalar>, dim>& columns,
+    size_t k,
+    const std::array<Scalar, dim>& p)
+{
+    for (size_t i = 0; i < dim; ++i) columns[i][k] = p[i];
+}
+
+/**
+ * @brief Contiguous scratch storage for a fixed number of structure-of-arrays columns
+ *
+ * Composite functions use it to hold intermediate per-point data (transformed positions,
+ * child values, child gradients) while evaluating a batch.
+ *
+ * @tparam count The number of columns
+ * @tparam Scalar The scalar type of the entries
+ */
+template <size_t count, typename Scalar = stf::Scalar>
+class ColumnBuffer
+{
+public:
+    /**
+     * @brief Allocate `count` columns of `size` entries each
+     *
+     * @param size The number of entries per column
+     */
+    explicit ColumnBuffer(size_t size)
+        : m_data(count * size)
+        , m_size(size)
+    {}
+
+    /**
+     * @brief Mutable view of the columns
+     */
+    std::array<std::span<Scalar>, count> columns()
+    {
+        std::array<std::span<Scalar>, count> result;
+        for (size_t i = 0; i < count; ++i) result[i] = {m_data.data() + i * m_size, m_size};
+        return result;
+    }
+
+    /**
+     * @brief Read-only view of the columns
+     */
+    std::array<std::span<const Scalar>, count> const_columns() const
+    {
+        std::array<std::span<const Scalar>, count> result;
+        for (size_t i = 0; i < count; ++i) result[i] = {m_data.data() + i * m_size, m_size};
+        return result;
+    }
+
+    /**
+     * @brief Read-only view of a single column
+     */
+    std::span<const Scalar> column(size_t i) const { return {m_data.data() + i * m_size, m_size}; }
+
+    /**
+     * @brief Mutable view of a single column
+     */
+    std::span<Scalar> column(size_t i) { return {m_data.data() + i * m_size, m_size}; }
+
+private:
+    std::vector<Scalar> m_data;
+    size_t m_size;
+};
+
+} // namespace stf
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Bounding volume hierarchy over axis-aligned boxes.
+ *
+ * Each box carries an integer id, typically the index of the object it bounds. Several boxes may
+ * share an id. The tree is built by median splits along the axis of largest centroid extent and
+ * stored as a flat array, with the left child of a node immediately following it.
+ *
+ * @tparam n The dimension of the boxes
+ */
+template <int n, typename Scalar = stf::Scalar>
+class BoxHierarchy
+{
+public:
+    /**
+     * @brief Constructs an empty hierarchy.
+     */
+    BoxHierarchy() = default;
+
+    /**
+     * @brief Builds the hierarchy over a set of finite, non-empty boxes.
+     *
+     * @param boxes The boxes
+     * @param ids The id of each box
+     */
+    BoxHierarchy(const std::vector<IntervalBox<n, Scalar>>& boxes, const std::vector<uint32_t>& ids)
+    {
+        m_items.reserve(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) m_items.push_back({boxes[i], ids[i]});
+        if (!m_items.empty()) {
+            m_nodes.reserve(2 * m_items.size());
+            build_node(0, static_cast<uint32_t>(m_items.size()));
+        }
+    }
+
+    /**
+     * @brief Calls `visitor(id)` for every box containing p.
+     *
+     * An id is reported once per box containing p, so ids shared by several boxes may repeat.
+     */
+    template <typename Visitor>
+    void visit(const std::array<Scalar, n>& p, Visitor&& visitor) const
+    {
+        if (m_nodes.empty()) return;
+
+        auto contains = [&](const IntervalBox<n, Scalar>& box) {
+            for (int i = 0; i < n; ++i) {
+                if (!box[i].contains(p[i])) return false;
+            }
+            return true;
+        };
+
+        // Median splits keep the depth logarithmic in the number of boxes.
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const uint32_t index = stack[--top];
+            const auto& node = m_nodes[index];
+            if (!contains(node.box)) continue;
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    if (contains(m_items[k].box)) visitor(m_items[k].id);
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = index + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of boxes.
+     */
+    size_t size() const { return m_items.size(); }
+
+    /**
+     * @brief Check whether the hierarchy holds no box.
+     */
+    bool empty() const { return m_items.empty(); }
+
+private:
+    struct Item
+    {
+        IntervalBox<n, Scalar> box; ///< The box
+        uint32_t id; ///< The id of the box
+    };
+
+    struct Node
+    {
+        IntervalBox<n, Scalar> box; ///< Hull of the items below the node
+        uint32_t first = 0; ///< First item of a leaf, or index of the right child
+        uint32_t count = 0; ///< Number of items of a leaf, 0 for an inner node
+    };
+
+    static constexpr uint32_t max_leaf_size = 4;
+
+    /**
+     * @brief Builds the subtree over items [begin, end).
+     */
+    void build_node(uint32_t begin, uint32_t end)
+    {
+        const auto index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back({});
+
+        auto box = empty_box<n, Scalar>();
+        auto centroids = empty_box<n, Scalar>();
+        for (uint32_t k = begin; k < end; ++k) {
+            box = hull(box, m_items[k].box);
+            for (int i = 0; i < n; ++i) {
+                centroids[i] = hull(centroids[i], Interval<Scalar>(m_items[k].box[i].midpoint()));
+            }
+        }
+        m_nodes[index].box = box;
+
+        if (end - begin <= max_leaf_size) {
+            m_nodes[index].first = begin;
+            m_nodes[index].count = end - begin;
+            return;
+        }
+
+        int axis = 0;
+        for (int i = 1; i < n; ++i) {
+            if (centroids[i].width() > centroids[axis].width()) axis = i;
+        }
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(
+            m_items.begin() + begin,
+            m_items.begin() + middle,
+            m_items.begin() + end,
+            [axis](const Item& a, const Item& b) {
+                return a.box[axis].midpoint() < b.box[axis].midpoint();
+            });
+
+        build_node(begin, middle);
+        m_nodes[index].first = static_cast<uint32_t>(m_nodes.size());
+        build_node(middle, end);
+    }
+
+private:
+    std::vector<Item> m_items; ///< The boxes, ordered by the hierarchy
+    std::vector<Node> m_nodes; ///< The nodes, root first
+};
+
+/**
+ * @brief Boxes of the sublevel sets of a family of functions at increasing levels.
+ *
+ * A function whose box at level c does not contain a point is above c there. This lets a union
+ * find the functions that can lie within a blending width of the minimum at a point without
+ * evaluating all of them: the levels are tried in increasing order until the smallest value
+ * found is at least the width below the level. Far from every function, coarser levels are
+ * needed, but only the functions whose coarse boxes contain the point are evaluated.
+ *
+ * @tparam n The dimension of the boxes
+ */
+template <int n, typename Scalar = stf::Scalar>
+class SublevelHierarchy
+{
+public:
+    /**
+     * @brief Constructs a hierarchy without levels, which evaluates every function.
+     */
+    SublevelHierarchy() = default;
+
+    /**
+     * @brief Builds the levels from a callback returning the boxes at a level.
+     *
+     * The levels start at `first_level` and double until they exceed `extent`, the size of the
+     * region covered by the functions.
+     *
+     * @param count The number of functions
+     * @param first_level The finest level
+     * @param extent The level above which every function is evaluated
+     * @param boxes_at Called as `boxes_at(level, boxes, ids, unbounded)`; appends the finite,
+     * non-empty boxes at that level with their function ids, and the ids of the functions whose
+     * box is unbounded
+     */
+    template <typename BoxesAt>
+    SublevelHierarchy(uint32_t count, Scalar first_level, Scalar extent, BoxesAt&& boxes_at)
+        : m_count(count)
+    {
+        constexpr size_t max_levels = 16;
+        Scalar level = first_level;
+        for (size_t j = 0; j < max_levels; ++j) {
+            std::vector<IntervalBox<n, Scalar>> boxes;
+            std::vector<uint32_t> ids;
+            std::vector<uint32_t> unbounded;
+            boxes_at(level, boxes, ids, unbounded);
+            m_levels.push_back({level, BoxHierarchy<n, Scalar>(boxes, ids), std::move(unbounded)});
+            if (!(level > 0 && level < extent)) break;
+            level *= 2;
+        }
+    }
+
+    /**
+     * @brief Evaluates the functions that can lie within `width` of the minimum at p.
+     *
+     * Every other function is larger than the smallest evaluated value plus `width` at p.
+     *
+     * @param p The point
+     * @param width The blending width
+     * @param evaluate Called at most once per function id, returns the function value at p
+     */
+    template <typename Evaluate>
+    void evaluate_near_minimum(const std::array<Scalar, n>& p, Scalar width, Evaluate&& evaluate)
+        const
+    {
+        std::vector<uint32_t> evaluated;
+        Scalar smallest = std::numeric_limits<Scalar>::infinity();
+        auto visit = [&](uint32_t i) {
+            auto it = std::lower_bound(evaluated.begin(), evaluated.end(), i);
+            if (it != evaluated.end() && *it == i) return;
+            evaluated.insert(it, i);
+            smallest = std::min(smallest, Scalar(evaluate(i)));
+        };
+
+        for (const auto& level : m_levels) {
+            for (auto i : level.unbounded) visit(i);
+            level.hierarchy.visit(p, visit);
+            if (smallest <= level.level - width) return;
+        }
+
+        // Nothing is close: evaluate the functions not visited yet.
+        size_t next = 0;
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (next < evaluated.size() && evaluated[next] == i) {
+                ++next;
+                continue;
+            }
+            evaluate(i);
+        }
+    }
+
+    /**
+     * @brief Get the finest level, or 0 if there is none.
+     */
+    Scalar first_level() const { return m_levels.empty() ? Scalar(0) : m_levels.front().level; }
+
+private:
+    struct Level
+    {
+        Scalar level; ///< The level of the boxes
+        BoxHierarchy<n, Scalar> hierarchy; ///< The bounded boxes at this level
+        std::vector<uint32_t> unbounded; ///< Functions with an unbounded box at this level
+    };
+
+    uint32_t m_count = 0; ///< The number of functions
+    std::vector<Level> m_levels; ///< The levels, finest first
+};
+
+} // namespace stf
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Options of the minimum clearance search.
+ */
+struct ClearanceOptions
+{
+    double tolerance = 1e-3; ///< Accepted gap between the clearance found and its lower bound
+    size_t max_nodes = size_t(1) << 20; ///< Number of space-time boxes after which the search stops
+    size_t descent_iterations = 64; ///< Maximum number of gradient steps per local refinement
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+};
+
+/**
+ * @brief Minimum clearance between two space-time functions.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct ClearanceResult
+{
+    Scalar clearance; ///< The smallest clearance found, negative when the shapes overlap
+    Scalar lower_bound; ///< A proven lower bound on the clearance
+    Scalar error; ///< clearance - lower_bound, at most the tolerance unless the budget ran out
+    Scalar time; ///< The time at which the clearance is reached
+    std::array<Scalar, dim> position; ///< The point halfway between the shapes at that time
+    size_t num_nodes = 0; ///< Number of space-time boxes examined
+    size_t num_evaluations = 0; ///< Number of evaluations of each function
+};
+
+/**
+ * @brief Computes the minimum clearance between the zero sublevel sets of two space-time
+ * functions over a time range, within a space-time domain.
+ *
+ * The clearance is 2 min over (x, t) of max(f(x, t), g(x, t)). For signed distance functions
+ * it is the distance between the two shapes, reached at the midpoint of their closest points;
+ * for any functions with a spatial Lipschitz constant of 1 it does not exceed that distance.
+ *
+ * The search is a branch and bound over space-time boxes, processed level by level with the
+ * boxes of a level examined in parallel. A box is dropped when the interval bounds of the two
+ * functions, or the values at its center combined with their Lipschitz bounds, show that it
+ * cannot improve the clearance found by more than the tolerance. Other boxes are split along
+ * the axis over which the functions may vary most. Whenever a box center improves the
+ * clearance, it is refined by proximal descent steps on the linearizations of f and g, which
+ * converge to the point where both are equal and minimal. The output does not depend on the
+ * thread count.
+ *
+ * @param f The first function, which must be safe to evaluate concurrently
+ * @param g The second function, which must be safe to evaluate concurrently
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param domain The spatial box to search
+ * @param options The tolerance, node budget, descent steps and thread count
+ * @return ClearanceResult<dim, Scalar> The clearance, its lower bound and where it is reached
+ */
+template <int dim, typename Scalar>
+ClearanceResult<dim, Scalar> minimum_clearance(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const SpaceTimeFunction<dim, Scalar>& g,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    const std::type_identity_t<IntervalBox<dim, Scalar>>& domain,
+    const ClearanceOptions& options = {})
+{
+    if (!(t0 <= t1)) throw std::invalid_argument("t0 must not exceed t1");
+    for (int i = 0; i < dim; ++i) {
+        if (!domain[i].is_finite() || domain[i].is_empty()) {
+            throw std::invalid_argument("The domain must be a finite, non-empty box");
+        }
+    }
+
+    constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+    const Scalar tolerance = Scalar(options.tolerance) / 2;
+
+    ClearanceResult<dim, Scalar> result;
+    result.num_nodes = 0;
+    result.num_evaluations = 0;
+
+    struct Point
+    {
+        std::array<Scalar, dim> x; ///< The position
+        Scalar t; ///< The time
+        Scalar value; ///< max(f, g) there
+        SpaceTimeEvaluation<dim, Scalar> ef; ///< Value and gradient of f
+        SpaceTimeEvaluation<dim, Scalar> eg; ///< Value and gradient of g
+    };
+    auto evaluate = [&](const std::array<Scalar, dim>& x, Scalar t) {
+        const auto ef = f.evaluate(x, t);
+        const auto eg = g.evaluate(x, t);
+        return Point{x, t, std::max(ef.value, eg.value), ef, eg};
+    };
+
+    // Proximal steps on the linearization of max(f, g): the step minimizing
+    // max(f + ∇f·Δ, g + ∇g·Δ) + μ/2 |Δ|² is -(λ∇f + (1 - λ)∇g) / μ for the λ in [0, 1]
+    // maximizing the dual, which both decreases and equalizes the two functions. μ grows after
+    // a rejected step and shrinks after an accepted one.
+    Point best{{}, t0, inf, {}, {}};
+    size_t descent_evaluations = 0;
+    auto descend = [&](Point p) {
+        Scalar mu = 1 / std::max(std::abs(p.value), tolerance);
+        for (size_t iteration = 0; iteration < options.descent_iterations; ++iteration) {
+            const auto& gf = p.ef.gradient;
+            const auto& gg = p.eg.gradient;
+            Scalar dot = 0, norm2 = 0;
+            for (int i = 0; i <= dim; ++i) {
+                dot += (gf[i] - gg[i]) * gg[i];
+                norm2 += (gf[i] - gg[i]) * (gf[i] - gg[i]);
+            }
+            Scalar lambda = p.ef.value > p.eg.value ? 1 : 0;
+            if (norm2 > 0) {
+                lambda = std::clamp<Scalar>(
+                    (mu * (p.ef.value - p.eg.value) - dot) / norm2,
+                    0,
+                    1);
+            }
+
+            std::array<Scalar, dim + 1> step;
+            Scalar length2 = 0;
+            for (int i = 0; i <= dim; ++i) {
+                step[i] = -(lambda * gf[i] + (1 - lambda) * gg[i]) / mu;
+                length2 += step[i] * step[i];
+            }
+            if (!(length2 > 0) || !std::isfinite(length2)) break;
+
+            std::array<Scalar, dim> x;
+            for (int i = 0; i < dim; ++i) {
+                x[i] = std::clamp(p.x[i] + step[i], domain[i].lower, domain[i].upper);
+            }
+            const auto q = evaluate(x, std::clamp(p.t + step[dim], t0, t1));
+            ++descent_evaluations;
+            if (q.value < p.value) {
+                p = q;
+                mu /= 2;
+            } else {
+                mu *= 4;
+            }
+        }
+        return p;
+    };
+
+    struct Node
+    {
+        IntervalBox<dim, Scalar> box; ///< The spatial box
+        Interval<Scalar> time; ///< The time interval
+    };
+    struct Examined
+    {
+        Point center; ///< Evaluation at the center of the box
+        Scalar lower; ///< Lower bound of max(f, g) over the box
+        LipschitzBound<Scalar> lipschitz; ///< Lipschitz bound of max(f, g) over the box
+    };
+
+    Scalar dropped_lower = inf;
+    std::vector<Node> level{{domain, Interval<Scalar>(t0, t1)}};
+    while (!level.empty()) {
+        if (result.num_nodes + level.size() > options.max_nodes) break;
+        result.num_nodes += level.size();
+
+        std::vector<Examined> examined(level.size());
+        parallel_for(level.size(), options.num_threads, [&](size_t k, size_t /*thread*/) {
+            const Node& node = level[k];
+            std::array<Scalar, dim> center;
+            Scalar radius2 = 0;
+            for (int i = 0; i < dim; ++i) {
+                center[i] = node.box[i].midpoint();
+                radius2 += node.box[i].width() * node.box[i].width() / 4;
+            }
+            Examined& e = examined[k];
+            e.center = evaluate(center, node.time.midpoint());
+
+            const Scalar bounds = std::max(
+                f.value_bounds(node.box, node.time).lower,
+                g.value_bounds(node.box, node.time).lower);
+            const auto lf = f.lipschitz_bound(node.box, node.time);
+            const auto lg = g.lipschitz_bound(node.box, node.time);
+            e.lipschitz = {std::max(lf.spatial, lg.spatial), std::max(lf.temporal, lg.temporal)};
+            Scalar lipschitz_lower = -inf;
+            if (std::isfinite(e.lipschitz.spatial) && std::isfinite(e.lipschitz.temporal)) {
+                lipschitz_lower = e.center.value -
+                                  lipschitz_product(e.lipschitz.spatial, std::sqrt(radius2)) -
+                                  lipschitz_product(e.lipschitz.temporal, node.time.width() / 2);
+            }
+            e.lower = std::max(bounds, lipschitz_lower);
+        });
+        result.num_evaluations += level.size();
+
+        size_t wave_best = level.size();
+        for (size_t k = 0; k < level.size(); ++k) {
+            if (examined[k].center.value < best.value &&
+                (wave_best == level.size() ||
+                 examined[k].center.value < examined[wave_best].center.value)) {
+                wave_best = k;
+            }
+        }
+        if (wave_best < level.size()) best = descend(examined[wave_best].center);
+
+        std::vector<Node> next;
+        for (size_t k = 0; k < level.size(); ++k) {
+            const Node& node = level[k];
+            const Examined& e = examined[k];
+            if (e.lower >= best.value - tolerance) {
+                dropped_lower = std::min(dropped_lower, e.lower);
+                continue;
+            }
+
+            // Split where the bound loses most: along the widest axis, weighted by its rate.
+            int axis = dim;
+            Scalar spread = std::isfinite(e.lipschitz.temporal)
+                                ? lipschitz_product(e.lipschitz.temporal, node.time.width())
+                                : node.time.width() / std::max<Scalar>(t1 - t0, 1e-300);
+            for (int i = 0; i < dim; ++i) {
+                const Scalar s = std::isfinite(e.lipschitz.spatial)
+                                     ? lipschitz_product(e.lipschitz.spatial, node.box[i].width())
+                                     : node.box[i].width() / domain[i].width();
+                if (s > spread) {
+                    spread = s;
+                    axis = i;
+                }
+            }
+            Node lower_half = node, upper_half = node;
+            if (axis == dim) {
+                lower_half.time.upper = upper_half.time.lower = node.time.midpoint();
+            } else {
+                lower_half.box[axis].upper = upper_half.box[axis].lower = node.box[axis].midpoint();
+            }
+            next.push_back(lower_half);
+            next.push_back(upper_half);
+        }
+        level = std::move(next);
+    }
+
+    // Boxes left when the budget ran out only contribute their parent bound.
+    Scalar lower = dropped_lower;
+    for (const Node& node : level) {
+        lower = std::min(
+            lower,
+            std::max(
+                f.value_bounds(node.box, node.time).lower,
+                g.value_bounds(node.box, node.time).lower));
+    }
+    lower = std::min(lower, best.value);
+
+    result.clearance = 2 * best.value;
+    result.lower_bound = 2 * lower;
+    result.error = result.clearance - result.lower_bound;
+    result.time = best.t;
+    result.position = best.x;
+    result.num_evaluations += descent_evaluations;
+    return result;
+}
+
+/**
+ * @brief Computes the minimum clearance between two space-time functions over a time range.
+ *
+ * The spatial domain is the smallest box containing the bounding boxes of both functions over
+ * the time range, which holds the closest points of signed distance functions and the segment
+ * between them.
+ *
+ * @param f The first function, which must be safe to evaluate concurrently
+ * @param g The second function, which must be safe to evaluate concurrently
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param options The tolerance, node budget, descent steps and thread count
+ * @return ClearanceResult<dim, Scalar> The clearance, its lower bound and where it is reached
+ */
+template <int dim, typename Scalar>
+ClearanceResult<dim, Scalar> minimum_clearance(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const SpaceTimeFunction<dim, Scalar>& g,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    const ClearanceOptions& options = {})
+{
+    const auto domain = hull(f.bounding_box(t0, t1), g.bounding_box(t0, t1));
+    for (int i = 0; i < dim; ++i) {
+        if (!domain[i].is_finite()) {
+            throw std::invalid_argument("The functions are unbounded; pass a domain box");
+        }
+    }
+    return minimum_clearance(f, g, t0, t1, domain, options);
+}
+
+} // namespace stf
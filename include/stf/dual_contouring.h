@@ -0,0 +1,653 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/marching_cubes.h>
+#include <stf/maths/interval.h>
+#include <stf/maths/maths_3d.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/sample_grid.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Quadratic error of a point with respect to a set of tangent planes.
+ *
+ * Each plane is given by a point and a unit normal; the error of x is the sum of the squared
+ * distances from x to the planes.
+ */
+template <typename Scalar = stf::Scalar>
+class QuadraticError
+{
+public:
+    /**
+     * @brief Adds the plane through a point with a unit normal.
+     *
+     * A zero normal only contributes the point to the mass point.
+     */
+    void add(const Vector3<Scalar>& point, const Vector3<Scalar>& normal)
+    {
+        const Scalar d = dot(normal, point);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) m_ata[i][j] += normal[i] * normal[j];
+            m_atb[i] += normal[i] * d;
+            m_mass[i] += point[i];
+        }
+        m_btb += d * d;
+        ++m_count;
+    }
+
+    /**
+     * @brief Adds the planes of another error.
+     */
+    void merge(const QuadraticError& other)
+    {
+        m_ata = stf::add(m_ata, other.m_ata);
+        m_atb = stf::add(m_atb, other.m_atb);
+        m_mass = stf::add(m_mass, other.m_mass);
+        m_btb += other.m_btb;
+        m_count += other.m_count;
+    }
+
+    /**
+     * @brief Get the number of planes.
+     */
+    size_t size() const { return m_count; }
+
+    /**
+     * @brief Get the average of the plane points.
+     */
+    Vector3<Scalar> mass_point() const { return scale(m_mass, Scalar(1) / Scalar(m_count)); }
+
+    /**
+     * @brief Get the error of a point.
+     */
+    Scalar error(const Vector3<Scalar>& x) const
+    {
+        const Scalar e = dot(x, apply_matrix(m_ata, x)) - 2 * dot(x, m_atb) + m_btb;
+        return std::max(e, Scalar(0));
+    }
+
+    /**
+     * @brief Finds the point of least error closest to the mass point.
+     *
+     * Directions in which the planes vary little (eigenvalues below `truncation` times the
+     * largest) are left at the mass point, so nearly flat sets of planes do not push the solution
+     * away along their common tangent.
+     *
+     * @param truncation The relative threshold of the pseudo-inverse
+     * @return Vector3<Scalar> The minimizer
+     */
+    Vector3<Scalar> solve(Scalar truncation = Scalar(0.1)) const
+    {
+        const auto c = mass_point();
+        const auto r = subtract(m_atb, apply_matrix(m_ata, c));
+        const auto [values, V] = symmetric_eigen(m_ata);
+        const Scalar largest = std::max({values[0], values[1], values[2]});
+
+        Vector3<Scalar> x = c;
+        if (!(largest > 0)) return x;
+        for (int k = 0; k < 3; ++k) {
+            if (values[k] < truncation * largest) continue;
+            const Vector3<Scalar> v{V[0][k], V[1][k], V[2][k]};
+            x = stf::add(x, scale(v, dot(v, r) / values[k]));
+        }
+        return x;
+    }
+
+private:
+    Matrix3<Scalar> m_ata{}; ///< Sum of n n^T
+    Vector3<Scalar> m_atb{}; ///< Sum of n (n . p)
+    Scalar m_btb = 0; ///< Sum of (n . p)^2
+    Vector3<Scalar> m_mass{}; ///< Sum of the plane points
+    size_t m_count = 0; ///< Number of planes
+};
+
+/**
+ * @brief Options of the dual contouring extractor.
+ */
+struct DualContouringOptions
+{
+    int max_depth = 7; ///< Depth of the finest cells, with 2^max_depth cells per axis (1 to 16)
+    /// Largest RMS distance from a merged vertex to the tangent planes it replaces, relative to
+    /// the finest cell size; 0 disables simplification
+    double tolerance = 0.01;
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+};
+
+/**
+ * @brief Implementation of `dual_contouring`.
+ */
+template <typename Scalar = stf::Scalar>
+class OctreeDualContouring
+{
+public:
+    /**
+     * @brief Builds the octree and extracts the mesh.
+     *
+     * @param f The function, which must be safe to evaluate concurrently
+     * @param box The box covered by the octree
+     * @param options The depth, tolerance and thread count
+     */
+    OctreeDualContouring(
+        const ImplicitFunction<3, Scalar>& f,
+        const IntervalBox<3, Scalar>& box,
+        const DualContouringOptions& options)
+        : m_f(f)
+        , m_max_depth(options.max_depth)
+    {
+        if (options.max_depth < 1 || options.max_depth > 16) {
+            throw std::invalid_argument("max_depth must be between 1 and 16");
+        }
+        if (!(options.tolerance >= 0)) {
+            throw std::invalid_argument("tolerance must be non-negative");
+        }
+        if (is_empty(box)) return;
+
+        const size_t n = size_t(1) << m_max_depth;
+        m_grid = GridSpec<3, Scalar>::from_box(box, {n + 1, n + 1, n + 1});
+        const Scalar h = std::min({m_grid.spacing[0], m_grid.spacing[1], m_grid.spacing[2]});
+        m_tolerance = Scalar(options.tolerance) * h;
+
+        build(options.num_threads);
+    }
+
+    /**
+     * @brief Get the extracted mesh.
+     */
+    TriangleMesh<Scalar>& mesh() { return m_mesh; }
+
+private:
+    using Coords = std::array<uint32_t, 3>;
+
+    /// Summary of a cell passed to its parent.
+    struct Cell
+    {
+        QuadraticError<Scalar> qef; ///< Tangent planes of the surface in the cell
+        Vector3<Scalar> vertex{}; ///< Vertex of the cell, if pending
+        uint8_t signs = 0; ///< Bit c set when corner c is inside
+        bool pending = false; ///< Whether the cell holds a vertex not emitted yet
+        bool collapsible = true; ///< Whether the parent may replace the cell by its own vertex
+    };
+
+    /// Vertices and surface edges found in a subtree.
+    struct Output
+    {
+        std::vector<std::pair<uint64_t, Vector3<Scalar>>> vertices; ///< Cell key and position
+        std::vector<uint64_t> edges; ///< (3 * lower node + axis) * 2 + inside at lower node
+    };
+
+    /// Cells below this many levels above the finest are sampled as one batch.
+    static constexpr int brick_levels = 3;
+
+    static Coords child_coords(const Coords& coords, int c)
+    {
+        return {2 * coords[0] + (c & 1), 2 * coords[1] + ((c >> 1) & 1), 2 * coords[2] + (c >> 2)};
+    }
+
+    static uint64_t key(int depth, const Coords& coords)
+    {
+        return (uint64_t(depth) << 48) | (uint64_t(coords[2]) << 32) |
+               (uint64_t(coords[1]) << 16) | uint64_t(coords[0]);
+    }
+
+    size_t cells_per_axis(int depth) const { return size_t(1) << (m_max_depth - depth); }
+
+    IntervalBox<3, Scalar> cell_box(int depth, const Coords& coords) const
+    {
+        const size_t size = cells_per_axis(depth);
+        IntervalBox<3, Scalar> box;
+        for (int i = 0; i < 3; ++i) {
+            box[i] = Interval<Scalar>(
+                m_grid.origin[i] + m_grid.spacing[i] * Scalar(coords[i] * size),
+                m_grid.origin[i] + m_grid.spacing[i] * Scalar((coords[i] + 1) * size));
+        }
+        return box;
+    }
+
+    void build(size_t num_threads)
+    {
+        // Subtrees below the split depth are built in parallel, the levels above serially.
+        const int split = std::min(m_max_depth, 2);
+        const uint32_t side = uint32_t(1) << split;
+        const size_t num_tasks = size_t(side) * side * side;
+        std::vector<Cell> roots(num_tasks);
+        std::vector<Output> outputs(num_tasks + 1);
+        parallel_for(num_tasks, num_threads, [&](size_t k, size_t /*thread*/) {
+            const Coords coords{
+                uint32_t(k % side),
+                uint32_t((k / side) % side),
+                uint32_t(k / (size_t(side) * side))};
+            roots[k] = process(split, coords, outputs[k]);
+        });
+
+        auto upper = [&](auto&& self, int depth, const Coords& coords) -> Cell {
+            if (depth == split) {
+                return roots[coords[0] + side * (coords[1] + size_t(side) * coords[2])];
+            }
+            std::array<Cell, 8> children;
+            for (int c = 0; c < 8; ++c) {
+                children[c] = self(self, depth + 1, child_coords(coords, c));
+            }
+            return combine(depth, coords, children, outputs[num_tasks]);
+        };
+        const Cell root = upper(upper, 0, {0, 0, 0});
+        if (root.pending) outputs[num_tasks].vertices.push_back({key(0, {0, 0, 0}), root.vertex});
+
+        assemble(outputs);
+    }
+
+    Cell process(int depth, const Coords& coords, Output& out) const
+    {
+        const auto bounds = m_f.value_bounds(cell_box(depth, coords));
+        if (bounds.lower >= 0) return Cell{};
+        if (bounds.upper < 0) return Cell{{}, {}, 0xff};
+        if (m_max_depth - depth <= brick_levels) return Brick(*this, depth, coords, out).root();
+
+        std::array<Cell, 8> children;
+        for (int c = 0; c < 8; ++c) children[c] = process(depth + 1, child_coords(coords, c), out);
+        return combine(depth, coords, children, out);
+    }
+
+    /// A cell sampled as one batch, subdivided down to the finest cells.
+    class Brick
+    {
+    public:
+        Brick(const OctreeDualContouring& dc, int depth, const Coords& coords, Output& out)
+            : m_dc(dc)
+            , m_depth(depth)
+            , m_coords(coords)
+            , m_out(out)
+            , m_size(dc.cells_per_axis(depth) + 1)
+            , m_values(m_size * m_size * m_size)
+            , m_hermite(3 * m_values.size(), -1)
+        {
+            ColumnBuffer<3, Scalar> positions(m_values.size());
+            auto columns = positions.columns();
+            for (size_t j = 0; j < m_values.size(); ++j) {
+                const auto p = dc.m_grid.position(node(local_node(j)));
+                for (int i = 0; i < 3; ++i) columns[i][j] = p[i];
+            }
+            dc.m_f.value_batch(positions.const_columns(), m_values);
+        }
+
+        Cell root() { return visit(m_depth, m_coords); }
+
+    private:
+        std::array<size_t, 3> local_node(size_t j) const
+        {
+            return {j % m_size, (j / m_size) % m_size, j / (m_size * m_size)};
+        }
+
+        /// Grid node of a local node.
+        std::array<size_t, 3> node(const std::array<size_t, 3>& local) const
+        {
+            const size_t first = m_dc.cells_per_axis(m_depth);
+            return {
+                m_coords[0] * first + local[0],
+                m_coords[1] * first + local[1],
+                m_coords[2] * first + local[2]};
+        }
+
+        size_t local_index(const std::array<size_t, 3>& local) const
+        {
+            return local[0] + m_size * (local[1] + m_size * local[2]);
+        }
+
+        Cell visit(int depth, const Coords& coords)
+        {
+            if (depth == m_dc.m_max_depth) return leaf(coords);
+            std::array<Cell, 8> children;
+            for (int c = 0; c < 8; ++c) children[c] = visit(depth + 1, child_coords(coords, c));
+            return m_dc.combine(depth, coords, children, m_out);
+        }
+
+        Cell leaf(const Coords& coords)
+        {
+            const size_t first = m_dc.cells_per_axis(m_depth);
+            std::array<size_t, 3> local;
+            for (int i = 0; i < 3; ++i) local[i] = coords[i] - m_coords[i] * first;
+
+            Cell cell;
+            for (int c = 0; c < 8; ++c) {
+                const std::array<size_t, 3> corner{
+                    local[0] + (c & 1), local[1] + ((c >> 1) & 1), local[2] + (c >> 2)};
+                if (m_values[local_index(corner)] < 0) cell.signs |= uint8_t(1 << c);
+            }
+            if (cell.signs == 0 || cell.signs == 0xff) return cell;
+
+            for (int edge = 0; edge < 12; ++edge) {
+                const int c0 = MarchingCubesTable::edge_corner(edge);
+                const int axis = MarchingCubesTable::edge_axis(edge);
+                const bool inside0 = (cell.signs >> c0) & 1;
+                if (inside0 == bool((cell.signs >> (c0 | (1 << axis))) & 1)) continue;
+
+                const std::array<size_t, 3> a{
+                    local[0] + (c0 & 1), local[1] + ((c0 >> 1) & 1), local[2] + (c0 >> 2)};
+                const auto& [point, normal] = hermite(a, axis);
+                cell.qef.add(point, normal);
+
+                // The cell owns the surface edges from its first corner, when they are not on
+                // the boundary of the octree.
+                const int u = (axis + 1) % 3;
+                const int v = (axis + 2) % 3;
+                if (c0 == 0 && coords[u] > 0 && coords[v] > 0) {
+                    const uint64_t node_index = m_dc.m_grid.index(node(a));
+                    m_out.edges.push_back((node_index * 3 + uint64_t(axis)) * 2 + inside0);
+                }
+            }
+            cell.vertex = m_dc.place(cell.qef, m_dc.cell_box(m_dc.m_max_depth, coords));
+            cell.pending = true;
+            return cell;
+        }
+
+        /// Surface point and unit normal on the edge from a local node along an axis.
+        const std::pair<Vector3<Scalar>, Vector3<Scalar>>& hermite(
+            const std::array<size_t, 3>& a,
+            int axis)
+        {
+            int& slot = m_hermite[3 * local_index(a) + axis];
+            if (slot >= 0) return m_points[slot];
+
+            std::array<size_t, 3> b = a;
+            ++b[axis];
+            const auto p0 = m_dc.m_grid.position(node(a));
+            const Scalar length = m_dc.m_grid.spacing[axis];
+            auto at = [&](Scalar t) {
+                auto p = p0;
+                p[axis] += t * length;
+                return p;
+            };
+
+            // Refine the linear estimate with a few steps of regula falsi.
+            Scalar ta = 0, tb = 1;
+            Scalar va = m_values[local_index(a)], vb = m_values[local_index(b)];
+            for (int iteration = 0; iteration < 2; ++iteration) {
+                const Scalar t = ta + va / (va - vb) * (tb - ta);
+                const Scalar vt = m_dc.m_f.value(at(t));
+                if ((vt < 0) == (va < 0)) {
+                    ta = t;
+                    va = vt;
+                } else {
+                    tb = t;
+                    vb = vt;
+                }
+            }
+            const auto point = at(ta + va / (va - vb) * (tb - ta));
+            auto normal = m_dc.m_f.gradient(point);
+            const Scalar length_normal = norm(normal);
+            normal = length_normal > 0 ? scale(normal, 1 / length_normal) : Vector3<Scalar>{};
+
+            slot = int(m_points.size());
+            m_points.push_back({point, normal});
+            return m_points[slot];
+        }
+
+    private:
+        const OctreeDualContouring& m_dc; ///< The extractor
+        int m_depth; ///< Depth of the brick
+        Coords m_coords; ///< Coordinates of the brick at its depth
+        Output& m_out; ///< Output of the subtree
+        size_t m_size; ///< Number of nodes per axis
+        std::vector<Scalar> m_values; ///< Node values
+        std::vector<int> m_hermite; ///< Index of the Hermite data of each local edge, or -1
+        std::vector<std::pair<Vector3<Scalar>, Vector3<Scalar>>> m_points; ///< Hermite data
+    };
+
+    /// Minimizer of a QEF, or its mass point when the minimizer leaves the cell.
+    Vector3<Scalar> place(const QuadraticError<Scalar>& qef, const IntervalBox<3, Scalar>& box)
+        const
+    {
+        const auto x = qef.solve();
+        for (int i = 0; i < 3; ++i) {
+            if (!box[i].contains(x[i])) return qef.mass_point();
+        }
+        return x;
+    }
+
+    /**
+     * @brief Merges the children of a cell into a single vertex when that is safe.
+     *
+     * A cell is collapsed when every child is collapsible, its corner signs yield a single sheet,
+     * the sign at the middle of each of its edges, faces and its center agrees with one of the
+     * corners of that edge, face or cell (so the surface does not cross them twice), it does not
+     * cross the boundary of the octree, and the merged vertex stays within tolerance of the
+     * tangent planes. Otherwise the pending child vertices are emitted.
+     */
+    Cell combine(int depth, const Coords& coords, const std::array<Cell, 8>& children, Output& out)
+        const
+    {
+        // Signs on the 3x3x3 lattice of child corners.
+        std::array<bool, 27> inside{};
+        auto lattice = [](int x, int y, int z) { return x + 3 * (y + 3 * z); };
+        Cell cell;
+        bool any_pending = false;
+        bool collapsible = m_tolerance > 0;
+        for (int c = 0; c < 8; ++c) {
+            const auto& child = children[c];
+            for (int k = 0; k < 8; ++k) {
+                const int x = (c & 1) + (k & 1);
+                const int y = ((c >> 1) & 1) + ((k >> 1) & 1);
+                const int z = (c >> 2) + (k >> 2);
+                inside[lattice(x, y, z)] = (child.signs >> k) & 1;
+            }
+            if ((child.signs >> c) & 1) cell.signs |= uint8_t(1 << c);
+            any_pending = any_pending || child.pending;
+            collapsible = collapsible && child.collapsible;
+            if (child.pending) cell.qef.merge(child.qef);
+        }
+        if (!any_pending) {
+            cell.collapsible = std::all_of(children.begin(), children.end(), [](const Cell& c) {
+                return c.collapsible;
+            });
+            return cell;
+        }
+
+        collapsible = collapsible && MarchingCubesTable::get().components(cell.signs) == 1;
+        for (int z = 0; z < 3 && collapsible; ++z) {
+            for (int y = 0; y < 3 && collapsible; ++y) {
+                for (int x = 0; x < 3 && collapsible; ++x) {
+                    if (x != 1 && y != 1 && z != 1) continue;
+                    // Corners of the edge, face or cell centered at (x, y, z).
+                    bool agrees = false;
+                    for (int c = 0; c < 8; ++c) {
+                        const int cx = x == 1 ? 2 * (c & 1) : x;
+                        const int cy = y == 1 ? 2 * ((c >> 1) & 1) : y;
+                        const int cz = z == 1 ? 2 * (c >> 2) : z;
+                        agrees = agrees || inside[lattice(cx, cy, cz)] == inside[lattice(x, y, z)];
+                    }
+                    collapsible = agrees;
+                }
+            }
+        }
+
+        // Faces on the boundary of the octree must not be crossed.
+        const uint32_t last = (uint32_t(1) << depth) - 1;
+        for (int i = 0; i < 3 && collapsible; ++i) {
+            for (int side = 0; side < 2; ++side) {
+                if (coords[i] != (side == 0 ? 0 : last)) continue;
+                const int fixed = 2 * side;
+                bool first = false;
+                for (int j = 0; j < 9; ++j) {
+                    std::array<int, 3> p;
+                    p[i] = fixed;
+                    p[(i + 1) % 3] = j % 3;
+                    p[(i + 2) % 3] = j / 3;
+                    const bool s = inside[lattice(p[0], p[1], p[2])];
+                    if (j == 0) first = s;
+                    collapsible = collapsible && s == first;
+                }
+            }
+        }
+
+        if (collapsible) {
+            cell.vertex = place(cell.qef, cell_box(depth, coords));
+            const Scalar rms = std::sqrt(cell.qef.error(cell.vertex) / Scalar(cell.qef.size()));
+            collapsible = rms <= m_tolerance;
+        }
+        if (collapsible) {
+            cell.pending = true;
+            return cell;
+        }
+
+        for (int c = 0; c < 8; ++c) {
+            if (children[c].pending) {
+                const auto child_key = key(depth + 1, child_coords(coords, c));
+                out.vertices.push_back({child_key, children[c].vertex});
+            }
+        }
+        cell.qef = {};
+        cell.collapsible = false;
+        return cell;
+    }
+
+    /// Numbers the vertices and connects the cells around each surface edge.
+    void assemble(const std::vector<Output>& outputs)
+    {
+        std::unordered_map<uint64_t, uint32_t> vertex_of_cell;
+        for (const auto& out : outputs) {
+            for (const auto& [cell_key, position] : out.vertices) {
+                vertex_of_cell.emplace(cell_key, uint32_t(m_mesh.vertices.size()));
+                m_mesh.vertices.push_back(position);
+            }
+        }
+
+        // Vertex of the emitted cell containing a finest cell.
+        auto find = [&](const std::array<size_t, 3>& finest) -> int64_t {
+            for (int depth = m_max_depth; depth >= 0; --depth) {
+                const int shift = m_max_depth - depth;
+                const Coords coords{
+                    uint32_t(finest[0] >> shift),
+                    uint32_t(finest[1] >> shift),
+                    uint32_t(finest[2] >> shift)};
+                auto it = vertex_of_cell.find(key(depth, coords));
+                if (it != vertex_of_cell.end()) return it->second;
+            }
+            return -1;
+        };
+
+        struct TriangleHash
+        {
+            size_t operator()(const std::array<uint32_t, 3>& t) const
+            {
+                const uint64_t h = (uint64_t(t[0]) << 42) ^ (uint64_t(t[1]) << 21) ^ t[2];
+                return std::hash<uint64_t>()(h);
+            }
+        };
+        std::unordered_set<std::array<uint32_t, 3>, TriangleHash> seen;
+        auto emit = [&](uint32_t a, uint32_t b, uint32_t c) {
+            std::array<uint32_t, 3> sorted{a, b, c};
+            std::sort(sorted.begin(), sorted.end());
+            if (seen.insert(sorted).second) m_mesh.triangles.push_back({a, b, c});
+        };
+
+        for (const auto& out : outputs) {
+            for (uint64_t edge : out.edges) {
+                const bool inside_lower = edge & 1;
+                const int axis = int((edge >> 1) % 3);
+                const auto n = m_grid.node(size_t((edge >> 1) / 3));
+                const int u = (axis + 1) % 3;
+                const int v = (axis + 2) % 3;
+
+                // The four cells around the edge, counterclockwise seen from the positive end.
+                std::array<std::array<size_t, 3>, 4> around{n, n, n, n};
+                --around[1][u];
+                --around[2][u];
+                --around[2][v];
+                --around[3][v];
+                if (!inside_lower) std::swap(around[1], around[3]);
+
+                std::vector<uint32_t> polygon;
+                for (const auto& finest : around) {
+                    const int64_t id = find(finest);
+                    if (id < 0) continue;
+                    if (polygon.empty() || polygon.back() != uint32_t(id)) {
+                        polygon.push_back(uint32_t(id));
+                    }
+                }
+                while (polygon.size() > 1 && polygon.front() == polygon.back()) polygon.pop_back();
+                if (polygon.size() == 3) {
+                    emit(polygon[0], polygon[1], polygon[2]);
+                } else if (polygon.size() == 4) {
+                    emit(polygon[0], polygon[1], polygon[2]);
+                    emit(polygon[0], polygon[2], polygon[3]);
+                }
+            }
+        }
+    }
+
+private:
+    const ImplicitFunction<3, Scalar>& m_f; ///< The function
+    int m_max_depth; ///< Depth of the finest cells
+    GridSpec<3, Scalar> m_grid; ///< Nodes of the finest cells
+    Scalar m_tolerance = 0; ///< Largest RMS distance of a merged vertex to its planes
+    TriangleMesh<Scalar> m_mesh; ///< The extracted mesh
+};
+
+/**
+ * @brief Extracts the zero level set of an implicit function with adaptive dual contouring.
+ *
+ * An octree over the box is refined where the value bounds do not exclude zero. In every finest
+ * cell crossed by the surface, the edge crossings and the unit gradients there (Hermite data)
+ * define a quadratic error function whose minimizer places the cell vertex, so sharp edges and
+ * corners are reproduced. Bottom-up, cells whose merged vertex stays within `tolerance` of all
+ * the tangent planes below them, and whose topology is simple, are collapsed into one vertex:
+ * flat regions become a few large triangles. Each surface edge of the finest grid then yields a
+ * quad joining the vertices of the cells around it.
+ *
+ * The 64 subtrees of depth 2 are built in parallel and merged serially, so the output does not
+ * depend on the thread count. The mesh is open where the surface leaves the box.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param box The box to mesh
+ * @param options The depth, simplification tolerance and thread count
+ * @return TriangleMesh<Scalar> The surface mesh, counterclockwise seen from outside
+ */
+template <typename Scalar>
+TriangleMesh<Scalar> dual_contouring(
+    const ImplicitFunction<3, Scalar>& f,
+    const IntervalBox<3, Scalar>& box,
+    const DualContouringOptions& options = {})
+{
+    OctreeDualContouring<Scalar> extractor(f, box, options);
+    return std::move(extractor.mesh());
+}
+
+/**
+ * @brief Extracts the zero level set of a space-time function at a fixed time with adaptive
+ * dual contouring.
+ *
+ * The function is bound to time t once, and its snapshot is meshed as in the implicit overload.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param box The box to mesh
+ * @param t The time
+ * @param options The depth, simplification tolerance and thread count
+ * @return TriangleMesh<Scalar> The surface mesh
+ */
+template <typename Scalar>
+TriangleMesh<Scalar> dual_contouring(
+    const SpaceTimeFunction<3, Scalar>& f,
+    const IntervalBox<3, Scalar>& box,
+    std::type_identity_t<Scalar> t,
+    const DualContouringOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    return dual_contouring(*snapshot, box, options);
+}
+
+} // namespace stf
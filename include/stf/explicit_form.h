@@ -1,10 +1,14 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
+#include <stf/maths/dual.h>
 #include <stf/space_time_function.h>
 
 #include <array>
+#include <cassert>
 #include <functional>
+#include <span>
 
 namespace stf {
 
@@ -15,12 +19,13 @@ namespace stf {
  * This class allows creating space-time functions from explicit function
  * definitions for the value, time derivative, and gradient. If the time
  * derivative or gradient are not provided, they are computed using finite
- * differences.
+ * differences. Alternatively, `from_generic` differentiates a generic lambda exactly with
+ * forward-mode automatic differentiation.
  *
  * @tparam dim The spatial dimension of the function
  */
-template <int dim>
-class ExplicitForm : public SpaceTimeFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class ExplicitForm : public SpaceTimeFunction<dim, Scalar>
 {
 public:
     /**
@@ -42,6 +47,46 @@ public:
         assert(m_function != nullptr);
     }
 
+    /**
+     * @brief Create an ExplicitForm differentiated by forward-mode automatic differentiation
+     *
+     * `func` must be callable as `func(pos, t)` both with plain scalars and with dual numbers
+     * (stf::Dual), typically a generic lambda. Elementary functions should be called unqualified
+     * after a using declaration (`using std::sin; sin(t)`) so that the dual overloads are found.
+     * The value, gradient and time derivative are exact, and `evaluate` computes the value and
+     * the full gradient in a single pass.
+     *
+     * @param func The generic function defining the value
+     * @return ExplicitForm The space-time function with automatic derivatives
+     */
+    template <typename Func>
+    static ExplicitForm from_generic(Func func)
+    {
+        using Gradient = Dual<Scalar, dim + 1>;
+        using TimeDerivative = Dual<Scalar, 1>;
+
+        auto evaluate = [func](std::array<Scalar, dim> pos, Scalar t) {
+            std::array<Gradient, dim> p;
+            for (int i = 0; i < dim; ++i) p[i] = Gradient::variable(pos[i], i);
+            const Gradient result = func(p, Gradient::variable(t, dim));
+            return SpaceTimeEvaluation<dim, Scalar>{result.value, result.derivatives};
+        };
+
+        ExplicitForm form(
+            [func](std::array<Scalar, dim> pos, Scalar t) -> Scalar { return func(pos, t); },
+            [func](std::array<Scalar, dim> pos, Scalar t) {
+                std::array<TimeDerivative, dim> p;
+                for (int i = 0; i < dim; ++i) p[i] = pos[i];
+                const TimeDerivative result = func(p, TimeDerivative::variable(t, 0));
+                return result.derivatives[0];
+            },
+            [evaluate](std::array<Scalar, dim> pos, Scalar t) {
+                return evaluate(pos, t).gradient;
+            });
+        form.m_evaluate = evaluate;
+        return form;
+    }
+
     /**
      * @brief Evaluate the function at a given position and time
      *
@@ -117,6 +162,89 @@ public:
         }
     }
 
+    /**
+     * @brief Evaluate the function together with its gradient
+     *
+     * Forms created by `from_generic` compute both in a single dual-number pass. When the
+     * gradient is approximated by finite differences, the value at the base point is shared
+     * between the value and every difference quotient.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return SpaceTimeEvaluation<dim, Scalar> The value and the space-time gradient
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        if (m_evaluate != nullptr) {
+            return m_evaluate(pos, t);
+        }
+
+        SpaceTimeEvaluation<dim, Scalar> result{m_function(pos, t), {}};
+        if (m_gradient != nullptr) {
+            result.gradient = m_gradient(pos, t);
+            return result;
+        }
+
+        // Finite difference
+        const Scalar delta = 1e-6;
+        for (int i = 0; i < dim; ++i) {
+            auto pos_delta = pos;
+            pos_delta[i] += delta;
+            result.gradient[i] = (m_function(pos_delta, t) - result.value) / delta;
+        }
+        if (m_time_derivative == nullptr) {
+            result.gradient[dim] = (m_function(pos, t + delta) - result.value) / delta;
+        } else {
+            result.gradient[dim] = m_time_derivative(pos, t);
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Evaluate the function at a batch of space-time points
+     *
+     * Calls the stored function object directly for each point.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            values[k] = m_function(gather(pos, k), t[k]);
+        }
+    }
+
+    /**
+     * @brief Compute the gradient at a batch of space-time points
+     *
+     * Calls the stored gradient function object directly when one was provided and falls back
+     * to the per-point finite difference approximation otherwise.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param gradients Output columns, spatial gradient first and time derivative last
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        if (m_gradient == nullptr) {
+            SpaceTimeFunction<dim, Scalar>::gradient_batch(pos, t, gradients);
+            return;
+        }
+        for (size_t k = 0; k < t.size(); ++k) {
+            const auto grad = m_gradient(gather(pos, k), t[k]);
+            for (int i = 0; i <= dim; ++i) gradients[i][k] = grad[i];
+        }
+    }
+
 private:
     std::function<Scalar(std::array<Scalar, dim>, Scalar)>
         m_function; ///< The function defining the value
@@ -124,6 +252,8 @@ private:
         m_time_derivative; ///< Optional function defining the time derivative
     std::function<std::array<Scalar, dim + 1>(std::array<Scalar, dim>, Scalar)>
         m_gradient; ///< Optional function defining the gradient
+    std::function<SpaceTimeEvaluation<dim, Scalar>(std::array<Scalar, dim>, Scalar)>
+        m_evaluate; ///< Optional function computing the value and the gradient together
 };
 
 } // namespace stf
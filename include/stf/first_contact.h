@@ -0,0 +1,298 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Options of the first contact search.
+ */
+struct FirstContactOptions
+{
+    size_t num_intervals = 8; ///< Number of time intervals the search starts from
+    /// Width below which time intervals with positive ends are no longer split, relative to the
+    /// time range. Contacts shorter than this may be missed.
+    double time_resolution = 1e-3;
+    /// Accuracy of the contact time, relative to the time range
+    double time_tolerance = 1e-9;
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+    size_t batch_size = 256; ///< Number of points whose start values are evaluated together
+};
+
+/**
+ * @brief Earliest contact of a space-time function at one position.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct ContactSample
+{
+    Scalar time; ///< The earliest time with f(pos, time) <= 0, NaN if there is none
+    /// The spatial gradient followed by the time derivative at the contact, NaN if there is none
+    std::array<Scalar, dim + 1> gradient;
+    size_t evaluations; ///< Number of function evaluations spent
+};
+
+/**
+ * @brief Computes the earliest t in [t0, t1] with f(pos, t) <= 0.
+ *
+ * Time intervals are searched from the earliest. An interval is dropped when its value bounds
+ * are positive, and its start is advanced by value / Lipschitz bound, the earliest time at which
+ * the value can reach zero. The remaining intervals are split at the Newton step of the start,
+ * or halved when that step leaves the interval, down to the time resolution. Once an interval
+ * ends at or below zero, the crossing is located by Newton steps safeguarded by bisection.
+ *
+ * The returned time satisfies f(pos, time) <= 0 and is within the time tolerance of a crossing.
+ *
+ * @param f The space-time function
+ * @param pos The position
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param options The tolerances
+ * @param start_value f(pos, t0) when already known, or NaN
+ * @return ContactSample<dim, Scalar> The contact time, gradient and evaluation count
+ */
+template <int dim, typename Scalar>
+ContactSample<dim, Scalar> first_contact_time(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const std::type_identity_t<std::array<Scalar, dim>>& pos,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    const FirstContactOptions& options = {},
+    std::type_identity_t<Scalar> start_value = std::numeric_limits<Scalar>::quiet_NaN())
+{
+    if (!(t0 <= t1)) throw std::invalid_argument("t0 must not exceed t1");
+
+    IntervalBox<dim, Scalar> point;
+    for (int i = 0; i < dim; ++i) point[i] = Interval<Scalar>(pos[i]);
+
+    constexpr Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+    const Scalar range = t1 - t0;
+    const Scalar resolution = Scalar(options.time_resolution) * range;
+    const Scalar tolerance = Scalar(options.time_tolerance) * range;
+
+    ContactSample<dim, Scalar> result{nan, {}, 0};
+    result.gradient.fill(nan);
+
+    struct Sample
+    {
+        Scalar t; ///< The time
+        Scalar value; ///< The value at t, NaN until sampled
+        std::array<Scalar, dim + 1> gradient; ///< The space-time gradient at t
+    };
+    auto sample = [&](Scalar t) {
+        const auto e = f.evaluate(pos, t);
+        ++result.evaluations;
+        return Sample{t, e.value, e.gradient};
+    };
+    auto contact = [&](const Sample& s) {
+        result.time = s.t;
+        result.gradient = s.gradient;
+        return result;
+    };
+
+    // Locate the crossing between a (positive) and c (non-positive).
+    auto refine = [&](Sample a, Sample c) {
+        Scalar previous_width = std::numeric_limits<Scalar>::infinity();
+        while (c.t - a.t > tolerance) {
+            const Scalar width = c.t - a.t;
+            Scalar t = (a.t + c.t) / 2;
+            if (width < previous_width / 2) {
+                // Newton from the end with the smaller value, kept only when inside the bracket.
+                const Sample& from = a.value < -c.value ? a : c;
+                const Scalar derivative = from.gradient[dim];
+                const Scalar newton = from.t - from.value / derivative;
+                if (derivative != 0 && newton > a.t && newton < c.t) t = newton;
+            }
+            previous_width = width;
+            const auto s = sample(t);
+            if (s.value <= 0) {
+                c = s;
+            } else {
+                a = s;
+            }
+        }
+        return contact(c);
+    };
+
+    if (std::isnan(start_value)) {
+        const auto s = sample(t0);
+        if (s.value <= 0) return contact(s);
+        start_value = s.value;
+    } else if (start_value <= 0) {
+        result.gradient = f.gradient(pos, t0);
+        ++result.evaluations;
+        result.time = t0;
+        return result;
+    }
+
+    struct Node
+    {
+        Sample a; ///< Start of the interval, positive once sampled
+        Sample b; ///< End of the interval
+    };
+
+    // Later intervals sit deeper in the stack, so the earliest is always searched first.
+    std::vector<Node> stack;
+    const size_t num_intervals = std::max<size_t>(options.num_intervals, 1);
+    for (size_t k = num_intervals; k > 0; --k) {
+        const Scalar a = t0 + range * Scalar(k - 1) / Scalar(num_intervals);
+        const Scalar b = k == num_intervals ? t1 : t0 + range * Scalar(k) / Scalar(num_intervals);
+        stack.push_back({{a, nan, {}}, {b, nan, {}}});
+    }
+    stack.back().a.value = start_value;
+    stack.back().a.gradient.fill(nan);
+
+    while (!stack.empty()) {
+        Node node = stack.back();
+        stack.pop_back();
+
+        const Interval<Scalar> times(node.a.t, node.b.t);
+        if (f.value_bounds(point, times).lower > 0) continue;
+
+        if (std::isnan(node.a.value)) {
+            node.a = sample(node.a.t);
+            if (node.a.value <= 0) return contact(node.a);
+        }
+
+        // No contact before the value can have decreased to zero at the Lipschitz rate.
+        const Scalar width = node.b.t - node.a.t;
+        const Scalar lipschitz = f.lipschitz_bound(point, times).temporal;
+        if (std::isfinite(lipschitz) && lipschitz > 0) {
+            const Scalar advance = node.a.t + node.a.value / lipschitz;
+            if (advance >= node.b.t) continue;
+            if (advance - node.a.t >= width / 8) {
+                stack.push_back({{advance, nan, {}}, node.b});
+                continue;
+            }
+        }
+
+        if (width <= resolution) {
+            if (std::isnan(node.b.value)) node.b = sample(node.b.t);
+            if (node.b.value <= 0) return refine(node.a, node.b);
+            continue;
+        }
+
+        Scalar split = (node.a.t + node.b.t) / 2;
+        const Scalar derivative = node.a.gradient[dim];
+        if (derivative < 0) {
+            const Scalar newton = node.a.t - node.a.value / derivative;
+            if (newton > node.a.t + width / 16 && newton < node.b.t) split = newton;
+        }
+        stack.push_back({{split, nan, {}}, node.b});
+        stack.push_back({node.a, {split, nan, {}}});
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the earliest contact time of a space-time function at a batch of points.
+ *
+ * The points are processed in batches: the start values of a batch are evaluated with one
+ * `value_batch` call, points already in contact at t0 get their gradients from one
+ * `gradient_batch` call, and the others are searched individually. Batches run in parallel and
+ * the output does not depend on the thread count.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param pos The positions, one span per coordinate
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param times Output receiving the contact time at each point, NaN where there is none
+ * @param gradients Optional output columns receiving the spatial gradient and time derivative at
+ * the contact, NaN where there is none; left untouched when empty
+ * @param options The search tolerances, thread count and batch size
+ * @return size_t The number of function evaluations spent
+ */
+template <int dim, typename Scalar>
+size_t first_contact_time_batch(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    std::type_identity_t<std::array<std::span<const Scalar>, dim>> pos,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    std::type_identity_t<std::span<Scalar>> times,
+    std::type_identity_t<std::array<std::span<Scalar>, dim + 1>> gradients = {},
+    const FirstContactOptions& options = {})
+{
+    const size_t n = times.size();
+    for (int i = 0; i < dim; ++i) {
+        if (pos[i].size() != n) throw std::invalid_argument("pos and times sizes differ");
+    }
+    const bool with_gradients = !gradients[0].empty();
+    for (int i = 0; i <= dim; ++i) {
+        if (gradients[i].size() != (with_gradients ? n : 0)) {
+            throw std::invalid_argument("gradients must be empty or hold one entry per point");
+        }
+    }
+    if (!(t0 <= t1)) throw std::invalid_argument("t0 must not exceed t1");
+    if (options.batch_size == 0) throw std::invalid_argument("batch_size must be positive");
+
+    const size_t batch_size = options.batch_size;
+    const size_t num_batches = (n + batch_size - 1) / batch_size;
+    std::vector<size_t> evaluations(num_batches, 0);
+    parallel_for(num_batches, options.num_threads, [&](size_t batch, size_t /*thread*/) {
+        const size_t begin = batch * batch_size;
+        const size_t count = std::min(n, begin + batch_size) - begin;
+        std::array<std::span<const Scalar>, dim> columns;
+        for (int i = 0; i < dim; ++i) columns[i] = pos[i].subspan(begin, count);
+
+        ColumnBuffer<2, Scalar> start(count);
+        std::fill(start.column(0).begin(), start.column(0).end(), t0);
+        f.value_batch(columns, start.column(0), start.column(1));
+        evaluations[batch] += count;
+
+        std::vector<size_t> touching;
+        for (size_t j = 0; j < count; ++j) {
+            const size_t k = begin + j;
+            if (start.column(1)[j] <= 0) {
+                times[k] = t0;
+                touching.push_back(k);
+                continue;
+            }
+            const auto result =
+                first_contact_time(f, gather(pos, k), t0, t1, options, start.column(1)[j]);
+            times[k] = result.time;
+            if (with_gradients) {
+                for (int i = 0; i <= dim; ++i) gradients[i][k] = result.gradient[i];
+            }
+            evaluations[batch] += result.evaluations;
+        }
+
+        if (with_gradients && !touching.empty()) {
+            const size_t m = touching.size();
+            ColumnBuffer<dim + 1, Scalar> buffer(m);
+            auto touching_columns = buffer.columns();
+            for (size_t j = 0; j < m; ++j) {
+                for (int i = 0; i < dim; ++i) touching_columns[i][j] = pos[i][touching[j]];
+            }
+            std::fill(touching_columns[dim].begin(), touching_columns[dim].end(), t0);
+            ColumnBuffer<dim + 1, Scalar> touching_gradients(m);
+            std::array<std::span<const Scalar>, dim> touching_pos;
+            for (int i = 0; i < dim; ++i) touching_pos[i] = buffer.column(i);
+            f.gradient_batch(touching_pos, buffer.column(dim), touching_gradients.columns());
+            for (size_t j = 0; j < m; ++j) {
+                for (int i = 0; i <= dim; ++i) {
+                    gradients[i][touching[j]] = touching_gradients.column(i)[j];
+                }
+            }
+            evaluations[batch] += m;
+        }
+    });
+
+    size_t total = 0;
+    for (size_t count : evaluations) total += count;
+    return total;
+}
+
+} // namespace stf
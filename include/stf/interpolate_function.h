@@ -1,13 +1,143 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/space_time_function.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <span>
 
 namespace stf {
 
+/**
+ * @brief Snapshot of an interpolate function at a fixed time.
+ *
+ * Blends the snapshots of both operands with a weight evaluated once from the interpolation
+ * function.
+ *
+ * @tparam dim The dimensionality of the space-time function
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class InterpolateSnapshot : public ImplicitFunction<dim, Scalar>
+{
+public:
+    /**
+     * @brief Construct a new Interpolate Snapshot object
+     *
+     * @param f1 The snapshot of the first function
+     * @param f2 The snapshot of the second function
+     * @param s The interpolation weight at the bound time
+     */
+    InterpolateSnapshot(
+        std::unique_ptr<ImplicitFunction<dim, Scalar>> f1,
+        std::unique_ptr<ImplicitFunction<dim, Scalar>> f2,
+        Scalar s)
+        : m_f1(std::move(f1))
+        , m_f2(std::move(f2))
+        , m_s(s)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        return m_f1->value(pos) * (1 - m_s) + m_f2->value(pos) * m_s;
+    }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        const auto g1 = m_f1->gradient(pos);
+        const auto g2 = m_f2->gradient(pos);
+        std::array<Scalar, dim> result;
+        for (int i = 0; i < dim; ++i) result[i] = g1[i] * (1 - m_s) + g2[i] * m_s;
+        return result;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto e1 = m_f1->evaluate(pos);
+        const auto e2 = m_f2->evaluate(pos);
+        ImplicitEvaluation<dim, Scalar> result;
+        result.value = e1.value * (1 - m_s) + e2.value * m_s;
+        for (int i = 0; i < dim; ++i) {
+            result.gradient[i] = e1.gradient[i] * (1 - m_s) + e2.gradient[i] * m_s;
+        }
+        return result;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        const auto H1 = m_f1->hessian(pos);
+        const auto H2 = m_f2->hessian(pos);
+        std::array<std::array<Scalar, dim>, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) result[i][j] = H1[i][j] * (1 - m_s) + H2[i][j] * m_s;
+        }
+        return result;
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f1->value_bounds(box) * (1 - m_s) + m_f2->value_bounds(box) * m_s;
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return lipschitz_product(std::abs(1 - m_s), m_f1->lipschitz_bound(box)) +
+               lipschitz_product(std::abs(m_s), m_f2->lipschitz_bound(box));
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        // A convex combination is at most `level` only where one of the operands is.
+        if (m_s < 0 || m_s > 1) return entire_box<dim, Scalar>();
+        return hull(m_f1->bounding_box(level), m_f2->bounding_box(level));
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<1, Scalar> b(values.size());
+        m_f1->value_batch(pos, values);
+        m_f2->value_batch(pos, b.column(0));
+
+        const auto vb = b.column(0);
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = values[k] * (1 - m_s) + vb[k] * m_s;
+        }
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        ColumnBuffer<dim, Scalar> grad_f2(gradients[0].size());
+        const auto g2 = grad_f2.columns();
+        m_f1->gradient_batch(pos, gradients);
+        m_f2->gradient_batch(pos, g2);
+
+        for (int i = 0; i < dim; ++i) {
+            for (size_t k = 0; k < gradients[i].size(); ++k) {
+                gradients[i][k] = gradients[i][k] * (1 - m_s) + g2[i][k] * m_s;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the interpolation weight at the bound time.
+     */
+    Scalar weight() const { return m_s; }
+
+private:
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> m_f1;
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> m_f2;
+    Scalar m_s;
+};
+
 /**
  * @brief A class that linearly interpolates two space-time functions at each time point.
  *
@@ -17,27 +147,54 @@ namespace stf {
  *
  * @tparam dim The dimensionality of the space-time function
  */
-template <int dim>
-class InterpolateFunction : public SpaceTimeFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class InterpolateFunction : public SpaceTimeFunction<dim, Scalar>
 {
 public:
+    /**
+     * @brief Construct a new Interpolate Function object with linear interpolation
+     *
+     * @param f1 The first space-time function (used at t=0)
+     * @param f2 The second space-time function (used at t=1)
+     */
+    InterpolateFunction(SpaceTimeFunction<dim, Scalar>& f1, SpaceTimeFunction<dim, Scalar>& f2)
+        : InterpolateFunction(
+              f1,
+              f2,
+              [](Scalar t) { return t; },
+              [](Scalar) { return Scalar(1); },
+              [](Interval<Scalar> t) { return t; },
+              [](Interval<Scalar>) { return Interval<Scalar>(1); })
+    {}
+
     /**
      * @brief Construct a new Interpolate Function object
      *
+     * The interpolation function is opaque to the library, so the value and Lipschitz bounds
+     * over a time range are only finite when the interval extensions of the interpolation
+     * function and of its derivative are provided.
+     *
      * @param f1 The first space-time function (used at t=0)
      * @param f2 The second space-time function (used at t=1)
-     * @param interpolation_func The interpolation function (default is linear)
+     * @param interpolation_func The interpolation function
      * @param interpolation_derivative The derivative of the interpolation function (default is 1)
+     * @param interpolation_bounds Interval extension of the interpolation function, or empty if
+     * unknown
+     * @param derivative_bounds Interval extension of its derivative, or empty if unknown
      */
     InterpolateFunction(
-        SpaceTimeFunction<dim>& f1,
-        SpaceTimeFunction<dim>& f2,
-        std::function<Scalar(Scalar)> interpolation_func = [](Scalar t) { return t; },
-        std::function<Scalar(Scalar)> interpolation_derivative = [](Scalar t) { return 1; })
+        SpaceTimeFunction<dim, Scalar>& f1,
+        SpaceTimeFunction<dim, Scalar>& f2,
+        std::function<Scalar(Scalar)> interpolation_func,
+        std::function<Scalar(Scalar)> interpolation_derivative = [](Scalar) { return Scalar(1); },
+        IntervalExtension<Scalar> interpolation_bounds = {},
+        IntervalExtension<Scalar> derivative_bounds = {})
         : m_f1(f1)
         , m_f2(f2)
-        , m_interpolation_func(interpolation_func)
-        , m_interpolation_derivative(interpolation_derivative)
+        , m_interpolation_func(std::move(interpolation_func))
+        , m_interpolation_derivative(std::move(interpolation_derivative))
+        , m_interpolation_bounds(std::move(interpolation_bounds))
+        , m_derivative_bounds(std::move(derivative_bounds))
     {}
 
     /**
@@ -80,28 +237,308 @@ public:
      */
     std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
     {
-        std::array<Scalar, dim + 1> grad_f1 = m_f1.gradient(pos, t);
-        std::array<Scalar, dim + 1> grad_f2 = m_f2.gradient(pos, t);
+        return evaluate(pos, t).gradient;
+    }
 
-        Scalar s = m_interpolation_func(t);
+    /**
+     * @brief Compute the interpolated value together with its gradient
+     *
+     * Both operands are evaluated exactly once and the interpolation functions are called once.
+     *
+     * @param pos The spatial position
+     * @param t The time parameter (0 to 1)
+     * @return SpaceTimeEvaluation<dim, Scalar> The interpolated value and gradient
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const auto e1 = m_f1.evaluate(pos, t);
+        const auto e2 = m_f2.evaluate(pos, t);
+        const Scalar s = m_interpolation_func(t);
+        const Scalar ds_dt = m_interpolation_derivative(t);
+
+        SpaceTimeEvaluation<dim, Scalar> result;
+        result.value = e1.value * (1 - s) + e2.value * s;
+        for (int i = 0; i < dim; ++i) {
+            result.gradient[i] = e1.gradient[i] * (1 - s) + e2.gradient[i] * s;
+        }
+        result.gradient[dim] = e1.gradient[dim] * (1 - s) + e2.gradient[dim] * s -
+                               e1.value * ds_dt + e2.value * ds_dt;
+        return result;
+    }
+
+    /**
+     * @brief Compute the space-time Hessian of the interpolated function
+     *
+     * Differentiating f1 (1 - s) + f2 s twice adds s' (∇f2 - ∇f1) to the mixed terms and
+     * 2 s' (∂f2/∂t - ∂f1/∂t) + s'' (f2 - f1) to ∂²/∂t². The second derivative s'' of the
+     * interpolation function is approximated by a central difference of its derivative, with a
+     * step of ∛ε scaled by max(1, |t|).
+     *
+     * @param pos The spatial position
+     * @param t The time parameter (0 to 1)
+     * @return std::array<std::array<Scalar, dim + 1>, dim + 1> The space-time Hessian
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        const Scalar delta = std::cbrt(std::numeric_limits<Scalar>::epsilon()) *
+                             std::max(Scalar(1), std::abs(t));
+        const auto e1 = m_f1.evaluate(pos, t);
+        const auto e2 = m_f2.evaluate(pos, t);
+        const auto H1 = m_f1.hessian(pos, t);
+        const auto H2 = m_f2.hessian(pos, t);
+        const Scalar s = m_interpolation_func(t);
+        const Scalar ds_dt = m_interpolation_derivative(t);
+        const Scalar d2s_dt2 =
+            (m_interpolation_derivative(t + delta) - m_interpolation_derivative(t - delta)) /
+            (2 * delta);
 
+        std::array<std::array<Scalar, dim + 1>, dim + 1> result;
+        for (int i = 0; i <= dim; ++i) {
+            for (int j = 0; j <= dim; ++j) result[i][j] = H1[i][j] * (1 - s) + H2[i][j] * s;
+        }
         for (int i = 0; i < dim; ++i) {
-            grad_f1[i] = grad_f1[i] * (1 - s) + grad_f2[i] * s;
+            const Scalar mixed = (e2.gradient[i] - e1.gradient[i]) * ds_dt;
+            result[i][dim] += mixed;
+            result[dim][i] += mixed;
+        }
+        result[dim][dim] += 2 * (e2.gradient[dim] - e1.gradient[dim]) * ds_dt +
+                            (e2.value - e1.value) * d2s_dt2;
+        return result;
+    }
+
+    /**
+     * @brief Bound the interpolated function over a space-time box
+     *
+     * The range of the interpolation weight over the time interval comes from its interval
+     * extension, and is entire without one. While the weight stays within [0, 1] the value is a
+     * convex combination of the operands and lies within the hull of their bounds; otherwise the
+     * bounds are combined in interval arithmetic.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return Interval<Scalar> A conservative range of values over the space-time box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        const auto a = m_f1.value_bounds(box, t);
+        const auto b = m_f2.value_bounds(box, t);
+        const auto s = curve_bounds(m_interpolation_func, m_interpolation_bounds, t);
+        if (s.lower >= 0 && s.upper <= 1) return hull(a, b);
+        return a * (1 - s) + b * s;
+    }
+
+    /**
+     * @brief Bound the rates of change of the interpolated function over a space-time box
+     *
+     * The time derivative is (1 - s) f1' + s f2' + s' (f2 - f1). The ranges of the weight and of
+     * its derivative come from their interval extensions, and are entire without them.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return LipschitzBound<Scalar> The Lipschitz constants over the space-time box
+     */
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        const auto s = curve_bounds(m_interpolation_func, m_interpolation_bounds, t);
+        const auto ds = curve_bounds(m_interpolation_derivative, m_derivative_bounds, t);
+        const Scalar w1 = abs(1 - s).upper;
+        const Scalar w2 = abs(s).upper;
+        const auto L1 = m_f1.lipschitz_bound(box, t);
+        const auto L2 = m_f2.lipschitz_bound(box, t);
+        const auto difference = m_f2.value_bounds(box, t) - m_f1.value_bounds(box, t);
+        return {
+            lipschitz_product(w1, L1.spatial) + lipschitz_product(w2, L2.spatial),
+            lipschitz_product(w1, L1.temporal) + lipschitz_product(w2, L2.temporal) +
+                lipschitz_product(abs(ds).upper, abs(difference).upper)};
+    }
+
+    /**
+     * @brief Bound the region swept by the zero set over a time range
+     *
+     * While the weight stays within [0, 1] the value is a convex combination of the operands, so
+     * it is at most `level` only where one of the operands is. Extrapolating or unknown weights
+     * leave the region unbounded.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the swept sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        const auto s = curve_bounds(m_interpolation_func, m_interpolation_bounds, Interval(t0, t1));
+        if (s.lower < 0 || s.upper > 1) return entire_box<dim, Scalar>();
+        return hull(m_f1.bounding_box(t0, t1, level), m_f2.bounding_box(t0, t1, level));
+    }
+
+public:
+    /**
+     * @brief Compute the interpolated value at a batch of space-time points
+     *
+     * The interpolation function is only re-evaluated when the time changes between consecutive
+     * points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<2, Scalar> scratch(t.size());
+        const auto columns = scratch.columns();
+        m_f1.value_batch(pos, t, values);
+        m_f2.value_batch(pos, t, columns[0]);
+        evaluate_per_time(m_interpolation_func, t, columns[1]);
+
+        for (size_t k = 0; k < t.size(); ++k) {
+            Scalar s = columns[1][k];
+            values[k] = values[k] * (1 - s) + columns[0][k] * s;
+        }
+    }
+
+    /**
+     * @brief Compute the time derivative at a batch of space-time points
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param time_derivatives Output span receiving one time derivative per point
+     */
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        ColumnBuffer<5, Scalar> scratch(t.size());
+        const auto columns = scratch.columns();
+        m_f1.value_batch(pos, t, columns[0]);
+        m_f2.value_batch(pos, t, columns[1]);
+        m_f2.time_derivative_batch(pos, t, columns[2]);
+        m_f1.time_derivative_batch(pos, t, time_derivatives);
+        evaluate_per_time(m_interpolation_func, t, columns[3]);
+        evaluate_per_time(m_interpolation_derivative, t, columns[4]);
+
+        for (size_t k = 0; k < t.size(); ++k) {
+            Scalar s = columns[3][k];
+            Scalar ds_dt = columns[4][k];
+            time_derivatives[k] = time_derivatives[k] * (1 - s) + columns[2][k] * s -
+                                  columns[0][k] * ds_dt + columns[1][k] * ds_dt;
         }
-        grad_f1[dim] = time_derivative(pos, t);
+    }
 
-        return grad_f1;
+    /**
+     * @brief Compute the gradient at a batch of space-time points
+     *
+     * The time component reuses the time derivatives carried by the operand gradients instead
+     * of evaluating them a second time.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param gradients Output columns, spatial gradient first and time derivative last
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        ColumnBuffer<4, Scalar> scratch(t.size());
+        ColumnBuffer<dim + 1, Scalar> grad_f2(t.size());
+        const auto columns = scratch.columns();
+        const auto g2 = grad_f2.columns();
+        m_f1.value_batch(pos, t, columns[0]);
+        m_f2.value_batch(pos, t, columns[1]);
+        m_f1.gradient_batch(pos, t, gradients);
+        m_f2.gradient_batch(pos, t, g2);
+        evaluate_per_time(m_interpolation_func, t, columns[2]);
+        evaluate_per_time(m_interpolation_derivative, t, columns[3]);
+
+        for (size_t k = 0; k < t.size(); ++k) {
+            Scalar s = columns[2][k];
+            Scalar ds_dt = columns[3][k];
+            for (int i = 0; i < dim; ++i) {
+                gradients[i][k] = gradients[i][k] * (1 - s) + g2[i][k] * s;
+            }
+            gradients[dim][k] = gradients[dim][k] * (1 - s) + g2[dim][k] * s -
+                                columns[0][k] * ds_dt + columns[1][k] * ds_dt;
+        }
+    }
+
+    /**
+     * @brief Freeze the function at time t, evaluating the interpolation function once
+     *
+     * @param t The time parameter (0 to 1)
+     * @return std::unique_ptr<ImplicitFunction<dim, Scalar>> The spatial snapshot at time t
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        return std::make_unique<InterpolateSnapshot<dim, Scalar>>(
+            m_f1.bind_time(t),
+            m_f2.bind_time(t),
+            m_interpolation_func(t));
     }
 
 private:
-    SpaceTimeFunction<dim>& m_f1; ///< The first function (used at t=0)
-    SpaceTimeFunction<dim>& m_f2; ///< The second function (used at t=1)
+    /**
+     * @brief Writes func(t[k]) to out[k], reusing the previous result for repeated times.
+     */
+    static void evaluate_per_time(
+        const std::function<Scalar(Scalar)>& func,
+        std::span<const Scalar> t,
+        std::span<Scalar> out)
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            out[k] = (k > 0 && t[k] == t[k - 1]) ? out[k - 1] : func(t[k]);
+        }
+    }
+
+public:
+    /**
+     * @brief Get the first function (used at t=0).
+     */
+    const SpaceTimeFunction<dim, Scalar>& first() const { return m_f1; }
+
+    /**
+     * @brief Get the second function (used at t=1).
+     */
+    const SpaceTimeFunction<dim, Scalar>& second() const { return m_f2; }
+
+    /**
+     * @brief Get the interpolation function.
+     */
+    const std::function<Scalar(Scalar)>& interpolation_function() const
+    {
+        return m_interpolation_func;
+    }
+
+    /**
+     * @brief Get the derivative of the interpolation function.
+     */
+    const std::function<Scalar(Scalar)>& interpolation_derivative() const
+    {
+        return m_interpolation_derivative;
+    }
+
+private:
+    SpaceTimeFunction<dim, Scalar>& m_f1; ///< The first function (used at t=0)
+    SpaceTimeFunction<dim, Scalar>& m_f2; ///< The second function (used at t=1)
 
     ///< The interpolation function
     std::function<Scalar(Scalar)> m_interpolation_func;
 
     /// The derivative of the interpolation function
     std::function<Scalar(Scalar)> m_interpolation_derivative;
+
+    /// Interval extension of the interpolation function, if known
+    IntervalExtension<Scalar> m_interpolation_bounds;
+
+    /// Interval extension of the derivative of the interpolation function, if known
+    IntervalExtension<Scalar> m_derivative_bounds;
 };
 
 } // namespace stf
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/sample_grid.h>
+#include <stf/space_time_function.h>
+#include <stf/sparse_grid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Indexed triangle mesh.
+ */
+template <typename Scalar = stf::Scalar>
+struct TriangleMesh
+{
+    std::vector<std::array<Scalar, 3>> vertices; ///< Vertex positions
+    std::vector<std::array<uint32_t, 3>> triangles; ///< Vertex indices, counterclockwise
+    std::vector<std::array<Scalar, 3>> normals; ///< Unit vertex normals, empty if not requested
+};
+
+/**
+ * @brief Options of the marching cubes extractor.
+ */
+struct MarchingCubesOptions
+{
+    size_t block_size = 16; ///< Number of cells per block along each axis
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+    bool normals = false; ///< Whether to compute vertex normals from the gradient
+};
+
+/**
+ * @brief Triangles of the 256 marching cubes configurations.
+ *
+ * Corner c of a cell sits at offset (c & 1, (c >> 1) & 1, (c >> 2) & 1), and configuration bit c
+ * is set when corner c is inside (negative). Edge 4 * a + k runs along axis a from the corner
+ * whose two other coordinates are the bits of k. The table is built by tracing the contour on
+ * every face of the cell; on faces with two diagonal inside corners, the inside corners are kept
+ * apart. The choice only depends on the face, so neighboring cells agree and the surface is
+ * closed.
+ */
+class MarchingCubesTable
+{
+public:
+    /**
+     * @brief Get the shared table.
+     */
+    static const MarchingCubesTable& get()
+    {
+        static const MarchingCubesTable table;
+        return table;
+    }
+
+    /**
+     * @brief Get the triangles of a configuration, as triples of edge indices.
+     */
+    const std::vector<std::array<uint8_t, 3>>& triangles(size_t configuration) const
+    {
+        return m_triangles[configuration];
+    }
+
+    /**
+     * @brief Get the number of connected sheets of a configuration.
+     */
+    size_t components(size_t configuration) const { return m_components[configuration]; }
+
+    /**
+     * @brief Get the lower corner of an edge.
+     */
+    static int edge_corner(int edge)
+    {
+        const int axis = edge / 4;
+        const int k = edge % 4;
+        return ((k & 1) << ((axis + 1) % 3)) | ((k >> 1) << ((axis + 2) % 3));
+    }
+
+    /**
+     * @brief Get the axis of an edge.
+     */
+    static int edge_axis(int edge) { return edge / 4; }
+
+private:
+    MarchingCubesTable()
+    {
+        for (int configuration = 0; configuration < 256; ++configuration) {
+            build(configuration);
+        }
+    }
+
+    static int edge_between(int c0, int c1)
+    {
+        const int lower = std::min(c0, c1);
+        const int axis = (c0 ^ c1) == 1 ? 0 : ((c0 ^ c1) == 2 ? 1 : 2);
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        return axis * 4 + (((lower >> u) & 1) | (((lower >> v) & 1) << 1));
+    }
+
+    void build(int configuration)
+    {
+        auto inside = [&](int corner) { return (configuration >> corner) & 1; };
+
+        // next[e] is the edge following e along the contour, -1 if e is not crossed.
+        std::array<int, 12> next;
+        next.fill(-1);
+        for (int axis = 0; axis < 3; ++axis) {
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            for (int side = 0; side < 2; ++side) {
+                // Face corners, counterclockwise seen from outside the cell.
+                std::array<int, 4> q;
+                const int square[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+                for (int k = 0; k < 4; ++k) {
+                    const int j = side == 1 ? k : 3 - k;
+                    q[k] = (side << axis) | (square[j][0] << u) | (square[j][1] << v);
+                }
+                // Join the crossing entering each run of inside corners to the one leaving it.
+                for (int k = 0; k < 4; ++k) {
+                    if (inside(q[k]) || !inside(q[(k + 1) % 4])) continue;
+                    int j = (k + 1) % 4;
+                    while (inside(q[(j + 1) % 4])) j = (j + 1) % 4;
+                    next[edge_between(q[k], q[(k + 1) % 4])] = edge_between(q[j], q[(j + 1) % 4]);
+                }
+            }
+        }
+
+        // Fan-triangulate every contour loop.
+        std::array<bool, 12> visited{};
+        for (int start = 0; start < 12; ++start) {
+            if (next[start] < 0 || visited[start]) continue;
+            std::vector<uint8_t> loop;
+            for (int e = start; !visited[e]; e = next[e]) {
+                visited[e] = true;
+                loop.push_back(static_cast<uint8_t>(e));
+            }
+            ++m_components[configuration];
+            for (size_t i = 1; i + 1 < loop.size(); ++i) {
+                m_triangles[configuration].push_back({loop[0], loop[i], loop[i + 1]});
+            }
+        }
+    }
+
+private:
+    std::array<std::vector<std::array<uint8_t, 3>>, 256> m_triangles;
+    std::array<size_t, 256> m_components{};
+};
+
+/**
+ * @brief Extracts the zero level set of an implicit function with marching cubes.
+ *
+ * The cells of the grid are split into blocks. Blocks whose bounds exclude zero are skipped
+ * (see `cull_blocks`); the others are sampled and triangulated independently in parallel, so
+ * memory scales with the number of blocks crossed by the surface rather than with the grid.
+ * Vertices on the same grid edge are merged, in block order, so the output does not depend on the
+ * thread count. Triangles are oriented counterclockwise seen from the positive side.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param options The block size, thread count, and whether to compute normals
+ * @return TriangleMesh<Scalar> The surface mesh
+ */
+template <typename Scalar>
+TriangleMesh<Scalar> marching_cubes(
+    const ImplicitFunction<3, Scalar>& f,
+    const GridSpec<3, Scalar>& grid,
+    const MarchingCubesOptions& options = {})
+{
+    if (options.block_size == 0) {
+        throw std::invalid_argument("block_size must be positive");
+    }
+
+    TriangleMesh<Scalar> mesh;
+    std::array<size_t, 3> cells;
+    std::array<size_t, 3> counts;
+    const size_t block_size = options.block_size;
+    for (int i = 0; i < 3; ++i) {
+        if (grid.resolution[i] < 2) return mesh;
+        cells[i] = grid.resolution[i] - 1;
+        counts[i] = (cells[i] + block_size - 1) / block_size;
+    }
+    const size_t num_threads = resolve_thread_count(options.num_threads);
+
+    // A block of cells covers the nodes from its first cell to one past its last cell.
+    auto block_box = [&](const std::array<size_t, 3>& lower, const std::array<size_t, 3>& upper) {
+        IntervalBox<3, Scalar> box;
+        for (int i = 0; i < 3; ++i) {
+            std::array<size_t, 3> first{}, last{};
+            first[i] = lower[i] * block_size;
+            last[i] = std::min(upper[i] * block_size, cells[i]);
+            box[i] = Interval<Scalar>(grid.position(first)[i], grid.position(last)[i]);
+        }
+        return box;
+    };
+    const auto blocks = cull_blocks(f, counts, Scalar(0), num_threads, block_box).blocks;
+
+    struct BlockMesh
+    {
+        std::vector<std::array<Scalar, 3>> vertices;
+        std::vector<uint64_t> keys; ///< Grid edge of each vertex: 3 * lower node + axis
+        std::vector<std::array<uint32_t, 3>> triangles;
+    };
+    struct Scratch
+    {
+        ColumnBuffer<3, Scalar> positions;
+        std::vector<Scalar> values;
+        std::unordered_map<uint64_t, uint32_t> vertex_of_edge;
+    };
+
+    const auto& table = MarchingCubesTable::get();
+    const size_t max_nodes = (block_size + 1) * (block_size + 1) * (block_size + 1);
+    const size_t block_threads = std::min(num_threads, std::max<size_t>(blocks.size(), 1));
+    std::vector<Scratch> scratch;
+    scratch.reserve(block_threads);
+    for (size_t i = 0; i < block_threads; ++i) {
+        scratch.push_back({ColumnBuffer<3, Scalar>(max_nodes), std::vector<Scalar>(max_nodes), {}});
+    }
+    std::vector<BlockMesh> block_meshes(blocks.size());
+
+    parallel_for(blocks.size(), block_threads, [&](size_t k, size_t thread) {
+        auto& s = scratch[thread];
+        std::array<size_t, 3> origin;
+        std::array<size_t, 3> size;
+        size_t index = blocks[k];
+        for (int i = 0; i < 3; ++i) {
+            origin[i] = (index % counts[i]) * block_size;
+            index /= counts[i];
+            size[i] = std::min(block_size, cells[i] - origin[i]) + 1;
+        }
+
+        // Sample the nodes of the block.
+        const size_t num_nodes = size[0] * size[1] * size[2];
+        auto columns = s.positions.columns();
+        std::array<size_t, 3> local{};
+        for (size_t j = 0; j < num_nodes; ++j) {
+            const auto p = grid.position({origin[0] + local[0], origin[1] + local[1],
+                                          origin[2] + local[2]});
+            for (int i = 0; i < 3; ++i) columns[i][j] = p[i];
+            for (int i = 0; i < 3 && ++local[i] == size[i]; ++i) local[i] = 0;
+        }
+        std::array<std::span<const Scalar>, 3> pos;
+        for (int i = 0; i < 3; ++i) pos[i] = s.positions.column(i).first(num_nodes);
+        f.value_batch(pos, std::span<Scalar>(s.values).first(num_nodes));
+
+        auto node_index = [&](size_t x, size_t y, size_t z) {
+            return x + size[0] * (y + size[1] * z);
+        };
+
+        auto& out = block_meshes[k];
+        s.vertex_of_edge.clear();
+        auto vertex = [&](size_t x, size_t y, size_t z, int edge) {
+            const int corner = MarchingCubesTable::edge_corner(edge);
+            const int axis = MarchingCubesTable::edge_axis(edge);
+            std::array<size_t, 3> a{x + (corner & 1), y + ((corner >> 1) & 1), z + (corner >> 2)};
+            std::array<size_t, 3> global;
+            for (int i = 0; i < 3; ++i) global[i] = origin[i] + a[i];
+            const uint64_t key = uint64_t(grid.index(global)) * 3 + uint64_t(axis);
+            auto [it, inserted] = s.vertex_of_edge.try_emplace(key, uint32_t(out.vertices.size()));
+            if (!inserted) return it->second;
+
+            std::array<size_t, 3> b = a;
+            ++b[axis];
+            const Scalar v0 = s.values[node_index(a[0], a[1], a[2])];
+            const Scalar v1 = s.values[node_index(b[0], b[1], b[2])];
+            auto p = grid.position(global);
+            p[axis] += v0 / (v0 - v1) * grid.spacing[axis];
+            out.vertices.push_back(p);
+            out.keys.push_back(key);
+            return it->second;
+        };
+
+        for (size_t z = 0; z + 1 < size[2]; ++z) {
+            for (size_t y = 0; y + 1 < size[1]; ++y) {
+                for (size_t x = 0; x + 1 < size[0]; ++x) {
+                    size_t configuration = 0;
+                    for (int c = 0; c < 8; ++c) {
+                        const Scalar v =
+                            s.values[node_index(x + (c & 1), y + ((c >> 1) & 1), z + (c >> 2))];
+                        if (v < 0) configuration |= size_t(1) << c;
+                    }
+                    for (const auto& triangle : table.triangles(configuration)) {
+                        out.triangles.push_back(
+                            {vertex(x, y, z, triangle[0]),
+                             vertex(x, y, z, triangle[1]),
+                             vertex(x, y, z, triangle[2])});
+                    }
+                }
+            }
+        }
+    });
+
+    // Merge the blocks, sharing the vertices on block boundaries.
+    std::unordered_map<uint64_t, uint32_t> vertex_of_edge;
+    for (const auto& block : block_meshes) {
+        std::vector<uint32_t> remap(block.vertices.size());
+        for (size_t j = 0; j < block.vertices.size(); ++j) {
+            auto [it, inserted] =
+                vertex_of_edge.try_emplace(block.keys[j], uint32_t(mesh.vertices.size()));
+            if (inserted) mesh.vertices.push_back(block.vertices[j]);
+            remap[j] = it->second;
+        }
+        for (const auto& triangle : block.triangles) {
+            mesh.triangles.push_back({remap[triangle[0]], remap[triangle[1]], remap[triangle[2]]});
+        }
+    }
+
+    if (options.normals) {
+        const size_t n = mesh.vertices.size();
+        ColumnBuffer<3, Scalar> positions(n);
+        ColumnBuffer<3, Scalar> gradients(n);
+        auto columns = positions.columns();
+        for (size_t j = 0; j < n; ++j) {
+            for (int i = 0; i < 3; ++i) columns[i][j] = mesh.vertices[j][i];
+        }
+
+        constexpr size_t tile_size = 4096;
+        const size_t num_tiles = (n + tile_size - 1) / tile_size;
+        parallel_for(num_tiles, num_threads, [&](size_t tile, size_t /*thread*/) {
+            const size_t begin = tile * tile_size;
+            const size_t count = std::min(tile_size, n - begin);
+            std::array<std::span<const Scalar>, 3> pos;
+            std::array<std::span<Scalar>, 3> gradient_columns;
+            for (int i = 0; i < 3; ++i) {
+                pos[i] = positions.column(i).subspan(begin, count);
+                gradient_columns[i] = gradients.column(i).subspan(begin, count);
+            }
+            f.gradient_batch(pos, gradient_columns);
+        });
+
+        mesh.normals.resize(n);
+        const auto g = gradients.const_columns();
+        for (size_t j = 0; j < n; ++j) {
+            const Scalar norm =
+                std::sqrt(g[0][j] * g[0][j] + g[1][j] * g[1][j] + g[2][j] * g[2][j]);
+            const Scalar scale = norm > 0 ? 1 / norm : 0;
+            mesh.normals[j] = {g[0][j] * scale, g[1][j] * scale, g[2][j] * scale};
+        }
+    }
+
+    return mesh;
+}
+
+/**
+ * @brief Extracts the zero level set of a space-time function at a fixed time.
+ *
+ * The function is bound to time t once, and its snapshot is meshed as in the implicit overload.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param t The time
+ * @param options The block size, thread count, and whether to compute normals
+ * @return TriangleMesh<Scalar> The surface mesh
+ */
+template <typename Scalar>
+TriangleMesh<Scalar> marching_cubes(
+    const SpaceTimeFunction<3, Scalar>& f,
+    const GridSpec<3, Scalar>& grid,
+    std::type_identity_t<Scalar> t,
+    const MarchingCubesOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    return marching_cubes(*snapshot, grid, options);
+}
+
+} // namespace stf
@@ -2,3 +2,5 @@
 
 #include <stf/maths/maths_3d.h>
 #include <stf/maths/maths_2d.h>
+#include <stf/maths/dual.h>
+#include <stf/maths/interval.h>
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <stf/common.h>
+
+#include <array>
+#include <cmath>
+#include <compare>
+#include <type_traits>
+
+namespace stf {
+
+/**
+ * @brief Dual number carrying a value and its partial derivatives for forward-mode AD.
+ *
+ * Arithmetic on dual numbers propagates the derivatives with respect to N independent variables
+ * alongside the value, so evaluating a function once on dual inputs yields its exact gradient.
+ * Plain scalars convert implicitly to constants.
+ *
+ * The elementary functions below are found through argument-dependent lookup. Generic code that
+ * should work with both plain scalars and dual numbers calls them unqualified after a using
+ * declaration, e.g. `using std::sqrt; return sqrt(x);`.
+ *
+ * @tparam Scalar The underlying scalar type
+ * @tparam N The number of independent variables
+ */
+template <typename Scalar, int N>
+struct Dual
+{
+    Scalar value = 0; ///< The value
+    std::array<Scalar, N> derivatives{}; ///< The partial derivatives of the value
+
+    Dual() = default;
+
+    /**
+     * @brief Constructs a constant, whose derivatives are all zero.
+     */
+    Dual(Scalar v)
+        : value(v)
+    {}
+
+    Dual(Scalar v, const std::array<Scalar, N>& d)
+        : value(v)
+        , derivatives(d)
+    {}
+
+    /**
+     * @brief Constructs the i-th independent variable with the given value.
+     */
+    static Dual variable(Scalar v, int i)
+    {
+        Dual result(v);
+        result.derivatives[i] = 1;
+        return result;
+    }
+
+    Dual operator-() const
+    {
+        Dual result(-value);
+        for (int i = 0; i < N; ++i) result.derivatives[i] = -derivatives[i];
+        return result;
+    }
+
+    Dual& operator+=(const Dual& b)
+    {
+        value += b.value;
+        for (int i = 0; i < N; ++i) derivatives[i] += b.derivatives[i];
+        return *this;
+    }
+
+    Dual& operator-=(const Dual& b)
+    {
+        value -= b.value;
+        for (int i = 0; i < N; ++i) derivatives[i] -= b.derivatives[i];
+        return *this;
+    }
+
+    Dual& operator*=(const Dual& b) { return *this = *this * b; }
+    Dual& operator/=(const Dual& b) { return *this = *this / b; }
+
+    friend Dual operator+(Dual a, const Dual& b) { return a += b; }
+    friend Dual operator-(Dual a, const Dual& b) { return a -= b; }
+
+    friend Dual operator*(const Dual& a, const Dual& b)
+    {
+        Dual result(a.value * b.value);
+        for (int i = 0; i < N; ++i) {
+            result.derivatives[i] = a.derivatives[i] * b.value + a.value * b.derivatives[i];
+        }
+        return result;
+    }
+
+    friend Dual operator/(const Dual& a, const Dual& b)
+    {
+        const Scalar inv = 1 / b.value;
+        Dual result(a.value * inv);
+        for (int i = 0; i < N; ++i) {
+            result.derivatives[i] = (a.derivatives[i] - result.value * b.derivatives[i]) * inv;
+        }
+        return result;
+    }
+
+    // Mixed operations with plain scalars skip the zero derivatives of the constant.
+    friend Dual operator+(Dual a, Scalar b)
+    {
+        a.value += b;
+        return a;
+    }
+
+    friend Dual operator-(Dual a, Scalar b)
+    {
+        a.value -= b;
+        return a;
+    }
+
+    friend Dual operator+(Scalar a, const Dual& b) { return b + a; }
+    friend Dual operator-(Scalar a, const Dual& b) { return -b + a; }
+
+    friend Dual operator*(Dual a, Scalar b)
+    {
+        a.value *= b;
+        for (int i = 0; i < N; ++i) a.derivatives[i] *= b;
+        return a;
+    }
+
+    friend Dual operator*(Scalar a, const Dual& b) { return b * a; }
+    friend Dual operator/(const Dual& a, Scalar b) { return a * (1 / b); }
+
+    // Comparisons only look at the value, so branches follow the primal computation.
+    friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+    friend auto operator<=>(const Dual& a, const Dual& b) { return a.value <=> b.value; }
+};
+
+/**
+ * @brief Applies the chain rule: returns f(x) given f(x.value) and f'(x.value).
+ */
+template <typename Scalar, int N>
+Dual<Scalar, N>
+chain(const Dual<Scalar, N>& x, std::type_identity_t<Scalar> f, std::type_identity_t<Scalar> df)
+{
+    Dual<Scalar, N> result(f);
+    for (int i = 0; i < N; ++i) result.derivatives[i] = df * x.derivatives[i];
+    return result;
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> sqrt(const Dual<Scalar, N>& x)
+{
+    const Scalar s = std::sqrt(x.value);
+    return chain(x, s, Scalar(0.5) / s);
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> cbrt(const Dual<Scalar, N>& x)
+{
+    const Scalar s = std::cbrt(x.value);
+    return chain(x, s, 1 / (3 * s * s));
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> exp(const Dual<Scalar, N>& x)
+{
+    const Scalar e = std::exp(x.value);
+    return chain(x, e, e);
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> log(const Dual<Scalar, N>& x)
+{
+    return chain(x, std::log(x.value), 1 / x.value);
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> sin(const Dual<Scalar, N>& x)
+{
+    return chain(x, std::sin(x.value), std::cos(x.value));
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> cos(const Dual<Scalar, N>& x)
+{
+    return chain(x, std::cos(x.value), -std::sin(x.value));
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> tan(const Dual<Scalar, N>& x)
+{
+    const Scalar t = std::tan(x.value);
+    return chain(x, t, 1 + t * t);
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> atan(const Dual<Scalar, N>& x)
+{
+    return chain(x, std::atan(x.value), 1 / (1 + x.value * x.value));
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> atan2(const Dual<Scalar, N>& y, const Dual<Scalar, N>& x)
+{
+    const Scalar r2 = x.value * x.value + y.value * y.value;
+    Dual<Scalar, N> result(std::atan2(y.value, x.value));
+    for (int i = 0; i < N; ++i) {
+        result.derivatives[i] = (x.value * y.derivatives[i] - y.value * x.derivatives[i]) / r2;
+    }
+    return result;
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> abs(const Dual<Scalar, N>& x)
+{
+    return x.value < 0 ? -x : x;
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> pow(const Dual<Scalar, N>& x, std::type_identity_t<Scalar> p)
+{
+    return chain(x, std::pow(x.value, p), p * std::pow(x.value, p - 1));
+}
+
+template <typename Scalar, int N>
+Dual<Scalar, N> pow(const Dual<Scalar, N>& x, const Dual<Scalar, N>& p)
+{
+    return exp(p * log(x));
+}
+
+} // namespace stf
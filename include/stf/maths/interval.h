@@ -0,0 +1,380 @@
+#pragma once
+
+#include <stf/common.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numbers>
+
+namespace stf {
+
+/**
+ * @brief Closed interval [lower, upper] used to bound function values over a region.
+ *
+ * Arithmetic on intervals returns an interval containing every result of the operation applied
+ * to members of the operands, so a function evaluated on intervals yields a conservative range.
+ * Infinite bounds are allowed; `entire()` is the whole real line and stands for "unknown".
+ *
+ * @tparam Scalar The scalar type of the bounds
+ */
+template <typename Scalar>
+struct Interval
+{
+    Scalar lower = 0; ///< The lower bound
+    Scalar upper = 0; ///< The upper bound
+
+    Interval() = default;
+
+    /**
+     * @brief Constructs the degenerate interval [v, v].
+     */
+    Interval(Scalar v)
+        : lower(v)
+        , upper(v)
+    {}
+
+    Interval(Scalar lo, Scalar hi)
+        : lower(lo)
+        , upper(hi)
+    {}
+
+    /**
+     * @brief The whole real line.
+     */
+    static Interval entire()
+    {
+        constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+        return {-inf, inf};
+    }
+
+    /**
+     * @brief The empty interval, whose lower bound exceeds its upper bound.
+     *
+     * It is the identity of `hull`; arithmetic on it is meaningless.
+     */
+    static Interval empty()
+    {
+        constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+        return {inf, -inf};
+    }
+
+    bool contains(Scalar v) const { return lower <= v && v <= upper; }
+    bool is_empty() const { return lower > upper; }
+    Scalar width() const { return upper - lower; }
+    Scalar midpoint() const { return (lower + upper) / 2; }
+    bool is_finite() const { return std::isfinite(lower) && std::isfinite(upper); }
+
+    Interval operator-() const { return {-upper, -lower}; }
+
+    friend Interval operator+(const Interval& a, const Interval& b)
+    {
+        return {a.lower + b.lower, a.upper + b.upper};
+    }
+
+    friend Interval operator-(const Interval& a, const Interval& b)
+    {
+        return {a.lower - b.upper, a.upper - b.lower};
+    }
+
+    friend Interval operator*(const Interval& a, const Interval& b)
+    {
+        // 0 * inf is taken to be 0 so that exact zeros do not poison unbounded ranges.
+        auto mul = [](Scalar x, Scalar y) { return (x == 0 || y == 0) ? Scalar(0) : x * y; };
+        const Scalar p[4] = {
+            mul(a.lower, b.lower),
+            mul(a.lower, b.upper),
+            mul(a.upper, b.lower),
+            mul(a.upper, b.upper)};
+        return {std::min({p[0], p[1], p[2], p[3]}), std::max({p[0], p[1], p[2], p[3]})};
+    }
+
+    friend Interval operator+(const Interval& a, Scalar b) { return {a.lower + b, a.upper + b}; }
+    friend Interval operator+(Scalar a, const Interval& b) { return b + a; }
+    friend Interval operator-(const Interval& a, Scalar b) { return {a.lower - b, a.upper - b}; }
+    friend Interval operator-(Scalar a, const Interval& b) { return -b + a; }
+
+    friend Interval operator*(const Interval& a, Scalar b)
+    {
+        if (b == 0) return Scalar(0);
+        return b > 0 ? Interval{a.lower * b, a.upper * b} : Interval{a.upper * b, a.lower * b};
+    }
+
+    friend Interval operator*(Scalar a, const Interval& b) { return b * a; }
+
+    Interval& operator+=(const Interval& b) { return *this = *this + b; }
+    Interval& operator-=(const Interval& b) { return *this = *this - b; }
+    Interval& operator*=(const Interval& b) { return *this = *this * b; }
+};
+
+/**
+ * @brief Axis-aligned box given as one interval per coordinate.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+using IntervalBox = std::array<Interval<Scalar>, dim>;
+
+/**
+ * @brief The box covering the whole space, standing for "unbounded".
+ */
+template <int dim, typename Scalar = stf::Scalar>
+IntervalBox<dim, Scalar> entire_box()
+{
+    IntervalBox<dim, Scalar> box;
+    box.fill(Interval<Scalar>::entire());
+    return box;
+}
+
+/**
+ * @brief The empty box, the identity of `hull`.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+IntervalBox<dim, Scalar> empty_box()
+{
+    IntervalBox<dim, Scalar> box;
+    box.fill(Interval<Scalar>::empty());
+    return box;
+}
+
+/**
+ * @brief Whether a box contains no point, i.e. one of its intervals is empty.
+ */
+template <typename Scalar, size_t dim>
+bool is_empty(const std::array<Interval<Scalar>, dim>& box)
+{
+    return std::any_of(box.begin(), box.end(), [](const auto& x) { return x.is_empty(); });
+}
+
+/**
+ * @brief Lipschitz constants of a function over a space-time region.
+ *
+ * For any two points (x, t) and (y, s) of the region, the function changes by at most
+ * spatial * |x - y| + temporal * |t - s|, i.e. spatial bounds the norm of the spatial gradient
+ * (or of the position Jacobian for a transform) and temporal bounds the magnitude of the time
+ * derivative (or of the velocity).
+ *
+ * @tparam Scalar The scalar type of the constants
+ */
+template <typename Scalar = stf::Scalar>
+struct LipschitzBound
+{
+    Scalar spatial = 0; ///< Bound on the spatial rate of change
+    Scalar temporal = 0; ///< Bound on the rate of change in time
+
+    /**
+     * @brief Infinite constants, standing for "unknown".
+     */
+    static LipschitzBound unbounded()
+    {
+        constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+        return {inf, inf};
+    }
+};
+
+/**
+ * @brief Product of two Lipschitz constants, where a zero rate wins over an unbounded one.
+ */
+template <typename Scalar>
+Scalar lipschitz_product(Scalar a, Scalar b)
+{
+    return (a == 0 || b == 0) ? Scalar(0) : a * b;
+}
+
+/**
+ * @brief Smallest interval containing both a and b.
+ */
+template <typename Scalar>
+Interval<Scalar> hull(const Interval<Scalar>& a, const Interval<Scalar>& b)
+{
+    return {std::min(a.lower, b.lower), std::max(a.upper, b.upper)};
+}
+
+/**
+ * @brief Smallest box containing both a and b.
+ */
+template <typename Scalar, size_t dim>
+std::array<Interval<Scalar>, dim> hull(
+    const std::array<Interval<Scalar>, dim>& a,
+    const std::array<Interval<Scalar>, dim>& b)
+{
+    std::array<Interval<Scalar>, dim> result;
+    for (size_t i = 0; i < dim; ++i) result[i] = hull(a[i], b[i]);
+    return result;
+}
+
+/**
+ * @brief Range of x² over x; tighter than x * x when x straddles zero.
+ */
+template <typename Scalar>
+Interval<Scalar> sqr(const Interval<Scalar>& x)
+{
+    const Scalar a = x.lower * x.lower;
+    const Scalar b = x.upper * x.upper;
+    if (x.contains(0)) return {0, std::max(a, b)};
+    return {std::min(a, b), std::max(a, b)};
+}
+
+template <typename Scalar>
+Interval<Scalar> abs(const Interval<Scalar>& x)
+{
+    if (x.lower >= 0) return x;
+    if (x.upper <= 0) return -x;
+    return {0, std::max(-x.lower, x.upper)};
+}
+
+/**
+ * @brief Range of √x over the non-negative part of x.
+ */
+template <typename Scalar>
+Interval<Scalar> sqrt(const Interval<Scalar>& x)
+{
+    return {std::sqrt(std::max(x.lower, Scalar(0))), std::sqrt(std::max(x.upper, Scalar(0)))};
+}
+
+/**
+ * @brief Range of xⁿ for a non-negative integer n.
+ */
+template <typename Scalar>
+Interval<Scalar> pow(const Interval<Scalar>& x, int n)
+{
+    if (n == 0) return Scalar(1);
+    if (n % 2 == 0) return pow(sqr(x), n / 2);
+    return {Scalar(std::pow(x.lower, n)), Scalar(std::pow(x.upper, n))};
+}
+
+template <typename Scalar>
+Interval<Scalar> min(const Interval<Scalar>& a, const Interval<Scalar>& b)
+{
+    return {std::min(a.lower, b.lower), std::min(a.upper, b.upper)};
+}
+
+template <typename Scalar>
+Interval<Scalar> max(const Interval<Scalar>& a, const Interval<Scalar>& b)
+{
+    return {std::max(a.lower, b.lower), std::max(a.upper, b.upper)};
+}
+
+/**
+ * @brief Range of cos over x, accounting for the extrema at multiples of π inside x.
+ */
+template <typename Scalar>
+Interval<Scalar> cos(const Interval<Scalar>& x)
+{
+    constexpr Scalar pi = std::numbers::pi_v<Scalar>;
+    if (!x.is_finite() || x.width() >= 2 * pi) return {-1, 1};
+
+    Scalar lower = std::min(std::cos(x.lower), std::cos(x.upper));
+    Scalar upper = std::max(std::cos(x.lower), std::cos(x.upper));
+    // Maxima at even multiples of π, minima at odd multiples.
+    for (Scalar k = std::ceil(x.lower / pi); k * pi <= x.upper; ++k) {
+        if (std::fmod(k, Scalar(2)) == 0) {
+            upper = 1;
+        } else {
+            lower = -1;
+        }
+    }
+    return {lower, upper};
+}
+
+template <typename Scalar>
+Interval<Scalar> sin(const Interval<Scalar>& x)
+{
+    return cos(x - std::numbers::pi_v<Scalar> / 2);
+}
+
+/**
+ * @brief Interval extension of a scalar function of time.
+ *
+ * Maps a time interval to an interval containing every value the function takes over it. It is
+ * how user-supplied offset and interpolation curves, whose closed form the library cannot see,
+ * provide their bounds; an empty extension stands for "unknown".
+ */
+template <typename Scalar>
+using IntervalExtension = std::function<Interval<Scalar>(Interval<Scalar>)>;
+
+/**
+ * @brief Range of a scalar function of time over an interval.
+ *
+ * The value is exact at a single time. Over a wider interval the range comes from the interval
+ * extension, and is entire without one: no finite set of samples bounds an arbitrary curve, e.g.
+ * cos(32 pi t) sampled at eight points looks constant.
+ *
+ * @param f The function
+ * @param extension The interval extension of f, possibly empty
+ * @param t The interval
+ * @return Interval<Scalar> A range containing f over t
+ */
+template <typename Scalar, typename F>
+Interval<Scalar> curve_bounds(
+    const F& f,
+    const IntervalExtension<Scalar>& extension,
+    Interval<Scalar> t)
+{
+    if (t.width() == 0) return f(t.lower);
+    return extension ? extension(t) : Interval<Scalar>::entire();
+}
+
+/**
+ * @brief Range of the Euclidean norm of the vectors in a box.
+ */
+template <typename Scalar, size_t dim>
+Interval<Scalar> norm_bounds(const std::array<Interval<Scalar>, dim>& box)
+{
+    Interval<Scalar> n2(0);
+    for (size_t i = 0; i < dim; ++i) n2 += sqr(box[i]);
+    return sqrt(n2);
+}
+
+/**
+ * @brief Euclidean distance range between the points of a box and a fixed point.
+ */
+template <typename Scalar, size_t dim>
+Interval<Scalar> distance_bounds(
+    const std::array<Interval<Scalar>, dim>& box,
+    const std::array<Scalar, dim>& p)
+{
+    std::array<Interval<Scalar>, dim> offset;
+    for (size_t i = 0; i < dim; ++i) offset[i] = box[i] - p[i];
+    return norm_bounds(offset);
+}
+
+/**
+ * @brief Center of a box.
+ */
+template <typename Scalar, size_t dim>
+std::array<Scalar, dim> box_center(const std::array<Interval<Scalar>, dim>& box)
+{
+    std::array<Scalar, dim> c;
+    for (size_t i = 0; i < dim; ++i) c[i] = box[i].midpoint();
+    return c;
+}
+
+/**
+ * @brief Half the length of the diagonal of a box, i.e. its circumradius.
+ */
+template <typename Scalar, size_t dim>
+Scalar box_radius(const std::array<Interval<Scalar>, dim>& box)
+{
+    Scalar r2 = 0;
+    for (size_t i = 0; i < dim; ++i) r2 += box[i].width() * box[i].width();
+    return std::sqrt(r2) / 2;
+}
+
+/**
+ * @brief Image of a box under the affine map x -> A x + b, with A given as rows.
+ */
+template <typename Scalar, size_t dim>
+std::array<Interval<Scalar>, dim> affine_bounds(
+    const std::array<std::array<Interval<Scalar>, dim>, dim>& A,
+    const std::array<Interval<Scalar>, dim>& b,
+    const std::array<Interval<Scalar>, dim>& box)
+{
+    std::array<Interval<Scalar>, dim> result = b;
+    for (size_t i = 0; i < dim; ++i) {
+        for (size_t j = 0; j < dim; ++j) result[i] += A[i][j] * box[j];
+    }
+    return result;
+}
+
+} // namespace stf
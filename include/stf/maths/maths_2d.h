@@ -6,34 +6,44 @@
 #include <cmath>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
 
 namespace stf {
 
-using Vec2 = std::array<Scalar, 2>;
-using Mat2 = std::array<std::array<Scalar, 2>, 2>;
+template <typename Scalar>
+using Vector2 = std::array<Scalar, 2>;
+template <typename Scalar>
+using Matrix2 = std::array<std::array<Scalar, 2>, 2>;
+
+using Vec2 = Vector2<stf::Scalar>;
+using Mat2 = Matrix2<stf::Scalar>;
 
 
 // Vector utilities
-inline Scalar dot(const Vec2& a, const Vec2& b)
+template <typename Scalar>
+Scalar dot(const Vector2<Scalar>& a, const Vector2<Scalar>& b)
 {
     return a[0] * b[0] + a[1] * b[1];
 }
 
-inline Scalar norm(const Vec2& v)
+template <typename Scalar>
+Scalar norm(const Vector2<Scalar>& v)
 {
     return std::sqrt(dot(v, v));
 }
 
-inline Vec2 normalize(const Vec2& v)
+template <typename Scalar>
+Vector2<Scalar> normalize(const Vector2<Scalar>& v)
 {
     Scalar n = norm(v);
     if (n < 1e-8) throw std::runtime_error("Zero-length vector");
     return {v[0] / n, v[1] / n};
 }
 
-inline Mat2 multiply(const Mat2& A, const Mat2& B)
+template <typename Scalar>
+Matrix2<Scalar> multiply(const Matrix2<Scalar>& A, const Matrix2<Scalar>& B)
 {
-    Mat2 result;
+    Matrix2<Scalar> result;
     for (int i = 0; i < 2; ++i) {
         for (int j = 0; j < 2; ++j) {
             result[i][j] = A[i][0] * B[0][j] + A[i][1] * B[1][j];
@@ -42,26 +52,30 @@ inline Mat2 multiply(const Mat2& A, const Mat2& B)
     return result;
 }
 
-inline Vec2 add(const Vec2& A, const Vec2& B)
+template <typename Scalar>
+Vector2<Scalar> add(const Vector2<Scalar>& A, const Vector2<Scalar>& B)
 {
     return {A[0] + B[0], A[1] + B[1]};
 }
 
-inline Vec2 subtract(const Vec2& A, const Vec2& B)
+template <typename Scalar>
+Vector2<Scalar> subtract(const Vector2<Scalar>& A, const Vector2<Scalar>& B)
 {
     return {A[0] - B[0], A[1] - B[1]};
 }
 
-inline Vec2 scale(const Vec2& A, Scalar s)
+template <typename Scalar>
+Vector2<Scalar> scale(const Vector2<Scalar>& A, std::type_identity_t<Scalar> s)
 {
     return {A[0] * s, A[1] * s};
 }
 
 // Rotation matrix from one vector to another
-inline Mat2 rotation_matrix(const Vec2& from, const Vec2& to)
+template <typename Scalar>
+Matrix2<Scalar> rotation_matrix(const Vector2<Scalar>& from, const Vector2<Scalar>& to)
 {
-    Vec2 u = normalize(from);
-    Vec2 v = normalize(to);
+    Vector2<Scalar> u = normalize(from);
+    Vector2<Scalar> v = normalize(to);
 
     Scalar c = dot(u, v); // cos(θ)
     Scalar s = u[0] * v[1] - u[1] * v[0]; // sin(θ) = cross product in 2D
@@ -70,17 +84,36 @@ inline Mat2 rotation_matrix(const Vec2& from, const Vec2& to)
 }
 
 // Apply 2D matrix to a vector
-inline Vec2 apply_matrix(const Mat2& M, const Vec2& v)
+template <typename Scalar>
+Vector2<Scalar> apply_matrix(const Matrix2<Scalar>& M, const Vector2<Scalar>& v)
 {
     return {M[0][0] * v[0] + M[0][1] * v[1], M[1][0] * v[0] + M[1][1] * v[1]};
 }
 
-inline Mat2 transpose(const Mat2& M)
+template <typename Scalar>
+Matrix2<Scalar> transpose(const Matrix2<Scalar>& M)
 {
     return {{{M[0][0], M[1][0]}, {M[0][1], M[1][1]}}};
 }
 
-inline Vec2 bezier(std::span<const Vec2, 4> control_points, Scalar t)
+template <typename Scalar>
+Scalar determinant(const Matrix2<Scalar>& M)
+{
+    return M[0][0] * M[1][1] - M[0][1] * M[1][0];
+}
+
+// Inverse of a non-singular 2D matrix
+template <typename Scalar>
+Matrix2<Scalar> inverse(const Matrix2<Scalar>& M)
+{
+    const Scalar inv_det = 1 / determinant(M);
+    return {{{M[1][1] * inv_det, -M[0][1] * inv_det}, {-M[1][0] * inv_det, M[0][0] * inv_det}}};
+}
+
+template <typename Scalar>
+Vector2<Scalar> bezier(
+    std::span<const Vector2<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
     return {
@@ -90,7 +123,10 @@ inline Vec2 bezier(std::span<const Vec2, 4> control_points, Scalar t)
             3 * u * t * t * control_points[2][1] + t * t * t * control_points[3][1]};
 }
 
-inline Vec2 bezier_derivative(std::span<const Vec2, 4> control_points, Scalar t)
+template <typename Scalar>
+Vector2<Scalar> bezier_derivative(
+    std::span<const Vector2<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
     Scalar uu = u * u;
@@ -106,7 +142,10 @@ inline Vec2 bezier_derivative(std::span<const Vec2, 4> control_points, Scalar t)
             3 * tt * (control_points[3][1] - control_points[2][1])};
 }
 
-inline Vec2 bezier_second_derivative(std::span<const Vec2, 4> control_points, Scalar t)
+template <typename Scalar>
+Vector2<Scalar> bezier_second_derivative(
+    std::span<const Vector2<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
 
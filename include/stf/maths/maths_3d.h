@@ -6,30 +6,41 @@
 #include <cmath>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace stf {
 
-using Vec3 = std::array<Scalar, 3>;
-using Mat3 = std::array<std::array<Scalar, 3>, 3>;
+template <typename Scalar>
+using Vector3 = std::array<Scalar, 3>;
+template <typename Scalar>
+using Matrix3 = std::array<std::array<Scalar, 3>, 3>;
+
+using Vec3 = Vector3<stf::Scalar>;
+using Mat3 = Matrix3<stf::Scalar>;
 
 
 // Vector utilities
-inline Scalar dot(const Vec3& a, const Vec3& b)
+template <typename Scalar>
+Scalar dot(const Vector3<Scalar>& a, const Vector3<Scalar>& b)
 {
     return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
 }
 
-inline Vec3 cross(const Vec3& a, const Vec3& b)
+template <typename Scalar>
+Vector3<Scalar> cross(const Vector3<Scalar>& a, const Vector3<Scalar>& b)
 {
     return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
 }
 
-inline Scalar norm(const Vec3& v)
+template <typename Scalar>
+Scalar norm(const Vector3<Scalar>& v)
 {
     return std::sqrt(dot(v, v));
 }
 
-inline Vec3 normalize(const Vec3& v)
+template <typename Scalar>
+Vector3<Scalar> normalize(const Vector3<Scalar>& v)
 {
     Scalar n = norm(v);
     if (n < 1e-8) throw std::runtime_error("Zero-length vector");
@@ -37,54 +48,62 @@ inline Vec3 normalize(const Vec3& v)
 }
 
 // Identity matrix
-inline Mat3 identityMatrix()
+template <typename Scalar = stf::Scalar>
+Matrix3<Scalar> identityMatrix()
 {
     return {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
 }
 
 // Skew-symmetric matrix from vector
-inline Mat3 skew(const Vec3& v)
+template <typename Scalar>
+Matrix3<Scalar> skew(const Vector3<Scalar>& v)
 {
     return {{{0.0, -v[2], v[1]}, {v[2], 0.0, -v[0]}, {-v[1], v[0], 0.0}}};
 }
 
 // Matrix addition: A + B
-inline Mat3 add(const Mat3& A, const Mat3& B)
+template <typename Scalar>
+Matrix3<Scalar> add(const Matrix3<Scalar>& A, const Matrix3<Scalar>& B)
 {
-    Mat3 result;
+    Matrix3<Scalar> result;
     for (int i = 0; i < 3; ++i)
         for (int j = 0; j < 3; ++j) result[i][j] = A[i][j] + B[i][j];
     return result;
 }
 
-inline Vec3 add(const Vec3& A, const Vec3& B)
+template <typename Scalar>
+Vector3<Scalar> add(const Vector3<Scalar>& A, const Vector3<Scalar>& B)
 {
     return {A[0] + B[0], A[1] + B[1], A[2] + B[2]};
 }
 
-inline Vec3 subtract(const Vec3& A, const Vec3& B)
+template <typename Scalar>
+Vector3<Scalar> subtract(const Vector3<Scalar>& A, const Vector3<Scalar>& B)
 {
     return {A[0] - B[0], A[1] - B[1], A[2] - B[2]};
 }
 
 // Scalar * matrix
-inline Mat3 scale(const Mat3& A, Scalar s)
+template <typename Scalar>
+Matrix3<Scalar> scale(const Matrix3<Scalar>& A, std::type_identity_t<Scalar> s)
 {
-    Mat3 result;
+    Matrix3<Scalar> result;
     for (int i = 0; i < 3; ++i)
         for (int j = 0; j < 3; ++j) result[i][j] = A[i][j] * s;
     return result;
 }
 
-inline Vec3 scale(const Vec3& A, Scalar s)
+template <typename Scalar>
+Vector3<Scalar> scale(const Vector3<Scalar>& A, std::type_identity_t<Scalar> s)
 {
     return {A[0] * s, A[1] * s, A[2] * s};
 }
 
 // Matrix multiplication: A * B
-inline Mat3 multiply(const Mat3& A, const Mat3& B)
+template <typename Scalar>
+Matrix3<Scalar> multiply(const Matrix3<Scalar>& A, const Matrix3<Scalar>& B)
 {
-    Mat3 result = {};
+    Matrix3<Scalar> result = {};
     for (int i = 0; i < 3; ++i)
         for (int j = 0; j < 3; ++j)
             for (int k = 0; k < 3; ++k) result[i][j] += A[i][k] * B[k][j];
@@ -92,36 +111,38 @@ inline Mat3 multiply(const Mat3& A, const Mat3& B)
 }
 
 // Rodrigues' rotation formula
-inline Mat3 rotation_matrix(const Vec3& from, const Vec3& to)
+template <typename Scalar>
+Matrix3<Scalar> rotation_matrix(const Vector3<Scalar>& from, const Vector3<Scalar>& to)
 {
-    Vec3 v1 = normalize(from);
-    Vec3 v2 = normalize(to);
+    Vector3<Scalar> v1 = normalize(from);
+    Vector3<Scalar> v2 = normalize(to);
 
     Scalar c = dot(v1, v2);
 
     if (c > 0.999999) {
-        return identityMatrix(); // Vectors are nearly identical
+        return identityMatrix<Scalar>(); // Vectors are nearly identical
     } else if (c < -0.999999) {
         // Vectors are opposite — pick orthogonal vector to rotate 180°
-        Vec3 axis = cross(v1, {1.0, 0.0, 0.0});
+        Vector3<Scalar> axis = cross(v1, {1.0, 0.0, 0.0});
         if (norm(axis) < 1e-6) axis = cross(v1, {0.0, 1.0, 0.0});
         axis = normalize(axis);
 
-        Mat3 K = skew(axis);
-        Mat3 KK = multiply(K, K);
-        return add(identityMatrix(), scale(KK, 2.0)); // 180° rotation
+        Matrix3<Scalar> K = skew(axis);
+        Matrix3<Scalar> KK = multiply(K, K);
+        return add(identityMatrix<Scalar>(), scale(KK, 2.0)); // 180° rotation
     } else {
-        Vec3 axis = normalize(cross(v1, v2));
+        Vector3<Scalar> axis = normalize(cross(v1, v2));
         Scalar s = std::sqrt(1.0 - c * c);
-        Mat3 K = skew(axis);
-        Mat3 KK = multiply(K, K);
+        Matrix3<Scalar> K = skew(axis);
+        Matrix3<Scalar> KK = multiply(K, K);
 
-        return add(add(identityMatrix(), scale(K, s)), scale(KK, 1 - c));
+        return add(add(identityMatrix<Scalar>(), scale(K, s)), scale(KK, 1 - c));
     }
 }
 
 // Apply 3D matrix to a vector
-inline Vec3 apply_matrix(const Mat3& M, const Vec3& v)
+template <typename Scalar>
+Vector3<Scalar> apply_matrix(const Matrix3<Scalar>& M, const Vector3<Scalar>& v)
 {
     return {
         M[0][0] * v[0] + M[0][1] * v[1] + M[0][2] * v[2],
@@ -129,13 +150,75 @@ inline Vec3 apply_matrix(const Mat3& M, const Vec3& v)
         M[2][0] * v[0] + M[2][1] * v[1] + M[2][2] * v[2]};
 }
 
-inline Mat3 transpose(const Mat3& M)
+template <typename Scalar>
+Matrix3<Scalar> transpose(const Matrix3<Scalar>& M)
 {
     return {
         {{M[0][0], M[1][0], M[2][0]}, {M[0][1], M[1][1], M[2][1]}, {M[0][2], M[1][2], M[2][2]}}};
 }
 
-inline Vec3 bezier(std::span<const Vec3, 4> control_points, Scalar t)
+template <typename Scalar>
+Scalar determinant(const Matrix3<Scalar>& M)
+{
+    return dot(M[0], cross(M[1], M[2]));
+}
+
+// Inverse of a non-singular 3D matrix, from the cross products of its rows
+template <typename Scalar>
+Matrix3<Scalar> inverse(const Matrix3<Scalar>& M)
+{
+    const Scalar inv_det = 1 / determinant(M);
+    return transpose(Matrix3<Scalar>{
+        scale(cross(M[1], M[2]), inv_det),
+        scale(cross(M[2], M[0]), inv_det),
+        scale(cross(M[0], M[1]), inv_det)});
+}
+
+// Eigen decomposition of a symmetric matrix by cyclic Jacobi rotations. Returns the eigenvalues
+// and a rotation whose columns are the matching eigenvectors.
+template <typename Scalar>
+std::pair<Vector3<Scalar>, Matrix3<Scalar>> symmetric_eigen(const Matrix3<Scalar>& M)
+{
+    Matrix3<Scalar> A = M;
+    Matrix3<Scalar> V = identityMatrix<Scalar>();
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        const Scalar off = A[0][1] * A[0][1] + A[0][2] * A[0][2] + A[1][2] * A[1][2];
+        const Scalar diagonal = A[0][0] * A[0][0] + A[1][1] * A[1][1] + A[2][2] * A[2][2];
+        if (off <= diagonal * Scalar(1e-30) || off == 0) break;
+
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (A[p][q] == 0) continue;
+                const Scalar theta = (A[q][q] - A[p][p]) / (2 * A[p][q]);
+                const Scalar t = (theta >= 0 ? 1 : -1) /
+                                 (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const Scalar c = 1 / std::sqrt(t * t + 1);
+                const Scalar s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const Scalar akp = A[k][p], akq = A[k][q];
+                    A[k][p] = c * akp - s * akq;
+                    A[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const Scalar apk = A[p][k], aqk = A[q][k];
+                    A[p][k] = c * apk - s * aqk;
+                    A[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const Scalar vkp = V[k][p], vkq = V[k][q];
+                    V[k][p] = c * vkp - s * vkq;
+                    V[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    return {{A[0][0], A[1][1], A[2][2]}, V};
+}
+
+template <typename Scalar>
+Vector3<Scalar> bezier(
+    std::span<const Vector3<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
     Scalar uu = u * u;
@@ -156,7 +239,10 @@ inline Vec3 bezier(std::span<const Vec3, 4> control_points, Scalar t)
             3 * utt * control_points[2][2] + ttt * control_points[3][2]};
 }
 
-inline Vec3 bezier_derivative(std::span<const Vec3, 4> control_points, Scalar t)
+template <typename Scalar>
+Vector3<Scalar> bezier_derivative(
+    std::span<const Vector3<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
     Scalar uu = u * u;
@@ -176,7 +262,10 @@ inline Vec3 bezier_derivative(std::span<const Vec3, 4> control_points, Scalar t)
             3 * tt * (control_points[3][2] - control_points[2][2])};
 }
 
-inline Vec3 bezier_second_derivative(std::span<const Vec3, 4> control_points, Scalar t)
+template <typename Scalar>
+Vector3<Scalar> bezier_second_derivative(
+    std::span<const Vector3<Scalar>, 4> control_points,
+    std::type_identity_t<Scalar> t)
 {
     Scalar u = 1 - t;
 
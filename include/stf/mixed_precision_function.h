@@ -0,0 +1,185 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/space_time_function.h>
+
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Space-time function evaluated in single precision away from its zero level set.
+ *
+ * Wraps two instances of the same function graph, one built with float and one with double.
+ * Values are first evaluated with the float graph; points whose value lies within `band` of zero
+ * are re-evaluated with the double graph. Samples that matter for contouring therefore have full
+ * double accuracy, while the bulk of a grid far from the surface is evaluated in float.
+ *
+ * Derivatives are only needed near the surface in practice and are always evaluated with the
+ * double graph.
+ *
+ * @tparam dim The spatial dimension of the function
+ */
+template <int dim>
+class MixedPrecisionFunction : public SpaceTimeFunction<dim>
+{
+public:
+    /**
+     * @brief Constructs a mixed-precision function.
+     *
+     * @param coarse The function graph built with float
+     * @param fine The same function graph built with double
+     * @param band Values with |f| below this threshold are re-evaluated with `fine`
+     */
+    MixedPrecisionFunction(
+        const SpaceTimeFunction<dim, float>& coarse,
+        const SpaceTimeFunction<dim>& fine,
+        Scalar band)
+        : m_coarse(coarse)
+        , m_fine(fine)
+        , m_band(band)
+    {
+        if (band < 0) {
+            throw std::invalid_argument("band must be non-negative");
+        }
+    }
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        std::array<float, dim> p;
+        for (int i = 0; i < dim; ++i) p[i] = static_cast<float>(pos[i]);
+        const Scalar v = m_coarse.value(p, static_cast<float>(t));
+        return std::abs(v) < m_band ? m_fine.value(pos, t) : v;
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_fine.time_derivative(pos, t);
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_fine.gradient(pos, t);
+    }
+
+    SpaceTimeEvaluation<dim> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_fine.evaluate(pos, t);
+    }
+
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        return m_fine.hessian(pos, t);
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim>& box, Interval<Scalar> t) const override
+    {
+        return m_fine.value_bounds(box, t);
+    }
+
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim>& box, Interval<Scalar> t)
+        const override
+    {
+        return m_fine.lipschitz_bound(box, t);
+    }
+
+    IntervalBox<dim> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        return m_fine.bounding_box(t0, t1, level);
+    }
+
+public:
+    /**
+     * @brief Evaluates the function at a batch of space-time points.
+     *
+     * The whole batch is evaluated by the float graph. The points falling within the band are
+     * then compacted and evaluated by the double graph in a single batch call.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        const size_t n = t.size();
+        ColumnBuffer<dim + 2, float> coarse(n);
+        const auto columns = coarse.columns();
+        for (int i = 0; i < dim; ++i) {
+            for (size_t k = 0; k < n; ++k) columns[i][k] = static_cast<float>(pos[i][k]);
+        }
+        for (size_t k = 0; k < n; ++k) columns[dim][k] = static_cast<float>(t[k]);
+
+        std::array<std::span<const float>, dim> coarse_pos;
+        for (int i = 0; i < dim; ++i) coarse_pos[i] = columns[i];
+        m_coarse.value_batch(coarse_pos, columns[dim], columns[dim + 1]);
+
+        std::vector<size_t> refine;
+        for (size_t k = 0; k < n; ++k) {
+            values[k] = columns[dim + 1][k];
+            if (std::abs(values[k]) < m_band) refine.push_back(k);
+        }
+        if (refine.empty()) return;
+
+        const size_t m = refine.size();
+        ColumnBuffer<dim + 2> fine(m);
+        const auto fine_columns = fine.columns();
+        for (size_t j = 0; j < m; ++j) {
+            for (int i = 0; i < dim; ++i) fine_columns[i][j] = pos[i][refine[j]];
+            fine_columns[dim][j] = t[refine[j]];
+        }
+
+        std::array<std::span<const Scalar>, dim> fine_pos;
+        for (int i = 0; i < dim; ++i) fine_pos[i] = fine_columns[i];
+        m_fine.value_batch(fine_pos, fine_columns[dim], fine_columns[dim + 1]);
+        for (size_t j = 0; j < m; ++j) values[refine[j]] = fine_columns[dim + 1][j];
+    }
+
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        m_fine.time_derivative_batch(pos, t, time_derivatives);
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        m_fine.gradient_batch(pos, t, gradients);
+    }
+
+public:
+    /**
+     * @brief Get the float function graph.
+     */
+    const SpaceTimeFunction<dim, float>& coarse() const { return m_coarse; }
+
+    /**
+     * @brief Get the double function graph.
+     */
+    const SpaceTimeFunction<dim>& fine() const { return m_fine; }
+
+    /**
+     * @brief Get the refinement band.
+     */
+    Scalar band() const { return m_band; }
+
+private:
+    const SpaceTimeFunction<dim, float>& m_coarse;
+    const SpaceTimeFunction<dim>& m_fine;
+    Scalar m_band;
+};
+
+} // namespace stf
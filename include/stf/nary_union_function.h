@@ -0,0 +1,615 @@
+#pragma once
+
+#include <stf/box_hierarchy.h>
+#include <stf/common.h>
+#include <stf/space_time_function.h>
+#include <stf/union_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace stf {
+
+template <int dim, typename Scalar>
+class NaryUnionSnapshot;
+
+/**
+ * @brief Union of any number of space-time functions, culled with a space-time BVH.
+ *
+ * The operands are blended in increasing order of value: starting from the smallest value, each
+ * following operand is blended in with the same smooth minimum as UnionFunction until one lies
+ * outside the smoothing zone of the accumulated value. For two operands this is exactly
+ * UnionFunction; unlike a chain of binary unions the result does not depend on the operand order.
+ * The gradient is continuous except where two operands other than the smallest tie within the
+ * smoothing zone, where the fold order changes.
+ *
+ * Only operands whose value can be within the smoothing zone of the minimum contribute. To find
+ * them without evaluating every operand, the time range [0, 1] is split into slabs and each
+ * operand's bounding boxes over each slab, at doubling levels starting from `cull_level`, are
+ * stored in bounding volume hierarchies over space x time. A query evaluates the operands whose
+ * boxes contain the query point, one level at a time, until their minimum is at most the level
+ * minus the smoothing zone: every other operand then exceeds it by more than the zone and is
+ * skipped. If no level suffices, all operands are evaluated. Operands whose boxes are unbounded,
+ * such as offset functions without bounds on their offset, are always evaluated. Culling is
+ * exact as long as the operands' `bounding_box` overrides are conservative.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class NaryUnionFunction : public SpaceTimeFunction<dim, Scalar>
+{
+private:
+    using Union = UnionFunction<dim, Scalar>;
+    using SpaceTimeBox = IntervalBox<dim + 1, Scalar>;
+
+public:
+    /**
+     * @brief Constructs an N-ary union and builds its culling hierarchy.
+     *
+     * @param functions The operands, which must outlive the union
+     * @param smooth_distance The distance over which to smooth the union (0 for a sharp union)
+     * @param num_time_slabs The number of slabs [0, 1] is split into for culling
+     */
+    explicit NaryUnionFunction(
+        std::vector<SpaceTimeFunction<dim, Scalar>*> functions,
+        Scalar smooth_distance = 0,
+        size_t num_time_slabs = 16)
+        : m_functions(std::move(functions))
+        , m_smooth_distance(smooth_distance)
+    {
+        if (m_functions.empty()) {
+            throw std::invalid_argument("Union requires at least one function");
+        }
+        if (std::find(m_functions.begin(), m_functions.end(), nullptr) != m_functions.end()) {
+            throw std::invalid_argument("Union operands must not be null");
+        }
+        if (smooth_distance < 0) {
+            throw std::invalid_argument("smooth_distance must be non-negative");
+        }
+        if (num_time_slabs == 0) {
+            throw std::invalid_argument("num_time_slabs must be positive");
+        }
+        build_hierarchy(num_time_slabs);
+    }
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        auto values = evaluate_children(pos, t, [&](const SpaceTimeFunction<dim, Scalar>& f) {
+            return f.value(pos, t);
+        });
+        return fold_value(values, m_smooth_distance);
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return evaluate(pos, t).gradient[dim];
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return evaluate(pos, t).gradient;
+    }
+
+    /**
+     * @brief Evaluates the union together with its gradient.
+     *
+     * Each contributing operand is evaluated once; the gradients are folded with the blend
+     * weights in the same order as the values.
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        auto evaluations = evaluate_children(
+            pos,
+            t,
+            [&](const SpaceTimeFunction<dim, Scalar>& f) { return f.evaluate(pos, t); });
+        return fold_evaluation(evaluations, m_smooth_distance);
+    }
+
+    /**
+     * @brief Computes the space-time Hessian by folding the operand Hessians.
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        auto evaluations = evaluate_children(pos, t, [&](const SpaceTimeFunction<dim, Scalar>& f) {
+            return std::pair{f.evaluate(pos, t), &f};
+        });
+        return fold_hessian(evaluations, m_smooth_distance, [&](const auto* f) {
+            return f->hessian(pos, t);
+        });
+    }
+
+    /**
+     * @brief Bounds the union over a space-time box.
+     *
+     * The union is at most the smallest operand, and blending lowers it by at most
+     * `max_lowering` of the operands that can lie within the smoothing zone of the minimum.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return A conservative range of values over the space-time box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        for (const auto* f : m_functions) bounds.push_back(f->value_bounds(box, t));
+        return fold_bounds(bounds, m_smooth_distance);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the union over a space-time box.
+     *
+     * The blend weights are convex, so the constants are the maxima over the operands that can
+     * lie within the smoothing zone of the minimum.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return The Lipschitz constants over the space-time box
+     */
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        for (const auto* f : m_functions) bounds.push_back(f->value_bounds(box, t));
+        const Scalar threshold = smallest_upper(bounds) + zone(m_smooth_distance);
+
+        LipschitzBound<Scalar> result;
+        for (size_t i = 0; i < m_functions.size(); ++i) {
+            if (bounds[i].lower > threshold) continue;
+            const auto L = m_functions[i]->lipschitz_bound(box, t);
+            result.spatial = std::max(result.spatial, L.spatial);
+            result.temporal = std::max(result.temporal, L.temporal);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the region swept by the union over a time range.
+     *
+     * Blending lowers the smallest operand by at most `max_lowering` of all operands, so the
+     * operands are bounded at that much above the level.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return A box containing the swept sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        const Scalar operand_level = level + max_lowering(m_functions.size(), m_smooth_distance);
+        auto result = empty_box<dim, Scalar>();
+        for (const auto* f : m_functions) {
+            result = hull(result, f->bounding_box(t0, t1, operand_level));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Freeze the union at time t by freezing every operand.
+     *
+     * @param t The time value
+     * @return std::unique_ptr<ImplicitFunction<dim, Scalar>> The spatial snapshot at time t
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        std::vector<std::unique_ptr<ImplicitFunction<dim, Scalar>>> snapshots;
+        snapshots.reserve(m_functions.size());
+        for (const auto* f : m_functions) snapshots.push_back(f->bind_time(t));
+        return std::make_unique<NaryUnionSnapshot<dim, Scalar>>(
+            std::move(snapshots),
+            m_smooth_distance,
+            cull_level(),
+            m_extent);
+    }
+
+public:
+    /**
+     * @brief Width of the smoothing zone: operands further than this above the accumulated
+     * value do not contribute.
+     */
+    static Scalar zone(Scalar smooth_distance) { return smooth_distance * 4; }
+
+    /**
+     * @brief Largest amount by which blending `count` operands lowers the smallest one.
+     *
+     * Each blend lowers the accumulated value by at most the smooth distance, and an operand is
+     * only blended while it lies within the smoothing zone of the accumulated value, so the
+     * total is also at most the zone plus one smooth distance.
+     */
+    static Scalar max_lowering(size_t count, Scalar smooth_distance)
+    {
+        if (count < 2) return 0;
+        return std::min(
+            Scalar(count - 1) * smooth_distance,
+            zone(smooth_distance) + smooth_distance);
+    }
+
+    /**
+     * @brief Folds operand values sorted in increasing order into the union value.
+     */
+    static Scalar fold_value(const std::vector<Scalar>& values, Scalar smooth_distance)
+    {
+        Scalar result = values.front();
+        for (size_t i = 1; i < values.size(); ++i) {
+            if (Union::blend_weights(result, values[i], smooth_distance)[1] == 0) break;
+            result = Union::blend_value(result, values[i], smooth_distance);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Folds operand evaluations sorted by increasing value into the union evaluation.
+     *
+     * Works for both space-time and spatial evaluations.
+     */
+    template <typename Evaluation>
+    static Evaluation fold_evaluation(
+        const std::vector<Evaluation>& evaluations,
+        Scalar smooth_distance)
+    {
+        Evaluation result = evaluations.front();
+        for (size_t i = 1; i < evaluations.size(); ++i) {
+            const auto& e = evaluations[i];
+            const auto w = Union::blend_weights(result.value, e.value, smooth_distance);
+            if (w[1] == 0) break;
+            for (size_t j = 0; j < result.gradient.size(); ++j) {
+                result.gradient[j] = Union::combine(w, result.gradient[j], e.gradient[j]);
+            }
+            result.value = Union::blend_value(result.value, e.value, smooth_distance);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Folds operand Hessians along the same order as `fold_evaluation`.
+     *
+     * @param evaluations Pairs of (evaluation, operand) sorted by increasing value
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     * @param hessian Returns the Hessian of an operand
+     */
+    template <typename Evaluation, typename Operand, typename HessianFn>
+    static auto fold_hessian(
+        const std::vector<std::pair<Evaluation, Operand>>& evaluations,
+        Scalar smooth_distance,
+        HessianFn&& hessian)
+    {
+        auto current = evaluations.front().first;
+        auto result = hessian(evaluations.front().second);
+        for (size_t i = 1; i < evaluations.size(); ++i) {
+            const auto& [e, operand] = evaluations[i];
+            const auto w = Union::blend_weights(current.value, e.value, smooth_distance);
+            if (w[1] == 0) break;
+            result = Union::blend_hessian(
+                w,
+                Union::blend_curvature(current.value, e.value, smooth_distance),
+                current.gradient,
+                e.gradient,
+                result,
+                hessian(operand));
+            for (size_t j = 0; j < current.gradient.size(); ++j) {
+                current.gradient[j] = Union::combine(w, current.gradient[j], e.gradient[j]);
+            }
+            current.value = Union::blend_value(current.value, e.value, smooth_distance);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Range of the union when the operands range over the given intervals.
+     */
+    static Interval<Scalar> fold_bounds(
+        const std::vector<Interval<Scalar>>& bounds,
+        Scalar smooth_distance)
+    {
+        const Scalar upper = smallest_upper(bounds);
+        const Scalar threshold = upper + zone(smooth_distance);
+        Scalar lower = std::numeric_limits<Scalar>::infinity();
+        size_t blended = 0;
+        for (const auto& b : bounds) {
+            lower = std::min(lower, b.lower);
+            if (b.lower < threshold) ++blended;
+        }
+        return {lower - max_lowering(blended, smooth_distance), upper};
+    }
+
+    /**
+     * @brief Smallest upper bound of a set of intervals.
+     */
+    static Scalar smallest_upper(const std::vector<Interval<Scalar>>& bounds)
+    {
+        Scalar result = std::numeric_limits<Scalar>::infinity();
+        for (const auto& b : bounds) result = std::min(result, b.upper);
+        return result;
+    }
+
+    /**
+     * @brief Get the number of operands.
+     */
+    size_t size() const { return m_functions.size(); }
+
+    /**
+     * @brief Get the i-th operand.
+     */
+    const SpaceTimeFunction<dim, Scalar>& function(size_t i) const { return *m_functions[i]; }
+
+    /**
+     * @brief Get the smooth distance (0 for a sharp union).
+     */
+    Scalar smooth_distance() const { return m_smooth_distance; }
+
+    /**
+     * @brief Get the finest level at which the operand boxes of the hierarchy are computed.
+     */
+    Scalar cull_level() const { return m_hierarchy.first_level(); }
+
+private:
+    static Scalar value_of(Scalar v) { return v; }
+
+    template <typename Evaluation>
+    static Scalar value_of(const Evaluation& e)
+    {
+        if constexpr (requires { e.first.value; }) {
+            return e.first.value;
+        } else {
+            return e.value;
+        }
+    }
+
+    /**
+     * @brief Evaluates the operands that can contribute at (pos, t), sorted by value.
+     *
+     * @param evaluate Called with an operand, returns its value or evaluation
+     */
+    template <typename Evaluate>
+    auto evaluate_children(const std::array<Scalar, dim>& pos, Scalar t, Evaluate&& evaluate)
+        const
+    {
+        using Result = decltype(evaluate(*m_functions.front()));
+        std::vector<Result> results;
+        if (t >= 0 && t <= 1) {
+            std::array<Scalar, dim + 1> p;
+            std::copy(pos.begin(), pos.end(), p.begin());
+            p[dim] = t;
+            m_hierarchy.evaluate_near_minimum(p, zone(m_smooth_distance), [&](uint32_t i) {
+                results.push_back(evaluate(*m_functions[i]));
+                return value_of(results.back());
+            });
+        } else {
+            // The hierarchy only covers [0, 1].
+            for (const auto* f : m_functions) results.push_back(evaluate(*f));
+        }
+
+        std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+            return value_of(a) < value_of(b);
+        });
+        return results;
+    }
+
+    /**
+     * @brief Builds the hierarchy of operand boxes over the time slabs.
+     *
+     * The finest level is the smoothing zone plus the mean half-diagonal of the operand boxes
+     * over the time slabs, so that queries within about one operand size of the surface are
+     * resolved by it. The levels double up to the diagonal of the swept region.
+     */
+    void build_hierarchy(size_t num_time_slabs)
+    {
+        auto slab = [&](size_t s) {
+            return Interval<Scalar>(Scalar(s) / num_time_slabs, Scalar(s + 1) / num_time_slabs);
+        };
+
+        Scalar size = 0;
+        size_t count = 0;
+        auto extent = empty_box<dim, Scalar>();
+        for (const auto* f : m_functions) {
+            for (size_t s = 0; s < num_time_slabs; ++s) {
+                const auto box = f->bounding_box(slab(s).lower, slab(s).upper);
+                if (is_empty(box)) continue;
+                const Scalar radius = box_radius(box);
+                if (!std::isfinite(radius)) continue;
+                size += radius;
+                ++count;
+                extent = hull(extent, box);
+            }
+        }
+        m_extent = count > 0 ? 2 * box_radius(extent) : Scalar(0);
+
+        m_hierarchy = SublevelHierarchy<dim + 1, Scalar>(
+            static_cast<uint32_t>(m_functions.size()),
+            zone(m_smooth_distance) + (count > 0 ? size / count : Scalar(0)),
+            m_extent,
+            [&](Scalar level, auto& boxes, auto& ids, auto& unbounded) {
+                auto finite = [](const auto& x) { return x.is_finite(); };
+                for (uint32_t i = 0; i < m_functions.size(); ++i) {
+                    for (size_t s = 0; s < num_time_slabs; ++s) {
+                        const auto box =
+                            m_functions[i]->bounding_box(slab(s).lower, slab(s).upper, level);
+                        if (is_empty(box)) continue;
+                        if (!std::all_of(box.begin(), box.end(), finite)) {
+                            unbounded.push_back(i);
+                            break;
+                        }
+
+                        SpaceTimeBox space_time_box;
+                        std::copy(box.begin(), box.end(), space_time_box.begin());
+                        space_time_box[dim] = slab(s);
+                        boxes.push_back(space_time_box);
+                        ids.push_back(i);
+                    }
+                }
+            });
+    }
+
+private:
+    std::vector<SpaceTimeFunction<dim, Scalar>*> m_functions; ///< The operands
+    Scalar m_smooth_distance = 0; ///< The distance over which to smooth the union
+    Scalar m_extent = 0; ///< Diagonal of the region swept by the operands over [0, 1]
+    SublevelHierarchy<dim + 1, Scalar> m_hierarchy; ///< Operand boxes over the time slabs
+};
+
+/**
+ * @brief Snapshot of an N-ary union at a fixed time.
+ *
+ * Blends the snapshots of the operands like NaryUnionFunction, culling them with a hierarchy of
+ * their bounding boxes at the same levels.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar>
+class NaryUnionSnapshot : public ImplicitFunction<dim, Scalar>
+{
+private:
+    using NaryUnion = NaryUnionFunction<dim, Scalar>;
+
+public:
+    /**
+     * @brief Constructs the snapshot.
+     *
+     * @param functions The snapshots of the operands
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     * @param cull_level The finest level of the culling hierarchy
+     * @param extent The level above which every operand is evaluated
+     */
+    NaryUnionSnapshot(
+        std::vector<std::unique_ptr<ImplicitFunction<dim, Scalar>>> functions,
+        Scalar smooth_distance,
+        Scalar cull_level,
+        Scalar extent)
+        : m_functions(std::move(functions))
+        , m_smooth_distance(smooth_distance)
+        , m_hierarchy(
+              static_cast<uint32_t>(m_functions.size()),
+              cull_level,
+              extent,
+              [&](Scalar level, auto& boxes, auto& ids, auto& unbounded) {
+                  auto finite = [](const auto& x) { return x.is_finite(); };
+                  for (uint32_t i = 0; i < m_functions.size(); ++i) {
+                      const auto box = m_functions[i]->bounding_box(level);
+                      if (is_empty(box)) continue;
+                      if (std::all_of(box.begin(), box.end(), finite)) {
+                          boxes.push_back(box);
+                          ids.push_back(i);
+                      } else {
+                          unbounded.push_back(i);
+                      }
+                  }
+              })
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        auto values = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return f.value(pos);
+        });
+        return NaryUnion::fold_value(values, m_smooth_distance);
+    }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return evaluate(pos).gradient;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        auto evaluations = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return f.evaluate(pos);
+        });
+        return NaryUnion::fold_evaluation(evaluations, m_smooth_distance);
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        auto evaluations = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return std::pair{f.evaluate(pos), &f};
+        });
+        return NaryUnion::fold_hessian(evaluations, m_smooth_distance, [&](const auto* f) {
+            return f->hessian(pos);
+        });
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        for (const auto& f : m_functions) bounds.push_back(f->value_bounds(box));
+        return NaryUnion::fold_bounds(bounds, m_smooth_distance);
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        for (const auto& f : m_functions) bounds.push_back(f->value_bounds(box));
+        const Scalar threshold =
+            NaryUnion::smallest_upper(bounds) + NaryUnion::zone(m_smooth_distance);
+
+        Scalar result = 0;
+        for (size_t i = 0; i < m_functions.size(); ++i) {
+            if (bounds[i].lower > threshold) continue;
+            result = std::max(result, m_functions[i]->lipschitz_bound(box));
+        }
+        return result;
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar operand_level =
+            level + NaryUnion::max_lowering(m_functions.size(), m_smooth_distance);
+        auto result = empty_box<dim, Scalar>();
+        for (const auto& f : m_functions) result = hull(result, f->bounding_box(operand_level));
+        return result;
+    }
+
+private:
+    static Scalar value_of(Scalar v) { return v; }
+
+    template <typename Evaluation>
+    static Scalar value_of(const Evaluation& e)
+    {
+        if constexpr (requires { e.first.value; }) {
+            return e.first.value;
+        } else {
+            return e.value;
+        }
+    }
+
+    /**
+     * @brief Evaluates the operands that can contribute at pos, sorted by value.
+     */
+    template <typename Evaluate>
+    auto evaluate_children(const std::array<Scalar, dim>& pos, Evaluate&& evaluate) const
+    {
+        using Result = decltype(evaluate(*m_functions.front()));
+        std::vector<Result> results;
+        m_hierarchy.evaluate_near_minimum(
+            pos,
+            NaryUnion::zone(m_smooth_distance),
+            [&](uint32_t i) {
+                results.push_back(evaluate(*m_functions[i]));
+                return value_of(results.back());
+            });
+
+        std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+            return value_of(a) < value_of(b);
+        });
+        return results;
+    }
+
+private:
+    std::vector<std::unique_ptr<ImplicitFunction<dim, Scalar>>> m_functions;
+    Scalar m_smooth_distance;
+    SublevelHierarchy<dim, Scalar> m_hierarchy;
+};
+
+} // namespace stf
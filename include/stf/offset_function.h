@@ -1,13 +1,101 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/space_time_function.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <span>
 
 namespace stf {
 
+/**
+ * @brief Snapshot of an offset function at a fixed time.
+ *
+ * Adds a constant, evaluated once from the offset function, to the snapshot of the base
+ * function.
+ *
+ * @tparam dim The spatial dimension of the function
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class OffsetSnapshot : public ImplicitFunction<dim, Scalar>
+{
+public:
+    /**
+     * @brief Constructs an OffsetSnapshot.
+     *
+     * @param f The snapshot of the base function
+     * @param offset The offset value at the bound time
+     */
+    OffsetSnapshot(std::unique_ptr<ImplicitFunction<dim, Scalar>> f, Scalar offset)
+        : m_f(std::move(f))
+        , m_offset(offset)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override { return m_f->value(pos) + m_offset; }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return m_f->gradient(pos);
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        auto result = m_f->evaluate(pos);
+        result.value += m_offset;
+        return result;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        return m_f->hessian(pos);
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f->value_bounds(box) + m_offset;
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f->lipschitz_bound(box);
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        return m_f->bounding_box(level - m_offset);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        m_f->value_batch(pos, values);
+        for (auto& v : values) v += m_offset;
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        m_f->gradient_batch(pos, gradients);
+    }
+
+    /**
+     * @brief Get the offset value at the bound time.
+     */
+    Scalar offset() const { return m_offset; }
+
+private:
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> m_f;
+    Scalar m_offset;
+};
+
 /**
  * @brief A space-time function that adds a time-dependent offset to another space-time function.
  *
@@ -16,24 +104,48 @@ namespace stf {
  *
  * @tparam dim The spatial dimension of the function
  */
-template <int dim>
-class OffsetFunction : public SpaceTimeFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class OffsetFunction : public SpaceTimeFunction<dim, Scalar>
 {
 public:
+    /**
+     * @brief Constructs an OffsetFunction with a zero offset.
+     *
+     * @param f The base space-time function
+     */
+    explicit OffsetFunction(SpaceTimeFunction<dim, Scalar>& f)
+        : OffsetFunction(
+              f,
+              [](Scalar) { return Scalar(0); },
+              [](Scalar) { return Scalar(0); },
+              [](Interval<Scalar>) { return Interval<Scalar>(0); },
+              [](Interval<Scalar>) { return Interval<Scalar>(0); })
+    {}
+
     /**
      * @brief Constructs an OffsetFunction with the given base function and offset functions.
      *
+     * The offset is opaque to the library, so the value and Lipschitz bounds over a time range
+     * are only finite when the interval extensions of the offset and of its derivative are
+     * provided.
+     *
      * @param f The base space-time function to be offset
      * @param offset_func Function that computes the time-dependent offset value
      * @param offset_derivative Function that computes the time derivative of the offset
+     * @param offset_bounds Interval extension of the offset, or empty if unknown
+     * @param derivative_bounds Interval extension of the offset derivative, or empty if unknown
      */
     OffsetFunction(
-        SpaceTimeFunction<dim>& f,
-        std::function<Scalar(Scalar)> offset_func = [](Scalar t) { return 0; },
-        std::function<Scalar(Scalar)> offset_derivative = [](Scalar t) { return 0; })
+        SpaceTimeFunction<dim, Scalar>& f,
+        std::function<Scalar(Scalar)> offset_func,
+        std::function<Scalar(Scalar)> offset_derivative = [](Scalar) { return Scalar(0); },
+        IntervalExtension<Scalar> offset_bounds = {},
+        IntervalExtension<Scalar> derivative_bounds = {})
         : m_f(f)
-        , m_offset_func(offset_func)
-        , m_offset_derivative(offset_derivative)
+        , m_offset_func(std::move(offset_func))
+        , m_offset_derivative(std::move(offset_derivative))
+        , m_offset_bounds(std::move(offset_bounds))
+        , m_derivative_bounds(std::move(derivative_bounds))
     {}
 
     /**
@@ -77,11 +189,207 @@ public:
         return grad;
     }
 
+    /**
+     * @brief Evaluates the function together with its gradient.
+     *
+     * @param pos The spatial position
+     * @param t The time
+     * @return The offset value followed by the spatial gradient and the time derivative
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        auto result = m_f.evaluate(pos, t);
+        result.value += m_offset_func(t);
+        result.gradient[dim] += m_offset_derivative(t);
+        return result;
+    }
+
+    /**
+     * @brief Computes the space-time Hessian of the function.
+     *
+     * The offset only depends on time, so it only adds its second derivative to ∂²f/∂t². The
+     * latter is approximated by a central difference of the offset derivative, with a step of
+     * ∛ε scaled by max(1, |t|).
+     *
+     * @param pos The spatial position
+     * @param t The time
+     * @return The space-time Hessian, time last
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        const Scalar delta = std::cbrt(std::numeric_limits<Scalar>::epsilon()) *
+                             std::max(Scalar(1), std::abs(t));
+        auto H = m_f.hessian(pos, t);
+        H[dim][dim] +=
+            (m_offset_derivative(t + delta) - m_offset_derivative(t - delta)) / (2 * delta);
+        return H;
+    }
+
+    /**
+     * @brief Bounds the function over a space-time box.
+     *
+     * The range of the offset over the time interval comes from its interval extension, and is
+     * entire without one.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return A conservative range of values over the space-time box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        return m_f.value_bounds(box, t) + curve_bounds(m_offset_func, m_offset_bounds, t);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the function over a space-time box.
+     *
+     * The offset does not depend on space. Its rate of change is bounded by the interval
+     * extension of the offset derivative, and is unbounded without one.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return The Lipschitz constants over the space-time box
+     */
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        const auto rate = abs(curve_bounds(m_offset_derivative, m_derivative_bounds, t));
+        auto result = m_f.lipschitz_bound(box, t);
+        result.temporal += rate.upper;
+        return result;
+    }
+
+    /**
+     * @brief Bounds the region swept by the zero set over a time range.
+     *
+     * The value is at most `level` only where the base function is at most `level` minus the
+     * smallest offset over the range. Without bounds on the offset the region is unbounded.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return A box containing the swept sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        const auto offset = curve_bounds(m_offset_func, m_offset_bounds, Interval(t0, t1));
+        if (!std::isfinite(offset.lower)) return entire_box<dim, Scalar>();
+        return m_f.bounding_box(t0, t1, level - offset.lower);
+    }
+
+public:
+    /**
+     * @brief Evaluates the function at a batch of space-time points.
+     *
+     * The offset function is only re-evaluated when the time changes between consecutive points,
+     * so a batch sampled at a single time calls it once.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        m_f.value_batch(pos, t, values);
+        add_per_time(m_offset_func, t, values);
+    }
+
+    /**
+     * @brief Computes the time derivative at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param time_derivatives Output span receiving one time derivative per point
+     */
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        m_f.time_derivative_batch(pos, t, time_derivatives);
+        add_per_time(m_offset_derivative, t, time_derivatives);
+    }
+
+    /**
+     * @brief Computes the gradient at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param gradients Output columns, spatial gradient first and time derivative last
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        m_f.gradient_batch(pos, t, gradients);
+        add_per_time(m_offset_derivative, t, gradients[dim]);
+    }
+
+    /**
+     * @brief Freezes the function at time t, evaluating the offset function once.
+     *
+     * @param t The time
+     * @return The spatial snapshot at time t
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        return std::make_unique<OffsetSnapshot<dim, Scalar>>(m_f.bind_time(t), m_offset_func(t));
+    }
+
+private:
+    /**
+     * @brief Adds func(t[k]) to out[k], reusing the previous result for repeated times.
+     */
+    static void add_per_time(
+        const std::function<Scalar(Scalar)>& func,
+        std::span<const Scalar> t,
+        std::span<Scalar> out)
+    {
+        Scalar cached_t = 0;
+        Scalar cached_value = 0;
+        for (size_t k = 0; k < t.size(); ++k) {
+            if (k == 0 || t[k] != cached_t) {
+                cached_t = t[k];
+                cached_value = func(cached_t);
+            }
+            out[k] += cached_value;
+        }
+    }
+
+public:
+    /**
+     * @brief Get the base space-time function.
+     */
+    const SpaceTimeFunction<dim, Scalar>& base() const { return m_f; }
+
+    /**
+     * @brief Get the time-dependent offset function.
+     */
+    const std::function<Scalar(Scalar)>& offset_function() const { return m_offset_func; }
+
+    /**
+     * @brief Get the time derivative of the offset function.
+     */
+    const std::function<Scalar(Scalar)>& offset_derivative() const
+    {
+        return m_offset_derivative;
+    }
+
 private:
-    SpaceTimeFunction<dim>& m_f; ///< Reference to the base space-time function
+    SpaceTimeFunction<dim, Scalar>& m_f; ///< Reference to the base space-time function
     std::function<Scalar(Scalar)> m_offset_func; ///< Function computing the time-dependent offset
     std::function<Scalar(Scalar)>
         m_offset_derivative; ///< Function computing the offset's time derivative
+    IntervalExtension<Scalar> m_offset_bounds; ///< Interval extension of the offset, if known
+    /// Interval extension of the offset derivative, if known
+    IntervalExtension<Scalar> m_derivative_bounds;
 };
 
 } // namespace stf
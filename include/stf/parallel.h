@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Resolve a requested number of threads, 0 meaning one per hardware thread.
+ */
+inline size_t resolve_thread_count(size_t requested)
+{
+    if (requested > 0) return requested;
+    const size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+/**
+ * @brief Run `fn(task, thread)` for every task in [0, count) on a pool of threads.
+ *
+ * Threads pick the next task from a shared counter, so uneven tasks balance out. `thread` is the
+ * index of the worker running the task, in [0, num_threads), for per-thread scratch storage. The
+ * calling thread is worker 0. The first exception thrown by a task stops the remaining tasks and
+ * is rethrown once every worker has finished.
+ *
+ * @param count The number of tasks
+ * @param num_threads The number of threads (0 for one per hardware thread)
+ * @param fn The task, called as fn(task, thread)
+ */
+template <typename Fn>
+void parallel_for(size_t count, size_t num_threads, Fn&& fn)
+{
+    num_threads = std::min(resolve_thread_count(num_threads), count);
+    if (num_threads <= 1) {
+        for (size_t task = 0; task < count; ++task) fn(task, size_t(0));
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&](size_t thread) {
+        try {
+            for (size_t task = next++; task < count; task = next++) fn(task, thread);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t thread = 1; thread < num_threads; ++thread) threads.emplace_back(worker, thread);
+    worker(0);
+    for (auto& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace stf
@@ -5,5 +5,6 @@
 #include <stf/primitives/implicit_ball.h>
 #include <stf/primitives/implicit_capsule.h>
 #include <stf/primitives/implicit_function.h>
+#include <stf/primitives/implicit_nary_union.h>
 #include <stf/primitives/implicit_torus.h>
 #include <stf/primitives/implicit_union.h>
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/maths/all.h>
 #include <stf/primitives/implicit_function.h>
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <fstream>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -34,8 +37,11 @@ namespace stf {
  * - Evaluate the implicit function at any point in 3D space
  * - Compute the gradient of the implicit function
  * - Normalize the space for better numerical stability
+ *
+ * @tparam Scalar The scalar type used for evaluation and storage
  */
-class Duchon : public ImplicitFunction<3>
+template <typename Scalar = stf::Scalar>
+class BasicDuchon : public ImplicitFunction<3, Scalar>
 {
 public:
     /**
@@ -53,7 +59,7 @@ public:
      * @throws std::runtime_error if no control points are provided
      * @throws std::runtime_error if radius is too close to zero
      */
-    Duchon(
+    BasicDuchon(
         std::vector<std::array<Scalar, 3>> points,
         std::vector<std::array<Scalar, 4>> rbf_coeffs,
         std::array<Scalar, 4> affine_coeffs,
@@ -90,7 +96,7 @@ public:
      * @throws std::runtime_error if the points are not 3D
      * @throws std::runtime_error if no samples are found in the file
      */
-    Duchon(
+    BasicDuchon(
         std::filesystem::path samples_file,
         std::filesystem::path coeffs_file,
         std::array<Scalar, 3> center = {0, 0, 0},
@@ -155,9 +161,9 @@ public:
             const auto& pi = m_points[i];
             const auto& coeffs = m_rbf_coeffs[i];
 
-            Vec3 diff = subtract(pos, pi);
+            Vector3<Scalar> diff = subtract(pos, pi);
             Scalar d = norm(diff);
-            Vec3 g = scale(diff, 3 * d);
+            Vector3<Scalar> g = scale(diff, 3 * d);
 
             result +=
                 d * d * d * coeffs[0] + g[0] * coeffs[1] + g[1] * coeffs[2] + g[2] * coeffs[3];
@@ -181,44 +187,257 @@ public:
      * @return The gradient vector at the given point
      */
     std::array<Scalar, 3> gradient(std::array<Scalar, 3> pos) const override
+    {
+        return BasicDuchon::evaluate(pos).gradient;
+    }
+
+    /**
+     * @brief Evaluates the implicit function and its gradient in a single pass over the control
+     * points.
+     *
+     * @param pos The 3D point at which to evaluate the function
+     * @return The value and the gradient at the given point
+     */
+    ImplicitEvaluation<3, Scalar> evaluate(std::array<Scalar, 3> pos) const override
     {
         pos = add(scale(pos, m_scale), m_translation);
         const size_t num_pts = m_points.size();
-        std::array<Scalar, 3> result{0, 0, 0};
-        const Mat3 I = identityMatrix();
+        Scalar value = 0;
+        std::array<Scalar, 3> grad{0, 0, 0};
+        const Matrix3<Scalar> I = identityMatrix<Scalar>();
 
         for (size_t i = 0; i < num_pts; i++) {
             const auto& pi = m_points[i];
             const auto& coeffs = m_rbf_coeffs[i];
 
-            Vec3 diff = subtract(pos, pi);
+            Vector3<Scalar> diff = subtract(pos, pi);
             Scalar d = norm(diff);
-            Vec3 g = scale(diff, 3 * d);
+            Vector3<Scalar> g = scale(diff, 3 * d);
+
+            value +=
+                d * d * d * coeffs[0] + g[0] * coeffs[1] + g[1] * coeffs[2] + g[2] * coeffs[3];
 
-            Mat3 O{
+            Matrix3<Scalar> O{
                 {{diff[0] * diff[0], diff[0] * diff[1], diff[0] * diff[2]},
                  {diff[1] * diff[0], diff[1] * diff[1], diff[1] * diff[2]},
                  {diff[2] * diff[0], diff[2] * diff[1], diff[2] * diff[2]}}};
-            Mat3 H{{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}};
+            Matrix3<Scalar> H{{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}};
             if (d > 1e-8) {
                 H = scale(add(scale(I, d), scale(O, 1 / d)), 3);
             }
 
-            result =
-                add(add(result, scale(g, coeffs[0])),
+            grad =
+                add(add(grad, scale(g, coeffs[0])),
                     apply_matrix(H, {coeffs[1], coeffs[2], coeffs[3]}));
         }
 
-        result =
-            add(result,
+        value += m_affine_coeffs[0] + m_affine_coeffs[1] * pos[0] + m_affine_coeffs[2] * pos[1] +
+                 m_affine_coeffs[3] * pos[2];
+        grad =
+            add(grad,
                 {
                     m_affine_coeffs[1],
                     m_affine_coeffs[2],
                     m_affine_coeffs[3],
                 });
+        grad = scale(grad, m_scale);
+
+        // Negate because the default vipss has positive values inside.
+        if (m_positive_inside) return {-value, scale(grad, -1)};
+        return {value, grad};
+    }
+
+    /**
+     * @brief Computes the Hessian of the implicit function at a given point.
+     *
+     * For each control point with offset diff, distance d and coefficients (a, b), the cubic
+     * term contributes 3a (d I + diff diffᵀ / d) and the gradient term contributes
+     * 3 (diff bᵀ + b diffᵀ + (diff·b) (I - diff diffᵀ / d²)) / d. The affine term vanishes.
+     *
+     * @param pos The 3D point at which to compute the Hessian
+     * @return The Hessian matrix at the given point
+     */
+    std::array<std::array<Scalar, 3>, 3> hessian(std::array<Scalar, 3> pos) const override
+    {
+        pos = add(scale(pos, m_scale), m_translation);
+        Matrix3<Scalar> H{};
+
+        for (size_t i = 0; i < m_points.size(); i++) {
+            const auto& coeffs = m_rbf_coeffs[i];
+            Vector3<Scalar> diff = subtract(pos, m_points[i]);
+            Scalar d = norm(diff);
+            if (d <= 1e-8) continue;
+
+            const Vector3<Scalar> b{coeffs[1], coeffs[2], coeffs[3]};
+            const Scalar proj = dot(diff, b);
+            for (int j = 0; j < 3; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    const Scalar outer = diff[j] * diff[k] / d;
+                    H[j][k] += 3 * coeffs[0] * outer +
+                               3 * (diff[j] * b[k] + b[j] * diff[k] - proj * outer / d) / d;
+                }
+                H[j][j] += 3 * coeffs[0] * d + 3 * proj / d;
+            }
+        }
+
         // Negate because the default vipss has positive values inside.
-        result = scale(result, m_scale);
-        return m_positive_inside ? scale(result, -1) : result;
+        return scale(H, m_positive_inside ? -m_scale * m_scale : m_scale * m_scale);
+    }
+
+    /**
+     * @brief Bounds the implicit function over a box.
+     *
+     * Each kernel d³ a + 3 d (diff·b) is evaluated in interval arithmetic on the normalized box
+     * and the ranges are summed with the range of the affine term.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> A conservative range of values over the box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<3, Scalar>& box) const override
+    {
+        IntervalBox<3, Scalar> q;
+        for (int j = 0; j < 3; ++j) q[j] = box[j] * m_scale + m_translation[j];
+
+        Interval<Scalar> result = m_affine_coeffs[0];
+        for (int j = 0; j < 3; ++j) result += m_affine_coeffs[j + 1] * q[j];
+        for (size_t i = 0; i < m_points.size(); i++) {
+            const auto& coeffs = m_rbf_coeffs[i];
+            Interval<Scalar> d2(0);
+            Interval<Scalar> proj(0);
+            for (int j = 0; j < 3; ++j) {
+                const auto diff = q[j] - m_points[i][j];
+                d2 += sqr(diff);
+                proj += diff * coeffs[j + 1];
+            }
+            const auto d = sqrt(d2);
+            result += pow(d, 3) * coeffs[0] + 3 * d * proj;
+        }
+
+        // Negate because the default vipss has positive values inside.
+        return m_positive_inside ? -result : result;
+    }
+
+    /**
+     * @brief Bounds the norm of the gradient over a box.
+     *
+     * The gradient of each kernel is 3 d a diff + 3 (d b + diff (diff·b) / d), whose norm is at
+     * most 3 |a| d² + 6 |b| d. The kernel bounds at the largest distance over the normalized box
+     * are summed with the norm of the affine gradient and scaled back to the input space.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Scalar A Lipschitz constant of the function over the box
+     */
+    Scalar lipschitz_bound(const IntervalBox<3, Scalar>& box) const override
+    {
+        IntervalBox<3, Scalar> q;
+        for (int j = 0; j < 3; ++j) q[j] = box[j] * m_scale + m_translation[j];
+
+        Scalar result = norm(std::array<Scalar, 3>{
+            m_affine_coeffs[1],
+            m_affine_coeffs[2],
+            m_affine_coeffs[3]});
+        for (size_t i = 0; i < m_points.size(); i++) {
+            const auto& coeffs = m_rbf_coeffs[i];
+            const Scalar d = distance_bounds(q, m_points[i]).upper;
+            const Scalar b = norm(std::array<Scalar, 3>{coeffs[1], coeffs[2], coeffs[3]});
+            result += 3 * std::abs(coeffs[0]) * d * d + 6 * b * d;
+        }
+        return result * m_scale;
+    }
+
+    /**
+     * @brief Evaluates the implicit function at a batch of points.
+     *
+     * Control points are visited in the outer loop and query points in the inner loop, so each
+     * kernel's coefficients are loaded once per batch and the inner loop is a straight pass over
+     * contiguous coordinate columns.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        std::span<Scalar> values) const override
+    {
+        const size_t n = values.size();
+        ColumnBuffer<3, Scalar> normalized(n);
+        const auto q = normalize_batch(pos, normalized);
+
+        std::fill(values.begin(), values.end(), Scalar(0));
+        for (size_t i = 0; i < m_points.size(); i++) {
+            const auto& pi = m_points[i];
+            const auto& coeffs = m_rbf_coeffs[i];
+            for (size_t k = 0; k < n; ++k) {
+                Scalar dx = q[0][k] - pi[0];
+                Scalar dy = q[1][k] - pi[1];
+                Scalar dz = q[2][k] - pi[2];
+                Scalar d = std::sqrt(dx * dx + dy * dy + dz * dz);
+                Scalar s = 3 * d;
+                values[k] += d * d * d * coeffs[0] + dx * s * coeffs[1] + dy * s * coeffs[2] +
+                             dz * s * coeffs[3];
+            }
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            values[k] += m_affine_coeffs[0] + m_affine_coeffs[1] * q[0][k] +
+                         m_affine_coeffs[2] * q[1][k] + m_affine_coeffs[3] * q[2][k];
+            // Negate because the default vipss has positive values inside.
+            if (m_positive_inside) values[k] = -values[k];
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the implicit function at a batch of points.
+     *
+     * Uses the same loop order as value_batch. The kernel Hessian 3(d I + diff diffᵀ / d) is
+     * applied to the gradient coefficients directly instead of being assembled.
+     *
+     * @param pos The coordinate columns
+     * @param gradients Output columns, one span per gradient component
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        std::array<std::span<Scalar>, 3> gradients) const override
+    {
+        const size_t n = pos[0].size();
+        ColumnBuffer<3, Scalar> normalized(n);
+        const auto q = normalize_batch(pos, normalized);
+
+        for (int j = 0; j < 3; ++j) std::fill(gradients[j].begin(), gradients[j].end(), 0);
+        for (size_t i = 0; i < m_points.size(); i++) {
+            const auto& pi = m_points[i];
+            const auto& coeffs = m_rbf_coeffs[i];
+            for (size_t k = 0; k < n; ++k) {
+                Scalar dx = q[0][k] - pi[0];
+                Scalar dy = q[1][k] - pi[1];
+                Scalar dz = q[2][k] - pi[2];
+                Scalar d = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+                // ∇(d³) a = 3 d diff a
+                Scalar s = 3 * d * coeffs[0];
+                Scalar gx = dx * s;
+                Scalar gy = dy * s;
+                Scalar gz = dz * s;
+                if (d > 1e-8) {
+                    // H b = 3 (d b + diff (diff·b) / d)
+                    Scalar proj = (dx * coeffs[1] + dy * coeffs[2] + dz * coeffs[3]) / d;
+                    gx += 3 * (d * coeffs[1] + dx * proj);
+                    gy += 3 * (d * coeffs[2] + dy * proj);
+                    gz += 3 * (d * coeffs[3] + dz * proj);
+                }
+                gradients[0][k] += gx;
+                gradients[1][k] += gy;
+                gradients[2][k] += gz;
+            }
+        }
+
+        // Negate because the default vipss has positive values inside.
+        const Scalar factor = m_positive_inside ? -m_scale : m_scale;
+        for (int j = 0; j < 3; ++j) {
+            for (size_t k = 0; k < n; ++k) {
+                gradients[j][k] = (gradients[j][k] + m_affine_coeffs[j + 1]) * factor;
+            }
+        }
     }
 
 private:
@@ -259,6 +478,26 @@ private:
     }
 
 
+    /**
+     * @brief Applies the normalization to a batch of points.
+     *
+     * @param pos The input coordinate columns
+     * @param buffer Scratch storage receiving the normalized coordinates
+     * @return Read-only view of the normalized coordinate columns
+     */
+    std::array<std::span<const Scalar>, 3> normalize_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        ColumnBuffer<3, Scalar>& buffer) const
+    {
+        const auto out = buffer.columns();
+        for (int j = 0; j < 3; ++j) {
+            for (size_t k = 0; k < pos[j].size(); ++k) {
+                out[j][k] = pos[j][k] * m_scale + m_translation[j];
+            }
+        }
+        return buffer.const_columns();
+    }
+
 private:
     std::vector<std::array<Scalar, 3>> m_points; ///< Control points defining the surface
     std::vector<std::array<Scalar, 4>> m_rbf_coeffs; ///< RBF coefficients for each control point
@@ -269,4 +508,7 @@ private:
     bool m_positive_inside; ///< Flag indicating if the inside of the surface is positive
 };
 
+/// Double precision Duchon interpolant.
+using Duchon = BasicDuchon<>;
+
 } // namespace stf
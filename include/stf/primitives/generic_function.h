@@ -1,9 +1,12 @@
 #pragma once
 
 #include <stf/common.h>
+#include <stf/maths/dual.h>
+#include <stf/primitives/implicit_function.h>
 
 #include <array>
 #include <functional>
+#include <stdexcept>
 
 namespace stf {
 
@@ -13,12 +16,13 @@ namespace stf {
  *
  * This class allows creating implicit functions by providing function pointers for both
  * the value and gradient computations. This is useful for creating custom implicit functions
- * without having to create a new class.
+ * without having to create a new class. `from_generic` instead derives the gradient of a generic
+ * lambda with forward-mode automatic differentiation.
  *
  * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
  */
-template <int dim>
-class GenericFunction : public ImplicitFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class GenericFunction : public ImplicitFunction<dim, Scalar>
 {
 public:
     /**
@@ -44,6 +48,35 @@ public:
 
     virtual ~GenericFunction() = default;
 
+    /**
+     * @brief Creates a generic function whose gradient is computed by automatic differentiation.
+     *
+     * `value_func` must be callable with both plain scalars and dual numbers (stf::Dual),
+     * typically a generic lambda. Elementary functions should be called unqualified after a
+     * using declaration (`using std::sqrt; sqrt(x)`) so that the dual overloads are found.
+     *
+     * @param value_func The generic function defining the value
+     * @return GenericFunction The implicit function with an exact gradient
+     */
+    template <typename Func>
+    static GenericFunction from_generic(Func value_func)
+    {
+        using Gradient = Dual<Scalar, dim>;
+
+        auto evaluate = [value_func](std::array<Scalar, dim> pos) {
+            std::array<Gradient, dim> p;
+            for (int i = 0; i < dim; ++i) p[i] = Gradient::variable(pos[i], i);
+            const Gradient result = value_func(p);
+            return ImplicitEvaluation<dim, Scalar>{result.value, result.derivatives};
+        };
+
+        GenericFunction function(
+            [value_func](std::array<Scalar, dim> pos) -> Scalar { return value_func(pos); },
+            [evaluate](std::array<Scalar, dim> pos) { return evaluate(pos).gradient; });
+        function.m_evaluate_func = evaluate;
+        return function;
+    }
+
     Scalar value(std::array<Scalar, dim> pos) const override { return m_value_func(pos); }
 
     std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
@@ -51,9 +84,16 @@ public:
         return m_gradient_func(pos);
     }
 
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        if (m_evaluate_func) return m_evaluate_func(pos);
+        return {m_value_func(pos), m_gradient_func(pos)};
+    }
+
 private:
     std::function<Scalar(std::array<Scalar, dim>)> m_value_func;
     std::function<std::array<Scalar, dim>(std::array<Scalar, dim>)> m_gradient_func;
+    std::function<ImplicitEvaluation<dim, Scalar>(std::array<Scalar, dim>)> m_evaluate_func;
 };
 
 } // namespace stf
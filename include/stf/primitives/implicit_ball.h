@@ -1,10 +1,12 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/primitives/implicit_function.h>
 
 #include <array>
 #include <cmath>
+#include <span>
 #include <stdexcept>
 
 namespace stf {
@@ -18,8 +20,8 @@ namespace stf {
  *
  * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
  */
-template <int dim>
-class ImplicitBall : public ImplicitFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class ImplicitBall : public ImplicitFunction<dim, Scalar>
 {
 public:
     /**
@@ -55,16 +57,16 @@ public:
                        std::sqrt(
                            (pos[0] - m_center[0]) * (pos[0] - m_center[0]) +
                            (pos[1] - m_center[1]) * (pos[1] - m_center[1])),
-                       m_degree) -
-                   std::pow(m_radius, m_degree);
+                       Scalar(m_degree)) -
+                   std::pow(m_radius, Scalar(m_degree));
         } else if constexpr (dim == 3) {
             return std::pow(
                        std::sqrt(
                            (pos[0] - m_center[0]) * (pos[0] - m_center[0]) +
                            (pos[1] - m_center[1]) * (pos[1] - m_center[1]) +
                            (pos[2] - m_center[2]) * (pos[2] - m_center[2])),
-                       m_degree) -
-                   std::pow(m_radius, m_degree);
+                       Scalar(m_degree)) -
+                   std::pow(m_radius, Scalar(m_degree));
         } else {
             throw std::invalid_argument("ImplicitBall is only defined for 2D and 3D.");
         }
@@ -82,31 +84,191 @@ public:
      */
     std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
     {
-        if constexpr (dim == 2) {
-            Scalar r = std::sqrt(
-                (pos[0] - m_center[0]) * (pos[0] - m_center[0]) +
-                (pos[1] - m_center[1]) * (pos[1] - m_center[1]));
-            Scalar d = m_degree * std::pow(r, m_degree - 1);
-            if (r == 0) return {0, 0};
+        return ImplicitBall::evaluate(pos).gradient;
+    }
 
-            return {(pos[0] - m_center[0]) * d / r, (pos[1] - m_center[1]) * d / r};
-        } else if constexpr (dim == 3) {
-            Scalar r = std::sqrt(
-                (pos[0] - m_center[0]) * (pos[0] - m_center[0]) +
-                (pos[1] - m_center[1]) * (pos[1] - m_center[1]) +
-                (pos[2] - m_center[2]) * (pos[2] - m_center[2]));
-            Scalar d = m_degree * std::pow(r, m_degree - 1);
-            if (r == 0) return {0, 0, 0};
-
-            return {
-                (pos[0] - m_center[0]) * d / r,
-                (pos[1] - m_center[1]) * d / r,
-                (pos[2] - m_center[2]) * d / r};
-        } else {
-            throw std::invalid_argument("ImplicitBall is only defined for 2D and 3D.");
+    /**
+     * @brief Evaluates the signed distance and its gradient together.
+     *
+     * The distance to the center is computed once and shared by both outputs.
+     *
+     * @param pos The position to evaluate at
+     * @return ImplicitEvaluation<dim, Scalar> The value and gradient at the given position
+     */
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        static_assert(dim == 2 || dim == 3, "ImplicitBall is only defined for 2D and 3D.");
+        std::array<Scalar, dim> diff;
+        Scalar r2 = 0;
+        for (int i = 0; i < dim; ++i) {
+            diff[i] = pos[i] - m_center[i];
+            r2 += diff[i] * diff[i];
+        }
+        Scalar r = std::sqrt(r2);
+
+        ImplicitEvaluation<dim, Scalar> result{
+            std::pow(r, Scalar(m_degree)) - std::pow(m_radius, Scalar(m_degree)),
+            {}};
+        if (r == 0) return result;
+
+        Scalar d = m_degree * std::pow(r, Scalar(m_degree - 1));
+        for (int i = 0; i < dim; ++i) {
+            result.gradient[i] = diff[i] * d / r;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the Hessian of the implicit function at a given position.
+     *
+     * With d the offset from the center, r = |d| and n the degree, the Hessian is
+     * n rⁿ⁻² I + n (n - 2) rⁿ⁻⁴ d dᵀ. At the center it is only defined for n = 2 and is set to
+     * zero otherwise.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The Hessian matrix
+     */
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        std::array<Scalar, dim> diff;
+        Scalar r2 = 0;
+        for (int i = 0; i < dim; ++i) {
+            diff[i] = pos[i] - m_center[i];
+            r2 += diff[i] * diff[i];
+        }
+
+        std::array<std::array<Scalar, dim>, dim> H{};
+        if (r2 == 0) {
+            if (m_degree == 2) {
+                for (int i = 0; i < dim; ++i) H[i][i] = 2;
+            }
+            return H;
+        }
+
+        const Scalar a = m_degree * std::pow(r2, Scalar(m_degree - 2) / 2);
+        const Scalar b = m_degree * (m_degree - 2) * std::pow(r2, Scalar(m_degree - 4) / 2);
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) H[i][j] = b * diff[i] * diff[j];
+            H[i][i] += a;
+        }
+        return H;
+    }
+
+    /**
+     * @brief Bounds the implicit function over a box.
+     *
+     * The value only depends on the distance to the center, whose exact range over the box is
+     * the distance to the closest and to the farthest point of the box.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> The range of values over the box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return pow(distance_bounds(box, m_center), m_degree) -
+               std::pow(m_radius, Scalar(m_degree));
+    }
+
+    /**
+     * @brief Bounds the norm of the gradient over a box.
+     *
+     * The gradient norm is n rⁿ⁻¹, where r is the distance to the center and n the degree, so it
+     * is 1 for the signed distance and grows with the distance from the center otherwise.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Scalar The largest gradient norm over the box
+     */
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        if (m_degree == 1) return 1;
+        return m_degree * std::pow(distance_bounds(box, m_center).upper, Scalar(m_degree - 1));
+    }
+
+    /**
+     * @brief Bounds the region where the function is at most a given level.
+     *
+     * The sublevel set is the ball of radius (rⁿ + level)^(1/n), empty if rⁿ + level < 0.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> The bounding box of the sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar power = std::pow(m_radius, Scalar(m_degree)) + level;
+        if (power < 0) return empty_box<dim, Scalar>();
+        const Scalar radius = std::pow(power, Scalar(1) / m_degree);
+        IntervalBox<dim, Scalar> box;
+        for (int i = 0; i < dim; ++i) box[i] = {m_center[i] - radius, m_center[i] + radius};
+        return box;
+    }
+
+    /**
+     * @brief Evaluates the implicit function at a batch of positions.
+     *
+     * Loops over the batch without per-position virtual dispatch.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = ImplicitBall::value(gather(pos, k));
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the implicit function at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param gradients Output columns, one span per gradient component
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        for (size_t k = 0; k < pos[0].size(); ++k) {
+            scatter(gradients, k, ImplicitBall::gradient(gather(pos, k)));
+        }
+    }
+
+    /**
+     * @brief Evaluates the value and the gradient together at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     * @param gradients Output columns, one span per gradient component
+     */
+    void evaluate_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            const auto e = ImplicitBall::evaluate(gather(pos, k));
+            values[k] = e.value;
+            scatter(gradients, k, e.gradient);
         }
     }
 
+public:
+    /**
+     * @brief Get the radius of the ball.
+     */
+    Scalar radius() const { return m_radius; }
+
+    /**
+     * @brief Get the center of the ball.
+     */
+    const std::array<Scalar, dim>& center() const { return m_center; }
+
+    /**
+     * @brief Get the degree of the distance function.
+     */
+    int degree() const { return m_degree; }
+
 private:
     Scalar m_radius; ///< The radius of the ball
     std::array<Scalar, dim> m_center; ///< The center point of the ball
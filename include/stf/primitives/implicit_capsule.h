@@ -1,11 +1,14 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/primitives/implicit_function.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <numeric>
+#include <span>
 
 namespace stf {
 
@@ -18,8 +21,8 @@ namespace stf {
  * 
  * @tparam dim The dimensionality of the space (2D or 3D)
  */
-template <int dim>
-class ImplicitCapsule : public ImplicitFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class ImplicitCapsule : public ImplicitFunction<dim, Scalar>
 {
 public:
     /**
@@ -69,28 +72,179 @@ public:
      * @return std::array<Scalar, dim> The normalized gradient vector
      */
     std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return ImplicitCapsule::evaluate(pos).gradient;
+    }
+
+    /**
+     * @brief Evaluates the signed distance and its gradient together.
+     *
+     * The closest point on the segment is computed once and shared by both outputs.
+     *
+     * @param pos The position to evaluate at
+     * @return ImplicitEvaluation<dim, Scalar> The value and gradient at the given position
+     */
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
     {
         std::array<Scalar, dim> closest_point = compute_closest_point(pos);
 
-        // Calculate the gradient
-        std::array<Scalar, dim> grad;
-        Scalar grad_norm = 0;
+        ImplicitEvaluation<dim, Scalar> result;
+        Scalar distance_squared = 0;
         for (int i = 0; i < dim; ++i) {
-            grad[i] = pos[i] - closest_point[i];
-            grad_norm += grad[i] * grad[i];
+            result.gradient[i] = pos[i] - closest_point[i];
+            distance_squared += result.gradient[i] * result.gradient[i];
         }
+        Scalar distance = std::sqrt(distance_squared);
+        result.value = distance - m_radius;
 
         // Normalize the gradient
-        grad_norm = std::sqrt(grad_norm);
-        if (grad_norm > 1e-6) {
+        if (distance > 1e-6) {
             for (int i = 0; i < dim; ++i) {
-                grad[i] /= grad_norm;
+                result.gradient[i] /= distance;
             }
         } else {
-            grad.fill(0);
+            result.gradient.fill(0);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Computes the Hessian of the implicit function at a given position.
+     *
+     * With n the unit gradient and ρ the distance to the segment, the Hessian is (I - n nᵀ) / ρ
+     * near the end caps and (I - n nᵀ - u uᵀ) / ρ along the cylinder, where u is the unit axis.
+     * It is set to zero on the segment, where the gradient is undefined.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The Hessian matrix
+     */
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        Scalar alpha;
+        std::array<Scalar, dim> closest_point = compute_closest_point(pos, &alpha);
+
+        std::array<Scalar, dim> n;
+        std::array<Scalar, dim> u;
+        Scalar distance_squared = 0;
+        Scalar length_squared = 0;
+        for (int i = 0; i < dim; ++i) {
+            n[i] = pos[i] - closest_point[i];
+            u[i] = m_p2[i] - m_p1[i];
+            distance_squared += n[i] * n[i];
+            length_squared += u[i] * u[i];
+        }
+
+        std::array<std::array<Scalar, dim>, dim> H{};
+        Scalar distance = std::sqrt(distance_squared);
+        if (distance <= 1e-6) return H;
+
+        const bool on_cylinder = alpha > 0 && alpha < 1;
+        const Scalar inv_length = 1 / std::sqrt(length_squared);
+        for (int i = 0; i < dim; ++i) {
+            n[i] /= distance;
+            u[i] *= inv_length;
         }
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) {
+                Scalar h = (i == j ? 1 : 0) - n[i] * n[j];
+                if (on_cylinder) h -= u[i] * u[j];
+                H[i][j] = h / distance;
+            }
+        }
+        return H;
+    }
 
-        return grad;
+    /**
+     * @brief Bounds the implicit function over a box.
+     *
+     * The signed distance is 1-Lipschitz, so it deviates from its value at the center of the box
+     * by at most the circumradius of the box.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> A conservative range of values over the box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        const Scalar radius = box_radius(box);
+        return ImplicitCapsule::value(box_center(box)) + Interval<Scalar>(-radius, radius);
+    }
+
+    /**
+     * @brief The signed distance is 1-Lipschitz everywhere.
+     */
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& /*box*/) const override { return 1; }
+
+    /**
+     * @brief Bounds the region where the function is at most a given level.
+     *
+     * The sublevel set is the capsule of radius r + level around the segment.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> The bounding box of the sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar radius = m_radius + level;
+        if (radius < 0) return empty_box<dim, Scalar>();
+        IntervalBox<dim, Scalar> box;
+        for (int i = 0; i < dim; ++i) {
+            box[i] = {
+                std::min(m_p1[i], m_p2[i]) - radius,
+                std::max(m_p1[i], m_p2[i]) + radius};
+        }
+        return box;
+    }
+
+    /**
+     * @brief Evaluates the implicit function at a batch of positions.
+     *
+     * Loops over the batch without per-position virtual dispatch.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = ImplicitCapsule::value(gather(pos, k));
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the implicit function at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param gradients Output columns, one span per gradient component
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        for (size_t k = 0; k < pos[0].size(); ++k) {
+            scatter(gradients, k, ImplicitCapsule::gradient(gather(pos, k)));
+        }
+    }
+
+    /**
+     * @brief Evaluates the value and the gradient together at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     * @param gradients Output columns, one span per gradient component
+     */
+    void evaluate_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            const auto e = ImplicitCapsule::evaluate(gather(pos, k));
+            values[k] = e.value;
+            scatter(gradients, k, e.gradient);
+        }
     }
 
 private:
@@ -98,9 +252,12 @@ private:
      * @brief Computes the closest point on the line segment to a given position.
      * 
      * @param pos The position to compute the closest point from
+     * @param alpha If not null, receives the unclamped segment parameter of the projection
      * @return std::array<Scalar, dim> The closest point on the line segment
      */
-    std::array<Scalar, dim> compute_closest_point(const std::array<Scalar, dim>& pos) const
+    std::array<Scalar, dim> compute_closest_point(
+        const std::array<Scalar, dim>& pos,
+        Scalar* alpha = nullptr) const
     {
         // Calculate the distance from the point to the line segment defined by p1 and p2
         std::array<Scalar, dim> d;
@@ -113,6 +270,7 @@ private:
             t += (pos[i] - m_p1[i]) * d[i];
         }
         t /= std::inner_product(d.begin(), d.end(), d.begin(), Scalar(0));
+        if (alpha != nullptr) *alpha = t;
 
         // Clamp t to the range [0, 1]
         t = std::max(Scalar(0), std::min(Scalar(1), t));
@@ -125,6 +283,22 @@ private:
         return closest_point;
     }
 
+public:
+    /**
+     * @brief Get the radius of the capsule.
+     */
+    Scalar radius() const { return m_radius; }
+
+    /**
+     * @brief Get the first end point of the capsule.
+     */
+    const std::array<Scalar, dim>& p1() const { return m_p1; }
+
+    /**
+     * @brief Get the second end point of the capsule.
+     */
+    const std::array<Scalar, dim>& p2() const { return m_p2; }
+
 private:
     Scalar m_radius; ///< The radius of the capsule
     std::array<Scalar, dim> m_p1; ///< The first end point of the capsule
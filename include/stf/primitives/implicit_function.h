@@ -1,11 +1,30 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
+#include <stf/maths/interval.h>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
 
 namespace stf {
 
+/**
+ * @brief Value and gradient of an implicit function at a single position.
+ *
+ * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct ImplicitEvaluation
+{
+    Scalar value; ///< The function value
+    std::array<Scalar, dim> gradient; ///< The spatial gradient
+};
+
 /**
  * @brief Base class for implicit functions in N-dimensional space.
  *
@@ -14,8 +33,10 @@ namespace stf {
  * values inside, and zero on the surface.
  *
  * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
+ * @tparam Scalar The scalar type used for evaluation (stf::Scalar, i.e. double, by default;
+ * float halves memory traffic)
  */
-template <int dim>
+template <int dim, typename Scalar = stf::Scalar>
 class ImplicitFunction
 {
 public:
@@ -40,6 +61,135 @@ public:
      */
     virtual std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const = 0;
 
+    /**
+     * @brief Evaluates the value and the gradient of the implicit function together.
+     *
+     * The default implementation calls `value` and `gradient`. Subclasses override it to share
+     * the work common to both.
+     *
+     * @param pos The position to evaluate at
+     * @return ImplicitEvaluation<dim, Scalar> The value and gradient at the given position
+     */
+    virtual ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const
+    {
+        return {value(pos), gradient(pos)};
+    }
+
+    /**
+     * @brief Computes the Hessian of the implicit function at a given position.
+     *
+     * The default implementation differentiates `gradient` with central differences. Subclasses
+     * with closed-form second derivatives override it.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The symmetric matrix of second derivatives
+     */
+    virtual std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const
+    {
+        return finite_difference_hessian(pos);
+    }
+
+    /**
+     * @brief Bounds the values of the implicit function over an axis-aligned box.
+     *
+     * The returned interval contains `value(pos)` for every position in the box, so a box whose
+     * bounds exclude zero cannot intersect the surface. The default implementation knows nothing
+     * about the function and returns the whole real line.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> A conservative range of values over the box
+     */
+    virtual Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& /*box*/) const
+    {
+        return Interval<Scalar>::entire();
+    }
+
+    /**
+     * @brief Bounds the norm of the gradient over an axis-aligned box.
+     *
+     * The function changes by at most this constant times the distance between two positions of
+     * the box, so a sphere tracer may safely step by |value| / bound. The default implementation
+     * returns infinity.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Scalar A Lipschitz constant of the function over the box
+     */
+    virtual Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& /*box*/) const
+    {
+        return std::numeric_limits<Scalar>::infinity();
+    }
+
+    /**
+     * @brief Bounds the region where the function is at most a given level.
+     *
+     * The returned box contains every position whose value is at most `level`; with the default
+     * level it contains the zero set and the interior. Larger levels are used by smooth unions,
+     * whose zero set extends beyond those of their operands. The default implementation returns
+     * the whole space.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the sublevel set, possibly empty
+     */
+    virtual IntervalBox<dim, Scalar> bounding_box(Scalar /*level*/ = 0) const
+    {
+        return entire_box<dim, Scalar>();
+    }
+
+public:
+    /**
+     * @brief Evaluates the implicit function at a batch of positions.
+     *
+     * Positions are given in structure-of-arrays layout, one span per coordinate. The default
+     * implementation calls `value` once per position.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     */
+    virtual void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = value(gather(pos, k));
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the implicit function at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param gradients Output columns, one span per gradient component
+     */
+    virtual void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const
+    {
+        for (size_t k = 0; k < pos[0].size(); ++k) {
+            scatter(gradients, k, gradient(gather(pos, k)));
+        }
+    }
+
+    /**
+     * @brief Evaluates the value and the gradient together at a batch of positions.
+     *
+     * The default implementation calls `evaluate` once per position.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     * @param gradients Output columns, one span per gradient component
+     */
+    virtual void evaluate_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values,
+        std::array<std::span<Scalar>, dim> gradients) const
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            const auto e = evaluate(gather(pos, k));
+            values[k] = e.value;
+            scatter(gradients, k, e.gradient);
+        }
+    }
+
 public:
     /**
      * @brief Computes the finite difference approximation of the gradient at a
@@ -64,6 +214,36 @@ public:
         }
         return grad;
     }
+
+    /**
+     * @brief Computes the finite difference approximation of the Hessian at a given position.
+     *
+     * Each column is the central difference of `gradient`; the result is symmetrized. The step
+     * along each axis is ∛ε scaled by max(1, |x|), where x is the coordinate being perturbed.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The finite difference Hessian
+     */
+    std::array<std::array<Scalar, dim>, dim> finite_difference_hessian(
+        std::array<Scalar, dim> pos) const
+    {
+        const Scalar step = std::cbrt(std::numeric_limits<Scalar>::epsilon());
+        std::array<std::array<Scalar, dim>, dim> H{};
+        for (int j = 0; j < dim; ++j) {
+            std::array<Scalar, dim> pos_plus = pos;
+            std::array<Scalar, dim> pos_minus = pos;
+            const Scalar delta = step * std::max(Scalar(1), std::abs(pos[j]));
+            pos_plus[j] += delta;
+            pos_minus[j] -= delta;
+            const auto grad_plus = gradient(pos_plus);
+            const auto grad_minus = gradient(pos_minus);
+            for (int i = 0; i < dim; ++i) H[i][j] = (grad_plus[i] - grad_minus[i]) / (2 * delta);
+        }
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < i; ++j) H[i][j] = H[j][i] = (H[i][j] + H[j][i]) / 2;
+        }
+        return H;
+    }
 };
 
 } // namespace stf
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <stf/box_hierarchy.h>
+#include <stf/common.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/primitives/implicit_union.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Implicit function representing the union of any number of implicit functions.
+ *
+ * The operands are blended in increasing order of value with the blending function of
+ * ImplicitUnion, stopping at the first operand outside the blending region of the accumulated
+ * value. For two operands this is exactly ImplicitUnion, and the result does not depend on the
+ * operand order. For three or more smooth operands it differs from a chain of ImplicitUnion, and
+ * its gradient jumps where two operands other than the smallest tie within the blending region.
+ *
+ * The bounding boxes of the operands at doubling levels, starting from `cull_level`, are stored
+ * in bounding volume hierarchies. An evaluation visits the operands whose boxes contain the
+ * position, one level at a time, until their minimum is at least the blending width below the
+ * level: the other operands then cannot contribute and are skipped. If no level suffices, every
+ * operand is evaluated, so the result does not depend on the culling.
+ *
+ * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
+ */
+template <
+    int dim,
+    BlendingFunction UnionType = BlendingFunction::Quadratic,
+    typename Scalar = stf::Scalar>
+class ImplicitNaryUnion : public ImplicitFunction<dim, Scalar>
+{
+private:
+    using Union = ImplicitUnion<dim, UnionType, Scalar>;
+
+public:
+    /**
+     * @brief Constructs a new N-ary implicit union and builds its culling hierarchy.
+     *
+     * @param functions The implicit functions to unite, which must outlive the union
+     * @param smooth_distance The distance over which to smooth the union (0 for no smoothing)
+     */
+    explicit ImplicitNaryUnion(
+        std::vector<ImplicitFunction<dim, Scalar>*> functions,
+        Scalar smooth_distance = 0)
+        : m_functions(std::move(functions))
+        , m_smooth_distance(smooth_distance)
+    {
+        if (m_functions.empty()) {
+            throw std::invalid_argument("Implicit union requires at least one function");
+        }
+        if (std::find(m_functions.begin(), m_functions.end(), nullptr) != m_functions.end()) {
+            throw std::invalid_argument("Implicit union operands must not be null");
+        }
+        build_hierarchy();
+    }
+
+    /**
+     * @brief Evaluates the union at a given position.
+     *
+     * @param pos The position to evaluate at
+     * @return Scalar The blended value of the operands near pos
+     */
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        auto values = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return f.value(pos);
+        });
+
+        Scalar result = values.front();
+        for (size_t i = 1; i < values.size(); ++i) {
+            const auto b = Union::blend(result, values[i], m_smooth_distance);
+            if (b.w2 == 0) break;
+            result = b.value;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the gradient of the union at a given position.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<Scalar, dim> The gradient vector
+     */
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return ImplicitNaryUnion::evaluate(pos).gradient;
+    }
+
+    /**
+     * @brief Evaluates the union and its gradient with a single evaluation of each operand.
+     *
+     * @param pos The position to evaluate at
+     * @return ImplicitEvaluation<dim, Scalar> The value and gradient at the given position
+     */
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        auto evaluations = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return f.evaluate(pos);
+        });
+
+        auto result = evaluations.front();
+        for (size_t i = 1; i < evaluations.size(); ++i) {
+            const auto& e = evaluations[i];
+            const auto b = Union::blend(result.value, e.value, m_smooth_distance);
+            if (b.w2 == 0) break;
+            for (int j = 0; j < dim; ++j) {
+                result.gradient[j] = b.w1 * result.gradient[j] + b.w2 * e.gradient[j];
+            }
+            result.value = b.value;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the Hessian of the union at a given position.
+     *
+     * Each blend step combines the accumulated Hessian with the next operand's as in
+     * ImplicitUnion::hessian.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The Hessian matrix
+     */
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        auto evaluations = evaluate_children(pos, [&](const ImplicitFunction<dim, Scalar>& f) {
+            return std::pair{f.evaluate(pos), &f};
+        });
+
+        auto current = evaluations.front().first;
+        auto result = evaluations.front().second->hessian(pos);
+        for (size_t i = 1; i < evaluations.size(); ++i) {
+            const auto& [e, f] = evaluations[i];
+            const auto b = Union::blend(current.value, e.value, m_smooth_distance);
+            if (b.w2 == 0) break;
+
+            const auto H = f->hessian(pos);
+            for (int r = 0; r < dim; ++r) {
+                const Scalar dr = current.gradient[r] - e.gradient[r];
+                for (int c = 0; c < dim; ++c) {
+                    const Scalar dc = current.gradient[c] - e.gradient[c];
+                    result[r][c] = b.w1 * result[r][c] + b.w2 * H[r][c] + b.curvature * dr * dc;
+                }
+            }
+            for (int j = 0; j < dim; ++j) {
+                current.gradient[j] = b.w1 * current.gradient[j] + b.w2 * e.gradient[j];
+            }
+            current.value = b.value;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the union over a box from the bounds of its operands.
+     *
+     * The union is at most the smallest operand upper bound, and blending lowers the smallest
+     * operand by at most `max_lowering` of the operands that can lie within the blending region.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> A conservative range of values over the box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        Scalar upper = std::numeric_limits<Scalar>::infinity();
+        for (const auto* f : m_functions) {
+            bounds.push_back(f->value_bounds(box));
+            upper = std::min(upper, bounds.back().upper);
+        }
+
+        const Scalar threshold = upper + Union::blend_width(m_smooth_distance);
+        Scalar lower = std::numeric_limits<Scalar>::infinity();
+        size_t blended = 0;
+        for (const auto& b : bounds) {
+            lower = std::min(lower, b.lower);
+            if (b.lower < threshold) ++blended;
+        }
+        return {lower - max_lowering(blended), upper};
+    }
+
+    /**
+     * @brief Bounds the norm of the gradient over a box.
+     *
+     * The blend weights are convex, so the bound is the largest bound of the operands that can
+     * lie within the blending region of the minimum.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Scalar A Lipschitz constant of the union over the box
+     */
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::vector<Interval<Scalar>> bounds;
+        bounds.reserve(m_functions.size());
+        Scalar upper = std::numeric_limits<Scalar>::infinity();
+        for (const auto* f : m_functions) {
+            bounds.push_back(f->value_bounds(box));
+            upper = std::min(upper, bounds.back().upper);
+        }
+
+        const Scalar threshold = upper + Union::blend_width(m_smooth_distance);
+        Scalar result = 0;
+        for (size_t i = 0; i < m_functions.size(); ++i) {
+            if (bounds[i].lower > threshold) continue;
+            result = std::max(result, m_functions[i]->lipschitz_bound(box));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the region where the union is at most a given level.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar expanded = level + max_lowering(m_functions.size());
+        auto result = empty_box<dim, Scalar>();
+        for (const auto* f : m_functions) result = hull(result, f->bounding_box(expanded));
+        return result;
+    }
+
+    /**
+     * @brief Largest amount by which blending `count` operands lowers the smallest one.
+     *
+     * Each blend lowers the accumulated value by at most the smooth distance, and an operand is
+     * only blended while it lies within the blending width of the accumulated value, so the
+     * total is also at most the blending width plus one smooth distance.
+     */
+    Scalar max_lowering(size_t count) const
+    {
+        if (count < 2 || m_smooth_distance <= 0) return 0;
+        return std::min(
+            Scalar(count - 1) * m_smooth_distance,
+            Union::blend_width(m_smooth_distance) + m_smooth_distance);
+    }
+
+    /**
+     * @brief Get the number of operands.
+     */
+    size_t size() const { return m_functions.size(); }
+
+    /**
+     * @brief Get the i-th operand.
+     */
+    const ImplicitFunction<dim, Scalar>& function(size_t i) const { return *m_functions[i]; }
+
+    /**
+     * @brief Get the distance over which the union is smoothed (0 for no smoothing).
+     */
+    Scalar smooth_distance() const { return m_smooth_distance; }
+
+    /**
+     * @brief Get the finest level at which the operand boxes of the hierarchy are computed.
+     */
+    Scalar cull_level() const { return m_hierarchy.first_level(); }
+
+private:
+    static Scalar value_of(Scalar v) { return v; }
+    static Scalar value_of(const ImplicitEvaluation<dim, Scalar>& e) { return e.value; }
+
+    template <typename Operand>
+    static Scalar value_of(const std::pair<ImplicitEvaluation<dim, Scalar>, Operand>& e)
+    {
+        return e.first.value;
+    }
+
+    /**
+     * @brief Evaluates the operands that can contribute at pos, sorted by value.
+     *
+     * @param evaluate Called with an operand, returns its value or evaluation
+     */
+    template <typename Evaluate>
+    auto evaluate_children(const std::array<Scalar, dim>& pos, Evaluate&& evaluate) const
+    {
+        using Result = decltype(evaluate(*m_functions.front()));
+        std::vector<Result> results;
+        const Scalar width = Union::blend_width(std::max(m_smooth_distance, Scalar(0)));
+        m_hierarchy.evaluate_near_minimum(pos, width, [&](uint32_t i) {
+            results.push_back(evaluate(*m_functions[i]));
+            return value_of(results.back());
+        });
+
+        std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+            return value_of(a) < value_of(b);
+        });
+        return results;
+    }
+
+    /**
+     * @brief Builds the hierarchy of operand boxes.
+     *
+     * The finest level is the blending width plus the mean half-diagonal of the operand boxes,
+     * so that positions within about one operand size of the surface are resolved by it. The
+     * levels double up to the diagonal of the union's box.
+     */
+    void build_hierarchy()
+    {
+        Scalar size = 0;
+        size_t count = 0;
+        auto extent = empty_box<dim, Scalar>();
+        for (const auto* f : m_functions) {
+            const auto box = f->bounding_box();
+            if (is_empty(box)) continue;
+            const Scalar radius = box_radius(box);
+            if (!std::isfinite(radius)) continue;
+            size += radius;
+            ++count;
+            extent = hull(extent, box);
+        }
+        const Scalar first_level = Union::blend_width(std::max(m_smooth_distance, Scalar(0))) +
+                                   (count > 0 ? size / count : Scalar(0));
+
+        m_hierarchy = SublevelHierarchy<dim, Scalar>(
+            static_cast<uint32_t>(m_functions.size()),
+            first_level,
+            count > 0 ? 2 * box_radius(extent) : Scalar(0),
+            [&](Scalar level, auto& boxes, auto& ids, auto& unbounded) {
+                auto finite = [](const auto& x) { return x.is_finite(); };
+                for (uint32_t i = 0; i < m_functions.size(); ++i) {
+                    const auto box = m_functions[i]->bounding_box(level);
+                    if (is_empty(box)) continue;
+                    if (std::all_of(box.begin(), box.end(), finite)) {
+                        boxes.push_back(box);
+                        ids.push_back(i);
+                    } else {
+                        unbounded.push_back(i);
+                    }
+                }
+            });
+    }
+
+private:
+    std::vector<ImplicitFunction<dim, Scalar>*> m_functions; ///< The implicit functions to unite
+    Scalar m_smooth_distance = 0; ///< The distance over which to smooth the union
+    SublevelHierarchy<dim, Scalar> m_hierarchy; ///< Operand boxes at increasing levels
+};
+
+} // namespace stf
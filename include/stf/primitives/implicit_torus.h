@@ -1,8 +1,14 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/primitives/implicit_function.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+
 namespace stf {
 
 /**
@@ -12,8 +18,11 @@ namespace stf {
  * R is the distance from the center of the tube to the center of the torus,
  * and r is the radius of the tube.
  * The torus lies in a plane orthogonal to the normal direction.
+ *
+ * @tparam Scalar The scalar type used for evaluation and storage
  */
-class ImplicitTorus : public ImplicitFunction<3>
+template <typename Scalar = stf::Scalar>
+class BasicImplicitTorus : public ImplicitFunction<3, Scalar>
 {
 public:
     /**
@@ -25,7 +34,7 @@ public:
      * @param center The center point of the torus
      * @param normal The normal direction (torus is orthogonal to this). Defaults to {0, 0, 1}.
      */
-    ImplicitTorus(Scalar R, Scalar r, std::array<Scalar, 3> center, 
+    BasicImplicitTorus(Scalar R, Scalar r, std::array<Scalar, 3> center, 
                   std::array<Scalar, 3> normal = {0, 0, 1})
         : m_R(R)
         , m_r(r)
@@ -59,30 +68,40 @@ public:
     }
 
     std::array<Scalar, 3> gradient(std::array<Scalar, 3> pos) const override
+    {
+        return BasicImplicitTorus::evaluate(pos).gradient;
+    }
+
+    /**
+     * @brief Evaluates the signed distance and its gradient together.
+     *
+     * The local coordinates and radial distances are computed once and shared by both outputs.
+     */
+    ImplicitEvaluation<3, Scalar> evaluate(std::array<Scalar, 3> pos) const override
     {
         // Transform to local coordinates
         auto local = to_local(pos);
-        
+
         Scalar x = local[0];
         Scalar y = local[1];
         Scalar z = local[2];
 
         Scalar len_xy = std::sqrt(x * x + y * y);
+        Scalar a = len_xy - m_R;
+        Scalar q_len = std::sqrt(a * a + z * z);
+        Scalar value = q_len - m_r;
 
         // Avoid division by zero (if point is at z-axis)
         if (len_xy < 1e-6f) {
             // Gradient in local coordinates
             std::array<Scalar, 3> local_grad = {0, 0, static_cast<Scalar>(z >= 0 ? 1 : -1)};
             // Transform back to world coordinates
-            return to_world(local_grad);
+            return {value, to_world(local_grad)};
         }
 
-        Scalar a = len_xy - m_R;
-        Scalar q_len = std::sqrt(a * a + z * z);
-
         // Again avoid division by zero if exactly on torus surface
         if (q_len < 1e-6f) {
-            return {0, 0, 0}; // Undefined
+            return {value, {0, 0, 0}}; // Undefined
         }
 
         Scalar dx = (a / q_len) * (x / len_xy);
@@ -91,9 +110,146 @@ public:
 
         // Gradient in local coordinates
         std::array<Scalar, 3> local_grad = {dx, dy, dz};
-        
+
         // Transform back to world coordinates
-        return to_world(local_grad);
+        return {value, to_world(local_grad)};
+    }
+
+    /**
+     * @brief Computes the Hessian of the implicit function at a given position.
+     *
+     * In local coordinates the function is g(ρ, z) = |(ρ - R, z)| - r with ρ = |(x, y)|. The
+     * Hessian combines the second derivatives of g with the curvature (I - e eᵀ) / ρ of ρ, where
+     * e is the radial direction, and is rotated back to world coordinates. It is set to zero on
+     * the axis and on the core circle, where the function is not twice differentiable.
+     */
+    std::array<std::array<Scalar, 3>, 3> hessian(std::array<Scalar, 3> pos) const override
+    {
+        auto local = to_local(pos);
+
+        Scalar x = local[0];
+        Scalar y = local[1];
+        Scalar z = local[2];
+
+        Scalar len_xy = std::sqrt(x * x + y * y);
+        Scalar a = len_xy - m_R;
+        Scalar q_len = std::sqrt(a * a + z * z);
+
+        std::array<std::array<Scalar, 3>, 3> H{};
+        if (len_xy < 1e-6f || q_len < 1e-6f) return H;
+
+        // Second derivatives of g with respect to (ρ, z)
+        const Scalar q3 = q_len * q_len * q_len;
+        const Scalar g_rr = z * z / q3;
+        const Scalar g_rz = -a * z / q3;
+        const Scalar g_zz = a * a / q3;
+        const Scalar g_r = a / q_len;
+
+        // Hessian in local coordinates
+        const std::array<Scalar, 2> e = {x / len_xy, y / len_xy};
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                H[i][j] = g_rr * e[i] * e[j] + g_r * ((i == j ? 1 : 0) - e[i] * e[j]) / len_xy;
+            }
+            H[i][2] = H[2][i] = g_rz * e[i];
+        }
+        H[2][2] = g_zz;
+
+        // Rotate back to world coordinates: Bᵀ H B, where the rows of B are the local axes.
+        std::array<std::array<Scalar, 3>, 3> HB;
+        for (int i = 0; i < 3; ++i) HB[i] = to_world(H[i]);
+        for (int j = 0; j < 3; ++j) H[j] = to_world({HB[0][j], HB[1][j], HB[2][j]});
+        return H;
+    }
+
+    /**
+     * @brief Bounds the implicit function over a box.
+     *
+     * The distance to the core circle is 1-Lipschitz, so the value deviates from its value at the
+     * center of the box by at most the circumradius of the box.
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<3, Scalar>& box) const override
+    {
+        const Scalar radius = box_radius(box);
+        return BasicImplicitTorus::value(box_center(box)) + Interval<Scalar>(-radius, radius);
+    }
+
+    /**
+     * @brief The signed distance is 1-Lipschitz everywhere.
+     */
+    Scalar lipschitz_bound(const IntervalBox<3, Scalar>& /*box*/) const override { return 1; }
+
+    /**
+     * @brief Bounds the region where the function is at most a given level.
+     *
+     * The sublevel set is the tube of radius r + level around the circle of radius R. Along
+     * coordinate axis i the circle extends by R √(1 - nᵢ²), where n is the unit normal.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<3, Scalar> The bounding box of the sublevel set
+     */
+    IntervalBox<3, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar tube = m_r + level;
+        if (tube < 0) return empty_box<3, Scalar>();
+        IntervalBox<3, Scalar> box;
+        for (int i = 0; i < 3; ++i) {
+            const Scalar extent =
+                m_R * std::sqrt(std::max(Scalar(0), 1 - m_normal[i] * m_normal[i])) + tube;
+            box[i] = {m_center[i] - extent, m_center[i] + extent};
+        }
+        return box;
+    }
+
+    /**
+     * @brief Evaluates the implicit function at a batch of positions.
+     *
+     * Loops over the batch without per-position virtual dispatch.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        std::span<Scalar> values) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = BasicImplicitTorus::value(gather(pos, k));
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the implicit function at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param gradients Output columns, one span per gradient component
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        std::array<std::span<Scalar>, 3> gradients) const override
+    {
+        for (size_t k = 0; k < pos[0].size(); ++k) {
+            scatter(gradients, k, BasicImplicitTorus::gradient(gather(pos, k)));
+        }
+    }
+
+    /**
+     * @brief Evaluates the value and the gradient together at a batch of positions.
+     *
+     * @param pos The coordinate columns
+     * @param values Output span receiving one value per position
+     * @param gradients Output columns, one span per gradient component
+     */
+    void evaluate_batch(
+        std::array<std::span<const Scalar>, 3> pos,
+        std::span<Scalar> values,
+        std::array<std::span<Scalar>, 3> gradients) const override
+    {
+        for (size_t k = 0; k < values.size(); ++k) {
+            const auto e = BasicImplicitTorus::evaluate(gather(pos, k));
+            values[k] = e.value;
+            scatter(gradients, k, e.gradient);
+        }
     }
 
 private:
@@ -172,4 +328,7 @@ private:
     std::array<Scalar, 3> m_v; ///< Second basis vector in the torus plane
 };
 
+/// Double precision torus.
+using ImplicitTorus = BasicImplicitTorus<>;
+
 } // namespace stf
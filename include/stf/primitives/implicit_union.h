@@ -3,6 +3,8 @@
 #include <stf/common.h>
 #include <stf/primitives/implicit_function.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <stdexcept>
 
@@ -48,8 +50,11 @@ enum class BlendingFunction {
  *
  * @tparam dim The dimension of the space (2 for 2D, 3 for 3D)
  */
-template <int dim, BlendingFunction UnionType = BlendingFunction::Quadratic>
-class ImplicitUnion : public ImplicitFunction<dim>
+template <
+    int dim,
+    BlendingFunction UnionType = BlendingFunction::Quadratic,
+    typename Scalar = stf::Scalar>
+class ImplicitUnion : public ImplicitFunction<dim, Scalar>
 {
 public:
     /**
@@ -59,7 +64,10 @@ public:
      * @param f2 The second implicit function
      * @param smooth_distance The distance over which to smooth the union (0 for no smoothing)
      */
-    ImplicitUnion(ImplicitFunction<dim>& f1, ImplicitFunction<dim>& f2, Scalar smooth_distance = 0)
+    ImplicitUnion(
+        ImplicitFunction<dim, Scalar>& f1,
+        ImplicitFunction<dim, Scalar>& f2,
+        Scalar smooth_distance = 0)
         : m_f1(f1)
         , m_f2(f2)
         , m_smooth_distance(smooth_distance)
@@ -78,32 +86,7 @@ public:
      */
     Scalar value(std::array<Scalar, dim> pos) const override
     {
-        Scalar a = m_f1.value(pos);
-        Scalar b = m_f2.value(pos);
-
-        if (m_smooth_distance > 0) {
-            if constexpr (UnionType == BlendingFunction::Quadratic) {
-                Scalar k = m_smooth_distance * 4.0;
-                Scalar h = std::max(k - abs(a - b), 0.0) / k;
-                return std::min(a, b) - h * h * k * (1.0 / 4.0);
-            } else if constexpr (UnionType == BlendingFunction::Cubic) {
-                Scalar k = m_smooth_distance * 6.0;
-                Scalar h = std::max(k - abs(a - b), 0.0) / k;
-                return std::min(a, b) - h * h * h * k * (1.0 / 6.0);
-            } else if constexpr (UnionType == BlendingFunction::Quartic) {
-                Scalar k = m_smooth_distance * 16.0 / 3.0;
-                Scalar h = std::max(k - abs(a - b), 0.0) / k;
-                return std::min(a, b) - h * h * h * (4.0 - h) * k * (1.0 / 16.0);
-            } else if constexpr (UnionType == BlendingFunction::Circular) {
-                Scalar k = m_smooth_distance * 1.0 / (1.0 - sqrt(0.5));
-                Scalar h = std::max(k - abs(a - b), 0.0) / k;
-                return std::min(a, b) - k * 0.5 * (1.0 + h - sqrt(1.0 - h * (h - 2.0)));
-            } else {
-                static_assert(always_false<bool>, "Unsupported BlendingFunction");
-            }
-        } else {
-            return std::min(a, b);
-        }
+        return blend(m_f1.value(pos), m_f2.value(pos), m_smooth_distance).value;
     }
 
     /**
@@ -117,113 +100,215 @@ public:
      */
     std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
     {
-        Scalar a = m_f1.value(pos);
-        Scalar b = m_f2.value(pos);
-
-        std::array<Scalar, dim> grad_a = m_f1.gradient(pos);
-        std::array<Scalar, dim> grad_b = m_f2.gradient(pos);
-
-        if (m_smooth_distance > 0) {
-            if constexpr (UnionType == BlendingFunction::Quadratic) {
-                Scalar k = m_smooth_distance * 4.0;
-                Scalar diff = a - b;
-                Scalar abs_diff = std::abs(diff);
-                bool a_is_smaller = (a < b);
-
-                if (abs_diff >= k) {
-                    // No blending region; just take min
-                    return (a < b) ? grad_a : grad_b;
-                }
-
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = -h * sign / 2;
-
-                std::array<Scalar, dim> grad;
-                for (int i = 0; i < dim; ++i) {
-                    Scalar dmin = (a_is_smaller) ? grad_a[i] : grad_b[i];
-                    grad[i] = dmin - coeff * (grad_a[i] - grad_b[i]);
-                }
-
-                return grad;
-            } else if constexpr (UnionType == BlendingFunction::Cubic) {
-                Scalar k = m_smooth_distance * 6.0;
-                Scalar diff = a - b;
-                Scalar abs_diff = std::abs(diff);
-                bool a_is_smaller = (a < b);
-
-                if (abs_diff >= k) {
-                    // No blending region; just take min
-                    return (a < b) ? grad_a : grad_b;
-                }
-
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = -h * h * sign / 2;
-
-                std::array<Scalar, dim> grad;
-                for (int i = 0; i < dim; ++i) {
-                    Scalar dmin = (a_is_smaller) ? grad_a[i] : grad_b[i];
-                    grad[i] = dmin - coeff * (grad_a[i] - grad_b[i]);
-                }
-
-                return grad;
-            } else if constexpr (UnionType == BlendingFunction::Quartic) {
-                Scalar k = m_smooth_distance * 16.0 / 3.0;
-                Scalar diff = a - b;
-                Scalar abs_diff = std::abs(diff);
-                bool a_is_smaller = (a < b);
-
-                if (abs_diff >= k) {
-                    // No blending region; just take min
-                    return (a < b) ? grad_a : grad_b;
-                }
-
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = -(3.0 / 16.0 * h * h * (4 - h) - h * h * h / 16.0) * sign;
-
-                std::array<Scalar, dim> grad;
-                for (int i = 0; i < dim; ++i) {
-                    Scalar dmin = (a_is_smaller) ? grad_a[i] : grad_b[i];
-                    grad[i] = dmin - coeff * (grad_a[i] - grad_b[i]);
-                }
-
-                return grad;
-            } else if constexpr (UnionType == BlendingFunction::Circular) {
-                Scalar k = m_smooth_distance * 1.0 / (1.0 - sqrt(0.5));
-                Scalar diff = a - b;
-                Scalar abs_diff = std::abs(diff);
-                bool a_is_smaller = (a < b);
-
-                if (abs_diff >= k) {
-                    // No blending region; just take min
-                    return (a < b) ? grad_a : grad_b;
-                }
-
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = -0.5 * (1 + (h - 1) / sqrt(1 - h * (h - 2))) * sign;
-
-                std::array<Scalar, dim> grad;
-                for (int i = 0; i < dim; ++i) {
-                    Scalar dmin = (a_is_smaller) ? grad_a[i] : grad_b[i];
-                    grad[i] = dmin - coeff * (grad_a[i] - grad_b[i]);
-                }
-
-                return grad;
-            } else {
-                static_assert(always_false<bool>, "Unsupported BlendingFunction");
+        return ImplicitUnion::evaluate(pos).gradient;
+    }
+
+    /**
+     * @brief Evaluates the union and its gradient with a single evaluation of each operand.
+     *
+     * @param pos The position to evaluate at
+     * @return ImplicitEvaluation<dim, Scalar> The value and gradient at the given position
+     */
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto ea = m_f1.evaluate(pos);
+        const auto eb = m_f2.evaluate(pos);
+        const auto b = blend(ea.value, eb.value, m_smooth_distance);
+
+        // Operands outside the blending region do not contribute at all.
+        if (b.w2 == 0) return {b.value, ea.gradient};
+        if (b.w1 == 0) return {b.value, eb.gradient};
+
+        ImplicitEvaluation<dim, Scalar> result{b.value, {}};
+        for (int i = 0; i < dim; ++i) {
+            result.gradient[i] = b.w1 * ea.gradient[i] + b.w2 * eb.gradient[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the Hessian of the union at a given position.
+     *
+     * Inside the blending region the Hessian is w1 H1 + w2 H2 + c (∇a - ∇b)(∇a - ∇b)ᵀ, where c is
+     * the second derivative of the blend along a - b.
+     *
+     * @param pos The position to evaluate at
+     * @return std::array<std::array<Scalar, dim>, dim> The Hessian matrix
+     */
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        const auto ea = m_f1.evaluate(pos);
+        const auto eb = m_f2.evaluate(pos);
+        const auto b = blend(ea.value, eb.value, m_smooth_distance);
+
+        if (b.w2 == 0) return m_f1.hessian(pos);
+        if (b.w1 == 0) return m_f2.hessian(pos);
+
+        const auto Ha = m_f1.hessian(pos);
+        const auto Hb = m_f2.hessian(pos);
+        std::array<std::array<Scalar, dim>, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            const Scalar di = ea.gradient[i] - eb.gradient[i];
+            for (int j = 0; j < dim; ++j) {
+                const Scalar dj = ea.gradient[j] - eb.gradient[j];
+                result[i][j] = b.w1 * Ha[i][j] + b.w2 * Hb[i][j] + b.curvature * di * dj;
             }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the union over a box from the bounds of its operands.
+     *
+     * Every blending function is non-decreasing in both operands, so the range of the union is
+     * spanned by the blends of the operand lower bounds and of the operand upper bounds.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Interval<Scalar> A conservative range of values over the box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        const auto a = m_f1.value_bounds(box);
+        const auto b = m_f2.value_bounds(box);
+        auto bound = [&](Scalar x, Scalar y) {
+            // An infinite operand lies outside the blending region.
+            if (std::isinf(x) || std::isinf(y)) return std::min(x, y);
+            return blend(x, y, m_smooth_distance).value;
+        };
+        return {bound(a.lower, b.lower), bound(a.upper, b.upper)};
+    }
+
+    /**
+     * @brief Bounds the norm of the gradient over a box.
+     *
+     * The gradient of the union is w1 ∇a + w2 ∇b with non-negative weights summing to one, so
+     * smoothing never increases the Lipschitz constant beyond that of the steeper operand.
+     *
+     * @param box The box, one interval per coordinate
+     * @return Scalar A Lipschitz constant of the union over the box
+     */
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return std::max(m_f1.lipschitz_bound(box), m_f2.lipschitz_bound(box));
+    }
+
+    /**
+     * @brief Bounds the region where the union is at most a given level.
+     *
+     * Every blending function lowers the minimum of the operands by at most the smooth distance,
+     * so the sublevel set lies within the sublevel sets of the operands at level + smooth
+     * distance.
+     *
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar expanded = level + std::max(m_smooth_distance, Scalar(0));
+        return hull(m_f1.bounding_box(expanded), m_f2.bounding_box(expanded));
+    }
+
+public:
+    /**
+     * @brief Blended value of two operands and the partial derivatives of the blend.
+     */
+    struct Blend
+    {
+        Scalar value; ///< The blended value
+        Scalar w1; ///< Partial derivative of the blend with respect to the first operand
+        Scalar w2; ///< Partial derivative of the blend with respect to the second operand
+        Scalar curvature = 0; ///< Second derivative of the blend along a - b
+    };
+
+    /**
+     * @brief Width of the blending region: operands further apart than this are not blended.
+     *
+     * @param smooth_distance The smoothing distance (0 for a hard union)
+     */
+    static Scalar blend_width(Scalar smooth_distance)
+    {
+        if constexpr (UnionType == BlendingFunction::Quadratic) {
+            return smooth_distance * 4.0;
+        } else if constexpr (UnionType == BlendingFunction::Cubic) {
+            return smooth_distance * 6.0;
+        } else if constexpr (UnionType == BlendingFunction::Quartic) {
+            return smooth_distance * 16.0 / 3.0;
+        } else if constexpr (UnionType == BlendingFunction::Circular) {
+            return smooth_distance * 1.0 / (1.0 - std::sqrt(0.5));
         } else {
-            // Hard union: take gradient of the smaller
-            return (a < b) ? grad_a : grad_b;
+            static_assert(always_false<bool>, "Unsupported BlendingFunction");
         }
     }
 
+    /**
+     * @brief Applies the blending function to the operand values a and b.
+     *
+     * The partial derivatives only depend on the operand values, so callers combine operand
+     * gradients as w1 * ∇a + w2 * ∇b.
+     *
+     * @param a The value of the first operand
+     * @param b The value of the second operand
+     * @param smooth_distance The smoothing distance (0 for a hard union)
+     */
+    static Blend blend(Scalar a, Scalar b, Scalar smooth_distance)
+    {
+        if (smooth_distance <= 0) {
+            // Hard union: take the smaller operand
+            return (a < b) ? Blend{a, 1, 0} : Blend{b, 0, 1};
+        }
+
+        const Scalar k = blend_width(smooth_distance);
+        Scalar abs_diff = std::abs(a - b);
+        if (abs_diff >= k) {
+            // No blending region; just take min
+            return (a < b) ? Blend{a, 1, 0} : Blend{b, 0, 1};
+        }
+
+        // value: the smooth minimum; w: the weight of the larger operand in the derivative;
+        // dw: the derivative of w with respect to h.
+        Scalar h = (k - abs_diff) / k;
+        Scalar value, w, dw;
+        if constexpr (UnionType == BlendingFunction::Quadratic) {
+            value = std::min(a, b) - h * h * k * (1.0 / 4.0);
+            w = h / 2;
+            dw = 0.5;
+        } else if constexpr (UnionType == BlendingFunction::Cubic) {
+            value = std::min(a, b) - h * h * h * k * (1.0 / 6.0);
+            w = h * h / 2;
+            dw = h;
+        } else if constexpr (UnionType == BlendingFunction::Quartic) {
+            value = std::min(a, b) - h * h * h * (4.0 - h) * k * (1.0 / 16.0);
+            w = 3.0 / 16.0 * h * h * (4 - h) - h * h * h / 16.0;
+            dw = 1.5 * h - 0.75 * h * h;
+        } else {
+            Scalar s = std::sqrt(1.0 - h * (h - 2.0));
+            value = std::min(a, b) - k * 0.5 * (1.0 + h - s);
+            w = 0.5 * (1 + (h - 1) / s);
+            dw = 1 / (s * s * s);
+        }
+        const Scalar curvature = -dw / k;
+        return (a < b) ? Blend{value, 1 - w, w, curvature} : Blend{value, w, 1 - w, curvature};
+    }
+
+public:
+    /**
+     * @brief Get the first implicit function.
+     */
+    const ImplicitFunction<dim, Scalar>& first() const { return m_f1; }
+
+    /**
+     * @brief Get the second implicit function.
+     */
+    const ImplicitFunction<dim, Scalar>& second() const { return m_f2; }
+
+    /**
+     * @brief Get the distance over which the union is smoothed (0 for no smoothing).
+     */
+    Scalar smooth_distance() const { return m_smooth_distance; }
+
 private:
-    ImplicitFunction<dim>& m_f1; ///< The first implicit function
-    ImplicitFunction<dim>& m_f2; ///< The second implicit function
+    ImplicitFunction<dim, Scalar>& m_f1; ///< The first implicit function
+    ImplicitFunction<dim, Scalar>& m_f2; ///< The second implicit function
     Scalar m_smooth_distance = 0; ///< The distance over which to smooth the union
 };
 
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Options of the projection onto a zero level set.
+ */
+struct ProjectionOptions
+{
+    size_t max_iterations = 32; ///< Maximum number of Newton steps per point
+    double tolerance = 1e-10; ///< A point has converged once |value| is at most this
+    /// Longest step a point may take at once
+    double max_step = std::numeric_limits<double>::infinity();
+    size_t batch_size = 256; ///< Number of points iterated together
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+};
+
+/**
+ * @brief Convergence report of a projection.
+ */
+template <typename Scalar = stf::Scalar>
+struct ProjectionReport
+{
+    std::vector<uint8_t> converged; ///< 1 where the point reached the tolerance, 0 otherwise
+    std::vector<uint32_t> iterations; ///< Number of Newton steps taken by each point
+    std::vector<Scalar> values; ///< Function value at each projected point
+    size_t num_converged = 0; ///< Number of converged points
+    size_t max_iterations = 0; ///< Largest number of steps taken by a point
+    size_t num_evaluations = 0; ///< Number of fused value and gradient evaluations
+};
+
+/**
+ * @brief Projects points onto the zero level set of an implicit function, in place.
+ *
+ * Each point takes Newton steps along the gradient, x -= f(x) ∇f(x) / |∇f(x)|², which land on
+ * the closest point of the zero set in one step for a distance function. A step that does not
+ * decrease |f| is undone and retried at half the length, and successful steps grow back towards
+ * the full length. A point stops once |f| is within the tolerance, after `max_iterations` steps,
+ * or at a vanishing gradient.
+ *
+ * Points are iterated in batches, each step evaluating the still active points of a batch with
+ * one `evaluate_batch` call; converged points leave the batch independently. Batches run in
+ * parallel and the output does not depend on the thread count.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param pos The coordinate columns, overwritten with the projected points
+ * @param options The iteration limits, tolerance, batch size and thread count
+ * @return ProjectionReport<Scalar> Per-point convergence, step counts and final values
+ */
+template <int dim, typename Scalar>
+ProjectionReport<Scalar> project_to_zero_set(
+    const ImplicitFunction<dim, Scalar>& f,
+    std::type_identity_t<std::array<std::span<Scalar>, dim>> pos,
+    const ProjectionOptions& options = {})
+{
+    const size_t n = pos[0].size();
+    for (int i = 1; i < dim; ++i) {
+        if (pos[i].size() != n) throw std::invalid_argument("Coordinate columns differ in size");
+    }
+    if (options.batch_size == 0) throw std::invalid_argument("batch_size must be positive");
+
+    const Scalar tolerance = Scalar(options.tolerance);
+    const Scalar max_step = Scalar(options.max_step);
+
+    ProjectionReport<Scalar> report;
+    report.converged.assign(n, 0);
+    report.iterations.assign(n, 0);
+    report.values.resize(n);
+
+    const size_t batch_size = options.batch_size;
+    const size_t num_batches = (n + batch_size - 1) / batch_size;
+    std::vector<size_t> evaluations(num_batches, 0);
+    parallel_for(num_batches, options.num_threads, [&](size_t batch, size_t /*thread*/) {
+        const size_t begin = batch * batch_size;
+        const size_t count = std::min(n, begin + batch_size) - begin;
+
+        struct Lane
+        {
+            size_t index; ///< Index of the point
+            std::array<Scalar, dim> position; ///< Current position
+            Scalar value; ///< Value at the current position
+            std::array<Scalar, dim> gradient; ///< Gradient at the current position
+            Scalar damping; ///< Fraction of the Newton step to take
+        };
+
+        ColumnBuffer<dim, Scalar> positions(count);
+        ColumnBuffer<dim, Scalar> gradients(count);
+        std::vector<Scalar> values(count);
+        auto evaluate = [&](size_t m) {
+            std::array<std::span<const Scalar>, dim> columns;
+            std::array<std::span<Scalar>, dim> gradient_columns;
+            for (int i = 0; i < dim; ++i) {
+                columns[i] = positions.column(i).first(m);
+                gradient_columns[i] = gradients.column(i).first(m);
+            }
+            f.evaluate_batch(columns, std::span<Scalar>(values).first(m), gradient_columns);
+            evaluations[batch] += m;
+        };
+
+        auto columns = positions.columns();
+        for (size_t j = 0; j < count; ++j) {
+            for (int i = 0; i < dim; ++i) columns[i][j] = pos[i][begin + j];
+        }
+        evaluate(count);
+        std::vector<Lane> active(count);
+        for (size_t j = 0; j < count; ++j) {
+            active[j] = {
+                begin + j,
+                gather(positions.const_columns(), j),
+                values[j],
+                gather(gradients.const_columns(), j),
+                1};
+        }
+
+        auto finish = [&](const Lane& lane, bool converged) {
+            scatter(pos, lane.index, lane.position);
+            report.values[lane.index] = lane.value;
+            report.converged[lane.index] = converged;
+        };
+
+        while (!active.empty()) {
+            // Retire finished points, and place the trial positions of the others.
+            size_t kept = 0;
+            for (const Lane& lane : active) {
+                if (std::abs(lane.value) <= tolerance) {
+                    finish(lane, true);
+                    continue;
+                }
+                Scalar norm2 = 0;
+                for (int i = 0; i < dim; ++i) norm2 += lane.gradient[i] * lane.gradient[i];
+                if (report.iterations[lane.index] >= options.max_iterations || !(norm2 > 0) ||
+                    !std::isfinite(lane.value)) {
+                    finish(lane, false);
+                    continue;
+                }
+                Scalar scale = -lane.damping * lane.value / norm2;
+                const Scalar length = std::abs(scale) * std::sqrt(norm2);
+                if (length > max_step) scale *= max_step / length;
+                for (int i = 0; i < dim; ++i) {
+                    columns[i][kept] = lane.position[i] + scale * lane.gradient[i];
+                }
+                active[kept++] = lane;
+            }
+            active.resize(kept);
+            if (active.empty()) break;
+
+            evaluate(kept);
+            for (size_t j = 0; j < kept; ++j) {
+                Lane& lane = active[j];
+                ++report.iterations[lane.index];
+                if (std::abs(values[j]) < std::abs(lane.value)) {
+                    lane.position = gather(positions.const_columns(), j);
+                    lane.value = values[j];
+                    lane.gradient = gather(gradients.const_columns(), j);
+                    lane.damping = std::min<Scalar>(1, 2 * lane.damping);
+                } else {
+                    lane.damping /= 2;
+                }
+            }
+        }
+    });
+
+    for (size_t k = 0; k < n; ++k) {
+        report.num_converged += report.converged[k];
+        report.max_iterations = std::max<size_t>(report.max_iterations, report.iterations[k]);
+    }
+    for (size_t count : evaluations) report.num_evaluations += count;
+    return report;
+}
+
+/**
+ * @brief Projects points onto the zero level set of a space-time function at time t, in place.
+ *
+ * @param f The space-time function, which must be safe to evaluate concurrently
+ * @param pos The coordinate columns, overwritten with the projected points
+ * @param t The time
+ * @param options The iteration limits, tolerance, batch size and thread count
+ * @return ProjectionReport<Scalar> Per-point convergence, step counts and final values
+ */
+template <int dim, typename Scalar>
+ProjectionReport<Scalar> project_to_zero_set(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    std::type_identity_t<std::array<std::span<Scalar>, dim>> pos,
+    std::type_identity_t<Scalar> t,
+    const ProjectionOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    return project_to_zero_set(*snapshot, pos, options);
+}
+
+} // namespace stf
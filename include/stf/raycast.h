@@ -0,0 +1,282 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Rays in structure-of-arrays layout.
+ *
+ * Ray k starts at the k-th origin and points along the k-th direction, which need not be
+ * normalized; distances along it are measured in multiples of the direction.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct RayBatch
+{
+    std::array<std::span<const Scalar>, dim> origins; ///< Origin coordinate columns
+    std::array<std::span<const Scalar>, dim> directions; ///< Direction coordinate columns
+
+    size_t size() const { return origins[0].size(); }
+};
+
+/**
+ * @brief Options of the sphere-tracing ray caster.
+ */
+struct RaycastOptions
+{
+    double max_distance = std::numeric_limits<double>::infinity(); ///< Rays stop at this distance
+    double tolerance = 1e-6; ///< A ray hits once the value drops below this
+    size_t max_steps = 256; ///< Rays still marching after this many steps miss
+    /// Factor applied to the sphere-tracing steps, from 1 (plain) to below 2
+    double relaxation = 1.2;
+    /// Lipschitz constant used where the function provides no finite bound
+    double lipschitz = 1;
+    size_t packet_size = 64; ///< Number of consecutive rays marched together
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+};
+
+/**
+ * @brief Hits of a ray batch.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct RaycastResult
+{
+    std::vector<Scalar> distances; ///< Hit distance of each ray, infinite on a miss
+    ColumnBuffer<dim, Scalar> normals; ///< Unit gradient at each hit, NaN on a miss
+    size_t num_evaluations = 0; ///< Number of function and gradient evaluations spent
+
+    explicit RaycastResult(size_t size)
+        : distances(size, std::numeric_limits<Scalar>::infinity())
+        , normals(size)
+    {}
+};
+
+/**
+ * @brief Casts rays against the zero level set of an implicit function by sphere tracing.
+ *
+ * Rays are first clipped to the bounding box of the function. They are then marched in packets
+ * of consecutive rays: each step evaluates the whole packet with `value_batch`, and the
+ * Lipschitz bound over the box around the packet (the node) turns every value into a radius
+ * free of the surface. Steps are over-relaxed by `options.relaxation`; when the sphere at the
+ * new point does not overlap the previous one the step may have skipped the surface, so the ray
+ * steps back and continues unrelaxed. Packets whose value bounds are positive over all their
+ * rays are skipped without evaluation. Normals come from one `gradient_batch` call per packet.
+ *
+ * Packets run in parallel. Rays of one packet should be coherent, e.g. the pixels of an image
+ * tile, which keeps the packet boxes small and their bounds tight.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param rays The rays
+ * @param options The tolerances, step controls, packet size and thread count
+ * @return RaycastResult<dim, Scalar> The hit distances and normals
+ */
+template <int dim, typename Scalar>
+RaycastResult<dim, Scalar> raycast(
+    const ImplicitFunction<dim, Scalar>& f,
+    const std::type_identity_t<RayBatch<dim, Scalar>>& rays,
+    const RaycastOptions& options = {})
+{
+    const size_t n = rays.size();
+    for (int i = 0; i < dim; ++i) {
+        if (rays.origins[i].size() != n || rays.directions[i].size() != n) {
+            throw std::invalid_argument("Ray columns must have the same size");
+        }
+    }
+    if (options.packet_size == 0) throw std::invalid_argument("packet_size must be positive");
+    if (!(options.relaxation >= 1 && options.relaxation < 2)) {
+        throw std::invalid_argument("relaxation must be in [1, 2)");
+    }
+
+    constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+    constexpr Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+    const Scalar tolerance = Scalar(options.tolerance);
+    const Scalar relaxation = Scalar(options.relaxation);
+    const Scalar default_lipschitz = Scalar(options.lipschitz);
+    const auto bounds = f.bounding_box(tolerance);
+
+    RaycastResult<dim, Scalar> result(n);
+    auto normals = result.normals.columns();
+    for (int i = 0; i < dim; ++i) std::fill(normals[i].begin(), normals[i].end(), nan);
+
+    const size_t packet_size = options.packet_size;
+    const size_t num_packets = (n + packet_size - 1) / packet_size;
+    std::vector<size_t> evaluations(num_packets, 0);
+    parallel_for(num_packets, options.num_threads, [&](size_t packet, size_t /*thread*/) {
+        const size_t begin = packet * packet_size;
+        const size_t count = std::min(n, begin + packet_size) - begin;
+
+        struct Ray
+        {
+            size_t index; ///< Index of the ray in the batch
+            Scalar t; ///< Current distance
+            Scalar end; ///< Distance at which the ray leaves the bounding box
+            Scalar scale; ///< Length of the direction
+            Scalar relaxation; ///< Current step factor
+            Scalar previous_t; ///< Distance of the previous evaluation
+            Scalar previous_radius; ///< Surface-free radius there, in distance units
+        };
+
+        // Clip the rays to the bounding box, and gather the box covering the remaining segments.
+        std::vector<Ray> active;
+        auto packet_box = empty_box<dim, Scalar>();
+        for (size_t k = begin; k < begin + count; ++k) {
+            Scalar start = 0;
+            Scalar end = Scalar(options.max_distance);
+            Scalar scale = 0;
+            for (int i = 0; i < dim; ++i) {
+                const Scalar o = rays.origins[i][k];
+                const Scalar d = rays.directions[i][k];
+                scale += d * d;
+                if (d != 0) {
+                    const Scalar a = (bounds[i].lower - o) / d;
+                    const Scalar b = (bounds[i].upper - o) / d;
+                    start = std::max(start, std::min(a, b));
+                    end = std::min(end, std::max(a, b));
+                } else if (!bounds[i].contains(o)) {
+                    end = -inf;
+                }
+            }
+            scale = std::sqrt(scale);
+            if (!(start <= end) || scale == 0) continue;
+            active.push_back({k, start, end, scale, relaxation, nan, 0});
+            for (int i = 0; i < dim; ++i) {
+                const Scalar o = rays.origins[i][k];
+                const Scalar d = rays.directions[i][k];
+                packet_box[i] = hull(packet_box[i], Interval<Scalar>(o + start * d, o + start * d));
+                if (std::isfinite(end)) {
+                    packet_box[i] = hull(packet_box[i], Interval<Scalar>(o + end * d, o + end * d));
+                } else if (d != 0) {
+                    packet_box[i] = hull(packet_box[i], Interval<Scalar>(d > 0 ? inf : -inf));
+                }
+            }
+        }
+        if (active.empty() || f.value_bounds(packet_box).lower >= tolerance) return;
+
+        auto usable = [&](Scalar lipschitz) {
+            return std::isfinite(lipschitz) ? lipschitz : default_lipschitz;
+        };
+        Scalar lipschitz = usable(f.lipschitz_bound(packet_box));
+        if (lipschitz == 0) lipschitz = default_lipschitz;
+
+        std::vector<size_t> hits;
+        ColumnBuffer<dim, Scalar> positions(count);
+        std::vector<Scalar> values(count);
+        for (size_t step = 0; step < options.max_steps && !active.empty(); ++step) {
+            const size_t m = active.size();
+            auto columns = positions.columns();
+            auto node = empty_box<dim, Scalar>();
+            for (size_t j = 0; j < m; ++j) {
+                const auto& ray = active[j];
+                for (int i = 0; i < dim; ++i) {
+                    const Scalar x =
+                        rays.origins[i][ray.index] + ray.t * rays.directions[i][ray.index];
+                    columns[i][j] = x;
+                    node[i] = hull(node[i], Interval<Scalar>(x));
+                }
+            }
+            std::array<std::span<const Scalar>, dim> packet_positions;
+            for (int i = 0; i < dim; ++i) packet_positions[i] = positions.column(i).first(m);
+            f.value_batch(packet_positions, std::span<Scalar>(values).first(m));
+            evaluations[packet] += m;
+
+            // The node covers every sphere computed with the previous bound, so its own bound
+            // holds for radii clamped to its margin.
+            Scalar margin = 0;
+            for (size_t j = 0; j < m; ++j) {
+                margin = std::max(margin, active[j].relaxation * std::abs(values[j]) / lipschitz);
+            }
+            for (int i = 0; i < dim; ++i) node[i] = node[i] + Interval<Scalar>(-margin, margin);
+            const Scalar node_lipschitz = usable(f.lipschitz_bound(node));
+
+            size_t kept = 0;
+            for (size_t j = 0; j < m; ++j) {
+                Ray ray = active[j];
+                const Scalar value = values[j];
+                const Scalar radius = std::min(std::abs(value) / node_lipschitz, margin);
+                if (ray.relaxation > 1 && !std::isnan(ray.previous_t) &&
+                    (value < 0 ||
+                     ray.previous_radius + radius < (ray.t - ray.previous_t) * ray.scale)) {
+                    ray.t = ray.previous_t + ray.previous_radius / ray.scale;
+                    ray.relaxation = 1;
+                    active[kept++] = ray;
+                    continue;
+                }
+                if (value < tolerance) {
+                    result.distances[ray.index] = ray.t;
+                    hits.push_back(ray.index);
+                    continue;
+                }
+                if (ray.t + radius / ray.scale >= ray.end) continue;
+                ray.previous_t = ray.t;
+                ray.previous_radius = radius;
+                ray.t = std::min(ray.t + ray.relaxation * radius / ray.scale, ray.end);
+                active[kept++] = ray;
+            }
+            active.resize(kept);
+            if (node_lipschitz > 0) lipschitz = node_lipschitz;
+        }
+
+        if (!hits.empty()) {
+            const size_t m = hits.size();
+            ColumnBuffer<dim, Scalar> hit_positions(m);
+            ColumnBuffer<dim, Scalar> gradients(m);
+            auto columns = hit_positions.columns();
+            for (size_t j = 0; j < m; ++j) {
+                const size_t k = hits[j];
+                const Scalar t = result.distances[k];
+                for (int i = 0; i < dim; ++i) {
+                    columns[i][j] = rays.origins[i][k] + t * rays.directions[i][k];
+                }
+            }
+            f.gradient_batch(hit_positions.const_columns(), gradients.columns());
+            evaluations[packet] += m;
+            for (size_t j = 0; j < m; ++j) {
+                Scalar norm = 0;
+                for (int i = 0; i < dim; ++i) norm += std::pow(gradients.column(i)[j], 2);
+                norm = std::sqrt(norm);
+                if (norm == 0) continue;
+                for (int i = 0; i < dim; ++i) normals[i][hits[j]] = gradients.column(i)[j] / norm;
+            }
+        }
+    });
+
+    for (size_t count : evaluations) result.num_evaluations += count;
+    return result;
+}
+
+/**
+ * @brief Casts rays against the zero level set of a space-time function at time t.
+ *
+ * @param f The space-time function, which must be safe to evaluate concurrently
+ * @param rays The rays
+ * @param t The time
+ * @param options The tolerances, step controls, packet size and thread count
+ * @return RaycastResult<dim, Scalar> The hit distances and normals
+ */
+template <int dim, typename Scalar>
+RaycastResult<dim, Scalar> raycast(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const std::type_identity_t<RayBatch<dim, Scalar>>& rays,
+    std::type_identity_t<Scalar> t,
+    const RaycastOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    return raycast(*snapshot, rays, options);
+}
+
+} // namespace stf
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Regular grid of sample positions.
+ *
+ * Node (i_0, ..., i_{dim-1}) lies at origin + i * spacing. Nodes are stored with the first axis
+ * varying fastest.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct GridSpec
+{
+    std::array<Scalar, dim> origin{}; ///< Position of the first node
+    std::array<Scalar, dim> spacing{}; ///< Distance between consecutive nodes along each axis
+    std::array<size_t, dim> resolution{}; ///< Number of nodes along each axis
+
+    /**
+     * @brief Grid with nodes on both ends of every interval of a box.
+     *
+     * @param box The box to sample
+     * @param resolution The number of nodes along each axis (a single node sits at the lower end)
+     */
+    static GridSpec
+    from_box(const IntervalBox<dim, Scalar>& box, const std::array<size_t, dim>& resolution)
+    {
+        GridSpec grid;
+        grid.resolution = resolution;
+        for (int i = 0; i < dim; ++i) {
+            grid.origin[i] = box[i].lower;
+            if (resolution[i] > 1) grid.spacing[i] = box[i].width() / (resolution[i] - 1);
+        }
+        return grid;
+    }
+
+    /**
+     * @brief Get the total number of nodes.
+     */
+    size_t size() const
+    {
+        size_t result = 1;
+        for (int i = 0; i < dim; ++i) result *= resolution[i];
+        return result;
+    }
+
+    /**
+     * @brief Get the linear index of a node.
+     */
+    size_t index(const std::array<size_t, dim>& node) const
+    {
+        size_t result = 0;
+        for (int i = dim - 1; i >= 0; --i) result = result * resolution[i] + node[i];
+        return result;
+    }
+
+    /**
+     * @brief Get the node at a linear index.
+     */
+    std::array<size_t, dim> node(size_t index) const
+    {
+        std::array<size_t, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            result[i] = index % resolution[i];
+            index /= resolution[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the position of a node.
+     */
+    std::array<Scalar, dim> position(const std::array<size_t, dim>& node) const
+    {
+        std::array<Scalar, dim> result;
+        for (int i = 0; i < dim; ++i) result[i] = origin[i] + spacing[i] * Scalar(node[i]);
+        return result;
+    }
+};
+
+/**
+ * @brief Options of the grid sampler.
+ */
+struct SampleGridOptions
+{
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+    size_t tile_size = 4096; ///< Number of consecutive nodes evaluated as one batch
+};
+
+/**
+ * @brief Samples an implicit function on a grid.
+ *
+ * The nodes are split into tiles of consecutive nodes, each evaluated as one batch by a pool of
+ * threads and written in place. Every node is computed the same way whatever the thread count,
+ * so the output is deterministic.
+ *
+ * @param f The function to sample, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param values Output receiving one value per node, in grid order
+ * @param gradients Optional output receiving the gradients as `dim` consecutive columns of
+ * `grid.size()` entries; left untouched when empty
+ * @param options The thread count and tile size
+ */
+template <int dim, typename Scalar>
+void sample_grid(
+    const ImplicitFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<std::span<Scalar>> values,
+    std::type_identity_t<std::span<Scalar>> gradients = {},
+    const SampleGridOptions& options = {})
+{
+    const size_t n = grid.size();
+    if (values.size() != n) {
+        throw std::invalid_argument("values must hold one entry per grid node");
+    }
+    if (!gradients.empty() && gradients.size() != dim * n) {
+        throw std::invalid_argument("gradients must hold dim entries per grid node");
+    }
+    if (options.tile_size == 0) {
+        throw std::invalid_argument("tile_size must be positive");
+    }
+
+    const size_t tile_size = options.tile_size;
+    const size_t num_tiles = (n + tile_size - 1) / tile_size;
+    const size_t num_threads = std::min(resolve_thread_count(options.num_threads), num_tiles);
+
+    // Coordinates of the current tile, one buffer per thread.
+    std::vector<ColumnBuffer<dim, Scalar>> scratch;
+    scratch.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) scratch.emplace_back(tile_size);
+
+    parallel_for(num_tiles, num_threads, [&](size_t tile, size_t thread) {
+        const size_t begin = tile * tile_size;
+        const size_t count = std::min(tile_size, n - begin);
+
+        auto columns = scratch[thread].columns();
+        auto node = grid.node(begin);
+        for (size_t k = 0; k < count; ++k) {
+            const auto p = grid.position(node);
+            for (int i = 0; i < dim; ++i) columns[i][k] = p[i];
+            for (int i = 0; i < dim && ++node[i] == grid.resolution[i]; ++i) node[i] = 0;
+        }
+
+        std::array<std::span<const Scalar>, dim> pos;
+        for (int i = 0; i < dim; ++i) pos[i] = scratch[thread].column(i).first(count);
+        f.value_batch(pos, values.subspan(begin, count));
+        if (!gradients.empty()) {
+            std::array<std::span<Scalar>, dim> gradient_columns;
+            for (int i = 0; i < dim; ++i) {
+                gradient_columns[i] = gradients.subspan(i * n + begin, count);
+            }
+            f.gradient_batch(pos, gradient_columns);
+        }
+    });
+}
+
+/**
+ * @brief Samples a space-time function on a grid at a fixed time.
+ *
+ * The function is bound to time t once, so the per-time state of every node of the function
+ * tree (transform matrices, offsets, interpolation weights) is computed once for the whole grid.
+ * The spatial gradients are written as in the implicit overload.
+ *
+ * @param f The function to sample, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param t The time
+ * @param values Output receiving one value per node, in grid order
+ * @param gradients Optional output receiving the spatial gradients
+ * @param options The thread count and tile size
+ */
+template <int dim, typename Scalar>
+void sample_grid(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<Scalar> t,
+    std::type_identity_t<std::span<Scalar>> values,
+    std::type_identity_t<std::span<Scalar>> gradients = {},
+    const SampleGridOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    sample_grid(*snapshot, grid, values, gradients, options);
+}
+
+/**
+ * @brief Samples the values of a space-time function on a grid at a fixed time.
+ *
+ * @param f The function to sample
+ * @param grid The grid
+ * @param t The time
+ * @param options The thread count and tile size
+ * @return std::vector<Scalar> One value per node, in grid order
+ */
+template <int dim, typename Scalar>
+std::vector<Scalar> sample_grid(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<Scalar> t,
+    const SampleGridOptions& options = {})
+{
+    std::vector<Scalar> values(grid.size());
+    sample_grid(f, grid, t, values, {}, options);
+    return values;
+}
+
+/**
+ * @brief One time slab of a space-time grid, passed to the sink of `sample_space_time_grid`.
+ *
+ * The spans are only valid during the sink call.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct GridSlab
+{
+    size_t step; ///< Index of the slab in the list of times
+    Scalar time; ///< Time of the slab
+    std::span<const Scalar> values; ///< One value per grid node, in grid order
+    std::span<const Scalar> gradients; ///< Spatial gradient columns, empty if not requested
+};
+
+/**
+ * @brief Samples a space-time function on a grid at a sequence of times, streaming the slabs.
+ *
+ * Each time slab is sampled with `sample_grid`, which binds the function to the slab time once,
+ * and handed to `sink` as a GridSlab. Only two slabs are held in memory: while the sink consumes
+ * slab k on a separate thread, slab k + 1 is computed. The sink is called once per time, in
+ * order, and never concurrently with itself. An exception thrown by the sink or the function
+ * stops the sampling and is rethrown.
+ *
+ * @param f The function to sample, which must be safe to evaluate concurrently
+ * @param grid The spatial grid
+ * @param times The times of the slabs
+ * @param sink Called with each `const GridSlab<dim, Scalar>&`
+ * @param with_gradients Whether to compute the spatial gradients
+ * @param options The thread count and tile size of each slab
+ */
+template <int dim, typename Scalar, typename Sink>
+void sample_space_time_grid(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<std::span<const Scalar>> times,
+    Sink&& sink,
+    bool with_gradients = false,
+    const SampleGridOptions& options = {})
+{
+    const size_t n = grid.size();
+    std::array<std::vector<Scalar>, 2> values{std::vector<Scalar>(n), std::vector<Scalar>(n)};
+    std::array<std::vector<Scalar>, 2> gradients;
+    if (with_gradients) {
+        for (auto& buffer : gradients) buffer.resize(dim * n);
+    }
+
+    // Slab k uses buffer k % 2, which was last read by the write of slab k - 2. That write is
+    // waited for before slab k - 1 is handed over, so the buffer is free when slab k starts.
+    std::future<void> pending;
+    for (size_t k = 0; k < times.size(); ++k) {
+        const size_t b = k % 2;
+        sample_grid(f, grid, times[k], values[b], gradients[b], options);
+        if (pending.valid()) pending.get();
+        pending = std::async(std::launch::async, [&, k, b]() {
+            sink(GridSlab<dim, Scalar>{k, times[k], values[b], gradients[b]});
+        });
+    }
+    if (pending.valid()) pending.get();
+}
+
+/**
+ * @brief Sink of `sample_space_time_grid` appending each slab to a binary stream.
+ *
+ * The values of each slab are written as raw native-endian scalars, followed by its gradient
+ * columns when present, so the stream holds the 4D array with time varying slowest.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class RawSlabWriter
+{
+public:
+    /**
+     * @brief Constructs a writer appending to a stream, which must outlive the writer.
+     *
+     * @param out The binary output stream
+     */
+    explicit RawSlabWriter(std::ostream& out)
+        : m_out(out)
+    {}
+
+    /**
+     * @brief Writes one slab.
+     *
+     * @param slab The slab to write
+     */
+    void operator()(const GridSlab<dim, Scalar>& slab)
+    {
+        write(slab.values);
+        write(slab.gradients);
+        if (!m_out) {
+            throw std::runtime_error("Failed to write slab " + std::to_string(slab.step));
+        }
+    }
+
+private:
+    void write(std::span<const Scalar> data)
+    {
+        m_out.write(
+            reinterpret_cast<const char*>(data.data()),
+            static_cast<std::streamsize>(data.size_bytes()));
+    }
+
+private:
+    std::ostream& m_out; ///< The output stream
+};
+
+} // namespace stf
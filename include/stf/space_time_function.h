@@ -1,11 +1,36 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
+#include <stf/primitives/implicit_function.h>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <span>
 
 namespace stf {
 
+template <int dim, typename Scalar = stf::Scalar>
+class TimeSnapshot;
+
+/**
+ * @brief Value and space-time gradient of a space-time function at a single point
+ *
+ * @tparam dim The spatial dimension of the function
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct SpaceTimeEvaluation
+{
+    Scalar value; ///< The function value
+
+    /// The spatial gradient followed by the time derivative, as returned by `gradient`
+    std::array<Scalar, dim + 1> gradient;
+};
+
 /**
  * @brief Abstract base class for space-time functions
  *
@@ -14,8 +39,10 @@ namespace stf {
  * derivative, and gradient.
  *
  * @tparam dim The spatial dimension of the function
+ * @tparam Scalar The scalar type used for evaluation (stf::Scalar, i.e. double, by default;
+ * float halves memory traffic)
  */
-template <int dim>
+template <int dim, typename Scalar = stf::Scalar>
 class SpaceTimeFunction
 {
 public:
@@ -53,6 +80,174 @@ public:
      */
     virtual std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const = 0;
 
+    /**
+     * @brief Evaluate the value, spatial gradient and time derivative together
+     *
+     * This is the preferred entry point when all three quantities are needed: implementations
+     * visit each child function and each transform only once. The default implementation calls
+     * `value` and `gradient`.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return SpaceTimeEvaluation<dim, Scalar> The value and the space-time gradient
+     */
+    virtual SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return {value(pos, t), gradient(pos, t)};
+    }
+
+    /**
+     * @brief Compute the second derivatives of the function with respect to space and time
+     *
+     * The Hessian is returned as a (dim+1)x(dim+1) symmetric matrix ordered like `gradient`:
+     * the leading dim x dim block is the spatial Hessian, the last column holds the mixed
+     * derivatives ∂²f/∂x∂t and the last entry is ∂²f/∂t². The default implementation
+     * differentiates `gradient` with central differences.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return std::array<std::array<Scalar, dim + 1>, dim + 1> The space-time Hessian
+     */
+    virtual std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const
+    {
+        return finite_difference_hessian(pos, t);
+    }
+
+    /**
+     * @brief Bound the function values over a space-time box
+     *
+     * The returned interval contains `value(pos, t)` for every position in the box and every
+     * time in the time interval, so a space-time box whose bounds exclude zero cannot intersect
+     * the swept surface. The default implementation returns the whole real line.
+     *
+     * @param box The spatial box, one interval per coordinate
+     * @param t The time interval
+     * @return Interval<Scalar> A conservative range of values over the space-time box
+     */
+    virtual Interval<Scalar> value_bounds(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const
+    {
+        return Interval<Scalar>::entire();
+    }
+
+    /**
+     * @brief Bound the rates of change of the function over a space-time box
+     *
+     * The spatial constant bounds the norm of the spatial gradient and the temporal constant
+     * bounds the magnitude of the time derivative, so that |f(x, t) - f(y, s)| is at most
+     * spatial * |x - y| + temporal * |t - s| within the box. The default implementation returns
+     * infinite constants.
+     *
+     * @param box The spatial box, one interval per coordinate
+     * @param t The time interval
+     * @return LipschitzBound<Scalar> The Lipschitz constants over the space-time box
+     */
+    virtual LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const
+    {
+        return LipschitzBound<Scalar>::unbounded();
+    }
+
+    /**
+     * @brief Bound the region swept by the zero set over a time range
+     *
+     * The returned box contains every position whose value is at most `level` at some time in
+     * [t0, t1]; with the default level it contains the swept surface and its interior. The
+     * default implementation returns the whole space.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the swept sublevel set, possibly empty
+     */
+    virtual IntervalBox<dim, Scalar>
+    bounding_box(Scalar /*t0*/, Scalar /*t1*/, Scalar /*level*/ = 0) const
+    {
+        return entire_box<dim, Scalar>();
+    }
+
+public:
+    /**
+     * @brief Evaluate the function at a batch of space-time points
+     *
+     * Points are given in structure-of-arrays layout: `pos[i][k]` is the i-th coordinate of the
+     * k-th point and `t[k]` is its time. The default implementation calls `value` once per point;
+     * subclasses override it to amortize dispatch over the whole batch.
+     *
+     * @param pos The spatial coordinate columns, one span per dimension
+     * @param t The time column
+     * @param values Output span receiving one function value per point
+     */
+    virtual void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const
+    {
+        assert(t.size() == values.size());
+        for (size_t k = 0; k < t.size(); ++k) {
+            values[k] = value(gather(pos, k), t[k]);
+        }
+    }
+
+    /**
+     * @brief Compute the time derivative at a batch of space-time points
+     *
+     * @param pos The spatial coordinate columns, one span per dimension
+     * @param t The time column
+     * @param time_derivatives Output span receiving one time derivative per point
+     */
+    virtual void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const
+    {
+        assert(t.size() == time_derivatives.size());
+        for (size_t k = 0; k < t.size(); ++k) {
+            time_derivatives[k] = time_derivative(gather(pos, k), t[k]);
+        }
+    }
+
+    /**
+     * @brief Compute the space-time gradient at a batch of space-time points
+     *
+     * @param pos The spatial coordinate columns, one span per dimension
+     * @param t The time column
+     * @param gradients Output columns, one span per gradient component. The first dim columns
+     * receive the spatial gradient and the last one the time derivative.
+     */
+    virtual void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            auto grad = gradient(gather(pos, k), t[k]);
+            for (int i = 0; i <= dim; ++i) gradients[i][k] = grad[i];
+        }
+    }
+
+public:
+    /**
+     * @brief Freeze the function at time t
+     *
+     * Returns a spatial function x -> f(x, t) in which every time-dependent quantity (affine
+     * maps of transforms, offsets, interpolation weights) has been computed once, so evaluating
+     * many points at the same time reduces to spatial math. The snapshot refers to the children
+     * of this function and must not outlive it. The default implementation forwards each query
+     * to this function with the bound time.
+     *
+     * @param t The time value
+     * @return std::unique_ptr<ImplicitFunction<dim, Scalar>> The spatial snapshot at time t
+     */
+    virtual std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const
+    {
+        return std::make_unique<TimeSnapshot<dim, Scalar>>(*this, t);
+    }
+
 public:
     /**
      * @brief Compute the gradient using finite differences
@@ -82,6 +277,143 @@ public:
         grad[dim] = (time_plus - time_minus) / (2 * delta);
         return grad;
     }
+
+    /**
+     * @brief Compute the space-time Hessian using finite differences
+     *
+     * Each column is the central difference of `gradient` along one space-time axis; the result
+     * is symmetrized. The step along each axis is ∛ε scaled by max(1, |x|), where x is the
+     * coordinate being perturbed.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return std::array<std::array<Scalar, dim + 1>, dim + 1> The space-time Hessian
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> finite_difference_hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const
+    {
+        const Scalar step = std::cbrt(std::numeric_limits<Scalar>::epsilon());
+        std::array<std::array<Scalar, dim + 1>, dim + 1> H{};
+        for (int j = 0; j <= dim; ++j) {
+            std::array<Scalar, dim> pos_plus = pos;
+            std::array<Scalar, dim> pos_minus = pos;
+            Scalar t_plus = t;
+            Scalar t_minus = t;
+            const Scalar delta = step * std::max(Scalar(1), std::abs(j < dim ? pos[j] : t));
+            if (j < dim) {
+                pos_plus[j] += delta;
+                pos_minus[j] -= delta;
+            } else {
+                t_plus += delta;
+                t_minus -= delta;
+            }
+            const auto grad_plus = gradient(pos_plus, t_plus);
+            const auto grad_minus = gradient(pos_minus, t_minus);
+            for (int i = 0; i <= dim; ++i) H[i][j] = (grad_plus[i] - grad_minus[i]) / (2 * delta);
+        }
+        for (int i = 0; i <= dim; ++i) {
+            for (int j = 0; j < i; ++j) H[i][j] = H[j][i] = (H[i][j] + H[j][i]) / 2;
+        }
+        return H;
+    }
+};
+
+/**
+ * @brief Generic snapshot of a space-time function at a fixed time
+ *
+ * Forwards every query to the space-time function with the bound time. This is the fallback
+ * returned by SpaceTimeFunction::bind_time when a function has nothing to precompute.
+ *
+ * @tparam dim The spatial dimension of the function
+ */
+template <int dim, typename Scalar>
+class TimeSnapshot : public ImplicitFunction<dim, Scalar>
+{
+public:
+    /**
+     * @brief Construct a snapshot of a space-time function
+     *
+     * @param f The space-time function, which must outlive the snapshot
+     * @param t The bound time
+     */
+    TimeSnapshot(const SpaceTimeFunction<dim, Scalar>& f, Scalar t)
+        : m_f(f)
+        , m_t(t)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override { return m_f.value(pos, m_t); }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return TimeSnapshot::evaluate(pos).gradient;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto e = m_f.evaluate(pos, m_t);
+        ImplicitEvaluation<dim, Scalar> result{e.value, {}};
+        for (int i = 0; i < dim; ++i) result.gradient[i] = e.gradient[i];
+        return result;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        const auto H = m_f.hessian(pos, m_t);
+        std::array<std::array<Scalar, dim>, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) result[i][j] = H[i][j];
+        }
+        return result;
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f.value_bounds(box, m_t);
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f.lipschitz_bound(box, m_t).spatial;
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        return m_f.bounding_box(m_t, m_t, level);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<1, Scalar> t(values.size());
+        std::fill(t.column(0).begin(), t.column(0).end(), m_t);
+        m_f.value_batch(pos, t.column(0), values);
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        const size_t n = gradients[0].size();
+        ColumnBuffer<2, Scalar> scratch(n);
+        const auto columns = scratch.columns();
+        std::fill(columns[0].begin(), columns[0].end(), m_t);
+
+        std::array<std::span<Scalar>, dim + 1> space_time_gradients;
+        for (int i = 0; i < dim; ++i) space_time_gradients[i] = gradients[i];
+        space_time_gradients[dim] = columns[1];
+        m_f.gradient_batch(pos, columns[0], space_time_gradients);
+    }
+
+    /**
+     * @brief Get the bound time.
+     */
+    Scalar time() const { return m_t; }
+
+private:
+    const SpaceTimeFunction<dim, Scalar>& m_f;
+    Scalar m_t;
 };
 
 } // namespace stf
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/sample_grid.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Values of a function on the blocks of a grid near its zero level set.
+ *
+ * The grid is split into cubic blocks of `block_size` nodes per axis. Only some blocks are stored,
+ * each as `block_nodes()` consecutive values with the first axis varying fastest. Blocks crossing
+ * the end of the grid hold NaN at the nodes beyond it.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct SparseGrid
+{
+    GridSpec<dim, Scalar> grid; ///< The underlying dense grid
+    size_t block_size = 8; ///< Number of nodes per block along each axis
+    std::vector<size_t> blocks; ///< Linear indices of the stored blocks, in increasing order
+    std::vector<Scalar> values; ///< The values of the stored blocks, one block after another
+    size_t num_evaluations = 0; ///< Function evaluations spent, including culling probes
+
+    /**
+     * @brief Get the number of blocks along each axis.
+     */
+    std::array<size_t, dim> block_counts() const
+    {
+        std::array<size_t, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            result[i] = (grid.resolution[i] + block_size - 1) / block_size;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the number of nodes of a block.
+     */
+    size_t block_nodes() const
+    {
+        size_t result = 1;
+        for (int i = 0; i < dim; ++i) result *= block_size;
+        return result;
+    }
+
+    /**
+     * @brief Get the first grid node of the k-th stored block.
+     */
+    std::array<size_t, dim> block_origin(size_t k) const
+    {
+        const auto counts = block_counts();
+        std::array<size_t, dim> result;
+        size_t index = blocks[k];
+        for (int i = 0; i < dim; ++i) {
+            result[i] = (index % counts[i]) * block_size;
+            index /= counts[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Find the value at a grid node.
+     *
+     * @param node The grid node
+     * @return const Scalar* The stored value, or nullptr if the block of the node is not stored
+     */
+    const Scalar* find(const std::array<size_t, dim>& node) const
+    {
+        const auto counts = block_counts();
+        size_t block = 0;
+        size_t local = 0;
+        for (int i = dim - 1; i >= 0; --i) {
+            block = block * counts[i] + node[i] / block_size;
+            local = local * block_size + node[i] % block_size;
+        }
+        auto it = std::lower_bound(blocks.begin(), blocks.end(), block);
+        if (it == blocks.end() || *it != block) return nullptr;
+        return values.data() + size_t(it - blocks.begin()) * block_nodes() + local;
+    }
+
+    /**
+     * @brief Get the number of evaluations a dense sampling of the grid would have spent.
+     */
+    size_t dense_evaluations() const { return grid.size(); }
+
+    /**
+     * @brief Get the number of evaluations saved compared to dense sampling.
+     */
+    size_t saved_evaluations() const
+    {
+        return num_evaluations < grid.size() ? grid.size() - num_evaluations : 0;
+    }
+};
+
+/**
+ * @brief Blocks kept by `cull_blocks`.
+ */
+struct BlockCulling
+{
+    std::vector<size_t> blocks; ///< Linear indices of the kept blocks, in increasing order
+    size_t num_probes = 0; ///< Function evaluations spent on Lipschitz probes
+};
+
+/**
+ * @brief Finds the blocks of a block grid over which a function may come within a band of zero.
+ *
+ * The block grid is subdivided like an octree. A cell is dropped when the value bounds over its
+ * box exclude [-band, band]. When they do not but the function has a finite Lipschitz bound, the
+ * value at the center of the box is probed to tighten them. Cells reduced to a single block are
+ * kept. The cells of each level are classified in parallel.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param counts The number of blocks along each axis, first axis fastest in block indices
+ * @param band The half-width of the band of values to capture
+ * @param num_threads The number of threads (0 for one per hardware thread)
+ * @param block_box Called as `block_box(lower, upper)`, returns the box covered by the blocks
+ * in [lower, upper)
+ * @return BlockCulling The kept blocks and the number of probes
+ */
+template <int dim, typename Scalar, typename BlockBox>
+BlockCulling cull_blocks(
+    const ImplicitFunction<dim, Scalar>& f,
+    const std::type_identity_t<std::array<size_t, dim>>& counts,
+    std::type_identity_t<Scalar> band,
+    size_t num_threads,
+    BlockBox&& block_box)
+{
+    BlockCulling result;
+    for (int i = 0; i < dim; ++i) {
+        if (counts[i] == 0) return result;
+    }
+
+    // A cell is a range [lower, upper) of blocks along each axis.
+    struct Cell
+    {
+        std::array<size_t, dim> lower;
+        std::array<size_t, dim> upper;
+    };
+
+    // Returns the number of probes spent and sets `keep`.
+    auto classify = [&](const Cell& cell, bool& keep) -> size_t {
+        const auto box = block_box(cell.lower, cell.upper);
+        auto bounds = f.value_bounds(box);
+        auto excluded = [&]() { return bounds.lower > band || bounds.upper < -band; };
+        keep = !excluded();
+        if (!keep) return 0;
+
+        const Scalar lipschitz = f.lipschitz_bound(box);
+        if (!std::isfinite(lipschitz)) return 0;
+        const Scalar center = f.value(box_center(box));
+        const Scalar reach = lipschitz * box_radius(box);
+        bounds.lower = std::max(bounds.lower, center - reach);
+        bounds.upper = std::min(bounds.upper, center + reach);
+        keep = !excluded();
+        return 1;
+    };
+
+    Cell root;
+    for (int i = 0; i < dim; ++i) {
+        root.lower[i] = 0;
+        root.upper[i] = counts[i];
+    }
+
+    // Breadth-first subdivision, one parallel pass per level.
+    std::vector<Cell> cells{root};
+    std::vector<char> keep;
+    std::vector<size_t> probes;
+    while (!cells.empty()) {
+        keep.assign(cells.size(), 0);
+        probes.assign(cells.size(), 0);
+        parallel_for(cells.size(), num_threads, [&](size_t k, size_t /*thread*/) {
+            bool kept = false;
+            probes[k] = classify(cells[k], kept);
+            keep[k] = kept;
+        });
+
+        std::vector<Cell> children;
+        for (size_t k = 0; k < cells.size(); ++k) {
+            result.num_probes += probes[k];
+            if (!keep[k]) continue;
+
+            const auto& cell = cells[k];
+            bool single = true;
+            for (int i = 0; i < dim; ++i) single = single && cell.upper[i] - cell.lower[i] == 1;
+            if (single) {
+                size_t index = 0;
+                for (int i = dim - 1; i >= 0; --i) index = index * counts[i] + cell.lower[i];
+                result.blocks.push_back(index);
+                continue;
+            }
+
+            // Halve every axis spanning several blocks.
+            for (size_t corner = 0; corner < (size_t(1) << dim); ++corner) {
+                Cell child = cell;
+                bool valid = true;
+                for (int i = 0; i < dim; ++i) {
+                    const size_t middle = cell.lower[i] + (cell.upper[i] - cell.lower[i]) / 2;
+                    const bool upper_half = (corner >> i) & 1;
+                    if (cell.upper[i] - cell.lower[i] == 1) {
+                        valid = valid && !upper_half;
+                    } else if (upper_half) {
+                        child.lower[i] = middle;
+                    } else {
+                        child.upper[i] = middle;
+                    }
+                }
+                if (valid) children.push_back(child);
+            }
+        }
+        cells = std::move(children);
+    }
+    std::sort(result.blocks.begin(), result.blocks.end());
+    return result;
+}
+
+/**
+ * @brief Options of the narrow-band sampler.
+ */
+struct NarrowBandOptions
+{
+    size_t block_size = 8; ///< Number of nodes per block along each axis
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+};
+
+/**
+ * @brief Samples an implicit function on the blocks of a grid that may come within a band of
+ * its zero level set.
+ *
+ * The blocks are selected by `cull_blocks` from the bounds over the box of their nodes, then
+ * sampled in full in parallel, one batch per block. Every node whose value lies within the band
+ * is thus stored, along with the other nodes of its block. The result does not depend on the
+ * thread count.
+ *
+ * Functions without bounds keep every block and cost slightly more than dense sampling.
+ *
+ * @param f The function to sample, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param band The half-width of the band of values to capture
+ * @param options The block size and thread count
+ * @return SparseGrid<dim, Scalar> The stored blocks and the evaluation count
+ */
+template <int dim, typename Scalar>
+SparseGrid<dim, Scalar> sample_narrow_band(
+    const ImplicitFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<Scalar> band,
+    const NarrowBandOptions& options = {})
+{
+    if (options.block_size == 0) {
+        throw std::invalid_argument("block_size must be positive");
+    }
+    if (!(band >= 0)) {
+        throw std::invalid_argument("band must be non-negative");
+    }
+
+    SparseGrid<dim, Scalar> result;
+    result.grid = grid;
+    result.block_size = options.block_size;
+    if (grid.size() == 0) return result;
+
+    const size_t block_size = options.block_size;
+    const auto counts = result.block_counts();
+    const size_t num_threads = resolve_thread_count(options.num_threads);
+
+    auto block_box = [&](const std::array<size_t, dim>& lower,
+                         const std::array<size_t, dim>& upper) {
+        IntervalBox<dim, Scalar> box;
+        for (int i = 0; i < dim; ++i) {
+            std::array<size_t, dim> first{}, last{};
+            first[i] = lower[i] * block_size;
+            last[i] = std::min(upper[i] * block_size, grid.resolution[i]) - 1;
+            box[i] = Interval<Scalar>(grid.position(first)[i], grid.position(last)[i]);
+        }
+        return box;
+    };
+    auto culling = cull_blocks(f, counts, band, num_threads, block_box);
+    result.blocks = std::move(culling.blocks);
+    result.num_evaluations = culling.num_probes;
+
+    // Sample the kept blocks, one batch per block.
+    const size_t block_nodes = result.block_nodes();
+    result.values.assign(
+        result.blocks.size() * block_nodes,
+        std::numeric_limits<Scalar>::quiet_NaN());
+    std::vector<size_t> evaluated(result.blocks.size(), 0);
+    const size_t block_threads = std::min(num_threads, std::max<size_t>(result.blocks.size(), 1));
+    std::vector<ColumnBuffer<dim, Scalar>> scratch;
+    std::vector<std::vector<Scalar>> block_values(block_threads);
+    std::vector<std::vector<size_t>> slots(block_threads);
+    scratch.reserve(block_threads);
+    for (size_t i = 0; i < block_threads; ++i) scratch.emplace_back(block_nodes);
+
+    parallel_for(result.blocks.size(), block_threads, [&](size_t k, size_t thread) {
+        const auto origin = result.block_origin(k);
+        auto columns = scratch[thread].columns();
+        auto& slot = slots[thread];
+        slot.clear();
+
+        std::array<size_t, dim> local{};
+        for (size_t j = 0; j < block_nodes; ++j) {
+            std::array<size_t, dim> node;
+            bool inside = true;
+            for (int i = 0; i < dim; ++i) {
+                node[i] = origin[i] + local[i];
+                inside = inside && node[i] < grid.resolution[i];
+            }
+            if (inside) {
+                const auto p = grid.position(node);
+                for (int i = 0; i < dim; ++i) columns[i][slot.size()] = p[i];
+                slot.push_back(j);
+            }
+            for (int i = 0; i < dim && ++local[i] == block_size; ++i) local[i] = 0;
+        }
+
+        const size_t count = slot.size();
+        std::array<std::span<const Scalar>, dim> pos;
+        for (int i = 0; i < dim; ++i) pos[i] = scratch[thread].column(i).first(count);
+        auto& buffer = block_values[thread];
+        buffer.resize(count);
+        f.value_batch(pos, buffer);
+
+        Scalar* out = result.values.data() + k * block_nodes;
+        for (size_t j = 0; j < count; ++j) out[slot[j]] = buffer[j];
+        evaluated[k] = count;
+    });
+    for (size_t count : evaluated) result.num_evaluations += count;
+
+    return result;
+}
+
+/**
+ * @brief Samples a space-time function at a fixed time on the blocks of a grid near its zero
+ * level set.
+ *
+ * The function is bound to time t once, and its snapshot provides the bounds used for culling.
+ *
+ * @param f The function to sample, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param t The time
+ * @param band The half-width of the band of values to capture
+ * @param options The block size and thread count
+ * @return SparseGrid<dim, Scalar> The stored blocks and the evaluation count
+ */
+template <int dim, typename Scalar>
+SparseGrid<dim, Scalar> sample_narrow_band(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<Scalar> t,
+    std::type_identity_t<Scalar> band,
+    const NarrowBandOptions& options = {})
+{
+    const auto snapshot = f.bind_time(t);
+    return sample_narrow_band(*snapshot, grid, band, options);
+}
+
+} // namespace stf
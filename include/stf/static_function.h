@@ -0,0 +1,802 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/space_time_function.h>
+#include <stf/sweep_function.h>
+#include <stf/transforms/transform.h>
+#include <stf/union_function.h>
+
+#include <array>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace stf {
+
+/*
+ * Compile-time composition of statically known function graphs.
+ *
+ * The classes in this file mirror SweepFunction, Compose and UnionFunction, but hold their
+ * operands by value and with their concrete types. Every call into an operand is qualified with
+ * the operand type, so no virtual dispatch happens inside the graph and the compiler is free to
+ * inline the whole evaluation:
+ *
+ * @code
+ * stf::ImplicitBall<3> ball(0.2, {0, 0, 0});
+ * stf::Translation<3> translate({1, 0, 0});
+ * stf::Rotation<3> rotate({0, 0, 0}, {0, 0, 1}, 90);
+ *
+ * auto sweep = stf::make_sweep(ball, stf::compose(translate, rotate));
+ * Scalar v = sweep.value({0.5, 0, 0}, 0.5);
+ *
+ * // Type-erased view usable wherever a SpaceTimeFunction is expected.
+ * auto fn = stf::make_function(sweep);
+ * @endcode
+ *
+ * Operands are copied, so later changes to the original objects are not observed.
+ */
+
+/**
+ * @brief Spatial dimension of an implicit function, a transform or a static node.
+ */
+template <int dim, typename Scalar>
+constexpr int static_dimension_of(const ImplicitFunction<dim, Scalar>*)
+{
+    return dim;
+}
+
+template <int dim, typename Scalar>
+constexpr int static_dimension_of(const Transform<dim, Scalar>*)
+{
+    return dim;
+}
+
+template <typename T>
+    requires requires { T::dim; }
+constexpr int static_dimension_of(const T*)
+{
+    return T::dim;
+}
+
+template <typename T>
+inline constexpr int static_dimension_v =
+    static_dimension_of(static_cast<const std::remove_cvref_t<T>*>(nullptr));
+
+/**
+ * @brief Scalar type of an implicit function, a transform or a static node.
+ */
+template <int dim, typename Scalar>
+Scalar static_scalar_of(const ImplicitFunction<dim, Scalar>*);
+
+template <int dim, typename Scalar>
+Scalar static_scalar_of(const Transform<dim, Scalar>*);
+
+template <typename T>
+    requires requires { typename T::Scalar; }
+typename T::Scalar static_scalar_of(const T*);
+
+template <typename T>
+using static_scalar_t =
+    decltype(static_scalar_of(static_cast<const std::remove_cvref_t<T>*>(nullptr)));
+
+/**
+ * @brief Composition of two transforms with concrete types, applying T1 and then T2.
+ *
+ * @tparam T1 The first transform type
+ * @tparam T2 The second transform type
+ */
+template <typename T1, typename T2>
+class StaticCompose
+{
+public:
+    using Scalar = static_scalar_t<T1>;
+    static constexpr int dim = static_dimension_v<T1>;
+    static_assert(dim == static_dimension_v<T2>, "Transforms must share a dimension");
+    static_assert(
+        std::is_same_v<Scalar, static_scalar_t<T2>>,
+        "Transforms must share a scalar type");
+
+    StaticCompose(T1 transform1, T2 transform2)
+        : m_transform1(std::move(transform1))
+        , m_transform2(std::move(transform2))
+    {}
+
+    std::array<Scalar, dim> transform(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return m_transform2.T2::transform(m_transform1.T1::transform(pos, t), t);
+    }
+
+    std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return evaluate(pos, t).velocity;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> position_Jacobian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const
+    {
+        return evaluate(pos, t).jacobian;
+    }
+
+    /**
+     * @brief Evaluates position, velocity and Jacobian of the composition in one pass.
+     */
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        const auto e1 = m_transform1.T1::evaluate(pos, t);
+        const auto e2 = m_transform2.T2::evaluate(e1.position, t);
+
+        TransformEvaluation<dim, Scalar> result{e2.position, e2.velocity, {}};
+        for (int i = 0; i < dim; ++i) {
+            // velocity = v2 + J2 * v1
+            for (int k = 0; k < dim; ++k) result.velocity[i] += e2.jacobian[i][k] * e1.velocity[k];
+
+            // Jacobian = J2 * J1
+            for (int j = 0; j < dim; ++j) {
+                Scalar sum = 0;
+                for (int k = 0; k < dim; ++k) sum += e2.jacobian[i][k] * e1.jacobian[k][j];
+                result.jacobian[i][j] = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the second derivatives of the composition, as Compose::hessian.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        const auto e1 = m_transform1.T1::evaluate(pos, t);
+        const auto e2 = m_transform2.T2::evaluate(e1.position, t);
+        const auto H1 = m_transform1.T1::hessian(pos, t);
+        const auto H2 = m_transform2.T2::hessian(e1.position, t);
+
+        std::array<std::array<Scalar, dim + 1>, dim + 1> A1{};
+        for (int p = 0; p < dim; ++p) {
+            for (int a = 0; a < dim; ++a) A1[p][a] = e1.jacobian[p][a];
+            A1[p][dim] = e1.velocity[p];
+        }
+        A1[dim][dim] = 1;
+
+        TransformHessian<dim, Scalar> H{};
+        for (int i = 0; i < dim; ++i) {
+            // M = H2_i A1
+            std::array<std::array<Scalar, dim + 1>, dim + 1> M{};
+            for (int p = 0; p <= dim; ++p) {
+                for (int b = 0; b <= dim; ++b) {
+                    for (int q = 0; q <= dim; ++q) M[p][b] += H2[i][p][q] * A1[q][b];
+                }
+            }
+            for (int a = 0; a <= dim; ++a) {
+                for (int b = 0; b <= dim; ++b) {
+                    Scalar sum = 0;
+                    for (int p = 0; p <= dim; ++p) sum += A1[p][a] * M[p][b];
+                    for (int k = 0; k < dim; ++k) sum += e2.jacobian[i][k] * H1[k][a][b];
+                    H[i][a][b] = sum;
+                }
+            }
+        }
+        return H;
+    }
+
+    /**
+     * @brief Bounds the composition by bounding T2 over the bounds of T1.
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const
+    {
+        return m_transform2.T2::transform_bounds(m_transform1.T1::transform_bounds(box, t), t);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the composition, as Compose::lipschitz_bound.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const
+    {
+        const auto L1 = m_transform1.T1::lipschitz_bound(box, t);
+        const auto L2 =
+            m_transform2.T2::lipschitz_bound(m_transform1.T1::transform_bounds(box, t), t);
+        return {
+            lipschitz_product(L2.spatial, L1.spatial),
+            L2.temporal + lipschitz_product(L2.spatial, L1.temporal)};
+    }
+
+    /**
+     * @brief Pulls a box back through both transforms, as Compose::inverse_transform_bounds.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const
+    {
+        return m_transform1.T1::inverse_transform_bounds(
+            m_transform2.T2::inverse_transform_bounds(box, t),
+            t);
+    }
+
+    /**
+     * @brief Whether both transforms are affine in position.
+     */
+    bool is_affine() const { return m_transform1.T1::is_affine() && m_transform2.T2::is_affine(); }
+
+    /**
+     * @brief Freezes the composition at time t, as Transform::affine_map.
+     *
+     * @throws std::runtime_error If the composition is not affine
+     */
+    AffineMap<dim, Scalar> affine_map(Scalar t) const
+    {
+        if (!is_affine()) {
+            throw std::runtime_error("Transform is not affine in position");
+        }
+        const auto e = evaluate({}, t);
+        return {e.jacobian, e.position};
+    }
+
+    /**
+     * @brief Get the first transform.
+     */
+    const T1& first() const { return m_transform1; }
+
+    /**
+     * @brief Get the second transform.
+     */
+    const T2& second() const { return m_transform2; }
+
+private:
+    T1 m_transform1;
+    T2 m_transform2;
+};
+
+/**
+ * @brief Generic snapshot of a static node at a fixed time, as TimeSnapshot.
+ *
+ * Forwards every query to the node with the bound time. Static nodes return it from `bind_time`
+ * when they have nothing to precompute.
+ *
+ * @tparam Node The static node type
+ */
+template <typename Node>
+class StaticSnapshot : public ImplicitFunction<Node::dim, typename Node::Scalar>
+{
+public:
+    using Scalar = typename Node::Scalar;
+    static constexpr int dim = Node::dim;
+
+    /**
+     * @brief Construct a snapshot of a static node
+     *
+     * @param node The static node, which must outlive the snapshot
+     * @param t The bound time
+     */
+    StaticSnapshot(const Node& node, Scalar t)
+        : m_node(node)
+        , m_t(t)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        return m_node.Node::value(pos, m_t);
+    }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return StaticSnapshot::evaluate(pos).gradient;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto e = m_node.Node::evaluate(pos, m_t);
+        ImplicitEvaluation<dim, Scalar> result{e.value, {}};
+        for (int i = 0; i < dim; ++i) result.gradient[i] = e.gradient[i];
+        return result;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        const auto H = m_node.Node::hessian(pos, m_t);
+        std::array<std::array<Scalar, dim>, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) result[i][j] = H[i][j];
+        }
+        return result;
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_node.Node::value_bounds(box, m_t);
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_node.Node::lipschitz_bound(box, m_t).spatial;
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        return m_node.Node::bounding_box(m_t, m_t, level);
+    }
+
+private:
+    const Node& m_node;
+    Scalar m_t;
+};
+
+/**
+ * @brief Sweep of an implicit function by a transform, both with concrete types.
+ *
+ * Computes F(x, t) = f(T(x, t)) exactly like SweepFunction.
+ *
+ * @tparam Primitive The implicit function type
+ * @tparam Motion The transform type
+ */
+template <typename Primitive, typename Motion>
+class StaticSweep
+{
+public:
+    using Scalar = static_scalar_t<Primitive>;
+    static constexpr int dim = static_dimension_v<Primitive>;
+    static_assert(dim == static_dimension_v<Motion>, "Operands must share a dimension");
+    static_assert(
+        std::is_same_v<Scalar, static_scalar_t<Motion>>,
+        "Operands must share a scalar type");
+
+    StaticSweep(Primitive implicit_function, Motion transform)
+        : m_implicit_function(std::move(implicit_function))
+        , m_transform(std::move(transform))
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return m_implicit_function.Primitive::value(m_transform.Motion::transform(pos, t));
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return evaluate(pos, t).gradient[dim];
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return evaluate(pos, t).gradient;
+    }
+
+    /**
+     * @brief Evaluates the value and the space-time gradient in one pass.
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        const auto T = m_transform.Motion::evaluate(pos, t);
+        const auto f = m_implicit_function.Primitive::evaluate(T.position);
+
+        SpaceTimeEvaluation<dim, Scalar> result{f.value, {}};
+
+        /* spatial part  ∇_x F = Jᵀ ∇f */
+        for (int i = 0; i < dim; ++i) {
+            Scalar sum = 0;
+            for (int k = 0; k < dim; ++k) sum += T.jacobian[k][i] * f.gradient[k];
+            result.gradient[i] = sum;
+        }
+
+        /* time component  ∂F/∂t = ∇f · ∂T/∂t */
+        Scalar dt = 0;
+        for (int i = 0; i < dim; ++i) dt += f.gradient[i] * T.velocity[i];
+        result.gradient[dim] = dt;
+
+        return result;
+    }
+
+    /**
+     * @brief Computes the space-time Hessian, as SweepFunction::hessian.
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const
+    {
+        const auto T = m_transform.Motion::evaluate(pos, t);
+        const auto HT = m_transform.Motion::hessian(pos, t);
+        const auto g = m_implicit_function.Primitive::gradient(T.position);
+        const auto Hf = m_implicit_function.Primitive::hessian(T.position);
+
+        std::array<std::array<Scalar, dim + 1>, dim> D;
+        for (int p = 0; p < dim; ++p) {
+            for (int a = 0; a < dim; ++a) D[p][a] = T.jacobian[p][a];
+            D[p][dim] = T.velocity[p];
+        }
+
+        // M = H_f D
+        std::array<std::array<Scalar, dim + 1>, dim> M{};
+        for (int p = 0; p < dim; ++p) {
+            for (int b = 0; b <= dim; ++b) {
+                for (int q = 0; q < dim; ++q) M[p][b] += Hf[p][q] * D[q][b];
+            }
+        }
+
+        std::array<std::array<Scalar, dim + 1>, dim + 1> result;
+        for (int a = 0; a <= dim; ++a) {
+            for (int b = 0; b <= dim; ++b) {
+                Scalar sum = 0;
+                for (int p = 0; p < dim; ++p) sum += D[p][a] * M[p][b] + g[p] * HT[p][a][b];
+                result[a][b] = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the sweep over a space-time box, as SweepFunction::value_bounds.
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t) const
+    {
+        return m_implicit_function.Primitive::value_bounds(
+            m_transform.Motion::transform_bounds(box, t));
+    }
+
+    /**
+     * @brief Bounds the rates of change of the sweep, as SweepFunction::lipschitz_bound.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const
+    {
+        const Scalar Lf = m_implicit_function.Primitive::lipschitz_bound(
+            m_transform.Motion::transform_bounds(box, t));
+        const auto LT = m_transform.Motion::lipschitz_bound(box, t);
+        return {lipschitz_product(Lf, LT.spatial), lipschitz_product(Lf, LT.temporal)};
+    }
+
+    /**
+     * @brief Bounds the swept region, as SweepFunction::bounding_box.
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const
+    {
+        const auto local = m_implicit_function.Primitive::bounding_box(level);
+        if (is_empty(local)) return local;
+        return m_transform.Motion::inverse_transform_bounds(local, {t0, t1});
+    }
+
+    /**
+     * @brief Freezes the sweep at time t, as SweepFunction::bind_time.
+     *
+     * Affine transforms are frozen into a SweepSnapshot; other transforms fall back to a
+     * StaticSnapshot.
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const
+    {
+        if (!m_transform.Motion::is_affine()) {
+            return std::make_unique<StaticSnapshot<StaticSweep>>(*this, t);
+        }
+        return std::make_unique<SweepSnapshot<dim, Scalar>>(
+            m_implicit_function,
+            m_transform.Motion::affine_map(t));
+    }
+
+    /**
+     * @brief Get the implicit function being swept.
+     */
+    const Primitive& implicit_function() const { return m_implicit_function; }
+
+    /**
+     * @brief Get the transformation applied to the implicit function.
+     */
+    const Motion& transform() const { return m_transform; }
+
+private:
+    Primitive m_implicit_function;
+    Motion m_transform;
+};
+
+/**
+ * @brief Union of two static space-time nodes, sharp or smooth as in UnionFunction.
+ *
+ * @tparam F1 The first operand type
+ * @tparam F2 The second operand type
+ */
+template <typename F1, typename F2>
+class StaticUnion
+{
+public:
+    using Scalar = static_scalar_t<F1>;
+    static constexpr int dim = static_dimension_v<F1>;
+    static_assert(dim == static_dimension_v<F2>, "Operands must share a dimension");
+    static_assert(std::is_same_v<Scalar, static_scalar_t<F2>>, "Operands must share a scalar type");
+
+private:
+    using Union = UnionFunction<dim, Scalar>;
+
+public:
+    StaticUnion(F1 f1, F2 f2, Scalar smooth_distance = 0)
+        : m_f1(std::move(f1))
+        , m_f2(std::move(f2))
+        , m_smooth_distance(smooth_distance)
+    {
+        if (smooth_distance < 0) {
+            throw std::invalid_argument("smooth_distance must be non-negative");
+        }
+    }
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return Union::blend_value(
+            m_f1.F1::value(pos, t),
+            m_f2.F2::value(pos, t),
+            m_smooth_distance);
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return evaluate(pos, t).gradient[dim];
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return evaluate(pos, t).gradient;
+    }
+
+    /**
+     * @brief Evaluates the value and the space-time gradient in one pass.
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        const auto ea = m_f1.F1::evaluate(pos, t);
+        const auto eb = m_f2.F2::evaluate(pos, t);
+        const auto w = Union::blend_weights(ea.value, eb.value, m_smooth_distance);
+
+        SpaceTimeEvaluation<dim, Scalar> result{
+            Union::blend_value(ea.value, eb.value, m_smooth_distance),
+            {}};
+        for (int i = 0; i <= dim; ++i) {
+            result.gradient[i] = Union::combine(w, ea.gradient[i], eb.gradient[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the space-time Hessian, as UnionFunction::hessian.
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const
+    {
+        const auto ea = m_f1.F1::evaluate(pos, t);
+        const auto eb = m_f2.F2::evaluate(pos, t);
+        const auto w = Union::blend_weights(ea.value, eb.value, m_smooth_distance);
+        if (w[1] == 0) return m_f1.F1::hessian(pos, t);
+        if (w[0] == 0) return m_f2.F2::hessian(pos, t);
+
+        return Union::blend_hessian(
+            w,
+            Union::blend_curvature(ea.value, eb.value, m_smooth_distance),
+            ea.gradient,
+            eb.gradient,
+            m_f1.F1::hessian(pos, t),
+            m_f2.F2::hessian(pos, t));
+    }
+
+    /**
+     * @brief Bounds the union over a space-time box, as UnionFunction::value_bounds.
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t) const
+    {
+        return Union::blend_bounds(
+            m_f1.F1::value_bounds(box, t),
+            m_f2.F2::value_bounds(box, t),
+            m_smooth_distance);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the union, as UnionFunction::lipschitz_bound.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const
+    {
+        return Union::blend_lipschitz(
+            m_f1.F1::value_bounds(box, t),
+            m_f2.F2::value_bounds(box, t),
+            m_f1.F1::lipschitz_bound(box, t),
+            m_f2.F2::lipschitz_bound(box, t),
+            m_smooth_distance);
+    }
+
+    /**
+     * @brief Bounds the swept region, as UnionFunction::bounding_box.
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const
+    {
+        const Scalar operand_level = Union::blend_level(level, m_smooth_distance);
+        return hull(
+            m_f1.F1::bounding_box(t0, t1, operand_level),
+            m_f2.F2::bounding_box(t0, t1, operand_level));
+    }
+
+    /**
+     * @brief Freezes the union at time t by freezing both operands, as UnionFunction::bind_time.
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const
+    {
+        return std::make_unique<UnionSnapshot<dim, Scalar>>(
+            m_f1.F1::bind_time(t),
+            m_f2.F2::bind_time(t),
+            m_smooth_distance);
+    }
+
+    /**
+     * @brief Get the first operand.
+     */
+    const F1& first() const { return m_f1; }
+
+    /**
+     * @brief Get the second operand.
+     */
+    const F2& second() const { return m_f2; }
+
+    /**
+     * @brief Get the smooth distance (0 for a sharp union).
+     */
+    Scalar smooth_distance() const { return m_smooth_distance; }
+
+private:
+    F1 m_f1;
+    F2 m_f2;
+    Scalar m_smooth_distance = 0;
+};
+
+/**
+ * @brief Type-erasing adaptor exposing a static node as a SpaceTimeFunction.
+ *
+ * Only the outermost call is virtual. The batch overrides loop over the inlined node, so a whole
+ * batch costs a single virtual dispatch.
+ *
+ * @tparam Node The static node type (StaticSweep, StaticUnion, ...)
+ */
+template <typename Node>
+class StaticFunction : public SpaceTimeFunction<Node::dim, typename Node::Scalar>
+{
+public:
+    using Scalar = typename Node::Scalar;
+    static constexpr int dim = Node::dim;
+
+    explicit StaticFunction(Node node)
+        : m_node(std::move(node))
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_node.Node::value(pos, t);
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_node.Node::time_derivative(pos, t);
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_node.Node::gradient(pos, t);
+    }
+
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_node.Node::evaluate(pos, t);
+    }
+
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        return m_node.Node::hessian(pos, t);
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        return m_node.Node::value_bounds(box, t);
+    }
+
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return m_node.Node::lipschitz_bound(box, t);
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        return m_node.Node::bounding_box(t0, t1, level);
+    }
+
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        return m_node.Node::bind_time(t);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            values[k] = m_node.Node::value(gather(pos, k), t[k]);
+        }
+    }
+
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            time_derivatives[k] = m_node.Node::time_derivative(gather(pos, k), t[k]);
+        }
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            scatter(gradients, k, m_node.Node::gradient(gather(pos, k), t[k]));
+        }
+    }
+
+    /**
+     * @brief Get the wrapped static node.
+     */
+    const Node& node() const { return m_node; }
+
+private:
+    Node m_node;
+};
+
+/**
+ * @brief Composes two transforms statically, applying transform1 and then transform2.
+ */
+template <typename T1, typename T2>
+StaticCompose<std::remove_cvref_t<T1>, std::remove_cvref_t<T2>> compose(
+    T1&& transform1,
+    T2&& transform2)
+{
+    return {std::forward<T1>(transform1), std::forward<T2>(transform2)};
+}
+
+/**
+ * @brief Sweeps an implicit function by a transform statically.
+ */
+template <typename Primitive, typename Motion>
+StaticSweep<std::remove_cvref_t<Primitive>, std::remove_cvref_t<Motion>> make_sweep(
+    Primitive&& implicit_function,
+    Motion&& transform)
+{
+    return {std::forward<Primitive>(implicit_function), std::forward<Motion>(transform)};
+}
+
+/**
+ * @brief Unites two static space-time nodes.
+ */
+template <typename F1, typename F2>
+StaticUnion<std::remove_cvref_t<F1>, std::remove_cvref_t<F2>> make_union(
+    F1&& f1,
+    F2&& f2,
+    static_scalar_t<F1> smooth_distance = 0)
+{
+    return {std::forward<F1>(f1), std::forward<F2>(f2), smooth_distance};
+}
+
+/**
+ * @brief Wraps a static node into a SpaceTimeFunction.
+ */
+template <typename Node>
+StaticFunction<std::remove_cvref_t<Node>> make_function(Node&& node)
+{
+    return StaticFunction<std::remove_cvref_t<Node>>(std::forward<Node>(node));
+}
+
+} // namespace stf
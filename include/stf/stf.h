@@ -5,11 +5,27 @@
 #include <stf/primitives/all.h>
 #include <stf/transforms/all.h>
 
+#include <stf/batch.h>
+#include <stf/box_hierarchy.h>
+#include <stf/clearance.h>
+#include <stf/dual_contouring.h>
 #include <stf/explicit_form.h>
+#include <stf/first_contact.h>
 #include <stf/interpolate_function.h>
+#include <stf/marching_cubes.h>
+#include <stf/mixed_precision_function.h>
+#include <stf/nary_union_function.h>
 #include <stf/offset_function.h>
+#include <stf/parallel.h>
+#include <stf/projection.h>
+#include <stf/raycast.h>
+#include <stf/sample_grid.h>
 #include <stf/space_time_function.h>
+#include <stf/sparse_grid.h>
+#include <stf/static_function.h>
 #include <stf/sweep_function.h>
+#include <stf/swept_envelope.h>
+#include <stf/tape.h>
 #include <stf/union_function.h>
 
 #ifdef STF_YAML_PARSER_ENABLED
@@ -1,16 +1,205 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
+#include <stf/maths/all.h>
 #include <stf/primitives/implicit_function.h>
 #include <stf/space_time_function.h>
 #include <stf/transforms/transform.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
+#include <memory>
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 namespace stf {
 
+/**
+ * @brief Snapshot of a swept function at a fixed time
+ *
+ * Evaluates f(A x + b), where A x + b is the affine map of the transform frozen at the bound
+ * time. The rotation matrices, frames and curve points of the transform are therefore computed
+ * once per snapshot instead of once per point.
+ *
+ * @tparam dim The spatial dimension of the function (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class SweepSnapshot : public ImplicitFunction<dim, Scalar>
+{
+public:
+    /**
+     * @brief Construct a new SweepSnapshot object
+     *
+     * @param implicit_function The swept implicit function, which must outlive the snapshot
+     * @param map The transform frozen at the bound time
+     */
+    SweepSnapshot(
+        const ImplicitFunction<dim, Scalar>& implicit_function,
+        const AffineMap<dim, Scalar>& map)
+        : m_implicit_function(implicit_function)
+        , m_map(map)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        return m_implicit_function.value(m_map.apply(pos));
+    }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return SweepSnapshot::evaluate(pos).gradient;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto f = m_implicit_function.evaluate(m_map.apply(pos));
+        return {f.value, transpose_apply(f.gradient)};
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        // Aᵀ H_f A
+        const auto Hf = m_implicit_function.hessian(m_map.apply(pos));
+        const auto& A = m_map.matrix;
+        std::array<std::array<Scalar, dim>, dim> result{};
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) {
+                for (int p = 0; p < dim; ++p) {
+                    for (int q = 0; q < dim; ++q) result[i][j] += A[p][i] * Hf[p][q] * A[q][j];
+                }
+            }
+        }
+        return result;
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::array<std::array<Interval<Scalar>, dim>, dim> A;
+        IntervalBox<dim, Scalar> b;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) A[i][j] = m_map.matrix[i][j];
+            b[i] = m_map.offset[i];
+        }
+        return m_implicit_function.value_bounds(affine_bounds(A, b, box));
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        std::array<std::array<Interval<Scalar>, dim>, dim> A;
+        IntervalBox<dim, Scalar> b;
+        Scalar frobenius2 = 0;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) {
+                A[i][j] = m_map.matrix[i][j];
+                frobenius2 += m_map.matrix[i][j] * m_map.matrix[i][j];
+            }
+            b[i] = m_map.offset[i];
+        }
+        const Scalar Lf = m_implicit_function.lipschitz_bound(affine_bounds(A, b, box));
+        return lipschitz_product(Lf, std::sqrt(frobenius2));
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        // Pull the primitive bounds back through x = A⁻¹ (y - b).
+        const auto local = m_implicit_function.bounding_box(level);
+        if (is_empty(local)) return local;
+        if (determinant(m_map.matrix) == 0) return entire_box<dim, Scalar>();
+
+        const auto inverse_matrix = inverse(m_map.matrix);
+        std::array<std::array<Interval<Scalar>, dim>, dim> A;
+        IntervalBox<dim, Scalar> offset;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) A[i][j] = inverse_matrix[i][j];
+            offset[i] = local[i] - m_map.offset[i];
+        }
+        return affine_bounds(A, IntervalBox<dim, Scalar>{}, offset);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<dim, Scalar> transformed_pos(values.size());
+        apply_batch(pos, transformed_pos.columns());
+        m_implicit_function.value_batch(transformed_pos.const_columns(), values);
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        const size_t n = gradients[0].size();
+        ColumnBuffer<dim, Scalar> transformed_pos(n);
+        ColumnBuffer<dim, Scalar> spatial_grad(n);
+        apply_batch(pos, transformed_pos.columns());
+        m_implicit_function.gradient_batch(transformed_pos.const_columns(), spatial_grad.columns());
+
+        const auto g = spatial_grad.const_columns();
+        for (size_t k = 0; k < n; ++k) scatter(gradients, k, transpose_apply(gather(g, k)));
+    }
+
+    void evaluate_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        const size_t n = values.size();
+        ColumnBuffer<dim, Scalar> transformed_pos(n);
+        ColumnBuffer<dim, Scalar> spatial_grad(n);
+        apply_batch(pos, transformed_pos.columns());
+        m_implicit_function.evaluate_batch(
+            transformed_pos.const_columns(),
+            values,
+            spatial_grad.columns());
+
+        const auto g = spatial_grad.const_columns();
+        for (size_t k = 0; k < n; ++k) scatter(gradients, k, transpose_apply(gather(g, k)));
+    }
+
+    /**
+     * @brief Get the frozen affine map.
+     */
+    const AffineMap<dim, Scalar>& affine_map() const { return m_map; }
+
+private:
+    /**
+     * @brief Maps a batch of positions through the frozen affine map.
+     */
+    void apply_batch(
+        const std::array<std::span<const Scalar>, dim>& pos,
+        const std::array<std::span<Scalar>, dim>& out) const
+    {
+        for (int i = 0; i < dim; ++i) {
+            std::fill(out[i].begin(), out[i].end(), m_map.offset[i]);
+            for (int j = 0; j < dim; ++j) {
+                const Scalar a = m_map.matrix[i][j];
+                for (size_t k = 0; k < out[i].size(); ++k) out[i][k] += a * pos[j][k];
+            }
+        }
+    }
+
+    /**
+     * @brief Pulls a spatial gradient back through the map: ∇_x F = Aᵀ ∇f.
+     */
+    std::array<Scalar, dim> transpose_apply(const std::array<Scalar, dim>& grad) const
+    {
+        std::array<Scalar, dim> result{};
+        for (int i = 0; i < dim; ++i) {
+            for (int k = 0; k < dim; ++k) result[i] += m_map.matrix[k][i] * grad[k];
+        }
+        return result;
+    }
+
+private:
+    const ImplicitFunction<dim, Scalar>& m_implicit_function;
+    AffineMap<dim, Scalar> m_map;
+};
+
 /**
  * @brief Space-time function created by sweeping an implicit function through
  * space
@@ -27,8 +216,8 @@ namespace stf {
  *
  * @tparam dim The spatial dimension of the function (2 or 3)
  */
-template <int dim>
-class SweepFunction : public SpaceTimeFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class SweepFunction : public SpaceTimeFunction<dim, Scalar>
 {
 public:
     /**
@@ -41,7 +230,9 @@ public:
      * @param implicit_function The implicit function to be swept through space
      * @param transform The transformation to apply to the implicit function
      */
-    SweepFunction(ImplicitFunction<dim>& implicit_function, Transform<dim>& transform)
+    SweepFunction(
+        ImplicitFunction<dim, Scalar>& implicit_function,
+        Transform<dim, Scalar>& transform)
         : m_implicit_function(&implicit_function)
         , m_transform(&transform)
     {}
@@ -82,9 +273,9 @@ public:
     {
         assert(m_implicit_function != nullptr);
         assert(m_transform != nullptr);
-        auto transformed_pos = m_transform->transform(pos, t);
-        auto velocity = m_transform->velocity(pos, t);
-        auto spacial_grad = m_implicit_function->gradient(transformed_pos);
+        const auto T = m_transform->evaluate(pos, t);
+        const auto& velocity = T.velocity;
+        auto spacial_grad = m_implicit_function->gradient(T.position);
         if constexpr (dim == 2) {
             return spacial_grad[0] * velocity[0] + spacial_grad[1] * velocity[1];
         } else if constexpr (dim == 3) {
@@ -102,8 +293,8 @@ public:
      * the spatial gradient of the implicit function and the Jacobian of the
      * transformation. The spatial part of the gradient is computed as ∇_x F =
      * J^T ∇f, where J is the position Jacobian of the transformation and ∇f is
-     * the gradient of the implicit function. The time component is computed
-     * using the time_derivative method.
+     * the gradient of the implicit function. The time component is ∇f · ∂T/∂t,
+     * shared with the evaluate method.
      *
      * @param pos The spatial position as an array of coordinates
      * @param t The time value
@@ -113,31 +304,302 @@ public:
      */
     virtual std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t)
         const override
+    {
+        return evaluate(pos, t).gradient;
+    }
+
+    /**
+     * @brief Evaluate the swept function together with its space-time gradient
+     *
+     * The transform and the implicit function are each evaluated once; the value and spatial
+     * gradient of the implicit function are then combined with the Jacobian and the velocity of
+     * the transform.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return SpaceTimeEvaluation<dim, Scalar> The value and the space-time gradient
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
     {
         assert(m_implicit_function != nullptr);
         assert(m_transform != nullptr);
 
-        const auto transformed_pos = m_transform->transform(pos, t);
-        const auto g_f = m_implicit_function->gradient(transformed_pos);
-        const auto J = m_transform->position_Jacobian(pos, t);
+        const auto T = m_transform->evaluate(pos, t);
+        const auto f = m_implicit_function->evaluate(T.position);
+        const auto& J = T.jacobian;
+        const auto& v = T.velocity;
+
+        SpaceTimeEvaluation<dim, Scalar> result{f.value, {}};
 
         /* spatial part  ∇_x F = Jᵀ ∇f */
-        std::array<Scalar, dim + 1> grad{};
         for (int i = 0; i < dim; ++i) {
             Scalar sum = 0;
-            for (int k = 0; k < dim; ++k) sum += J[k][i] * g_f[k];
-            grad[i] = sum;
+            for (int k = 0; k < dim; ++k) sum += J[k][i] * f.gradient[k];
+            result.gradient[i] = sum;
+        }
+
+        /* time component  ∂F/∂t = ∇f · ∂T/∂t */
+        Scalar dt = 0;
+        for (int i = 0; i < dim; ++i) dt += f.gradient[i] * v[i];
+        result.gradient[dim] = dt;
+
+        return result;
+    }
+
+    /**
+     * @brief Compute the space-time Hessian of the swept function
+     *
+     * With D = [J | v] the space-time Jacobian of the transform, the chain rule gives
+     * H_F = Dᵀ H_f D + Σ_k ∂f/∂y_k H_T_k, where H_f is the Hessian of the implicit function and
+     * H_T_k are the second derivatives of the transform. The second term carries the time
+     * derivative of the Jacobian and the acceleration of the transform.
+     *
+     * @param pos The spatial position as an array of coordinates
+     * @param t The time value
+     * @return std::array<std::array<Scalar, dim + 1>, dim + 1> The space-time Hessian
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+
+        const auto T = m_transform->evaluate(pos, t);
+        const auto HT = m_transform->hessian(pos, t);
+        const auto g = m_implicit_function->gradient(T.position);
+        const auto Hf = m_implicit_function->hessian(T.position);
+
+        std::array<std::array<Scalar, dim + 1>, dim> D;
+        for (int p = 0; p < dim; ++p) {
+            for (int a = 0; a < dim; ++a) D[p][a] = T.jacobian[p][a];
+            D[p][dim] = T.velocity[p];
+        }
+
+        // M = H_f D
+        std::array<std::array<Scalar, dim + 1>, dim> M{};
+        for (int p = 0; p < dim; ++p) {
+            for (int b = 0; b <= dim; ++b) {
+                for (int q = 0; q < dim; ++q) M[p][b] += Hf[p][q] * D[q][b];
+            }
+        }
+
+        std::array<std::array<Scalar, dim + 1>, dim + 1> result;
+        for (int a = 0; a <= dim; ++a) {
+            for (int b = 0; b <= dim; ++b) {
+                Scalar sum = 0;
+                for (int p = 0; p < dim; ++p) sum += D[p][a] * M[p][b] + g[p] * HT[p][a][b];
+                result[a][b] = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bound the swept function over a space-time box
+     *
+     * The implicit function is bounded over the box containing the transformed space-time box.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return Interval<Scalar> A conservative range of values over the space-time box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        return m_implicit_function->value_bounds(m_transform->transform_bounds(box, t));
+    }
+
+    /**
+     * @brief Bound the rates of change of the swept function over a space-time box
+     *
+     * By the chain rule, the gradient of f(T(x, t)) is bounded by the Lipschitz constant of the
+     * implicit function over the transformed box times the Jacobian and velocity bounds of the
+     * transform.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return LipschitzBound<Scalar> The Lipschitz constants over the space-time box
+     */
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        const Scalar Lf =
+            m_implicit_function->lipschitz_bound(m_transform->transform_bounds(box, t));
+        const auto LT = m_transform->lipschitz_bound(box, t);
+        return {lipschitz_product(Lf, LT.spatial), lipschitz_product(Lf, LT.temporal)};
+    }
+
+    /**
+     * @brief Bound the region swept by the zero set over a time range
+     *
+     * The bounding box of the implicit function is pulled back through the inverse bounds of
+     * the transform over the time range.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return IntervalBox<dim, Scalar> A box containing the swept sublevel set
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        const auto local = m_implicit_function->bounding_box(level);
+        if (is_empty(local)) return local;
+        return m_transform->inverse_transform_bounds(local, {t0, t1});
+    }
+
+public:
+    /**
+     * @brief Evaluate the swept function at a batch of space-time points
+     *
+     * The whole batch is first transformed, then the implicit function is evaluated on the
+     * transformed columns, so each stage dispatches once per batch instead of once per point.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one function value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        ColumnBuffer<dim, Scalar> transformed_pos(t.size());
+        m_transform->transform_batch(pos, t, transformed_pos.columns());
+        m_implicit_function->value_batch(transformed_pos.const_columns(), values);
+    }
+
+    /**
+     * @brief Compute the time derivative at a batch of space-time points
+     *
+     * The transform is evaluated once per point, yielding the transformed position and the
+     * velocity together.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param time_derivatives Output span receiving one time derivative per point
+     */
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        const size_t n = t.size();
+        ColumnBuffer<dim, Scalar> transformed_pos(n);
+        ColumnBuffer<dim, Scalar> velocity(n);
+        ColumnBuffer<dim, Scalar> spatial_grad(n);
+        for (size_t k = 0; k < n; ++k) {
+            const auto T = m_transform->evaluate(gather(pos, k), t[k]);
+            scatter(transformed_pos.columns(), k, T.position);
+            scatter(velocity.columns(), k, T.velocity);
+        }
+        m_implicit_function->gradient_batch(
+            transformed_pos.const_columns(),
+            spatial_grad.columns());
+
+        const auto v = velocity.const_columns();
+        const auto g = spatial_grad.const_columns();
+        for (size_t k = 0; k < n; ++k) {
+            Scalar sum = 0;
+            for (int i = 0; i < dim; ++i) sum += g[i][k] * v[i][k];
+            time_derivatives[k] = sum;
+        }
+    }
+
+    /**
+     * @brief Compute the space-time gradient at a batch of space-time points
+     *
+     * The transform is evaluated once per point, yielding the transformed position, the velocity
+     * and the position Jacobian together; the implicit gradient is then evaluated once for the
+     * whole batch and shared between the spatial and the time components.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param gradients Output columns, spatial gradient first and time derivative last
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        const size_t n = t.size();
+        ColumnBuffer<dim, Scalar> transformed_pos(n);
+        ColumnBuffer<dim, Scalar> spatial_grad(n);
+        std::vector<TransformEvaluation<dim, Scalar>> evaluations(n);
+        for (size_t k = 0; k < n; ++k) {
+            evaluations[k] = m_transform->evaluate(gather(pos, k), t[k]);
+            scatter(transformed_pos.columns(), k, evaluations[k].position);
         }
+        m_implicit_function->gradient_batch(
+            transformed_pos.const_columns(),
+            spatial_grad.columns());
+
+        const auto g = spatial_grad.const_columns();
+        for (size_t k = 0; k < n; ++k) {
+            const auto& J = evaluations[k].jacobian;
+            const auto& v = evaluations[k].velocity;
 
-        /* time component */
-        grad[dim] = time_derivative(pos, t);
+            /* spatial part  ∇_x F = Jᵀ ∇f */
+            for (int i = 0; i < dim; ++i) {
+                Scalar sum = 0;
+                for (int j = 0; j < dim; ++j) sum += J[j][i] * g[j][k];
+                gradients[i][k] = sum;
+            }
 
-        return grad;
+            /* time component */
+            Scalar dt = 0;
+            for (int i = 0; i < dim; ++i) dt += g[i][k] * v[i];
+            gradients[dim][k] = dt;
+        }
     }
 
+    /**
+     * @brief Freeze the swept function at time t
+     *
+     * Affine transforms are frozen into a SweepSnapshot; other transforms fall back to the
+     * generic snapshot.
+     *
+     * @param t The time value
+     * @return std::unique_ptr<ImplicitFunction<dim, Scalar>> The spatial snapshot at time t
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        assert(m_implicit_function != nullptr);
+        assert(m_transform != nullptr);
+        if (!m_transform->is_affine()) return SpaceTimeFunction<dim, Scalar>::bind_time(t);
+        return std::make_unique<SweepSnapshot<dim, Scalar>>(
+            *m_implicit_function,
+            m_transform->affine_map(t));
+    }
+
+public:
+    /**
+     * @brief Get the implicit function being swept.
+     */
+    const ImplicitFunction<dim, Scalar>& implicit_function() const { return *m_implicit_function; }
+
+    /**
+     * @brief Get the transformation applied to the implicit function.
+     */
+    const Transform<dim, Scalar>& transform() const { return *m_transform; }
+
 private:
-    ImplicitFunction<dim>* m_implicit_function = nullptr; ///< The implicit function being swept
-    Transform<dim>* m_transform = nullptr; ///< The transformation applied to the implicit function
+    /// The implicit function being swept
+    ImplicitFunction<dim, Scalar>* m_implicit_function = nullptr;
+    /// The transformation applied to the implicit function
+    Transform<dim, Scalar>* m_transform = nullptr;
 };
 
 } // namespace stf
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/maths/interval.h>
+#include <stf/parallel.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/sample_grid.h>
+#include <stf/space_time_function.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Options of the swept envelope search.
+ */
+struct SweptEnvelopeOptions
+{
+    size_t num_intervals = 8; ///< Number of time intervals the search starts from
+    /// Width below which time intervals are no longer split, relative to the time range
+    double time_resolution = 1e-3;
+    /// Accuracy of the minimizing time, relative to the time range
+    double time_tolerance = 1e-9;
+    /// Time intervals whose lower bound is within this of the best value found are dropped
+    double value_tolerance = 1e-9;
+    /// The search stops once the envelope is proven above `cutoff` or found below `-cutoff`
+    double cutoff = std::numeric_limits<double>::infinity();
+    size_t num_threads = 0; ///< Number of threads (0 for one per hardware thread)
+    size_t tile_size = 1024; ///< Number of consecutive points searched by one thread in order
+};
+
+/**
+ * @brief Minimum over time of a space-time function at one position.
+ */
+template <typename Scalar = stf::Scalar>
+struct EnvelopeSample
+{
+    Scalar value; ///< The minimum value
+    Scalar time; ///< A time reaching it, NaN if the search stopped at the cutoff from above
+    size_t evaluations; ///< Number of function evaluations spent
+};
+
+/**
+ * @brief Computes min over t in [t0, t1] of f(pos, t).
+ *
+ * The search is a branch and bound over time intervals. An interval is dropped when its value
+ * bounds, or once its ends are sampled the temporal Lipschitz bound combined with the values
+ * there, show that it cannot improve the best value found. An interval whose time derivative goes
+ * from negative to positive holds a local minimum, which is located by safeguarded secant steps
+ * on the time derivative and becomes the split point. Other intervals are halved down to the
+ * time resolution.
+ *
+ * A warm-start time, typically the minimizing time of a neighboring point, is refined first; a
+ * good initial value lets the bounds discard most of the time range. When the value bounds over
+ * the whole range exceed `options.cutoff`, their lower end is returned without evaluating the
+ * function; the search also stops once a value below `-options.cutoff` is found.
+ *
+ * @param f The space-time function
+ * @param pos The position
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param warm_start A time to try first, or NaN
+ * @param options The tolerances and cutoff
+ * @return EnvelopeSample<Scalar> The minimum, a minimizing time and the evaluation count
+ */
+template <int dim, typename Scalar>
+EnvelopeSample<Scalar> minimize_over_time(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const std::type_identity_t<std::array<Scalar, dim>>& pos,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    std::type_identity_t<Scalar> warm_start,
+    const SweptEnvelopeOptions& options = {})
+{
+    IntervalBox<dim, Scalar> point;
+    for (int i = 0; i < dim; ++i) point[i] = Interval<Scalar>(pos[i]);
+
+    const Scalar cutoff = Scalar(options.cutoff);
+    const Scalar range = t1 - t0;
+    const Scalar resolution = Scalar(options.time_resolution) * range;
+    const Scalar tolerance = Scalar(options.time_tolerance) * range;
+    const Scalar value_tolerance = Scalar(options.value_tolerance);
+
+    EnvelopeSample<Scalar> best{std::numeric_limits<Scalar>::infinity(), t0, 0};
+    if (std::isfinite(cutoff)) {
+        const Scalar lower = f.value_bounds(point, Interval<Scalar>(t0, t1)).lower;
+        if (lower > cutoff) {
+            return {lower, std::numeric_limits<Scalar>::quiet_NaN(), 0};
+        }
+    }
+
+    struct Sample
+    {
+        Scalar t; ///< The time
+        Scalar value; ///< The value at t
+        Scalar derivative; ///< The time derivative at t
+    };
+    auto sample = [&](Scalar t) {
+        const auto e = f.evaluate(pos, t);
+        ++best.evaluations;
+        if (e.value < best.value) {
+            best.value = e.value;
+            best.time = t;
+        }
+        return Sample{t, e.value, e.gradient[dim]};
+    };
+    auto done = [&]() { return best.value <= -cutoff; };
+
+    // Locate the zero of the time derivative between a (negative) and b (positive).
+    auto refine = [&](Sample a, Sample b) {
+        Sample lowest = a.value < b.value ? a : b;
+        int side = 0;
+        for (int iteration = 0; iteration < 64 && b.t - a.t > tolerance; ++iteration) {
+            Scalar t = b.t - b.derivative * (b.t - a.t) / (b.derivative - a.derivative);
+            if (!(t > a.t && t < b.t)) t = (a.t + b.t) / 2;
+            const auto s = sample(t);
+            if (s.value < lowest.value) lowest = s;
+            if (s.derivative == 0) break;
+            // Illinois modification: halve the stale end so the bracket shrinks from both sides.
+            if (s.derivative < 0) {
+                a = s;
+                if (side == -1) b.derivative /= 2;
+                side = -1;
+            } else {
+                b = s;
+                if (side == 1) a.derivative /= 2;
+                side = 1;
+            }
+        }
+        return lowest;
+    };
+
+    // Refine the warm start by walking downhill until the derivative changes sign.
+    if (std::isfinite(warm_start) && warm_start >= t0 && warm_start <= t1) {
+        const auto s = sample(warm_start);
+        const Scalar step = range / Scalar(4 * std::max<size_t>(options.num_intervals, 1));
+        if (s.derivative != 0) {
+            const Scalar direction = s.derivative < 0 ? 1 : -1;
+            Sample near = s;
+            for (Scalar h = step;; h *= 2) {
+                const Scalar t = std::clamp(s.t + direction * h, t0, t1);
+                const auto far = sample(t);
+                if ((far.derivative < 0) != (near.derivative < 0)) {
+                    if (direction > 0) {
+                        refine(near, far);
+                    } else {
+                        refine(far, near);
+                    }
+                    break;
+                }
+                if (far.value > near.value || t == t0 || t == t1) break;
+                near = far;
+            }
+        }
+        if (done()) return best;
+    }
+
+    struct Node
+    {
+        Sample a; ///< Start of the interval
+        Sample b; ///< End of the interval
+        bool refined = false; ///< Whether a local minimum inside was already located
+    };
+
+    // The ends of an interval are only sampled once its value bounds fail to discard it.
+    constexpr Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+    std::vector<Node> stack;
+    const size_t num_intervals = std::max<size_t>(options.num_intervals, 1);
+    for (size_t k = num_intervals; k > 0; --k) {
+        const Scalar a = t0 + range * Scalar(k - 1) / Scalar(num_intervals);
+        const Scalar b = k == num_intervals ? t1 : t0 + range * Scalar(k) / Scalar(num_intervals);
+        stack.push_back({{a, nan, nan}, {b, nan, nan}});
+    }
+
+    while (!stack.empty() && !done()) {
+        Node node = stack.back();
+        stack.pop_back();
+
+        const Scalar width = node.b.t - node.a.t;
+        const Interval<Scalar> times(node.a.t, node.b.t);
+        Scalar lower = f.value_bounds(point, times).lower;
+        if (lower >= best.value - value_tolerance) continue;
+
+        if (std::isnan(node.a.value)) node.a = sample(node.a.t);
+        if (std::isnan(node.b.value)) node.b = sample(node.b.t);
+        const Scalar lipschitz = f.lipschitz_bound(point, times).temporal;
+        if (std::isfinite(lipschitz)) {
+            lower = std::max(lower, (node.a.value + node.b.value - lipschitz * width) / 2);
+        }
+        if (lower >= best.value - value_tolerance) continue;
+
+        if (width <= resolution) {
+            if (!node.refined && node.a.derivative < 0 && node.b.derivative > 0) {
+                refine(node.a, node.b);
+            }
+            continue;
+        }
+
+        // Split at the located minimum so that neither half brackets it again.
+        if (!node.refined && node.a.derivative < 0 && node.b.derivative > 0) {
+            const auto minimum = refine(node.a, node.b);
+            if (minimum.t > node.a.t && minimum.t < node.b.t) {
+                stack.push_back({minimum, node.b, true});
+                stack.push_back({node.a, minimum, true});
+                continue;
+            }
+        }
+        const auto middle = sample((node.a.t + node.b.t) / 2);
+        stack.push_back({middle, node.b, node.refined});
+        stack.push_back({node.a, middle, node.refined});
+    }
+    return best;
+}
+
+/**
+ * @brief Minimum over a time range of a space-time function, sampled on a grid.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct SweptEnvelope
+{
+    GridSpec<dim, Scalar> grid; ///< The grid
+    std::vector<Scalar> values; ///< The minimum over time at each node, in grid order
+    std::vector<Scalar> times; ///< A minimizing time at each node, NaN beyond the cutoff
+    size_t num_evaluations = 0; ///< Number of function evaluations spent
+
+    /**
+     * @brief Writes the values as raw native-endian scalars in grid order.
+     *
+     * The layout matches a single slab written by RawSlabWriter.
+     *
+     * @param out The binary output stream
+     */
+    void write(std::ostream& out) const
+    {
+        out.write(
+            reinterpret_cast<const char*>(values.data()),
+            static_cast<std::streamsize>(values.size() * sizeof(Scalar)));
+        if (!out) throw std::runtime_error("Failed to write swept envelope");
+    }
+};
+
+/**
+ * @brief Computes the minimum over a time range of a space-time function at a batch of points.
+ *
+ * The points are split into tiles searched in parallel. Within a tile, the points are searched
+ * in order and each starts from the minimizing time of the previous one, so consecutive points
+ * should be close to each other. The output does not depend on the thread count.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param pos The positions, one span per coordinate
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param values Output receiving the minimum at each point
+ * @param times Optional output receiving a minimizing time at each point; left untouched when
+ * empty
+ * @param options The search tolerances, cutoff, thread count and tile size
+ * @return size_t The number of function evaluations spent
+ */
+template <int dim, typename Scalar>
+size_t swept_envelope_batch(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    std::type_identity_t<std::array<std::span<const Scalar>, dim>> pos,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    std::type_identity_t<std::span<Scalar>> values,
+    std::type_identity_t<std::span<Scalar>> times = {},
+    const SweptEnvelopeOptions& options = {})
+{
+    const size_t n = values.size();
+    for (int i = 0; i < dim; ++i) {
+        if (pos[i].size() != n) throw std::invalid_argument("pos and values sizes differ");
+    }
+    if (!times.empty() && times.size() != n) {
+        throw std::invalid_argument("times must be empty or hold one entry per point");
+    }
+    if (!(t0 <= t1)) throw std::invalid_argument("t0 must not exceed t1");
+    if (options.tile_size == 0) throw std::invalid_argument("tile_size must be positive");
+
+    const size_t tile_size = options.tile_size;
+    const size_t num_tiles = (n + tile_size - 1) / tile_size;
+    std::vector<size_t> evaluations(num_tiles, 0);
+    parallel_for(num_tiles, options.num_threads, [&](size_t tile, size_t /*thread*/) {
+        const size_t begin = tile * tile_size;
+        const size_t end = std::min(n, begin + tile_size);
+        Scalar warm_start = std::numeric_limits<Scalar>::quiet_NaN();
+        for (size_t k = begin; k < end; ++k) {
+            std::array<Scalar, dim> p;
+            for (int i = 0; i < dim; ++i) p[i] = pos[i][k];
+            const auto result = minimize_over_time(f, p, t0, t1, warm_start, options);
+            values[k] = result.value;
+            if (!times.empty()) times[k] = result.time;
+            if (std::isfinite(result.time)) warm_start = result.time;
+            evaluations[tile] += result.evaluations;
+        }
+    });
+
+    size_t total = 0;
+    for (size_t count : evaluations) total += count;
+    return total;
+}
+
+/**
+ * @brief Samples the minimum over a time range of a space-time function on a grid.
+ *
+ * Consecutive nodes along the first axis are searched in order, each warm-started from the
+ * minimizing time of the previous node.
+ *
+ * @param f The function, which must be safe to evaluate concurrently
+ * @param grid The grid
+ * @param t0 The start of the time range
+ * @param t1 The end of the time range
+ * @param options The search tolerances, cutoff, thread count and tile size
+ * @return SweptEnvelope<dim, Scalar> The values and minimizing times at the nodes
+ */
+template <int dim, typename Scalar>
+SweptEnvelope<dim, Scalar> sample_swept_envelope(
+    const SpaceTimeFunction<dim, Scalar>& f,
+    const GridSpec<dim, Scalar>& grid,
+    std::type_identity_t<Scalar> t0,
+    std::type_identity_t<Scalar> t1,
+    const SweptEnvelopeOptions& options = {})
+{
+    SweptEnvelope<dim, Scalar> envelope;
+    envelope.grid = grid;
+    const size_t n = grid.size();
+    envelope.values.resize(n);
+    envelope.times.resize(n);
+
+    ColumnBuffer<dim, Scalar> positions(n);
+    auto columns = positions.columns();
+    auto node = grid.node(0);
+    for (size_t k = 0; k < n; ++k) {
+        const auto p = grid.position(node);
+        for (int i = 0; i < dim; ++i) columns[i][k] = p[i];
+        for (int i = 0; i < dim && ++node[i] == grid.resolution[i]; ++i) node[i] = 0;
+    }
+
+    envelope.num_evaluations = swept_envelope_batch(
+        f,
+        positions.const_columns(),
+        t0,
+        t1,
+        envelope.values,
+        envelope.times,
+        options);
+    return envelope;
+}
+
+/**
+ * @brief Implicit function of the volume swept by a space-time function over a time range.
+ *
+ * The value at x is min over t in [t0, t1] of f(x, t), whose zero level set is the boundary of
+ * the swept volume. By the envelope theorem its gradient is the spatial gradient of f at the
+ * minimizing time (one-sided where several times tie). The swept function can be meshed or
+ * sampled like any implicit function; batches are searched in order with warm starts.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class SweptEnvelopeFunction : public ImplicitFunction<dim, Scalar>
+{
+public:
+    /**
+     * @brief Constructs the envelope of a function, which must outlive it.
+     *
+     * @param f The space-time function
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param options The search tolerances; the cutoff should stay infinite when exact values
+     * are needed everywhere
+     */
+    SweptEnvelopeFunction(
+        const SpaceTimeFunction<dim, Scalar>& f,
+        Scalar t0 = 0,
+        Scalar t1 = 1,
+        const SweptEnvelopeOptions& options = {})
+        : m_f(f)
+        , m_t0(t0)
+        , m_t1(t1)
+        , m_options(options)
+    {
+        if (!(t0 <= t1)) throw std::invalid_argument("t0 must not exceed t1");
+    }
+
+    Scalar value(std::array<Scalar, dim> pos) const override { return search(pos).value; }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return spatial_gradient(pos, search(pos).time);
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto result = search(pos);
+        return {result.value, spatial_gradient(pos, result.time)};
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f.value_bounds(box, Interval<Scalar>(m_t0, m_t1));
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return m_f.lipschitz_bound(box, Interval<Scalar>(m_t0, m_t1)).spatial;
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        return m_f.bounding_box(m_t0, m_t1, level);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        Scalar warm_start = std::numeric_limits<Scalar>::quiet_NaN();
+        for (size_t k = 0; k < values.size(); ++k) {
+            std::array<Scalar, dim> p;
+            for (int i = 0; i < dim; ++i) p[i] = pos[i][k];
+            const auto result = minimize_over_time(m_f, p, m_t0, m_t1, warm_start, m_options);
+            values[k] = result.value;
+            if (std::isfinite(result.time)) warm_start = result.time;
+        }
+    }
+
+private:
+    EnvelopeSample<Scalar> search(const std::array<Scalar, dim>& pos) const
+    {
+        return minimize_over_time(
+            m_f,
+            pos,
+            m_t0,
+            m_t1,
+            std::numeric_limits<Scalar>::quiet_NaN(),
+            m_options);
+    }
+
+    std::array<Scalar, dim> spatial_gradient(const std::array<Scalar, dim>& pos, Scalar t) const
+    {
+        if (!std::isfinite(t)) t = (m_t0 + m_t1) / 2;
+        const auto g = m_f.gradient(pos, t);
+        std::array<Scalar, dim> result;
+        for (int i = 0; i < dim; ++i) result[i] = g[i];
+        return result;
+    }
+
+private:
+    const SpaceTimeFunction<dim, Scalar>& m_f; ///< The space-time function
+    Scalar m_t0; ///< Start of the time range
+    Scalar m_t1; ///< End of the time range
+    SweptEnvelopeOptions m_options; ///< The search options
+};
+
+} // namespace stf
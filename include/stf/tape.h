@@ -0,0 +1,804 @@
+#pragma once
+
+#include <stf/batch.h>
+#include <stf/common.h>
+#include <stf/interpolate_function.h>
+#include <stf/nary_union_function.h>
+#include <stf/offset_function.h>
+#include <stf/primitives/implicit_ball.h>
+#include <stf/primitives/implicit_capsule.h>
+#include <stf/primitives/implicit_function.h>
+#include <stf/primitives/implicit_nary_union.h>
+#include <stf/primitives/implicit_union.h>
+#include <stf/space_time_function.h>
+#include <stf/sweep_function.h>
+#include <stf/transforms/compose.h>
+#include <stf/transforms/rotation.h>
+#include <stf/transforms/scale.h>
+#include <stf/transforms/transform.h>
+#include <stf/transforms/translation.h>
+#include <stf/union_function.h>
+
+#ifdef STF_YAML_PARSER_ENABLED
+#include <stf/yaml_parser.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace stf {
+
+/**
+ * @brief Operations of the tape interpreter.
+ */
+enum class TapeOp : uint8_t {
+    Translate, ///< Position ← position + c t
+    Rotate, ///< Position ← R(θ t) (position - c) + c
+    Scale, ///< Position ← (position - c) (1 + (f - 1) t) + c
+    TransformCall, ///< Position ← Transform::transform_batch(position, t)
+
+    Ball, ///< Value ← |position - c|^p - r^p
+    Capsule, ///< Value ← distance(position, segment) - r
+    ImplicitCall, ///< Value ← ImplicitFunction::value_batch(position)
+
+    Min, ///< Value ← min(a, b)
+    SoftMinQuadratic, ///< Value ← quadratic soft minimum of a and b
+    SoftMinCubic, ///< Value ← cubic soft minimum of a and b
+    SoftMinQuartic, ///< Value ← quartic soft minimum of a and b
+    SoftMinCircular, ///< Value ← circular soft minimum of a and b
+    NaryUnion, ///< Value ← the inputs in increasing order, folded with a binary minimum
+    Offset, ///< Value ← a + o(t)
+    Interpolate, ///< Value ← a (1 - s(t)) + b s(t)
+    FunctionCall, ///< Value ← SpaceTimeFunction::value_batch(position, t)
+};
+
+/**
+ * @brief A single instruction of a compiled tape.
+ *
+ * Positions occupy `dim` consecutive registers starting at the given index; values occupy a single
+ * register. Only the fields relevant to the operation are set.
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct TapeInstruction
+{
+    TapeOp op; ///< The operation
+    uint32_t out = 0; ///< Output register
+    uint32_t in0 = 0; ///< First input register
+    uint32_t in1 = 0; ///< Second input register (binary operations)
+    uint32_t num_inputs = 0; ///< Number of inputs of NaryUnion, listed in the input pool from in0
+    TapeOp blend = TapeOp::Min; ///< Binary minimum folding the inputs of NaryUnion
+    uint32_t constants = 0; ///< Offset of the operation's constants in the constant pool
+
+    const Transform<dim, Scalar>* transform = nullptr; ///< Node called by TransformCall
+    const ImplicitFunction<dim, Scalar>* implicit = nullptr; ///< Node called by ImplicitCall
+    const SpaceTimeFunction<dim, Scalar>* function = nullptr; ///< Node called by FunctionCall
+    const std::function<Scalar(Scalar)>* callback = nullptr; ///< Offset or interpolation weight
+};
+
+/**
+ * @brief A space-time function graph lowered to a flat instruction tape.
+ *
+ * The constructor walks the graph once and emits one instruction per node into a contiguous
+ * tape. Built-in transforms (translation, rotation, scale, compose), primitives (ball, capsule)
+ * and operators (sweep, binary and n-ary unions, offset, interpolate) become native instructions
+ * whose constants live in a single pool. Any other node (Duchon, torus, polylines, explicit forms,
+ * user subclasses, ...) becomes a call instruction that forwards a whole batch to the node's own
+ * batch API, so every graph can be compiled.
+ *
+ * Evaluation runs the tape over chunks of points. Each instruction processes a whole chunk in a
+ * tight loop over a register file of structure-of-arrays columns, so dispatch happens once per
+ * instruction and chunk rather than once per node and point. The register file and the sorting
+ * scratch of the n-ary unions live in a per-thread workspace that is reused across calls.
+ *
+ * Only function values are computed by the tape; time derivatives and gradients are forwarded to
+ * the source graph, which must outlive the tape.
+ *
+ * @tparam dim The spatial dimension of the function
+ */
+template <int dim, typename Scalar = stf::Scalar>
+class Tape : public SpaceTimeFunction<dim, Scalar>
+{
+public:
+    /// Number of points processed by each pass over the tape
+    static constexpr size_t chunk_size = 256;
+
+    /**
+     * @brief Compile a space-time function graph into a tape.
+     *
+     * @param function The root of the graph to compile
+     */
+    explicit Tape(const SpaceTimeFunction<dim, Scalar>& function)
+        : m_source(function)
+    {
+        // Registers [0, dim) hold the query position and register dim holds the time.
+        m_num_registers = dim + 1;
+        m_result = lower(function, 0);
+    }
+
+    Scalar value(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        std::array<std::span<const Scalar>, dim> columns;
+        for (int i = 0; i < dim; ++i) columns[i] = {&pos[i], 1};
+        Scalar result;
+        value_batch(columns, {&t, 1}, {&result, 1});
+        return result;
+    }
+
+    Scalar time_derivative(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_source.time_derivative(pos, t);
+    }
+
+    std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_source.gradient(pos, t);
+    }
+
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_source.evaluate(pos, t);
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        return m_source.value_bounds(box, t);
+    }
+
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return m_source.lipschitz_bound(box, t);
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        return m_source.bounding_box(t0, t1, level);
+    }
+
+    /**
+     * @brief Evaluate the tape at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        const size_t n = t.size();
+        const size_t stride = std::min(n, chunk_size);
+
+        // The workspace is reused across calls; a tape reached again through a call instruction
+        // while this thread's workspace is in use gets a buffer of its own.
+        thread_local Workspace workspace;
+        std::vector<Scalar> nested_buffer;
+        const bool nested = workspace.busy;
+        std::vector<Scalar>& buffer = nested ? nested_buffer : workspace.buffer;
+        WorkspaceLock lock(workspace, !nested);
+
+        const size_t size = m_num_registers * stride + m_max_inputs;
+        if (buffer.size() < size) buffer.resize(size);
+        Scalar* registers = buffer.data();
+        Scalar* scratch = registers + m_num_registers * stride;
+
+        for (size_t begin = 0; begin < n; begin += stride) {
+            const size_t count = std::min(stride, n - begin);
+            for (int i = 0; i < dim; ++i) {
+                std::copy_n(pos[i].begin() + begin, count, registers + i * stride);
+            }
+            std::copy_n(t.begin() + begin, count, registers + dim * stride);
+
+            run(registers, scratch, stride, count);
+            std::copy_n(registers + m_result * stride, count, values.begin() + begin);
+        }
+    }
+
+    /**
+     * @brief Get the compiled instructions.
+     */
+    const std::vector<TapeInstruction<dim, Scalar>>& instructions() const { return m_instructions; }
+
+    /**
+     * @brief Get the number of registers used by the tape, including the inputs.
+     */
+    size_t num_registers() const { return m_num_registers; }
+
+private:
+    /**
+     * @brief Per-thread storage for the register file and the n-ary union scratch.
+     */
+    struct Workspace
+    {
+        std::vector<Scalar> buffer;
+        bool busy = false;
+    };
+
+    /**
+     * @brief Marks a workspace as busy for the duration of an evaluation.
+     */
+    class WorkspaceLock
+    {
+    public:
+        WorkspaceLock(Workspace& workspace, bool active)
+            : m_workspace(active ? &workspace : nullptr)
+        {
+            if (m_workspace) m_workspace->busy = true;
+        }
+        ~WorkspaceLock()
+        {
+            if (m_workspace) m_workspace->busy = false;
+        }
+        WorkspaceLock(const WorkspaceLock&) = delete;
+        WorkspaceLock& operator=(const WorkspaceLock&) = delete;
+
+    private:
+        Workspace* m_workspace;
+    };
+
+    /**
+     * @brief Executes every instruction on `count` lanes of the register file.
+     *
+     * @param scratch Storage for the inputs of one lane of the widest n-ary union
+     */
+    void run(Scalar* registers, Scalar* scratch, size_t stride, size_t count) const
+    {
+        auto reg = [&](uint32_t r) { return registers + r * stride; };
+        auto positions = [&](uint32_t r) {
+            std::array<std::span<const Scalar>, dim> columns;
+            for (int i = 0; i < dim; ++i) columns[i] = {reg(r + i), count};
+            return columns;
+        };
+        const Scalar* t = reg(dim);
+
+        for (const auto& inst : m_instructions) {
+            const Scalar* c = m_constants.data() + inst.constants;
+            Scalar* out = reg(inst.out);
+            const Scalar* a = reg(inst.in0);
+            const Scalar* b = reg(inst.in1);
+
+            switch (inst.op) {
+            case TapeOp::Translate:
+                for (int i = 0; i < dim; ++i) {
+                    Scalar* o = reg(inst.out + i);
+                    const Scalar* p = reg(inst.in0 + i);
+                    for (size_t k = 0; k < count; ++k) o[k] = p[k] + c[i] * t[k];
+                }
+                break;
+            case TapeOp::Rotate: run_rotate(inst, c, reg, t, count); break;
+            case TapeOp::Scale:
+                for (int i = 0; i < dim; ++i) {
+                    Scalar* o = reg(inst.out + i);
+                    const Scalar* p = reg(inst.in0 + i);
+                    for (size_t k = 0; k < count; ++k) {
+                        o[k] = (p[k] - c[dim + i]) * (1 + (c[i] - 1) * t[k]) + c[dim + i];
+                    }
+                }
+                break;
+            case TapeOp::TransformCall: {
+                std::array<std::span<Scalar>, dim> columns;
+                for (int i = 0; i < dim; ++i) columns[i] = {reg(inst.out + i), count};
+                inst.transform->transform_batch(positions(inst.in0), {t, count}, columns);
+                break;
+            }
+            case TapeOp::Ball: run_ball(c, reg, inst, count); break;
+            case TapeOp::Capsule: run_capsule(c, reg, inst, count); break;
+            case TapeOp::ImplicitCall:
+                inst.implicit->value_batch(positions(inst.in0), {out, count});
+                break;
+            case TapeOp::Min:
+                for (size_t k = 0; k < count; ++k) out[k] = std::min(a[k], b[k]);
+                break;
+            case TapeOp::SoftMinQuadratic:
+                run_soft_min<TapeOp::SoftMinQuadratic>(c[0], a, b, out, count);
+                break;
+            case TapeOp::SoftMinCubic:
+                run_soft_min<TapeOp::SoftMinCubic>(c[0], a, b, out, count);
+                break;
+            case TapeOp::SoftMinQuartic:
+                run_soft_min<TapeOp::SoftMinQuartic>(c[0], a, b, out, count);
+                break;
+            case TapeOp::SoftMinCircular:
+                run_soft_min<TapeOp::SoftMinCircular>(c[0], a, b, out, count);
+                break;
+            case TapeOp::NaryUnion:
+                switch (inst.blend) {
+                case TapeOp::SoftMinQuadratic:
+                    run_nary_union<TapeOp::SoftMinQuadratic>(inst, c, reg, scratch, count);
+                    break;
+                case TapeOp::SoftMinCubic:
+                    run_nary_union<TapeOp::SoftMinCubic>(inst, c, reg, scratch, count);
+                    break;
+                case TapeOp::SoftMinQuartic:
+                    run_nary_union<TapeOp::SoftMinQuartic>(inst, c, reg, scratch, count);
+                    break;
+                case TapeOp::SoftMinCircular:
+                    run_nary_union<TapeOp::SoftMinCircular>(inst, c, reg, scratch, count);
+                    break;
+                default: run_nary_union<TapeOp::Min>(inst, c, reg, scratch, count); break;
+                }
+                break;
+            case TapeOp::Offset: {
+                Scalar offset = 0;
+                for (size_t k = 0; k < count; ++k) {
+                    if (k == 0 || t[k] != t[k - 1]) offset = (*inst.callback)(t[k]);
+                    out[k] = a[k] + offset;
+                }
+                break;
+            }
+            case TapeOp::Interpolate: {
+                Scalar s = 0;
+                for (size_t k = 0; k < count; ++k) {
+                    if (k == 0 || t[k] != t[k - 1]) s = (*inst.callback)(t[k]);
+                    out[k] = a[k] * (1 - s) + b[k] * s;
+                }
+                break;
+            }
+            case TapeOp::FunctionCall:
+                inst.function->value_batch(positions(inst.in0), {t, count}, {out, count});
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Binary minimum of a and b, smoothed over the blending width k by the soft minimum
+     * matching `op`.
+     */
+    template <TapeOp op>
+    static Scalar soft_min(Scalar k, Scalar a, Scalar b)
+    {
+        if constexpr (op == TapeOp::Min) {
+            return std::min(a, b);
+        } else {
+            const Scalar h = std::max(k - std::abs(a - b), Scalar(0)) / k;
+            if constexpr (op == TapeOp::SoftMinQuadratic) {
+                return std::min(a, b) - h * h * k * Scalar(1.0 / 4.0);
+            } else if constexpr (op == TapeOp::SoftMinCubic) {
+                return std::min(a, b) - h * h * h * k * Scalar(1.0 / 6.0);
+            } else if constexpr (op == TapeOp::SoftMinQuartic) {
+                return std::min(a, b) - h * h * h * (4 - h) * k * Scalar(1.0 / 16.0);
+            } else {
+                return std::min(a, b) - k * Scalar(0.5) * (1 + h - std::sqrt(1 - h * (h - 2)));
+            }
+        }
+    }
+
+    template <TapeOp op>
+    static void
+    run_soft_min(Scalar k, const Scalar* a, const Scalar* b, Scalar* out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) out[i] = soft_min<op>(k, a[i], b[i]);
+    }
+
+    /**
+     * @brief Sorts the inputs of each lane and folds them with the binary minimum `op`.
+     *
+     * Once an input lies outside the blending width of the accumulated value, so do all the
+     * following ones and they leave it unchanged; the fold therefore matches the sorted folds of
+     * NaryUnionFunction and ImplicitNaryUnion, which stop there.
+     */
+    template <TapeOp op, typename Reg>
+    void run_nary_union(
+        const TapeInstruction<dim, Scalar>& inst,
+        const Scalar* c,
+        Reg reg,
+        Scalar* values,
+        size_t count) const
+    {
+        // Constants: blending width (smooth unions only).
+        const uint32_t* inputs = m_inputs.data() + inst.in0;
+        const Scalar k = op == TapeOp::Min ? Scalar(0) : c[0];
+        Scalar* out = reg(inst.out);
+        for (size_t i = 0; i < count; ++i) {
+            for (uint32_t j = 0; j < inst.num_inputs; ++j) values[j] = reg(inputs[j])[i];
+            std::sort(values, values + inst.num_inputs);
+            Scalar result = values[0];
+            for (uint32_t j = 1; j < inst.num_inputs; ++j) {
+                result = soft_min<op>(k, result, values[j]);
+            }
+            out[i] = result;
+        }
+    }
+
+    template <typename Reg>
+    static void run_rotate(
+        const TapeInstruction<dim, Scalar>& inst,
+        const Scalar* c,
+        Reg reg,
+        const Scalar* t,
+        size_t count)
+    {
+        // Constants: center (dim), angular speed in radians, normalized axis (3D only).
+        const Scalar omega = c[dim];
+        if constexpr (dim == 2) {
+            const Scalar *x = reg(inst.in0), *y = reg(inst.in0 + 1);
+            Scalar *ox = reg(inst.out), *oy = reg(inst.out + 1);
+            for (size_t k = 0; k < count; ++k) {
+                const Scalar cs = std::cos(omega * t[k]);
+                const Scalar sn = std::sin(omega * t[k]);
+                const Scalar px = x[k] - c[0], py = y[k] - c[1];
+                ox[k] = px * cs - py * sn + c[0];
+                oy[k] = px * sn + py * cs + c[1];
+            }
+        } else {
+            const Scalar ux = c[dim + 1], uy = c[dim + 2], uz = c[dim + 3];
+            const Scalar *x = reg(inst.in0), *y = reg(inst.in0 + 1), *z = reg(inst.in0 + 2);
+            Scalar *ox = reg(inst.out), *oy = reg(inst.out + 1), *oz = reg(inst.out + 2);
+            for (size_t k = 0; k < count; ++k) {
+                const Scalar cs = std::cos(omega * t[k]);
+                const Scalar sn = std::sin(omega * t[k]);
+                const Scalar oc = 1 - cs;
+                const Scalar px = x[k] - c[0], py = y[k] - c[1], pz = z[k] - c[2];
+                ox[k] = px * (cs + ux * ux * oc) + py * (ux * uy * oc - uz * sn) +
+                        pz * (ux * uz * oc + uy * sn) + c[0];
+                oy[k] = px * (uy * ux * oc + uz * sn) + py * (cs + uy * uy * oc) +
+                        pz * (uy * uz * oc - ux * sn) + c[1];
+                oz[k] = px * (uz * ux * oc - uy * sn) + py * (uz * uy * oc + ux * sn) +
+                        pz * (cs + uz * uz * oc) + c[2];
+            }
+        }
+    }
+
+    template <typename Reg>
+    static void run_ball(
+        const Scalar* c,
+        Reg reg,
+        const TapeInstruction<dim, Scalar>& inst,
+        size_t count)
+    {
+        // Constants: center (dim), radius^degree, degree.
+        Scalar* out = reg(inst.out);
+        std::fill_n(out, count, Scalar(0));
+        for (int i = 0; i < dim; ++i) {
+            const Scalar* p = reg(inst.in0 + i);
+            for (size_t k = 0; k < count; ++k) out[k] += (p[k] - c[i]) * (p[k] - c[i]);
+        }
+        const Scalar degree = c[dim + 1];
+        for (size_t k = 0; k < count; ++k) {
+            const Scalar r = std::sqrt(out[k]);
+            out[k] = (degree == 1 ? r : std::pow(r, degree)) - c[dim];
+        }
+    }
+
+    template <typename Reg>
+    static void run_capsule(
+        const Scalar* c,
+        Reg reg,
+        const TapeInstruction<dim, Scalar>& inst,
+        size_t count)
+    {
+        // Constants: p1 (dim), p2 - p1 (dim), 1 / |p2 - p1|², radius.
+        Scalar* out = reg(inst.out);
+        const Scalar* d = c + dim;
+        for (size_t k = 0; k < count; ++k) {
+            Scalar s = 0;
+            for (int i = 0; i < dim; ++i) s += (reg(inst.in0 + i)[k] - c[i]) * d[i];
+            s = std::max(Scalar(0), std::min(Scalar(1), s * c[2 * dim]));
+
+            Scalar distance_squared = 0;
+            for (int i = 0; i < dim; ++i) {
+                Scalar diff = reg(inst.in0 + i)[k] - (c[i] + s * d[i]);
+                distance_squared += diff * diff;
+            }
+            out[k] = std::sqrt(distance_squared) - c[2 * dim + 1];
+        }
+    }
+
+private:
+    /**
+     * @brief Lowers a space-time function evaluated at the position in registers [pos, pos + dim).
+     *
+     * @return The register holding the function value
+     */
+    uint32_t lower(const SpaceTimeFunction<dim, Scalar>& f, uint32_t pos)
+    {
+        if (auto tape = dynamic_cast<const Tape*>(&f)) {
+            return lower(tape->m_source, pos);
+        }
+        if (auto sweep = dynamic_cast<const SweepFunction<dim, Scalar>*>(&f)) {
+            const uint32_t transformed = lower_transform(sweep->transform(), pos);
+            const uint32_t result = lower_implicit(sweep->implicit_function(), transformed);
+            release(transformed, dim);
+            return result;
+        }
+        if (auto op = dynamic_cast<const UnionFunction<dim, Scalar>*>(&f)) {
+            const uint32_t a = lower(op->first(), pos);
+            const uint32_t b = lower(op->second(), pos);
+            if (op->smooth_distance() > 0) {
+                return emit_binary(TapeOp::SoftMinQuadratic, a, b, {op->smooth_distance() * 4});
+            }
+            return emit_binary(TapeOp::Min, a, b, {});
+        }
+        if (auto op = dynamic_cast<const NaryUnionFunction<dim, Scalar>*>(&f)) {
+            std::vector<uint32_t> inputs;
+            for (size_t i = 0; i < op->size(); ++i) inputs.push_back(lower(op->function(i), pos));
+            if (op->smooth_distance() > 0) {
+                return emit_nary_union(TapeOp::SoftMinQuadratic, inputs, op->smooth_distance() * 4);
+            }
+            return emit_nary_union(TapeOp::Min, inputs, 0);
+        }
+        if (auto op = dynamic_cast<const OffsetFunction<dim, Scalar>*>(&f)) {
+            const uint32_t a = lower(op->base(), pos);
+            TapeInstruction<dim, Scalar> inst{TapeOp::Offset};
+            inst.in0 = a;
+            inst.callback = &op->offset_function();
+            release(a, 1);
+            inst.out = allocate(1);
+            m_instructions.push_back(inst);
+            return inst.out;
+        }
+        if (auto op = dynamic_cast<const InterpolateFunction<dim, Scalar>*>(&f)) {
+            const uint32_t a = lower(op->first(), pos);
+            const uint32_t b = lower(op->second(), pos);
+            TapeInstruction<dim, Scalar> inst{TapeOp::Interpolate};
+            inst.in0 = a;
+            inst.in1 = b;
+            inst.callback = &op->interpolation_function();
+            release(a, 1);
+            release(b, 1);
+            inst.out = allocate(1);
+            m_instructions.push_back(inst);
+            return inst.out;
+        }
+#ifdef STF_YAML_PARSER_ENABLED
+        if constexpr (std::is_same_v<Scalar, stf::Scalar>) {
+            if (auto managed = dynamic_cast<const ManagedSpaceTimeFunction<dim>*>(&f)) {
+                return lower(managed->function(), pos);
+            }
+        }
+#endif
+
+        TapeInstruction<dim, Scalar> inst{TapeOp::FunctionCall};
+        inst.in0 = pos;
+        inst.function = &f;
+        inst.out = allocate(1);
+        m_instructions.push_back(inst);
+        return inst.out;
+    }
+
+    /**
+     * @brief Lowers a transform applied to the position in registers [pos, pos + dim).
+     *
+     * @return The first of the dim registers holding the transformed position
+     */
+    uint32_t lower_transform(const Transform<dim, Scalar>& transform, uint32_t pos)
+    {
+        if (auto compose = dynamic_cast<const Compose<dim, Scalar>*>(&transform)) {
+            const uint32_t intermediate = lower_transform(compose->first(), pos);
+            const uint32_t result = lower_transform(compose->second(), intermediate);
+            release(intermediate, dim);
+            return result;
+        }
+
+        TapeInstruction<dim, Scalar> inst{TapeOp::TransformCall};
+        inst.in0 = pos;
+        inst.constants = static_cast<uint32_t>(m_constants.size());
+        if (auto op = dynamic_cast<const Translation<dim, Scalar>*>(&transform)) {
+            inst.op = TapeOp::Translate;
+            push_constants(op->translation());
+        } else if (auto op = dynamic_cast<const Rotation<dim, Scalar>*>(&transform)) {
+            inst.op = TapeOp::Rotate;
+            push_constants(op->center());
+            m_constants.push_back(Scalar(op->angle() * std::numbers::pi / 180));
+            if constexpr (dim == 3) {
+                const auto& axis = op->axis();
+                const Scalar len =
+                    std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+                push_constants(std::array<Scalar, 3>{axis[0] / len, axis[1] / len, axis[2] / len});
+            }
+        } else if (auto op = dynamic_cast<const Scale<dim, Scalar>*>(&transform)) {
+            inst.op = TapeOp::Scale;
+            push_constants(op->factors());
+            push_constants(op->center());
+        } else {
+            inst.transform = &transform;
+        }
+        inst.out = allocate(dim);
+        m_instructions.push_back(inst);
+        return inst.out;
+    }
+
+    /**
+     * @brief Lowers an implicit function evaluated at the position in registers [pos, pos + dim).
+     *
+     * @return The register holding the function value
+     */
+    uint32_t lower_implicit(const ImplicitFunction<dim, Scalar>& f, uint32_t pos)
+    {
+        if (auto ball = dynamic_cast<const ImplicitBall<dim, Scalar>*>(&f)) {
+            TapeInstruction<dim, Scalar> inst{TapeOp::Ball};
+            inst.in0 = pos;
+            inst.constants = static_cast<uint32_t>(m_constants.size());
+            push_constants(ball->center());
+            m_constants.push_back(std::pow(ball->radius(), Scalar(ball->degree())));
+            m_constants.push_back(Scalar(ball->degree()));
+            inst.out = allocate(1);
+            m_instructions.push_back(inst);
+            return inst.out;
+        }
+        if (auto capsule = dynamic_cast<const ImplicitCapsule<dim, Scalar>*>(&f)) {
+            TapeInstruction<dim, Scalar> inst{TapeOp::Capsule};
+            inst.in0 = pos;
+            inst.constants = static_cast<uint32_t>(m_constants.size());
+            std::array<Scalar, dim> d;
+            Scalar dd = 0;
+            for (int i = 0; i < dim; ++i) {
+                d[i] = capsule->p2()[i] - capsule->p1()[i];
+                dd += d[i] * d[i];
+            }
+            push_constants(capsule->p1());
+            push_constants(d);
+            m_constants.push_back(1 / dd);
+            m_constants.push_back(capsule->radius());
+            inst.out = allocate(1);
+            m_instructions.push_back(inst);
+            return inst.out;
+        }
+        if (auto result = lower_implicit_union<BlendingFunction::Quadratic>(f, pos, 4.0)) {
+            return *result;
+        }
+        if (auto result = lower_implicit_union<BlendingFunction::Cubic>(f, pos, 6.0)) {
+            return *result;
+        }
+        if (auto result = lower_implicit_union<BlendingFunction::Quartic>(f, pos, 16.0 / 3.0)) {
+            return *result;
+        }
+        if (auto result = lower_implicit_union<BlendingFunction::Circular>(
+                f,
+                pos,
+                1.0 / (1.0 - std::sqrt(0.5)))) {
+            return *result;
+        }
+
+        TapeInstruction<dim, Scalar> inst{TapeOp::ImplicitCall};
+        inst.in0 = pos;
+        inst.implicit = &f;
+        inst.out = allocate(1);
+        m_instructions.push_back(inst);
+        return inst.out;
+    }
+
+    /**
+     * @brief Lowers f if it is an ImplicitUnion or an ImplicitNaryUnion with the given blending
+     * function.
+     *
+     * @param k_factor Ratio between the blending width k and the smooth distance
+     */
+    template <BlendingFunction blending>
+    std::optional<uint32_t>
+    lower_implicit_union(const ImplicitFunction<dim, Scalar>& f, uint32_t pos, Scalar k_factor)
+    {
+        TapeOp code = TapeOp::SoftMinQuadratic;
+        if constexpr (blending == BlendingFunction::Cubic) code = TapeOp::SoftMinCubic;
+        if constexpr (blending == BlendingFunction::Quartic) code = TapeOp::SoftMinQuartic;
+        if constexpr (blending == BlendingFunction::Circular) code = TapeOp::SoftMinCircular;
+
+        if (auto op = dynamic_cast<const ImplicitNaryUnion<dim, blending, Scalar>*>(&f)) {
+            std::vector<uint32_t> inputs;
+            for (size_t i = 0; i < op->size(); ++i) {
+                inputs.push_back(lower_implicit(op->function(i), pos));
+            }
+            if (op->smooth_distance() <= 0) return emit_nary_union(TapeOp::Min, inputs, 0);
+            return emit_nary_union(code, inputs, op->smooth_distance() * k_factor);
+        }
+
+        auto op = dynamic_cast<const ImplicitUnion<dim, blending, Scalar>*>(&f);
+        if (op == nullptr) return std::nullopt;
+
+        const uint32_t a = lower_implicit(op->first(), pos);
+        const uint32_t b = lower_implicit(op->second(), pos);
+        if (op->smooth_distance() <= 0) return emit_binary(TapeOp::Min, a, b, {});
+        return emit_binary(code, a, b, {op->smooth_distance() * k_factor});
+    }
+
+    /**
+     * @brief Emits a binary value operation and releases its operands.
+     */
+    uint32_t emit_binary(TapeOp op, uint32_t a, uint32_t b, std::initializer_list<Scalar> constants)
+    {
+        TapeInstruction<dim, Scalar> inst{op};
+        inst.in0 = a;
+        inst.in1 = b;
+        inst.constants = static_cast<uint32_t>(m_constants.size());
+        m_constants.insert(m_constants.end(), constants);
+        release(a, 1);
+        release(b, 1);
+        inst.out = allocate(1);
+        m_instructions.push_back(inst);
+        return inst.out;
+    }
+
+    /**
+     * @brief Emits the union of the values in `inputs` and releases them.
+     *
+     * A sharp union is order-independent and becomes a chain of Min instructions; a smooth one
+     * becomes a single NaryUnion instruction folding the sorted inputs with `blend`.
+     *
+     * @param k The blending width of `blend`
+     */
+    uint32_t emit_nary_union(TapeOp blend, const std::vector<uint32_t>& inputs, Scalar k)
+    {
+        if (inputs.size() == 1) return inputs.front();
+        if (blend == TapeOp::Min) {
+            uint32_t result = inputs.front();
+            for (size_t i = 1; i < inputs.size(); ++i) {
+                result = emit_binary(TapeOp::Min, result, inputs[i], {});
+            }
+            return result;
+        }
+
+        TapeInstruction<dim, Scalar> inst{TapeOp::NaryUnion};
+        inst.blend = blend;
+        inst.in0 = static_cast<uint32_t>(m_inputs.size());
+        inst.num_inputs = static_cast<uint32_t>(inputs.size());
+        m_max_inputs = std::max<size_t>(m_max_inputs, inputs.size());
+        inst.constants = static_cast<uint32_t>(m_constants.size());
+        m_constants.push_back(k);
+        m_inputs.insert(m_inputs.end(), inputs.begin(), inputs.end());
+        for (uint32_t r : inputs) release(r, 1);
+        inst.out = allocate(1);
+        m_instructions.push_back(inst);
+        return inst.out;
+    }
+
+    template <size_t n>
+    void push_constants(const std::array<Scalar, n>& values)
+    {
+        m_constants.insert(m_constants.end(), values.begin(), values.end());
+    }
+
+    /**
+     * @brief Allocates `count` consecutive registers, reusing released ones when possible.
+     *
+     * Every instruction reads its operands before writing its output, so an operand released
+     * just before allocating the output may be reused in place.
+     */
+    uint32_t allocate(uint32_t count)
+    {
+        auto& pool = count == 1 ? m_free_values : m_free_positions;
+        if (!pool.empty()) {
+            const uint32_t r = pool.back();
+            pool.pop_back();
+            return r;
+        }
+        const auto r = static_cast<uint32_t>(m_num_registers);
+        m_num_registers += count;
+        return r;
+    }
+
+    /**
+     * @brief Returns registers to the allocator. Input registers are never released.
+     */
+    void release(uint32_t r, uint32_t count)
+    {
+        if (r <= dim) return;
+        (count == 1 ? m_free_values : m_free_positions).push_back(r);
+    }
+
+private:
+    const SpaceTimeFunction<dim, Scalar>& m_source; ///< The compiled graph
+    std::vector<TapeInstruction<dim, Scalar>> m_instructions; ///< The instruction tape
+    std::vector<Scalar> m_constants; ///< Constant pool shared by all instructions
+    std::vector<uint32_t> m_inputs; ///< Input registers of the n-ary instructions
+    size_t m_num_registers = 0; ///< Size of the register file, in columns
+    size_t m_max_inputs = 0; ///< Largest number of inputs of an n-ary instruction
+    uint32_t m_result = 0; ///< Register holding the final value
+
+    std::vector<uint32_t> m_free_values; ///< Released single registers
+    std::vector<uint32_t> m_free_positions; ///< Released blocks of dim registers
+};
+
+} // namespace stf
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/transforms/transform.h>
 
@@ -17,8 +18,8 @@ namespace stf {
  *
  * @tparam dim The dimensionality of the space (2D or 3D)
  */
-template <int dim>
-class Compose : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class Compose : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -27,7 +28,7 @@ public:
      * @param transform1 The first transformation to apply
      * @param transform2 The second transformation to apply
      */
-    Compose(Transform<dim>& transform1, Transform<dim>& transform2)
+    Compose(Transform<dim, Scalar>& transform1, Transform<dim, Scalar>& transform2)
         : m_transform1(transform1)
         , m_transform2(transform2)
     {}
@@ -40,29 +41,7 @@ public:
 
     std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const override
     {
-        auto intermediate = m_transform1.transform(pos, t);
-        const auto v1 = m_transform1.velocity(pos, t);
-        const auto v2 = m_transform2.velocity(intermediate, t);
-        const auto J2 = m_transform2.position_Jacobian(intermediate, t);
-
-        // result = v2 + J2 * v1
-        std::array<Scalar, dim> result;
-
-        if constexpr (dim == 3) {
-            result = {
-                v2[0] + J2[0][0] * v1[0] + J2[0][1] * v1[1] + J2[0][2] * v1[2],
-                v2[1] + J2[1][0] * v1[0] + J2[1][1] * v1[1] + J2[1][2] * v1[2],
-                v2[2] + J2[2][0] * v1[0] + J2[2][1] * v1[1] + J2[2][2] * v1[2],
-            };
-        } else {
-            static_assert(dim == 2, "Composite transform is only implemented for 2D and 3D");
-            result = {
-                v2[0] + J2[0][0] * v1[0] + J2[0][1] * v1[1],
-                v2[1] + J2[1][0] * v1[0] + J2[1][1] * v1[1],
-            };
-        }
-
-        return result;
+        return evaluate(pos, t).velocity;
     }
 
     std::array<std::array<Scalar, dim>, dim> position_Jacobian(
@@ -85,9 +64,154 @@ public:
         return J;
     }
 
+    /**
+     * @brief Bounds the composition by bounding the second transform over the bounds of the first.
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return m_transform2.transform_bounds(m_transform1.transform_bounds(box, t), t);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the composition with the chain rule.
+     *
+     * The second transform is bounded over the bounds of the first: the Jacobian norm is at most
+     * L2 L1 and the speed at most v2 + L2 v1.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        const auto L1 = m_transform1.lipschitz_bound(box, t);
+        const auto L2 = m_transform2.lipschitz_bound(m_transform1.transform_bounds(box, t), t);
+        return {
+            lipschitz_product(L2.spatial, L1.spatial),
+            L2.temporal + lipschitz_product(L2.spatial, L1.temporal)};
+    }
+
+    /**
+     * @brief Pulls the box back through the second transform, then through the first.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return m_transform1.inverse_transform_bounds(
+            m_transform2.inverse_transform_bounds(box, t),
+            t);
+    }
+
+    bool is_affine() const override { return m_transform1.is_affine() && m_transform2.is_affine(); }
+
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const auto e1 = m_transform1.evaluate(pos, t);
+        const auto e2 = m_transform2.evaluate(e1.position, t);
+
+        TransformEvaluation<dim, Scalar> result{e2.position, e2.velocity, {}};
+        for (int i = 0; i < dim; ++i) {
+            // velocity = v2 + J2 * v1
+            for (int k = 0; k < dim; ++k) result.velocity[i] += e2.jacobian[i][k] * e1.velocity[k];
+
+            // Jacobian = J2 * J1
+            for (int j = 0; j < dim; ++j) {
+                Scalar sum = 0;
+                for (int k = 0; k < dim; ++k) sum += e2.jacobian[i][k] * e1.jacobian[k][j];
+                result.jacobian[i][j] = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the second derivatives of the composition.
+     *
+     * With A1 the space-time Jacobian of (x, t) -> (T1(x, t), t), the Hessian of the i-th output
+     * is A1ᵀ H2_i A1 + Σ_k (∂T2_i/∂y_k) H1_k.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const auto e1 = m_transform1.evaluate(pos, t);
+        const auto e2 = m_transform2.evaluate(e1.position, t);
+        const auto H1 = m_transform1.hessian(pos, t);
+        const auto H2 = m_transform2.hessian(e1.position, t);
+
+        std::array<std::array<Scalar, dim + 1>, dim + 1> A1{};
+        for (int p = 0; p < dim; ++p) {
+            for (int a = 0; a < dim; ++a) A1[p][a] = e1.jacobian[p][a];
+            A1[p][dim] = e1.velocity[p];
+        }
+        A1[dim][dim] = 1;
+
+        TransformHessian<dim, Scalar> H{};
+        for (int i = 0; i < dim; ++i) {
+            // M = H2_i A1
+            std::array<std::array<Scalar, dim + 1>, dim + 1> M{};
+            for (int p = 0; p <= dim; ++p) {
+                for (int b = 0; b <= dim; ++b) {
+                    for (int q = 0; q <= dim; ++q) M[p][b] += H2[i][p][q] * A1[q][b];
+                }
+            }
+            for (int a = 0; a <= dim; ++a) {
+                for (int b = 0; b <= dim; ++b) {
+                    Scalar sum = 0;
+                    for (int p = 0; p <= dim; ++p) sum += A1[p][a] * M[p][b];
+                    for (int k = 0; k < dim; ++k) sum += e2.jacobian[i][k] * H1[k][a][b];
+                    H[i][a][b] = sum;
+                }
+            }
+        }
+        return H;
+    }
+
+    void transform_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        ColumnBuffer<dim, Scalar> intermediate(t.size());
+        m_transform1.transform_batch(pos, t, intermediate.columns());
+        m_transform2.transform_batch(intermediate.const_columns(), t, out);
+    }
+
+    void velocity_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        ColumnBuffer<dim, Scalar> intermediate(t.size());
+        ColumnBuffer<dim, Scalar> v1(t.size());
+        m_transform1.transform_batch(pos, t, intermediate.columns());
+        m_transform1.velocity_batch(pos, t, v1.columns());
+        m_transform2.velocity_batch(intermediate.const_columns(), t, out);
+
+        // result = v2 + J2 * v1
+        const auto q = intermediate.const_columns();
+        const auto v = v1.const_columns();
+        for (size_t k = 0; k < t.size(); ++k) {
+            const auto J2 = m_transform2.position_Jacobian(gather(q, k), t[k]);
+            for (int i = 0; i < dim; ++i) {
+                for (int j = 0; j < dim; ++j) out[i][k] += J2[i][j] * v[j][k];
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Get the first transformation.
+     */
+    const Transform<dim, Scalar>& first() const { return m_transform1; }
+
+    /**
+     * @brief Get the second transformation.
+     */
+    const Transform<dim, Scalar>& second() const { return m_transform2; }
+
 private:
-    Transform<dim>& m_transform1; ///< First transformation
-    Transform<dim>& m_transform2; ///< Second transformation
+    Transform<dim, Scalar>& m_transform1; ///< First transformation
+    Transform<dim, Scalar>& m_transform2; ///< Second transformation
 };
 
 } // namespace stf
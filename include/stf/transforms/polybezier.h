@@ -4,8 +4,12 @@
 #include <stf/maths/all.h>
 #include <stf/transforms/transform.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
 #include <stdexcept>
 #include <tuple>
 #include <vector>
@@ -22,8 +26,8 @@ namespace stf {
  *
  * @tparam dim The dimension of the space (2 or 3)
  */
-template <int dim>
-class PolyBezier : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class PolyBezier : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -40,7 +44,7 @@ public:
      * @return A PolyBezier object representing the constructed curve.
      * @throws std::runtime_error If fewer than 3 sample points are provided.
      */
-    static PolyBezier<dim> from_samples(
+    static PolyBezier<dim, Scalar> from_samples(
         std::vector<std::array<Scalar, dim>> samples,
         bool follow_tangent = true)
     {
@@ -209,7 +213,7 @@ public:
      * @return The Jacobian matrix of the transformation
      */
     std::array<std::array<Scalar, dim>, dim> position_Jacobian(
-        std::array<Scalar, dim> pos,
+        std::array<Scalar, dim> /*pos*/,
         Scalar t) const override
     {
         if (m_follow_tangent) {
@@ -225,6 +229,166 @@ public:
         }
     }
 
+    /**
+     * @brief Computes the second derivatives of the transformation.
+     *
+     * Without tangent following, the transform is a translation along the curve and the only
+     * non-zero term is the acceleration. The rotating Bishop frame falls back to the finite
+     * difference implementation.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        if (m_follow_tangent) return Transform<dim, Scalar>::hessian(pos, t);
+
+        const size_t num_beziers = (m_points.size() - 1) / 3;
+        auto [segment, alpha] = find_bezier(t);
+        std::span<const std::array<Scalar, dim>, 4> control_points{
+            m_points.data() + segment * 3,
+            4};
+        const auto acceleration = bezier_second_derivative(control_points, alpha);
+
+        TransformHessian<dim, Scalar> H{};
+        for (int i = 0; i < dim; ++i) {
+            H[i][dim][dim] = -acceleration[i] * Scalar(num_beziers * num_beziers);
+        }
+        return H;
+    }
+
+    /**
+     * @brief Bounds the transformed box over a time interval.
+     *
+     * The curve point of each overlapping segment is bounded by evaluating its Bernstein form on
+     * the local parameter interval. Without tangent following the transform is a translation by
+     * the curve point. With it, the rotating frame is only known to be orthonormal, so each
+     * coordinate is bounded by the largest distance between the box and the curve bounds.
+     *
+     * @param box The input box
+     * @param t The parameter interval along the curve
+     * @return A box containing the transformed positions
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        const auto curve = curve_bounds(t, 0);
+        IntervalBox<dim, Scalar> result;
+        for (int i = 0; i < dim; ++i) result[i] = box[i] - curve[i];
+        if (m_follow_tangent) {
+            Interval<Scalar> distance2(0);
+            for (int i = 0; i < dim; ++i) distance2 += sqr(result[i]);
+            const Scalar radius = std::sqrt(distance2.upper);
+            result.fill({-radius, radius});
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bound the rates of change over a time interval.
+     *
+     * The Jacobian is the identity or an orthonormal frame, so the spatial constant is 1. Without
+     * tangent following the velocity is the curve derivative. With it, the frame rotates at a
+     * rate bounded by the curve acceleration over its speed, which adds a term proportional to
+     * the distance between the box and the curve; the bound is infinite if the curve speed may
+     * vanish.
+     *
+     * @param box The input box
+     * @param t The parameter interval along the curve
+     * @return The Lipschitz constants of the transform
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        const Scalar num_beziers = Scalar((m_points.size() - 1) / 3);
+        const auto speed = norm_bounds(curve_bounds(t, 1));
+        if (!m_follow_tangent) return {1, num_beziers * speed.upper};
+        if (speed.lower <= 0) return {1, std::numeric_limits<Scalar>::infinity()};
+
+        const auto curve = curve_bounds(t, 0);
+        IntervalBox<dim, Scalar> offset;
+        for (int i = 0; i < dim; ++i) offset[i] = box[i] - curve[i];
+        const Scalar rotation_rate = std::sqrt(Scalar(dim)) *
+                                     norm_bounds(curve_bounds(t, 2)).upper / speed.lower *
+                                     std::max(Scalar(1), speed.upper);
+        return {1, num_beziers * (rotation_rate * norm_bounds(offset).upper + speed.upper)};
+    }
+
+    /**
+     * @brief Bounds the positions mapped into a box over a time interval.
+     *
+     * The inverse maps a local position y to F y + B(t), with F the identity or an orthonormal
+     * frame. Without tangent following the result is the box moved by the curve bounds; with it,
+     * each coordinate of F y is bounded by the largest norm of y.
+     *
+     * @param box The box of local positions
+     * @param t The parameter interval along the curve
+     * @return A box containing the preimage of the box
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        const auto curve = curve_bounds(t, 0);
+        const Scalar radius = norm_bounds(box).upper;
+        IntervalBox<dim, Scalar> result;
+        for (int i = 0; i < dim; ++i) {
+            result[i] = curve[i] + (m_follow_tangent ? Interval<Scalar>(-radius, radius) : box[i]);
+        }
+        return result;
+    }
+
+    bool is_affine() const override { return true; }
+
+    /**
+     * @brief Computes the transformed position, velocity and Jacobian together.
+     *
+     * The Bezier segment lookup, curve derivatives and Bishop frame are evaluated once and shared
+     * by the three outputs.
+     *
+     * @param pos The input position
+     * @param t The parameter along the curve [0,1]
+     * @return The transformed position, velocity and Jacobian
+     */
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const size_t num_beziers = (m_points.size() - 1) / 3;
+        auto [segment, alpha] = find_bezier(t);
+
+        std::span<const std::array<Scalar, dim>, 4> control_points{
+            m_points.data() + segment * 3,
+            4};
+        auto bezier_point = bezier(control_points, alpha);
+        auto bezier_velocity = bezier_derivative(control_points, alpha);
+
+        TransformEvaluation<dim, Scalar> result{};
+        if (m_follow_tangent) {
+            auto bezier_acceleration = bezier_second_derivative(control_points, alpha);
+            auto frame = get_frame(segment, alpha);
+            auto frame_derivative =
+                get_frame_derivative(frame, bezier_velocity, bezier_acceleration);
+            auto frame_T = transpose(frame);
+
+            for (int i = 0; i < dim; ++i) {
+                pos[i] -= bezier_point[i];
+            }
+            result.position = apply_matrix(frame_T, pos);
+            result.jacobian = frame_T;
+
+            auto p = apply_matrix(frame_T, apply_matrix(frame_derivative, result.position));
+            auto v = apply_matrix(frame_T, bezier_velocity);
+            for (int i = 0; i < dim; i++) {
+                result.velocity[i] = (-p[i] - v[i]) * num_beziers;
+            }
+        } else {
+            for (int i = 0; i < dim; ++i) {
+                result.position[i] = pos[i] - bezier_point[i];
+                result.velocity[i] = -bezier_velocity[i] * num_beziers;
+                result.jacobian[i][i] = 1;
+            }
+        }
+        return result;
+    }
+
 private:
     /**
      * @brief Finds the Bezier segment and local parameter for a given curve parameter.
@@ -245,6 +409,68 @@ private:
         return {segment, alpha};
     }
 
+    /**
+     * @brief Bounds the curve or one of its derivatives over a parameter interval.
+     *
+     * Each overlapping segment is evaluated in Bernstein form on its local parameter interval and
+     * the results are merged. Derivatives are with respect to the local parameter alpha.
+     *
+     * @param t The parameter interval along the curve
+     * @param order The derivative order: 0 for the curve point, 1 or 2 for its derivatives
+     * @return A box containing the curve point or derivative
+     */
+    IntervalBox<dim, Scalar> curve_bounds(Interval<Scalar> t, int order) const
+    {
+        const size_t num_beziers = (m_points.size() - 1) / 3;
+        const auto first = std::get<0>(find_bezier(std::clamp(t.lower, Scalar(0), Scalar(1))));
+        const auto last = std::get<0>(find_bezier(std::clamp(t.upper, Scalar(0), Scalar(1))));
+
+        IntervalBox<dim, Scalar> result;
+        for (size_t segment = first; segment <= last; ++segment) {
+            // The first and last beziers extrapolate beyond [0, 1].
+            Interval<Scalar> segment_t = t;
+            if (segment > 0) {
+                segment_t.lower = std::max(t.lower, Scalar(segment) / num_beziers);
+            }
+            if (segment + 1 < num_beziers) {
+                segment_t.upper = std::min(t.upper, Scalar(segment + 1) / num_beziers);
+            }
+            const auto alpha = segment_t * Scalar(num_beziers) - Scalar(segment);
+            const auto beta = 1 - alpha;
+
+            // Control points of the derivative curve, scaled by the derivative factor.
+            const auto* P = m_points.data() + segment * 3;
+            std::array<std::array<Scalar, dim>, 4> control;
+            for (int i = 0; i < dim; ++i) {
+                for (int k = 0; k < 4 - order; ++k) {
+                    if (order == 0) {
+                        control[k][i] = P[k][i];
+                    } else if (order == 1) {
+                        control[k][i] = 3 * (P[k + 1][i] - P[k][i]);
+                    } else {
+                        control[k][i] = 6 * (P[k + 2][i] - 2 * P[k + 1][i] + P[k][i]);
+                    }
+                }
+            }
+
+            std::array<Interval<Scalar>, 4> basis;
+            if (order == 0) {
+                basis = {pow(beta, 3), 3 * sqr(beta) * alpha, 3 * beta * sqr(alpha), pow(alpha, 3)};
+            } else if (order == 1) {
+                basis = {sqr(beta), 2 * beta * alpha, sqr(alpha), Scalar(0)};
+            } else {
+                basis = {beta, alpha, Scalar(0), Scalar(0)};
+            }
+
+            for (int i = 0; i < dim; ++i) {
+                Interval<Scalar> coordinate(0);
+                for (int k = 0; k < 4 - order; ++k) coordinate += basis[k] * control[k][i];
+                result[i] = segment == first ? coordinate : hull(result[i], coordinate);
+            }
+        }
+        return result;
+    }
+
     /**
      * @brief Gets the Bishop frame at a given segment and parameter.
      *
@@ -304,16 +530,16 @@ private:
             auto [N1, N2, T] = transpose(frame);
 
             auto acc_T = dot(bezier_acceleration, T);
-            Vec3 dT{
+            Vector3<Scalar> dT{
                 (bezier_acceleration[0] - acc_T * T[0]) / bezier_speed,
                 (bezier_acceleration[1] - acc_T * T[1]) / bezier_speed,
                 (bezier_acceleration[2] - acc_T * T[2]) / bezier_speed};
             Scalar kappa1 = dot(dT, N1);
             Scalar kappa2 = dot(dT, N2);
-            Vec3 dN1{-kappa1 * T[0], -kappa1 * T[1], -kappa1 * T[2]};
-            Vec3 dN2{-kappa2 * T[0], -kappa2 * T[1], -kappa2 * T[2]};
+            Vector3<Scalar> dN1{-kappa1 * T[0], -kappa1 * T[1], -kappa1 * T[2]};
+            Vector3<Scalar> dN2{-kappa2 * T[0], -kappa2 * T[1], -kappa2 * T[2]};
 
-            Mat3 result;
+            Matrix3<Scalar> result;
             result[0] = {dN1[0], dN2[0], dT[0]};
             result[1] = {dN1[1], dN2[1], dT[1]};
             result[2] = {dN1[2], dN2[2], dT[2]};
@@ -323,13 +549,13 @@ private:
             auto [N1, T] = transpose(frame);
 
             auto acc_T = dot(bezier_acceleration, T);
-            Vec2 dT{
+            Vector2<Scalar> dT{
                 (bezier_acceleration[0] - acc_T * T[0]) / bezier_speed,
                 (bezier_acceleration[1] - acc_T * T[1]) / bezier_speed};
             Scalar kappa = bezier_speed * dot(dT, N1);
-            Vec2 dN1{-kappa * T[0], -kappa * T[1]};
+            Vector2<Scalar> dN1{-kappa * T[0], -kappa * T[1]};
 
-            Mat2 result;
+            Matrix2<Scalar> result;
             result[0] = {dN1[0], dT[0]};
             result[1] = {dN1[1], dT[1]};
             return result;
@@ -351,10 +577,10 @@ private:
         m_frames.reserve(num_beziers * m_frames_per_bezier);
 
         if constexpr (dim == 3) {
-            Vec3 from_vector{0, 0, 1}; // Align z-axis with the first segment.
-            Vec3 to_vector{0, 0, 0};
+            Vector3<Scalar> from_vector{0, 0, 1}; // Align z-axis with the first segment.
+            Vector3<Scalar> to_vector{0, 0, 0};
             for (size_t i = 0; i < num_beziers; ++i) {
-                std::span<const Vec3, 4> control_points{m_points.data() + i * 3, 4};
+                std::span<const Vector3<Scalar>, 4> control_points{m_points.data() + i * 3, 4};
                 for (size_t j = 0; j < m_frames_per_bezier; ++j) {
                     Scalar t = static_cast<Scalar>(j) / (m_frames_per_bezier - 1);
                     to_vector = bezier_derivative(control_points, t);
@@ -368,10 +594,10 @@ private:
                 }
             }
         } else if constexpr (dim == 2) {
-            Vec2 from_vector{0, 1}; // Align y-axis with the first segment.
-            Vec2 to_vector{0, 0};
+            Vector2<Scalar> from_vector{0, 1}; // Align y-axis with the first segment.
+            Vector2<Scalar> to_vector{0, 0};
             for (size_t i = 0; i < num_beziers; ++i) {
-                std::span<const Vec2, 4> control_points{m_points.data() + i * 3, 4};
+                std::span<const Vector2<Scalar>, 4> control_points{m_points.data() + i * 3, 4};
                 for (size_t j = 0; j < m_frames_per_bezier; ++j) {
                     Scalar t = static_cast<Scalar>(j) / (m_frames_per_bezier - 1);
                     to_vector = bezier_derivative(control_points, t);
@@ -4,6 +4,7 @@
 #include <stf/maths/all.h>
 #include <stf/transforms/transform.h>
 
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 #include <tuple>
@@ -23,8 +24,8 @@ namespace stf {
  *
  * @tparam dim The dimension of the space (2 or 3 supported).
  */
-template <int dim>
-class Polyline : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class Polyline : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -86,7 +87,7 @@ public:
      * @return The velocity vector at the given parameter.
      * @throws std::runtime_error if the polyline has fewer than 2 points.
      */
-    std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const override
+    std::array<Scalar, dim> velocity(std::array<Scalar, dim> /*pos*/, Scalar t) const override
     {
         if (m_points.size() < 2) {
             throw std::runtime_error("Polyline must consist of at least 2 points.");
@@ -113,7 +114,7 @@ public:
      * @throws std::runtime_error if the polyline has fewer than 2 points.
      */
     std::array<std::array<Scalar, dim>, dim> position_Jacobian(
-        std::array<Scalar, dim> pos,
+        std::array<Scalar, dim> /*pos*/,
         Scalar t) const override
     {
         if (m_points.size() < 2) {
@@ -124,6 +125,130 @@ public:
         return transpose(m_frames[segment]);
     }
 
+    /**
+     * @brief Each segment is traversed at constant velocity with a constant frame, so the
+     * second derivatives vanish away from the vertices.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> /*pos*/, Scalar /*t*/)
+        const override
+    {
+        return {};
+    }
+
+    /**
+     * @brief Bound the transformed box over a time interval.
+     *
+     * Each segment overlapping the time interval moves the box linearly under a constant frame;
+     * the bounds are the hull of the per-segment bounds.
+     *
+     * @param box The input box (local coordinates).
+     * @param t The parameter interval along the polyline.
+     * @return A box containing the transformed positions.
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        auto result = empty_box<dim, Scalar>();
+        for_each_segment(t, [&](size_t segment, Interval<Scalar> alpha) {
+            auto& p0 = m_points[segment];
+            auto& p1 = m_points[segment + 1];
+            IntervalBox<dim, Scalar> offset;
+            for (int i = 0; i < dim; ++i) offset[i] = box[i] - (p0[i] + alpha * (p1[i] - p0[i]));
+
+            const auto frame_T = transpose(m_frames[segment]);
+            std::array<std::array<Interval<Scalar>, dim>, dim> matrix;
+            for (int i = 0; i < dim; ++i) {
+                for (int j = 0; j < dim; ++j) matrix[i][j] = frame_T[i][j];
+            }
+            result = hull(result, affine_bounds(matrix, IntervalBox<dim, Scalar>{}, offset));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Bound the positions mapped into a box over a time interval.
+     *
+     * On each overlapping segment the inverse maps a local position y to F y + p(t), where F is
+     * the segment frame and p(t) the point moving along the segment.
+     *
+     * @param box The box of local positions.
+     * @param t The parameter interval along the polyline.
+     * @return A box containing the preimage of the box.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        auto result = empty_box<dim, Scalar>();
+        for_each_segment(t, [&](size_t segment, Interval<Scalar> alpha) {
+            auto& p0 = m_points[segment];
+            auto& p1 = m_points[segment + 1];
+            IntervalBox<dim, Scalar> point;
+            for (int i = 0; i < dim; ++i) point[i] = p0[i] + alpha * (p1[i] - p0[i]);
+
+            std::array<std::array<Interval<Scalar>, dim>, dim> matrix;
+            for (int i = 0; i < dim; ++i) {
+                for (int j = 0; j < dim; ++j) matrix[i][j] = m_frames[segment][i][j];
+            }
+            result = hull(result, affine_bounds(matrix, point, box));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Bound the rates of change over a time interval.
+     *
+     * The frames are orthonormal, so the Jacobian has unit norm. Each segment is traversed at
+     * constant speed; the temporal constant is the largest speed of the overlapping segments.
+     *
+     * @param box The input box (unused).
+     * @param t The parameter interval along the polyline.
+     * @return The Lipschitz constants of the transform.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> t) const override
+    {
+        const auto [first, last] = find_segments(t);
+        Scalar speed = 0;
+        for (size_t segment = first; segment <= last; ++segment) {
+            speed = std::max(speed, norm(subtract(m_points[segment + 1], m_points[segment])));
+        }
+        return {1, speed * (m_points.size() - 1)};
+    }
+
+    bool is_affine() const override { return true; }
+
+    /**
+     * @brief Compute the transformed position, velocity and Jacobian with a single segment lookup.
+     *
+     * @param pos The position to transform (local coordinates).
+     * @param t The parameter along the polyline in [0, 1].
+     * @return The transformed position, velocity and Jacobian at the given parameter.
+     * @throws std::runtime_error if the polyline has fewer than 2 points.
+     */
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        if (m_points.size() < 2) {
+            throw std::runtime_error("Polyline must consist of at least 2 points.");
+        }
+
+        auto [segment, alpha] = find_segment(t);
+
+        auto& p0 = m_points[segment];
+        auto& p1 = m_points[segment + 1];
+
+        std::array<Scalar, dim> velocity;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] -= p0[i] + alpha * (p1[i] - p0[i]);
+            velocity[i] = (p0[i] - p1[i]) * (m_points.size() - 1);
+        }
+
+        const auto frame_T = transpose(m_frames[segment]);
+        return {apply_matrix(frame_T, pos), apply_matrix(frame_T, velocity), frame_T};
+    }
+
 private:
     /**
      * @brief Find the segment and interpolation parameter for a given t.
@@ -143,6 +268,43 @@ private:
         return {segment, alpha};
     }
 
+    /**
+     * @brief Find the first and last segments visited over a parameter interval.
+     *
+     * @param t The parameter interval along the polyline.
+     * @return A tuple (first segment index, last segment index).
+     */
+    std::tuple<size_t, size_t> find_segments(Interval<Scalar> t) const
+    {
+        const auto first = std::get<0>(find_segment(std::clamp(t.lower, Scalar(0), Scalar(1))));
+        const auto last = std::get<0>(find_segment(std::clamp(t.upper, Scalar(0), Scalar(1))));
+        return {first, last};
+    }
+
+    /**
+     * @brief Visit the segments overlapping a parameter interval.
+     *
+     * @param t The parameter interval along the polyline.
+     * @param f Called as f(segment, alpha) with the range alpha of the local parameter.
+     */
+    template <typename F>
+    void for_each_segment(Interval<Scalar> t, F&& f) const
+    {
+        const size_t num_segments = m_points.size() - 1;
+        const auto [first, last] = find_segments(t);
+        for (size_t segment = first; segment <= last; ++segment) {
+            // The first and last segments extrapolate beyond [0, 1].
+            Interval<Scalar> segment_t = t;
+            if (segment > 0) {
+                segment_t.lower = std::max(t.lower, Scalar(segment) / num_segments);
+            }
+            if (segment + 1 < num_segments) {
+                segment_t.upper = std::min(t.upper, Scalar(segment + 1) / num_segments);
+            }
+            f(segment, segment_t * Scalar(num_segments) - Scalar(segment));
+        }
+    }
+
     /**
      * @brief Initialize identity frames for each segment of the polyline.
      *
@@ -179,8 +341,8 @@ private:
         m_frames.reserve(m_points.size() - 1);
 
         if constexpr (dim == 3) {
-            Vec3 from_vector{0, 0, 1}; // Align z-axis with the first segment.
-            Vec3 to_vector{0, 0, 0};
+            Vector3<Scalar> from_vector{0, 0, 1}; // Align z-axis with the first segment.
+            Vector3<Scalar> to_vector{0, 0, 0};
             for (size_t i = 0; i + 1 < m_points.size(); ++i) {
                 auto& p0 = m_points[i];
                 auto& p1 = m_points[i + 1];
@@ -194,8 +356,8 @@ private:
                 from_vector = to_vector;
             }
         } else if constexpr (dim == 2) {
-            Vec2 from_vector{0, 1}; // Align y-axis with the first segment.
-            Vec2 to_vector{0, 0};
+            Vector2<Scalar> from_vector{0, 1}; // Align y-axis with the first segment.
+            Vector2<Scalar> to_vector{0, 0};
             for (size_t i = 0; i < m_points.size() - 1; ++i) {
                 auto& p0 = m_points[i];
                 auto& p1 = m_points[i + 1];
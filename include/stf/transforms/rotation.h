@@ -1,11 +1,13 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/transforms/transform.h>
 
 #include <array>
-#include <span>
+#include <cmath>
 #include <numbers>
+#include <span>
 
 namespace stf {
 
@@ -19,8 +21,8 @@ namespace stf {
  *
  * @tparam dim The dimensionality of the space (2D or 3D)
  */
-template <int dim>
-class Rotation : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class Rotation : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -31,8 +33,8 @@ public:
      * @param angle The total angle of rotation in degrees (default: 360)
      */
     Rotation(std::array<Scalar, dim> center, std::array<Scalar, dim> axis, Scalar angle = 360)
-        : m_axis(axis)
-        , m_center(center)
+        : m_center(center)
+        , m_axis(axis)
         , m_angle(angle)
     {}
 
@@ -40,7 +42,7 @@ public:
     {
         if constexpr (dim == 3) {
             // Convert angle to radians
-            Scalar angle = t * m_angle * std::numbers::pi / 180.0;
+            Scalar angle = t * m_angle * std::numbers::pi_v<Scalar> / 180.0;
 
             // Normalize the axis
             Scalar axis_length = 0;
@@ -96,7 +98,7 @@ public:
             static_assert(dim == 2, "Rotation is only implemented for 2D and 3d");
 
             // Convert angle to radians
-            Scalar angle = t * m_angle * std::numbers::pi / 180.0;
+            Scalar angle = t * m_angle * std::numbers::pi_v<Scalar> / 180.0;
 
             pos[0] -= m_center[0];
             pos[1] -= m_center[1];
@@ -111,47 +113,7 @@ public:
 
     std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const override
     {
-        if constexpr (dim == 3) {
-            // Normalize the axis
-            Scalar axis_length = 0;
-            for (int i = 0; i < dim; ++i) {
-                axis_length += m_axis[i] * m_axis[i];
-            }
-            axis_length = std::sqrt(axis_length);
-
-            std::array<Scalar, dim> normalized_axis;
-            for (int i = 0; i < dim; ++i) {
-                normalized_axis[i] = m_axis[i] / axis_length;
-            }
-
-            pos = transform(pos, t);
-            // Translate point to origin
-            for (int i = 0; i < dim; ++i) {
-                pos[i] -= m_center[i];
-            }
-
-            // Cross product of axis and position gives the velocity direction
-            std::array<Scalar, dim> velocity;
-            velocity[0] = (normalized_axis[1] * pos[2] - normalized_axis[2] * pos[1]) * m_angle *
-                          std::numbers::pi / 180.0;
-            velocity[1] = (normalized_axis[2] * pos[0] - normalized_axis[0] * pos[2]) * m_angle *
-                          std::numbers::pi / 180.0;
-            velocity[2] = (normalized_axis[0] * pos[1] - normalized_axis[1] * pos[0]) * m_angle *
-                          std::numbers::pi / 180.0;
-
-            return velocity;
-        } else {
-            static_assert(dim == 2, "Rotation is only implemented for 2D and 3d");
-
-            pos = transform(pos, t);
-            pos[0] -= m_center[0];
-            pos[1] -= m_center[1];
-
-            return {
-                -pos[1] * m_angle * std::numbers::pi / 180.0,
-                pos[0] * m_angle * std::numbers::pi / 180.0,
-            };
-        }
+        return Rotation::evaluate(pos, t).velocity;
     }
 
     std::array<std::array<Scalar, dim>, dim> position_Jacobian(
@@ -159,7 +121,7 @@ public:
         Scalar t) const override
     {
         // rotation angle (rad)
-        const Scalar theta = t * m_angle * std::numbers::pi / 180.0;
+        const Scalar theta = t * m_angle * std::numbers::pi_v<Scalar> / 180.0;
         std::array<std::array<Scalar, dim>, dim> J{};
 
         // since theta and center do not depend on pos, the Jacobian is the
@@ -200,6 +162,219 @@ public:
         return J;
     }
 
+    /**
+     * @brief Computes the second derivatives of the rotation.
+     *
+     * With ω the angular speed and K the cross product with the unit axis, the rotation matrix
+     * R evolves as dR/dt = ω K R. The mixed terms are therefore ω K R and the acceleration is
+     * ω K v, where v is the velocity.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const auto e = Rotation::evaluate(pos, t);
+        const Scalar omega = m_angle * std::numbers::pi_v<Scalar> / 180.0;
+
+        TransformHessian<dim, Scalar> H{};
+        for (int j = 0; j < dim; ++j) {
+            std::array<Scalar, dim> column;
+            for (int i = 0; i < dim; ++i) column[i] = e.jacobian[i][j];
+            const auto rate = axis_cross(column);
+            for (int i = 0; i < dim; ++i) H[i][j][dim] = H[i][dim][j] = omega * rate[i];
+        }
+        const auto acceleration = axis_cross(e.velocity);
+        for (int i = 0; i < dim; ++i) H[i][dim][dim] = omega * acceleration[i];
+        return H;
+    }
+
+    /**
+     * @brief Bounds the rotated box over a time interval.
+     *
+     * The entries of the rotation matrix are bounded with interval sine and cosine of the angle
+     * range and applied to the offsets from the center.
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        const auto theta = t * (m_angle * std::numbers::pi_v<Scalar> / 180);
+        const auto c = cos(theta);
+        const auto s = sin(theta);
+
+        std::array<std::array<Interval<Scalar>, dim>, dim> R;
+        if constexpr (dim == 2) {
+            R = {{{c, -s}, {s, c}}};
+        } else {
+            const Scalar len =
+                std::sqrt(m_axis[0] * m_axis[0] + m_axis[1] * m_axis[1] + m_axis[2] * m_axis[2]);
+            const std::array<Scalar, 3> u{m_axis[0] / len, m_axis[1] / len, m_axis[2] / len};
+            const auto oc = 1 - c;
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) R[i][j] = u[i] * u[j] * oc;
+                R[i][i] = c * (1 - u[i] * u[i]) + u[i] * u[i];
+            }
+            R[0][1] -= u[2] * s;
+            R[0][2] += u[1] * s;
+            R[1][0] += u[2] * s;
+            R[1][2] -= u[0] * s;
+            R[2][0] -= u[1] * s;
+            R[2][1] += u[0] * s;
+        }
+
+        IntervalBox<dim, Scalar> offset;
+        IntervalBox<dim, Scalar> center;
+        for (int i = 0; i < dim; ++i) {
+            offset[i] = box[i] - m_center[i];
+            center[i] = m_center[i];
+        }
+        return affine_bounds(R, center, offset);
+    }
+
+    /**
+     * @brief A rotation is an isometry; points move at the angular speed times their distance to
+     * the center.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> /*t*/) const override
+    {
+        const Scalar omega = std::abs(m_angle) * std::numbers::pi_v<Scalar> / 180;
+        return {1, omega * distance_bounds(box, m_center).upper};
+    }
+
+    /**
+     * @brief The inverse of the rotation at time t is the rotation at time -t.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return Rotation::transform_bounds(box, -t);
+    }
+
+    bool is_affine() const override { return true; }
+
+    /**
+     * @brief Computes the rotated position, velocity and Jacobian together.
+     *
+     * The rotation matrix (and therefore the trigonometry) is evaluated once and shared by the
+     * three outputs.
+     */
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        TransformEvaluation<dim, Scalar> result;
+        result.jacobian = Rotation::position_Jacobian(pos, t);
+        result.position = rotate(result.jacobian, pos);
+        result.velocity = rotational_velocity(result.position);
+        return result;
+    }
+
+    /**
+     * @brief Rotates a batch of points.
+     *
+     * The rotation matrix only depends on time, so it is rebuilt only when the time changes
+     * between consecutive points.
+     */
+    void transform_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        std::array<std::array<Scalar, dim>, dim> R{};
+        for (size_t k = 0; k < t.size(); ++k) {
+            if (k == 0 || t[k] != t[k - 1]) R = Rotation::position_Jacobian({}, t[k]);
+            scatter(out, k, rotate(R, gather(pos, k)));
+        }
+    }
+
+    /**
+     * @brief Calculates the velocity of a batch of points.
+     *
+     * The velocity is the angular velocity crossed with the rotated offset from the center.
+     */
+    void velocity_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        std::array<std::array<Scalar, dim>, dim> R{};
+        for (size_t k = 0; k < t.size(); ++k) {
+            if (k == 0 || t[k] != t[k - 1]) R = Rotation::position_Jacobian({}, t[k]);
+            scatter(out, k, rotational_velocity(rotate(R, gather(pos, k))));
+        }
+    }
+
+private:
+    /**
+     * @brief Applies the rotation matrix R around the rotation center.
+     */
+    std::array<Scalar, dim> rotate(
+        const std::array<std::array<Scalar, dim>, dim>& R,
+        const std::array<Scalar, dim>& pos) const
+    {
+        std::array<Scalar, dim> result;
+        for (int i = 0; i < dim; ++i) {
+            Scalar sum = 0;
+            for (int j = 0; j < dim; ++j) sum += R[i][j] * (pos[j] - m_center[j]);
+            result[i] = sum + m_center[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Velocity of a point that has already been rotated.
+     *
+     * The velocity is the angular velocity crossed with the offset from the rotation center.
+     *
+     * @param rotated_pos The rotated position
+     */
+    std::array<Scalar, dim> rotational_velocity(std::array<Scalar, dim> rotated_pos) const
+    {
+        const Scalar omega = m_angle * std::numbers::pi_v<Scalar> / 180.0;
+        for (int i = 0; i < dim; ++i) {
+            rotated_pos[i] -= m_center[i];
+        }
+
+        // Cross product of axis and position gives the velocity direction
+        auto velocity = axis_cross(rotated_pos);
+        for (int i = 0; i < dim; ++i) velocity[i] *= omega;
+        return velocity;
+    }
+
+    /**
+     * @brief Cross product of the unit rotation axis with v (a quarter turn of v in 2D).
+     */
+    std::array<Scalar, dim> axis_cross(const std::array<Scalar, dim>& v) const
+    {
+        if constexpr (dim == 3) {
+            // Normalize the axis
+            const Scalar len =
+                std::sqrt(m_axis[0] * m_axis[0] + m_axis[1] * m_axis[1] + m_axis[2] * m_axis[2]);
+            const Scalar ux = m_axis[0] / len;
+            const Scalar uy = m_axis[1] / len;
+            const Scalar uz = m_axis[2] / len;
+
+            return {uy * v[2] - uz * v[1], uz * v[0] - ux * v[2], ux * v[1] - uy * v[0]};
+        } else {
+            return {-v[1], v[0]};
+        }
+    }
+
+public:
+    /**
+     * @brief Get the center point of rotation.
+     */
+    const std::array<Scalar, dim>& center() const { return m_center; }
+
+    /**
+     * @brief Get the rotation axis (3D only, not normalized).
+     */
+    const std::array<Scalar, dim>& axis() const { return m_axis; }
+
+    /**
+     * @brief Get the total rotation angle in degrees.
+     */
+    Scalar angle() const { return m_angle; }
+
 private:
     std::array<Scalar, dim> m_center; ///< Center point of rotation
     std::array<Scalar, dim> m_axis; ///< Rotation axis (3D only)
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/transforms/transform.h>
 
+#include <algorithm>
 #include <array>
 #include <span>
 
@@ -19,8 +21,8 @@ namespace stf {
  *
  * @tparam dim The dimensionality of the space (2D or 3D)
  */
-template <int dim>
-class Scale : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class Scale : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -57,7 +59,7 @@ public:
         return pos;
     }
 
-    std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const override
+    std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar /*t*/) const override
     {
         // Translate to origin
         for (int i = 0; i < dim; ++i) {
@@ -83,6 +85,133 @@ public:
         return jacobian;
     }
 
+    /**
+     * @brief Computes the second derivatives of the scaling.
+     *
+     * The scale factors grow linearly in time, so the only non-zero terms are the mixed
+     * derivatives ∂²T_i/∂x_i∂t = factor_i - 1.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> /*pos*/, Scalar /*t*/)
+        const override
+    {
+        TransformHessian<dim, Scalar> H{};
+        for (int i = 0; i < dim; ++i) H[i][i][dim] = H[i][dim][i] = m_factors[i] - 1;
+        return H;
+    }
+
+    /**
+     * @brief Bounds the scaled box over a time interval.
+     *
+     * Each coordinate is the product of the offset from the pivot and a factor linear in t, two
+     * independent quantities, so the interval product is exact.
+     */
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        IntervalBox<dim, Scalar> result;
+        for (int i = 0; i < dim; ++i) {
+            const auto factor = 1 + (m_factors[i] - 1) * t;
+            result[i] = (box[i] - m_center[i]) * factor + m_center[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Bounds the rates of change of the scaling.
+     *
+     * The Jacobian is diagonal, so its norm is the largest factor magnitude over the time
+     * interval. The velocity is the offset from the pivot times factor - 1.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        LipschitzBound<Scalar> result;
+        IntervalBox<dim, Scalar> velocity;
+        for (int i = 0; i < dim; ++i) {
+            const auto factor = 1 + (m_factors[i] - 1) * t;
+            result.spatial = std::max(result.spatial, abs(factor).upper);
+            velocity[i] = (box[i] - m_center[i]) * (m_factors[i] - 1);
+        }
+        result.temporal = norm_bounds(velocity).upper;
+        return result;
+    }
+
+    /**
+     * @brief Bounds the positions scaled into a box over a time interval.
+     *
+     * Each coordinate is divided by the scaling factor; a factor range containing zero collapses
+     * the whole axis and leaves the coordinate unbounded.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        IntervalBox<dim, Scalar> result;
+        for (int i = 0; i < dim; ++i) {
+            const auto factor = 1 + (m_factors[i] - 1) * t;
+            if (factor.contains(0)) {
+                result[i] = Interval<Scalar>::entire();
+                continue;
+            }
+            const Interval<Scalar> inverse_factor(1 / factor.upper, 1 / factor.lower);
+            result[i] = (box[i] - m_center[i]) * inverse_factor + m_center[i];
+        }
+        return result;
+    }
+
+    bool is_affine() const override { return true; }
+
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        TransformEvaluation<dim, Scalar> result{};
+        for (int i = 0; i < dim; ++i) {
+            Scalar offset = pos[i] - m_center[i];
+            Scalar factor = 1.0 + (m_factors[i] - 1.0) * t;
+            result.position[i] = offset * factor + m_center[i];
+            result.velocity[i] = offset * (m_factors[i] - 1.0);
+            result.jacobian[i][i] = factor;
+        }
+        return result;
+    }
+
+    void transform_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        for (int i = 0; i < dim; ++i) {
+            for (size_t k = 0; k < t.size(); ++k) {
+                out[i][k] =
+                    (pos[i][k] - m_center[i]) * (1.0 + (m_factors[i] - 1.0) * t[k]) + m_center[i];
+            }
+        }
+    }
+
+    void velocity_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        for (int i = 0; i < dim; ++i) {
+            for (size_t k = 0; k < t.size(); ++k) {
+                out[i][k] = (pos[i][k] - m_center[i]) * (m_factors[i] - 1.0);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Get the scaling factors reached at t = 1.
+     */
+    const std::array<Scalar, dim>& factors() const { return m_factors; }
+
+    /**
+     * @brief Get the pivot point of the scaling.
+     */
+    const std::array<Scalar, dim>& center() const { return m_center; }
+
 private:
     std::array<Scalar, dim> m_factors; ///< Scaling factors for each dimension
     std::array<Scalar, dim> m_center; ///< Center point of scaling
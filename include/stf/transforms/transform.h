@@ -1,12 +1,69 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
+#include <stf/maths/interval.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
 #include <span>
+#include <stdexcept>
 
 namespace stf {
 
+/**
+ * @brief Transformed position, velocity and position Jacobian of a transform at a single point.
+ *
+ * @tparam dim The dimensionality of the space (2D or 3D)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct TransformEvaluation
+{
+    std::array<Scalar, dim> position; ///< The transformed position
+    std::array<Scalar, dim> velocity; ///< The velocity of the point
+    std::array<std::array<Scalar, dim>, dim> jacobian; ///< The position Jacobian
+};
+
+/**
+ * @brief Second derivatives of a transform with respect to position and time.
+ *
+ * Entry i is the (dim+1)x(dim+1) symmetric Hessian of the i-th output coordinate with respect to
+ * the space-time point (x, t), with time last. The mixed terms ∂²T/∂x∂t are the rate of change
+ * of the position Jacobian and the last entry is the acceleration.
+ *
+ * @tparam dim The dimensionality of the space (2D or 3D)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+using TransformHessian = std::array<std::array<std::array<Scalar, dim + 1>, dim + 1>, dim>;
+
+/**
+ * @brief Affine map x -> matrix * x + offset.
+ *
+ * Describes a transform frozen at a fixed time, see Transform::affine_map.
+ *
+ * @tparam dim The dimensionality of the space (2D or 3D)
+ */
+template <int dim, typename Scalar = stf::Scalar>
+struct AffineMap
+{
+    std::array<std::array<Scalar, dim>, dim> matrix; ///< The linear part (the position Jacobian)
+    std::array<Scalar, dim> offset; ///< The image of the origin
+
+    /**
+     * @brief Applies the map to a position.
+     */
+    std::array<Scalar, dim> apply(const std::array<Scalar, dim>& pos) const
+    {
+        std::array<Scalar, dim> result = offset;
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) result[i] += matrix[i][j] * pos[j];
+        }
+        return result;
+    }
+};
+
 /**
  * @brief Base class for geometric transformations in n-dimensional space.
  *
@@ -15,8 +72,10 @@ namespace stf {
  * position transformation and velocity calculation.
  *
  * @tparam dim The dimensionality of the space (2D or 3D)
+ * @tparam Scalar The scalar type used for evaluation (stf::Scalar, i.e. double, by default;
+ * float halves memory traffic)
  */
-template <int dim>
+template <int dim, typename Scalar = stf::Scalar>
 class Transform
 {
 public:
@@ -58,6 +117,156 @@ public:
         std::array<Scalar, dim> pos,
         Scalar t) const = 0;
 
+    /**
+     * @brief Computes the transformed position, the velocity and the position Jacobian together.
+     *
+     * Subclasses override this method so that work shared by the three quantities (segment
+     * lookup, trigonometry, frame evaluation) is done once. The default implementation calls
+     * `transform`, `velocity` and `position_Jacobian`.
+     *
+     * @param pos The input position
+     * @param t The time parameter for time-dependent transformations
+     * @return TransformEvaluation<dim, Scalar> The position, velocity and Jacobian
+     */
+    virtual TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return {transform(pos, t), velocity(pos, t), position_Jacobian(pos, t)};
+    }
+
+    /**
+     * @brief Computes the second derivatives of the transformation.
+     *
+     * The default implementation differentiates the position Jacobian and the velocity returned
+     * by `evaluate` with central differences.
+     *
+     * @param pos The input position
+     * @param t The time parameter for time-dependent transformations
+     * @return TransformHessian<dim, Scalar> The space-time Hessian of each output coordinate
+     */
+    virtual TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        return finite_difference_hessian(pos, t);
+    }
+
+    /**
+     * @brief Bounds the transformed positions of a box over a time interval.
+     *
+     * The returned box contains `transform(pos, t)` for every position in `box` and every time
+     * in `t`. The default implementation returns an unbounded box.
+     *
+     * @param box The input box, one interval per coordinate
+     * @param t The time interval
+     * @return IntervalBox<dim, Scalar> A box containing the image of the space-time box
+     */
+    virtual IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const
+    {
+        IntervalBox<dim, Scalar> result;
+        result.fill(Interval<Scalar>::entire());
+        return result;
+    }
+
+    /**
+     * @brief Bounds the rates of change of the transformation over a space-time box.
+     *
+     * The spatial constant bounds the operator norm of the position Jacobian and the temporal
+     * constant bounds the speed of the transformed points. The default implementation returns
+     * infinite constants.
+     *
+     * @param box The input box, one interval per coordinate
+     * @param t The time interval
+     * @return LipschitzBound<Scalar> The Lipschitz constants over the space-time box
+     */
+    virtual LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const
+    {
+        return LipschitzBound<Scalar>::unbounded();
+    }
+
+    /**
+     * @brief Bounds the positions mapped into a box over a time interval.
+     *
+     * The returned box contains every position x such that transform(x, t) lies in the box for
+     * some t in the interval. Sweeping a primitive pulls its bounding box back through this
+     * bound. The default implementation returns the whole space.
+     *
+     * @param box The box of transformed positions
+     * @param t The time interval
+     * @return IntervalBox<dim, Scalar> A box containing the preimage of the box
+     */
+    virtual IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const
+    {
+        return entire_box<dim, Scalar>();
+    }
+
+    /**
+     * @brief Whether the transformation is affine in position at any fixed time.
+     *
+     * Affine transforms can be frozen into an AffineMap with `affine_map`. The default
+     * implementation returns false.
+     */
+    virtual bool is_affine() const { return false; }
+
+    /**
+     * @brief Freezes an affine transformation at time t.
+     *
+     * The map is read off a single evaluation at the origin: the transformed origin is the
+     * offset and the position Jacobian is the linear part.
+     *
+     * @param t The time parameter
+     * @return AffineMap<dim, Scalar> The map x -> transform(x, t)
+     * @throws std::runtime_error If the transformation is not affine
+     */
+    AffineMap<dim, Scalar> affine_map(Scalar t) const
+    {
+        if (!is_affine()) {
+            throw std::runtime_error("Transform is not affine in position");
+        }
+        const auto e = evaluate({}, t);
+        return {e.jacobian, e.position};
+    }
+
+    /**
+     * @brief Transforms a batch of points.
+     *
+     * Points are given in structure-of-arrays layout, one span per coordinate, together with a
+     * time column. The default implementation calls `transform` once per point.
+     *
+     * @param pos The input coordinate columns
+     * @param t The time column
+     * @param out Output coordinate columns receiving the transformed points
+     */
+    virtual void transform_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            scatter(out, k, transform(gather(pos, k), t[k]));
+        }
+    }
+
+    /**
+     * @brief Calculates the velocity of a batch of points.
+     *
+     * @param pos The input coordinate columns
+     * @param t The time column
+     * @param out Output coordinate columns receiving the velocities
+     */
+    virtual void velocity_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const
+    {
+        for (size_t k = 0; k < t.size(); ++k) {
+            scatter(out, k, velocity(gather(pos, k), t[k]));
+        }
+    }
+
     /**
      * @brief Calculates velocity using finite difference approximation.
      *
@@ -120,6 +329,54 @@ public:
         }
         return J;
     }
+
+    /**
+     * @brief Calculates the second derivatives using finite difference
+     *
+     * Central differences of the position Jacobian and the velocity along each space-time axis,
+     * symmetrized. The step along each axis is ∛ε scaled by max(1, |x|), where x is the
+     * coordinate being perturbed.
+     *
+     * @param pos The position at which to calculate the second derivatives
+     * @param t The time parameter
+     * @return TransformHessian<dim, Scalar> The approximated second derivatives
+     */
+    TransformHessian<dim, Scalar>
+    finite_difference_hessian(std::array<Scalar, dim> pos, Scalar t) const
+    {
+        const Scalar step = std::cbrt(std::numeric_limits<Scalar>::epsilon());
+        TransformHessian<dim, Scalar> H{};
+        for (int b = 0; b <= dim; ++b) {
+            auto pos_plus = pos;
+            auto pos_minus = pos;
+            Scalar t_plus = t;
+            Scalar t_minus = t;
+            const Scalar delta = step * std::max(Scalar(1), std::abs(b < dim ? pos[b] : t));
+            if (b < dim) {
+                pos_plus[b] += delta;
+                pos_minus[b] -= delta;
+            } else {
+                t_plus += delta;
+                t_minus -= delta;
+            }
+            const auto e_plus = evaluate(pos_plus, t_plus);
+            const auto e_minus = evaluate(pos_minus, t_minus);
+            for (int i = 0; i < dim; ++i) {
+                for (int a = 0; a < dim; ++a) {
+                    H[i][a][b] = (e_plus.jacobian[i][a] - e_minus.jacobian[i][a]) / (2 * delta);
+                }
+                H[i][dim][b] = (e_plus.velocity[i] - e_minus.velocity[i]) / (2 * delta);
+            }
+        }
+        for (int i = 0; i < dim; ++i) {
+            for (int a = 0; a <= dim; ++a) {
+                for (int b = 0; b < a; ++b) {
+                    H[i][a][b] = H[i][b][a] = (H[i][a][b] + H[i][b][a]) / 2;
+                }
+            }
+        }
+        return H;
+    }
 };
 
 } // namespace stf
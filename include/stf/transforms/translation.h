@@ -1,9 +1,12 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/transforms/transform.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <span>
 
 namespace stf {
@@ -17,8 +20,8 @@ namespace stf {
  *
  * @tparam dim The dimensionality of the space (2D or 3D)
  */
-template <int dim>
-class Translation : public Transform<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class Translation : public Transform<dim, Scalar>
 {
 public:
     /**
@@ -39,14 +42,14 @@ public:
         return pos;
     }
 
-    std::array<Scalar, dim> velocity(std::array<Scalar, dim> pos, Scalar t) const override
+    std::array<Scalar, dim> velocity(std::array<Scalar, dim> /*pos*/, Scalar /*t*/) const override
     {
         return m_translation;
     }
 
     std::array<std::array<Scalar, dim>, dim> position_Jacobian(
-        std::array<Scalar, dim> pos,
-        Scalar t) const override
+        std::array<Scalar, dim> /*pos*/,
+        Scalar /*t*/) const override
     {
         std::array<std::array<Scalar, dim>, dim> jacobian{};
         // For translation, the Jacobian is the identity matrix
@@ -56,6 +59,84 @@ public:
         return jacobian;
     }
 
+    /**
+     * @brief A translation at constant velocity has no second derivatives.
+     */
+    TransformHessian<dim, Scalar> hessian(std::array<Scalar, dim> /*pos*/, Scalar /*t*/)
+        const override
+    {
+        return {};
+    }
+
+    IntervalBox<dim, Scalar> transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        IntervalBox<dim, Scalar> result;
+        for (int i = 0; i < dim; ++i) result[i] = box[i] + m_translation[i] * t;
+        return result;
+    }
+
+    /**
+     * @brief A translation is an isometry moving at constant speed.
+     */
+    LipschitzBound<Scalar> lipschitz_bound(
+        const IntervalBox<dim, Scalar>& /*box*/,
+        Interval<Scalar> /*t*/) const override
+    {
+        Scalar speed = 0;
+        for (int i = 0; i < dim; ++i) speed += m_translation[i] * m_translation[i];
+        return {1, std::sqrt(speed)};
+    }
+
+    /**
+     * @brief The inverse of a translation by t v is the translation by -t v.
+     */
+    IntervalBox<dim, Scalar> inverse_transform_bounds(
+        const IntervalBox<dim, Scalar>& box,
+        Interval<Scalar> t) const override
+    {
+        return Translation::transform_bounds(box, -t);
+    }
+
+    bool is_affine() const override { return true; }
+
+    TransformEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return {
+            Translation::transform(pos, t),
+            m_translation,
+            Translation::position_Jacobian(pos, t)};
+    }
+
+    void transform_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        for (int i = 0; i < dim; ++i) {
+            for (size_t k = 0; k < t.size(); ++k) {
+                out[i][k] = pos[i][k] + m_translation[i] * t[k];
+            }
+        }
+    }
+
+    void velocity_batch(
+        std::array<std::span<const Scalar>, dim> /*pos*/,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim> out) const override
+    {
+        for (int i = 0; i < dim; ++i) {
+            std::fill_n(out[i].begin(), t.size(), m_translation[i]);
+        }
+    }
+
+public:
+    /**
+     * @brief Get the translation vector.
+     */
+    const std::array<Scalar, dim>& translation() const { return m_translation; }
+
 private:
     std::array<Scalar, dim> m_translation;
 };
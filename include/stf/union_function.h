@@ -1,13 +1,22 @@
 #pragma once
 
+#include <stf/batch.h>
 #include <stf/common.h>
 #include <stf/space_time_function.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <memory>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 
 namespace stf {
 
+template <int dim, typename Scalar = stf::Scalar>
+class UnionSnapshot;
+
 /**
  * @brief A class representing the union of two space-time functions.
  * 
@@ -18,8 +27,8 @@ namespace stf {
  * 
  * @tparam dim The dimension of the space (2 or 3)
  */
-template <int dim>
-class UnionFunction : public SpaceTimeFunction<dim>
+template <int dim, typename Scalar = stf::Scalar>
+class UnionFunction : public SpaceTimeFunction<dim, Scalar>
 {
 public:
     /**
@@ -32,8 +41,8 @@ public:
      *                       If > 0, performs a smooth union over this distance.
      */
     UnionFunction(
-        SpaceTimeFunction<dim>& f1,
-        SpaceTimeFunction<dim>& f2,
+        SpaceTimeFunction<dim, Scalar>& f1,
+        SpaceTimeFunction<dim, Scalar>& f2,
         Scalar smooth_distance = 0)
         : m_f1(f1)
         , m_f2(f2)
@@ -56,16 +65,7 @@ public:
      */
     Scalar value(std::array<Scalar, dim> pos, Scalar t) const override
     {
-        Scalar a = m_f1.value(pos, t);
-        Scalar b = m_f2.value(pos, t);
-
-        if (m_smooth_distance > 0) {
-            Scalar k = m_smooth_distance * 4.0;
-            Scalar h = std::max(k - std::abs(a - b), 0.0) / k;
-            return std::min(a, b) - h * h * k * (1.0 / 4.0);
-        } else {
-            return std::min(a, b);
-        }
+        return blend_value(m_f1.value(pos, t), m_f2.value(pos, t), m_smooth_distance);
     }
 
     /**
@@ -84,34 +84,7 @@ public:
         Scalar b = m_f2.value(pos, t);
         Scalar da = m_f1.time_derivative(pos, t);
         Scalar db = m_f2.time_derivative(pos, t);
-
-        if (m_smooth_distance > 0) {
-            Scalar k = m_smooth_distance * 4.0;
-            Scalar diff = a - b;
-            Scalar abs_diff = std::abs(diff);
-            bool a_is_smaller = (a < b);
-
-            if (abs_diff >= k) {
-                // Outside smoothing zone
-                return (a < b) ? da : db;
-            } else {
-                // Inside smoothing zone
-                // Compute dh/dpos = -(1/k) * sign(a - b) * (grad_a - grad_b)
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = - h * sign / 2;
-
-                return (a_is_smaller ? da : db) - coeff * (da - db);
-            }
-        } else {
-            if (a < b)
-                return da;
-            else if (b < a)
-                return db;
-            else {
-                return (da + db) / 2;
-            }
-        }
+        return combine(blend_weights(a, b, m_smooth_distance), da, db);
     }
 
     /**
@@ -127,62 +100,541 @@ public:
      */
     std::array<Scalar, dim + 1> gradient(std::array<Scalar, dim> pos, Scalar t) const override
     {
-        Scalar a = m_f1.value(pos, t);
-        Scalar b = m_f2.value(pos, t);
-        std::array<Scalar, dim + 1> grad_a = m_f1.gradient(pos, t);
-        std::array<Scalar, dim + 1> grad_b = m_f2.gradient(pos, t);
+        return evaluate(pos, t).gradient;
+    }
+
+    /**
+     * @brief Evaluates the union function together with its gradient.
+     *
+     * Each operand is evaluated exactly once; its value selects the blend weights applied to its
+     * gradient.
+     *
+     * @param pos The spatial position to evaluate at
+     * @param t The time to evaluate at
+     * @return The value followed by the spatial gradient and the time derivative
+     */
+    SpaceTimeEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        const auto ea = m_f1.evaluate(pos, t);
+        const auto eb = m_f2.evaluate(pos, t);
+        const auto w = blend_weights(ea.value, eb.value, m_smooth_distance);
+
+        SpaceTimeEvaluation<dim, Scalar> result{
+            blend_value(ea.value, eb.value, m_smooth_distance),
+            {}};
+        for (int i = 0; i <= dim; ++i) {
+            result.gradient[i] = combine(w, ea.gradient[i], eb.gradient[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the space-time Hessian of the union function.
+     *
+     * The operand Hessians are combined with the blend weights, plus the curvature of the blend
+     * times (∇a - ∇b)(∇a - ∇b)ᵀ inside the smoothing zone.
+     *
+     * @param pos The spatial position to evaluate at
+     * @param t The time to evaluate at
+     * @return The space-time Hessian, time last
+     */
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        const auto ea = m_f1.evaluate(pos, t);
+        const auto eb = m_f2.evaluate(pos, t);
+        const auto w = blend_weights(ea.value, eb.value, m_smooth_distance);
+        if (w[1] == 0) return m_f1.hessian(pos, t);
+        if (w[0] == 0) return m_f2.hessian(pos, t);
+
+        return blend_hessian(
+            w,
+            blend_curvature(ea.value, eb.value, m_smooth_distance),
+            ea.gradient,
+            eb.gradient,
+            m_f1.hessian(pos, t),
+            m_f2.hessian(pos, t));
+    }
+
+    /**
+     * @brief Bounds the union over a space-time box from the bounds of its operands.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return A conservative range of values over the space-time box
+     */
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        return blend_bounds(
+            m_f1.value_bounds(box, t),
+            m_f2.value_bounds(box, t),
+            m_smooth_distance);
+    }
+
+    /**
+     * @brief Bounds the rates of change of the union over a space-time box.
+     *
+     * The derivatives of the union are convex combinations of those of the operands, so each
+     * constant is the larger of the operand constants, or that of the only operand which can be
+     * active in the box.
+     *
+     * @param box The spatial box
+     * @param t The time interval
+     * @return The Lipschitz constants over the space-time box
+     */
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim, Scalar>& box, Interval<Scalar> t)
+        const override
+    {
+        return blend_lipschitz(
+            m_f1.value_bounds(box, t),
+            m_f2.value_bounds(box, t),
+            m_f1.lipschitz_bound(box, t),
+            m_f2.lipschitz_bound(box, t),
+            m_smooth_distance);
+    }
+
+    /**
+     * @brief Bounds the region swept by the union over a time range.
+     *
+     * @param t0 The start of the time range
+     * @param t1 The end of the time range
+     * @param level The level of the sublevel set to bound
+     * @return The hull of the operand boxes at the level returned by `blend_level`
+     */
+    IntervalBox<dim, Scalar> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        const Scalar operand_level = blend_level(level, m_smooth_distance);
+        return hull(
+            m_f1.bounding_box(t0, t1, operand_level),
+            m_f2.bounding_box(t0, t1, operand_level));
+    }
+
+public:
+    /**
+     * @brief Evaluates the union function at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param values Output span receiving one value per point
+     */
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<1, Scalar> b(t.size());
+        m_f1.value_batch(pos, t, values);
+        m_f2.value_batch(pos, t, b.column(0));
+
+        const auto vb = b.column(0);
+        for (size_t k = 0; k < t.size(); ++k) {
+            values[k] = blend_value(values[k], vb[k], m_smooth_distance);
+        }
+    }
+
+    /**
+     * @brief Computes the time derivative of the union function at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param time_derivatives Output span receiving one time derivative per point
+     */
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        ColumnBuffer<3, Scalar> scratch(t.size());
+        const auto columns = scratch.columns();
+        m_f1.value_batch(pos, t, columns[0]);
+        m_f2.value_batch(pos, t, columns[1]);
+        m_f1.time_derivative_batch(pos, t, time_derivatives);
+        m_f2.time_derivative_batch(pos, t, columns[2]);
+
+        for (size_t k = 0; k < t.size(); ++k) {
+            const auto w = blend_weights(columns[0][k], columns[1][k], m_smooth_distance);
+            time_derivatives[k] = combine(w, time_derivatives[k], columns[2][k]);
+        }
+    }
+
+    /**
+     * @brief Computes the gradient of the union function at a batch of space-time points.
+     *
+     * @param pos The spatial coordinate columns
+     * @param t The time column
+     * @param gradients Output columns, spatial gradient first and time derivative last
+     */
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        ColumnBuffer<2, Scalar> values(t.size());
+        ColumnBuffer<dim + 1, Scalar> grad_b(t.size());
+        const auto v = values.columns();
+        const auto gb = grad_b.columns();
+        m_f1.value_batch(pos, t, v[0]);
+        m_f2.value_batch(pos, t, v[1]);
+        m_f1.gradient_batch(pos, t, gradients);
+        m_f2.gradient_batch(pos, t, gb);
+
+        for (size_t k = 0; k < t.size(); ++k) {
+            const auto w = blend_weights(v[0][k], v[1][k], m_smooth_distance);
+            for (int i = 0; i <= dim; ++i) {
+                gradients[i][k] = combine(w, gradients[i][k], gb[i][k]);
+            }
+        }
+    }
+
+    /**
+     * @brief Freeze the union at time t by freezing both operands.
+     *
+     * @param t The time value
+     * @return std::unique_ptr<ImplicitFunction<dim, Scalar>> The spatial snapshot at time t
+     */
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> bind_time(Scalar t) const override
+    {
+        return std::make_unique<UnionSnapshot<dim, Scalar>>(
+            m_f1.bind_time(t),
+            m_f2.bind_time(t),
+            m_smooth_distance);
+    }
+
+public:
+    /**
+     * @brief Blends the values of the two operands.
+     *
+     * @param a The value of the first operand
+     * @param b The value of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    static Scalar blend_value(Scalar a, Scalar b, Scalar smooth_distance)
+    {
+        if (smooth_distance > 0) {
+            Scalar k = smooth_distance * 4.0;
+            Scalar h = std::max(k - std::abs(a - b), Scalar(0)) / k;
+            return std::min(a, b) - h * h * k * (1.0 / 4.0);
+        } else {
+            return std::min(a, b);
+        }
+    }
+
+    /**
+     * @brief Range of the blended value when the operands range over a and b.
+     *
+     * The blend is non-decreasing in both operands, so its range is spanned by the blends of the
+     * lower and of the upper bounds.
+     *
+     * @param a The range of the first operand
+     * @param b The range of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    static Interval<Scalar>
+    blend_bounds(const Interval<Scalar>& a, const Interval<Scalar>& b, Scalar smooth_distance)
+    {
+        auto blend = [&](Scalar x, Scalar y) {
+            // An infinite operand lies outside any smoothing zone.
+            if (std::isinf(x) || std::isinf(y)) return std::min(x, y);
+            return blend_value(x, y, smooth_distance);
+        };
+        return {blend(a.lower, b.lower), blend(a.upper, b.upper)};
+    }
 
-        if (m_smooth_distance > 0) {
-            Scalar k = m_smooth_distance * 4.0;
-            Scalar diff = a - b;
-            Scalar abs_diff = std::abs(diff);
-            bool a_is_smaller = (a < b);
+    /**
+     * @brief Operand level bounding the region where the blend is at most `level`.
+     *
+     * The blend lowers the smaller operand by at most the smoothing distance, so the blend is at
+     * most `level` only where one of the operands is at most `level + smooth_distance`.
+     *
+     * @param level The level of the blend
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    static Scalar blend_level(Scalar level, Scalar smooth_distance)
+    {
+        return level + std::max(smooth_distance, Scalar(0));
+    }
 
+    /**
+     * @brief Lipschitz constants of the blend given those of the operands.
+     *
+     * The blend weights are convex, so the constants are the maxima of the operand constants.
+     * When the value ranges show that one operand is below the other by more than the smoothing
+     * zone everywhere, only that operand contributes.
+     *
+     * @param a The range of the first operand
+     * @param b The range of the second operand
+     * @param La The Lipschitz constants of the first operand
+     * @param Lb The Lipschitz constants of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    template <typename L>
+    static L blend_lipschitz(
+        const Interval<Scalar>& a,
+        const Interval<Scalar>& b,
+        const L& La,
+        const L& Lb,
+        Scalar smooth_distance)
+    {
+        const Scalar k = smooth_distance * 4;
+        if (a.upper + k < b.lower) return La;
+        if (b.upper + k < a.lower) return Lb;
+        if constexpr (std::is_same_v<L, Scalar>) {
+            return std::max(La, Lb);
+        } else {
+            return {std::max(La.spatial, Lb.spatial), std::max(La.temporal, Lb.temporal)};
+        }
+    }
+
+    /**
+     * @brief Weights of the operand derivatives in the derivative of the union.
+     *
+     * The derivative of the union is w[0] * f1' + w[1] * f2', where the weights only depend on
+     * the operand values a = f1 and b = f2.
+     *
+     * @param a The value of the first operand
+     * @param b The value of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    static std::array<Scalar, 2> blend_weights(Scalar a, Scalar b, Scalar smooth_distance)
+    {
+        if (smooth_distance > 0) {
+            Scalar k = smooth_distance * 4.0;
+            Scalar abs_diff = std::abs(a - b);
             if (abs_diff >= k) {
                 // Outside smoothing zone
-                return (a_is_smaller) ? grad_a : grad_b;
-            } else {
-                // Inside smoothing zone
-                // Compute dh/dpos = -(1/k) * sign(a - b) * (grad_a - grad_b)
-                Scalar h = (k - abs_diff) / k;
-                Scalar sign = (a_is_smaller) ? -1.0 : 1.0;
-                Scalar coeff = - h * sign / 2;
-
-                std::array<Scalar, dim + 1> grad_result;
-                for (int i = 0; i <= dim; ++i) {
-                    Scalar dmin = (a_is_smaller) ? grad_a[i] : grad_b[i];
-                    grad_result[i] = dmin - coeff * (grad_a[i] - grad_b[i]);
-                }
-                return grad_result;
+                return (a < b) ? std::array<Scalar, 2>{1, 0} : std::array<Scalar, 2>{0, 1};
             }
+            Scalar h = (k - abs_diff) / k;
+            return (a < b) ? std::array<Scalar, 2>{1 - h / 2, h / 2}
+                           : std::array<Scalar, 2>{h / 2, 1 - h / 2};
         } else {
-            if (a < b)
-                return grad_a;
-            else if (b < a)
-                return grad_b;
-            else {
-                if constexpr (dim == 3) {
-                    return {
-                        (grad_a[0] + grad_b[0]) / 2,
-                        (grad_a[1] + grad_b[1]) / 2,
-                        (grad_a[2] + grad_b[2]) / 2,
-                        (grad_a[3] + grad_b[3]) / 2,
-                    };
-                } else {
-                    static_assert(dim == 2, "Only 2D and 3D are supported");
-                    return {
-                        (grad_a[0] + grad_b[0]) / 2,
-                        (grad_a[1] + grad_b[1]) / 2,
-                        (grad_a[2] + grad_b[2]) / 2,
-                    };
-                }
+            if (a < b) return {1, 0};
+            if (b < a) return {0, 1};
+            return {0.5, 0.5};
+        }
+    }
+
+    /**
+     * @brief Combines two operand derivatives using blend weights.
+     *
+     * Operands with a zero weight are skipped entirely so that they do not leak into the result.
+     */
+    static Scalar combine(const std::array<Scalar, 2>& w, Scalar da, Scalar db)
+    {
+        if (w[1] == 0) return da;
+        if (w[0] == 0) return db;
+        return w[0] * da + w[1] * db;
+    }
+
+    /**
+     * @brief Second derivative of the blended value along a - b.
+     *
+     * Zero outside the smoothing zone and for a sharp union.
+     *
+     * @param a The value of the first operand
+     * @param b The value of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    static Scalar blend_curvature(Scalar a, Scalar b, Scalar smooth_distance)
+    {
+        if (smooth_distance <= 0) return 0;
+        Scalar k = smooth_distance * 4.0;
+        return std::abs(a - b) < k ? -1 / (2 * k) : 0;
+    }
+
+    /**
+     * @brief Combines two operand Hessians: w[0] Ha + w[1] Hb + c (ga - gb)(ga - gb)ᵀ.
+     *
+     * Works for both space-time (n = dim + 1) and spatial (n = dim) Hessians.
+     *
+     * @param w The blend weights
+     * @param c The blend curvature
+     * @param ga The gradient of the first operand
+     * @param gb The gradient of the second operand
+     * @param Ha The Hessian of the first operand
+     * @param Hb The Hessian of the second operand
+     */
+    template <size_t n>
+    static std::array<std::array<Scalar, n>, n> blend_hessian(
+        const std::array<Scalar, 2>& w,
+        Scalar c,
+        const std::array<Scalar, n>& ga,
+        const std::array<Scalar, n>& gb,
+        const std::array<std::array<Scalar, n>, n>& Ha,
+        const std::array<std::array<Scalar, n>, n>& Hb)
+    {
+        std::array<std::array<Scalar, n>, n> result;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                result[i][j] =
+                    w[0] * Ha[i][j] + w[1] * Hb[i][j] + c * (ga[i] - gb[i]) * (ga[j] - gb[j]);
+            }
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Get the first operand.
+     */
+    const SpaceTimeFunction<dim, Scalar>& first() const { return m_f1; }
+
+    /**
+     * @brief Get the second operand.
+     */
+    const SpaceTimeFunction<dim, Scalar>& second() const { return m_f2; }
+
+    /**
+     * @brief Get the smooth distance (0 for a sharp union).
+     */
+    Scalar smooth_distance() const { return m_smooth_distance; }
+
+private:
+    SpaceTimeFunction<dim, Scalar>& m_f1;
+    SpaceTimeFunction<dim, Scalar>& m_f2;
+    Scalar m_smooth_distance = 0;
+};
+
+/**
+ * @brief Snapshot of a union of space-time functions at a fixed time.
+ *
+ * Blends the snapshots of both operands exactly like UnionFunction blends the operands.
+ *
+ * @tparam dim The dimension of the space (2 or 3)
+ */
+template <int dim, typename Scalar>
+class UnionSnapshot : public ImplicitFunction<dim, Scalar>
+{
+private:
+    using Union = UnionFunction<dim, Scalar>;
+
+public:
+    /**
+     * @brief Constructs a UnionSnapshot from the snapshots of both operands.
+     *
+     * @param f1 The snapshot of the first operand
+     * @param f2 The snapshot of the second operand
+     * @param smooth_distance The smoothing distance (0 for a sharp union)
+     */
+    UnionSnapshot(
+        std::unique_ptr<ImplicitFunction<dim, Scalar>> f1,
+        std::unique_ptr<ImplicitFunction<dim, Scalar>> f2,
+        Scalar smooth_distance)
+        : m_f1(std::move(f1))
+        , m_f2(std::move(f2))
+        , m_smooth_distance(smooth_distance)
+    {}
+
+    Scalar value(std::array<Scalar, dim> pos) const override
+    {
+        return Union::blend_value(
+            m_f1->value(pos),
+            m_f2->value(pos),
+            m_smooth_distance);
+    }
+
+    std::array<Scalar, dim> gradient(std::array<Scalar, dim> pos) const override
+    {
+        return UnionSnapshot::evaluate(pos).gradient;
+    }
+
+    ImplicitEvaluation<dim, Scalar> evaluate(std::array<Scalar, dim> pos) const override
+    {
+        const auto ea = m_f1->evaluate(pos);
+        const auto eb = m_f2->evaluate(pos);
+        const auto w = Union::blend_weights(ea.value, eb.value, m_smooth_distance);
+
+        ImplicitEvaluation<dim, Scalar> result{
+            Union::blend_value(ea.value, eb.value, m_smooth_distance),
+            {}};
+        for (int i = 0; i < dim; ++i) {
+            result.gradient[i] = Union::combine(w, ea.gradient[i], eb.gradient[i]);
+        }
+        return result;
+    }
+
+    std::array<std::array<Scalar, dim>, dim> hessian(std::array<Scalar, dim> pos) const override
+    {
+        const auto ea = m_f1->evaluate(pos);
+        const auto eb = m_f2->evaluate(pos);
+        const auto w = Union::blend_weights(ea.value, eb.value, m_smooth_distance);
+        if (w[1] == 0) return m_f1->hessian(pos);
+        if (w[0] == 0) return m_f2->hessian(pos);
+
+        return Union::blend_hessian(
+            w,
+            Union::blend_curvature(ea.value, eb.value, m_smooth_distance),
+            ea.gradient,
+            eb.gradient,
+            m_f1->hessian(pos),
+            m_f2->hessian(pos));
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return Union::blend_bounds(
+            m_f1->value_bounds(box),
+            m_f2->value_bounds(box),
+            m_smooth_distance);
+    }
+
+    Scalar lipschitz_bound(const IntervalBox<dim, Scalar>& box) const override
+    {
+        return Union::blend_lipschitz(
+            m_f1->value_bounds(box),
+            m_f2->value_bounds(box),
+            m_f1->lipschitz_bound(box),
+            m_f2->lipschitz_bound(box),
+            m_smooth_distance);
+    }
+
+    IntervalBox<dim, Scalar> bounding_box(Scalar level = 0) const override
+    {
+        const Scalar operand_level = Union::blend_level(level, m_smooth_distance);
+        return hull(m_f1->bounding_box(operand_level), m_f2->bounding_box(operand_level));
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<Scalar> values) const override
+    {
+        ColumnBuffer<1, Scalar> b(values.size());
+        m_f1->value_batch(pos, values);
+        m_f2->value_batch(pos, b.column(0));
+
+        const auto vb = b.column(0);
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k] = Union::blend_value(values[k], vb[k], m_smooth_distance);
+        }
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::array<std::span<Scalar>, dim> gradients) const override
+    {
+        const size_t n = gradients[0].size();
+        ColumnBuffer<2, Scalar> values(n);
+        ColumnBuffer<dim, Scalar> grad_b(n);
+        const auto v = values.columns();
+        const auto gb = grad_b.columns();
+        m_f1->value_batch(pos, v[0]);
+        m_f2->value_batch(pos, v[1]);
+        m_f1->gradient_batch(pos, gradients);
+        m_f2->gradient_batch(pos, gb);
+
+        for (size_t k = 0; k < n; ++k) {
+            const auto w = Union::blend_weights(v[0][k], v[1][k], m_smooth_distance);
+            for (int i = 0; i < dim; ++i) {
+                gradients[i][k] = Union::combine(w, gradients[i][k], gb[i][k]);
             }
         }
     }
 
 private:
-    SpaceTimeFunction<dim>& m_f1;
-    SpaceTimeFunction<dim>& m_f2;
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> m_f1;
+    std::unique_ptr<ImplicitFunction<dim, Scalar>> m_f2;
     Scalar m_smooth_distance = 0;
 };
 
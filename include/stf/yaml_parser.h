@@ -3,15 +3,18 @@
 #ifdef STF_YAML_PARSER_ENABLED
 
 #include <stf/explicit_form.h>
+#include <stf/nary_union_function.h>
 #include <stf/offset_function.h>
 #include <stf/space_time_function.h>
 #include <stf/sweep_function.h>
 #include <stf/union_function.h>
 #include <stf/primitives/duchon.h>
+#include <stf/primitives/implicit_nary_union.h>
 #include <stf/primitives/implicit_union.h>
 #include <yaml-cpp/yaml.h>
 
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -30,6 +33,20 @@ public:
     {}
 };
 
+/**
+ * @brief A single-variable function of time parsed from YAML
+ *
+ * The function, its derivative and the interval extensions of both come from a single parse, so
+ * they always describe the same curve.
+ */
+struct SingleVariableFunction
+{
+    std::function<Scalar(Scalar)> function; ///< The function
+    std::function<Scalar(Scalar)> derivative; ///< Its derivative
+    IntervalExtension<Scalar> bounds; ///< Interval extension of the function
+    IntervalExtension<Scalar> derivative_bounds; ///< Interval extension of the derivative
+};
+
 /**
  * @brief Parsing context that manages object lifetimes
  *
@@ -93,6 +110,65 @@ public:
         return m_function->gradient(pos, t);
     }
 
+    SpaceTimeEvaluation<dim> evaluate(std::array<Scalar, dim> pos, Scalar t) const override
+    {
+        return m_function->evaluate(pos, t);
+    }
+
+    std::array<std::array<Scalar, dim + 1>, dim + 1> hessian(
+        std::array<Scalar, dim> pos,
+        Scalar t) const override
+    {
+        return m_function->hessian(pos, t);
+    }
+
+    Interval<Scalar> value_bounds(const IntervalBox<dim>& box, Interval<Scalar> t) const override
+    {
+        return m_function->value_bounds(box, t);
+    }
+
+    LipschitzBound<Scalar> lipschitz_bound(const IntervalBox<dim>& box, Interval<Scalar> t)
+        const override
+    {
+        return m_function->lipschitz_bound(box, t);
+    }
+
+    IntervalBox<dim> bounding_box(Scalar t0, Scalar t1, Scalar level = 0) const override
+    {
+        return m_function->bounding_box(t0, t1, level);
+    }
+
+    void value_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> values) const override
+    {
+        m_function->value_batch(pos, t, values);
+    }
+
+    void time_derivative_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::span<Scalar> time_derivatives) const override
+    {
+        m_function->time_derivative_batch(pos, t, time_derivatives);
+    }
+
+    void gradient_batch(
+        std::array<std::span<const Scalar>, dim> pos,
+        std::span<const Scalar> t,
+        std::array<std::span<Scalar>, dim + 1> gradients) const override
+    {
+        m_function->gradient_batch(pos, t, gradients);
+    }
+
+    std::unique_ptr<ImplicitFunction<dim>> bind_time(Scalar t) const override
+    {
+        return m_function->bind_time(t);
+    }
+
+    const SpaceTimeFunction<dim>& function() const { return *m_function; }
+
 private:
     std::unique_ptr<SpaceTimeFunction<dim>> m_function;
     std::unique_ptr<Context<dim>> m_context;
@@ -177,6 +253,14 @@ private:
     static std::unique_ptr<ImplicitFunction<dim>> parse_duchon(const YAML::Node& node, const std::string& yaml_file_dir = "");
     static std::unique_ptr<ImplicitFunction<dim>> parse_implicit_union(const YAML::Node& node, Context<dim>& context, const std::string& yaml_file_dir = "");
 
+    // Builds an implicit union of the primitives, flat or as a chain of binary unions
+    template <BlendingFunction blending>
+    static std::unique_ptr<ImplicitFunction<dim>> make_implicit_union(
+        std::vector<ImplicitFunction<dim>*> primitives,
+        Scalar smooth_distance,
+        bool nary,
+        Context<dim>& context);
+
     // Specific parsers for transforms
     static std::unique_ptr<Transform<dim>> parse_translation(const YAML::Node& node);
     static std::unique_ptr<Transform<dim>> parse_scale(const YAML::Node& node);
@@ -205,9 +289,9 @@ private:
         const std::string& file_path, const std::string& yaml_file_dir = "");
     
     // Helper function to parse single-variable functions from YAML
-    // Returns a pair of (function, derivative_function)
-    static std::pair<std::function<Scalar(Scalar)>, std::function<Scalar(Scalar)>> 
-        parse_single_variable_function_with_derivative(const YAML::Node& node, const std::string& field_name);
+    // Returns the function, its derivative and the interval extensions of both
+    static SingleVariableFunction
+    parse_single_variable_function(const YAML::Node& node, const std::string& field_name);
 };
 
 // Convenience functions for common use cases
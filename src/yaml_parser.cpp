@@ -183,9 +183,9 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_from_node(
 
 template <int dim>
 std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_explicit_form(
-    const YAML::Node& node,
-    Context<dim>& context,
-    const std::string& yaml_file_dir)
+    const YAML::Node& /*node*/,
+    Context<dim>& /*context*/,
+    const std::string& /*yaml_file_dir*/)
 {
     // For explicit forms, we would need to support function definitions in YAML
     // This is complex and would require a scripting language or mathematical expression parser
@@ -226,16 +226,17 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_offset_function(
 
     // Parse offset function and compute its derivative analytically
     validate_required_field(node, "offset_function");
-    auto [offset_func, offset_deriv_func] =
-        parse_single_variable_function_with_derivative(node, "offset_function");
+    auto offset = parse_single_variable_function(node, "offset_function");
 
     // Store the base function and get raw pointer
     auto* base_function_ptr = context.add_function(std::move(base_function));
 
     return std::make_unique<OffsetFunction<dim>>(
         *base_function_ptr,
-        offset_func,
-        offset_deriv_func);
+        std::move(offset.function),
+        std::move(offset.derivative),
+        std::move(offset.bounds),
+        std::move(offset.derivative_bounds));
 }
 
 template <int dim>
@@ -271,7 +272,13 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_union_function(
         function_ptrs.push_back(context.add_function(std::move(func)));
     }
 
-    // For simplicity, we'll create a binary union tree
+    // Sharp unions, and smooth unions that opt in with `nary: true`, load as one flat node. Other
+    // smooth unions keep the binary chain, whose blend the flat node's sorted fold does not
+    // reproduce for three or more functions.
+    if (smooth_distance == 0 || parse_bool(node, "nary", false)) {
+        return std::make_unique<NaryUnionFunction<dim>>(std::move(function_ptrs), smooth_distance);
+    }
+
     auto result =
         std::make_unique<UnionFunction<dim>>(*function_ptrs[0], *function_ptrs[1], smooth_distance);
 
@@ -282,7 +289,7 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_union_function(
             std::make_unique<UnionFunction<dim>>(*prev_union, *function_ptrs[i], smooth_distance);
     }
 
-    return std::move(result);
+    return result;
 }
 
 template <int dim>
@@ -456,7 +463,7 @@ std::unique_ptr<Transform<dim>> YamlParser<dim>::parse_compose(
         result = std::make_unique<Compose<dim>>(*prev_compose, *transform_ptrs[i]);
     }
 
-    return std::move(result);
+    return result;
 }
 
 template <int dim>
@@ -661,14 +668,21 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_interpolate_funct
     // Create interpolation functions based on type
     std::function<Scalar(Scalar)> interpolation_func;
     std::function<Scalar(Scalar)> interpolation_derivative;
+    // Interval extensions of both, so the interpolation keeps finite bounds
+    IntervalExtension<Scalar> interpolation_bounds;
+    IntervalExtension<Scalar> derivative_bounds;
 
     if (interpolation_type == "linear") {
         interpolation_func = [](Scalar t) { return t; };
-        interpolation_derivative = [](Scalar t) { return 1.0; };
+        interpolation_derivative = [](Scalar /*t*/) { return 1.0; };
+        interpolation_bounds = [](Interval<Scalar> t) { return t; };
+        derivative_bounds = [](Interval<Scalar>) { return Interval<Scalar>(1); };
     } else if (interpolation_type == "smooth") {
         // Smooth step interpolation using polynomial: 3t² - 2t³
         interpolation_func = [](Scalar t) { return 3 * t * t - 2 * t * t * t; };
         interpolation_derivative = [](Scalar t) { return 6 * t - 6 * t * t; };
+        interpolation_bounds = [](Interval<Scalar> t) { return 3 * sqr(t) - 2 * pow(t, 3); };
+        derivative_bounds = [](Interval<Scalar> t) { return 6 * t - 6 * sqr(t); };
     } else if (interpolation_type == "cosine") {
         // Cosine interpolation using generalized sinusoidal function
         // Formula: offset + amplitude × (sin(t × n × 2π + phase - π/2) + 1) / 2
@@ -684,6 +698,16 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_interpolate_funct
             return amplitude * num_periods * std::numbers::pi * 
                 std::cos(t * num_periods * 2.0 * std::numbers::pi + phase - std::numbers::pi / 2.0);
         };
+        interpolation_bounds = [num_periods, amplitude, phase, offset](Interval<Scalar> t) {
+            const auto angle =
+                t * (num_periods * 2.0 * std::numbers::pi) + (phase - std::numbers::pi / 2.0);
+            return offset + amplitude * 0.5 * (sin(angle) + 1.0);
+        };
+        derivative_bounds = [num_periods, amplitude, phase](Interval<Scalar> t) {
+            const auto angle =
+                t * (num_periods * 2.0 * std::numbers::pi) + (phase - std::numbers::pi / 2.0);
+            return amplitude * num_periods * std::numbers::pi * cos(angle);
+        };
     } else if (interpolation_type == "custom") {
         // For custom interpolation, we would need to parse mathematical expressions
         // For now, throw an error suggesting this isn't supported
@@ -699,7 +723,9 @@ std::unique_ptr<SpaceTimeFunction<dim>> YamlParser<dim>::parse_interpolate_funct
         *function1_ptr,
         *function2_ptr,
         interpolation_func,
-        interpolation_derivative);
+        interpolation_derivative,
+        interpolation_bounds,
+        derivative_bounds);
 }
 
 template <int dim>
@@ -840,73 +866,74 @@ std::unique_ptr<ImplicitFunction<dim>> YamlParser<dim>::parse_implicit_union(
         primitive_ptrs.push_back(context.add_primitive(std::move(primitive)));
     }
 
-    // Create union tree based on blending function
-    std::unique_ptr<ImplicitFunction<dim>> result;
+    // Sharp unions, and smooth unions that opt in with `nary: true`, load as one flat node. Other
+    // smooth unions keep the binary chain, whose blend the flat node's sorted fold does not
+    // reproduce for three or more primitives.
+    const bool nary = smooth_distance == 0 || parse_bool(node, "nary", false);
 
     if (blending_str == "quadratic") {
-        result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Quadratic>>(
-            *primitive_ptrs[0],
-            *primitive_ptrs[1],
-            smooth_distance);
-
-        for (size_t i = 2; i < primitive_ptrs.size(); ++i) {
-            auto* prev_union = context.add_primitive(std::move(result));
-            result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Quadratic>>(
-                *prev_union,
-                *primitive_ptrs[i],
-                smooth_distance);
-        }
+        return make_implicit_union<BlendingFunction::Quadratic>(
+            std::move(primitive_ptrs),
+            smooth_distance,
+            nary,
+            context);
     } else if (blending_str == "cubic") {
-        result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Cubic>>(
-            *primitive_ptrs[0],
-            *primitive_ptrs[1],
-            smooth_distance);
-
-        for (size_t i = 2; i < primitive_ptrs.size(); ++i) {
-            auto* prev_union = context.add_primitive(std::move(result));
-            result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Cubic>>(
-                *prev_union,
-                *primitive_ptrs[i],
-                smooth_distance);
-        }
+        return make_implicit_union<BlendingFunction::Cubic>(
+            std::move(primitive_ptrs),
+            smooth_distance,
+            nary,
+            context);
     } else if (blending_str == "quartic") {
-        result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Quartic>>(
-            *primitive_ptrs[0],
-            *primitive_ptrs[1],
-            smooth_distance);
-
-        for (size_t i = 2; i < primitive_ptrs.size(); ++i) {
-            auto* prev_union = context.add_primitive(std::move(result));
-            result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Quartic>>(
-                *prev_union,
-                *primitive_ptrs[i],
-                smooth_distance);
-        }
+        return make_implicit_union<BlendingFunction::Quartic>(
+            std::move(primitive_ptrs),
+            smooth_distance,
+            nary,
+            context);
     } else if (blending_str == "circular") {
-        result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Circular>>(
-            *primitive_ptrs[0],
-            *primitive_ptrs[1],
-            smooth_distance);
-
-        for (size_t i = 2; i < primitive_ptrs.size(); ++i) {
-            auto* prev_union = context.add_primitive(std::move(result));
-            result = std::make_unique<ImplicitUnion<dim, BlendingFunction::Circular>>(
-                *prev_union,
-                *primitive_ptrs[i],
-                smooth_distance);
-        }
+        return make_implicit_union<BlendingFunction::Circular>(
+            std::move(primitive_ptrs),
+            smooth_distance,
+            nary,
+            context);
     } else {
         throw YamlParseError(
             "Unknown blending function: " + blending_str +
             ". Supported: quadratic, cubic, quartic, circular");
     }
+}
+
+template <int dim>
+template <BlendingFunction blending>
+std::unique_ptr<ImplicitFunction<dim>> YamlParser<dim>::make_implicit_union(
+    std::vector<ImplicitFunction<dim>*> primitives,
+    Scalar smooth_distance,
+    bool nary,
+    Context<dim>& context)
+{
+    if (nary) {
+        return std::make_unique<ImplicitNaryUnion<dim, blending>>(
+            std::move(primitives),
+            smooth_distance);
+    }
+
+    std::unique_ptr<ImplicitFunction<dim>> result = std::make_unique<ImplicitUnion<dim, blending>>(
+        *primitives[0],
+        *primitives[1],
+        smooth_distance);
+
+    for (size_t i = 2; i < primitives.size(); ++i) {
+        auto* prev_union = context.add_primitive(std::move(result));
+        result = std::make_unique<ImplicitUnion<dim, blending>>(
+            *prev_union,
+            *primitives[i],
+            smooth_distance);
+    }
 
     return result;
 }
 
 template <int dim>
-std::pair<std::function<Scalar(Scalar)>, std::function<Scalar(Scalar)>>
-YamlParser<dim>::parse_single_variable_function_with_derivative(
+SingleVariableFunction YamlParser<dim>::parse_single_variable_function(
     const YAML::Node& node,
     const std::string& field_name)
 {
@@ -921,16 +948,24 @@ YamlParser<dim>::parse_single_variable_function_with_derivative(
 
     if (type == "constant") {
         Scalar value = parse_scalar(func_node, "value");
-        auto func = [value](Scalar t) { return value; };
-        auto deriv = [](Scalar t) { return 0.0; }; // Derivative of constant is 0
-        return std::make_pair(func, deriv);
+        auto func = [value](Scalar /*t*/) { return value; };
+        auto deriv = [](Scalar /*t*/) { return 0.0; }; // Derivative of constant is 0
+        return {
+            func,
+            deriv,
+            [value](Interval<Scalar>) { return Interval<Scalar>(value); },
+            [](Interval<Scalar>) { return Interval<Scalar>(0); }};
 
     } else if (type == "linear") {
         Scalar a = parse_scalar(func_node, "slope");
         Scalar b = parse_scalar(func_node, "intercept");
         auto func = [a, b](Scalar t) { return a * t + b; };
-        auto deriv = [a](Scalar t) { return a; }; // Derivative of at+b is a
-        return std::make_pair(func, deriv);
+        auto deriv = [a](Scalar /*t*/) { return a; }; // Derivative of at+b is a
+        return {
+            func,
+            deriv,
+            [a, b](Interval<Scalar> t) { return a * t + b; },
+            [a](Interval<Scalar>) { return Interval<Scalar>(a); }};
 
     } else if (type == "polynomial") {
         if (!func_node["coefficients"].IsSequence()) {
@@ -969,7 +1004,20 @@ YamlParser<dim>::parse_single_variable_function_with_derivative(
             return result;
         };
 
-        return std::make_pair(func, deriv);
+        // Horner's scheme in interval arithmetic.
+        auto horner = [](const std::vector<Scalar>& c, Interval<Scalar> t) {
+            Interval<Scalar> result(0);
+            for (auto it = c.rbegin(); it != c.rend(); ++it) result = result * t + *it;
+            return result;
+        };
+        std::vector<Scalar> deriv_coeffs;
+        for (size_t i = 1; i < coeffs.size(); ++i) deriv_coeffs.push_back(i * coeffs[i]);
+
+        return {
+            func,
+            deriv,
+            [coeffs, horner](Interval<Scalar> t) { return horner(coeffs, t); },
+            [deriv_coeffs, horner](Interval<Scalar> t) { return horner(deriv_coeffs, t); }};
 
     } else if (type == "sinusoidal") {
         Scalar amplitude = parse_scalar(func_node, "amplitude");
@@ -992,7 +1040,15 @@ YamlParser<dim>::parse_single_variable_function_with_derivative(
             return amplitude * frequency * std::cos(frequency * t + phase);
         };
 
-        return std::make_pair(func, deriv);
+        return {
+            func,
+            deriv,
+            [amplitude, frequency, phase, offset](Interval<Scalar> t) {
+                return amplitude * sin(frequency * t + phase) + offset;
+            },
+            [amplitude, frequency, phase](Interval<Scalar> t) {
+                return amplitude * frequency * cos(frequency * t + phase);
+            }};
 
     } else if (type == "exponential") {
         Scalar amplitude = parse_scalar(func_node, "amplitude");
@@ -1009,7 +1065,22 @@ YamlParser<dim>::parse_single_variable_function_with_derivative(
         // Derivative: d/dt(A*exp(rt) + c) = A*r*exp(rt)
         auto deriv = [amplitude, rate](Scalar t) { return amplitude * rate * std::exp(rate * t); };
 
-        return std::make_pair(func, deriv);
+        // exp(rate * t) is monotone, so its range is spanned by the ends of the interval.
+        auto exp_range = [rate](Interval<Scalar> t) {
+            const Scalar a = std::exp(rate * t.lower);
+            const Scalar b = std::exp(rate * t.upper);
+            return Interval<Scalar>(std::min(a, b), std::max(a, b));
+        };
+
+        return {
+            func,
+            deriv,
+            [amplitude, offset, exp_range](Interval<Scalar> t) {
+                return amplitude * exp_range(t) + offset;
+            },
+            [amplitude, rate, exp_range](Interval<Scalar> t) {
+                return amplitude * rate * exp_range(t);
+            }};
 
     } else if (type == "polybezier") {
         if (!func_node["control_points"].IsSequence()) {
@@ -1142,7 +1213,28 @@ YamlParser<dim>::parse_single_variable_function_with_derivative(
             return bezier_deriv * dt_scale;
         };
 
-        return std::make_pair(func, deriv);
+        // Each segment lies in the hull of its control values and its derivative in the hull of
+        // the scaled control differences; the curve is constant outside its time range.
+        auto values = Interval<Scalar>::empty();
+        Interval<Scalar> rates(0);
+        for (const auto& point : control_points) {
+            values = hull(values, Interval<Scalar>(point.second));
+        }
+        for (size_t i = 0; i + 3 < control_points.size(); i += 3) {
+            const Scalar duration = control_points[i + 3].first - control_points[i].first;
+            if (std::abs(duration) < 1e-10) continue;
+            for (size_t j = i; j < i + 3; ++j) {
+                const Scalar rate =
+                    3 * (control_points[j + 1].second - control_points[j].second) / duration;
+                rates = hull(rates, Interval<Scalar>(rate));
+            }
+        }
+
+        return {
+            func,
+            deriv,
+            [values](Interval<Scalar>) { return values; },
+            [rates](Interval<Scalar>) { return rates; }};
 
     } else {
         throw YamlParseError(
@@ -0,0 +1,244 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <stf/stf.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Checks that every edge is shared by two triangles traversing it in opposite directions.
+ */
+void check_closed(const stf::TriangleMesh<>& mesh)
+{
+    std::map<std::pair<uint32_t, uint32_t>, int> directed;
+    for (const auto& triangle : mesh.triangles) {
+        for (int i = 0; i < 3; ++i) ++directed[{triangle[i], triangle[(i + 1) % 3]}];
+    }
+    for (const auto& [edge, count] : directed) {
+        REQUIRE(count == 1);
+        REQUIRE(directed.count({edge.second, edge.first}) == 1);
+    }
+}
+
+/**
+ * Volume enclosed by a closed mesh, positive when the triangles face outwards.
+ */
+stf::Scalar enclosed_volume(const stf::TriangleMesh<>& mesh)
+{
+    stf::Scalar volume = 0;
+    for (const auto& triangle : mesh.triangles) {
+        const auto& a = mesh.vertices[triangle[0]];
+        const auto& b = mesh.vertices[triangle[1]];
+        const auto& c = mesh.vertices[triangle[2]];
+        volume += (a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0]) +
+                   a[2] * (b[0] * c[1] - b[1] * c[0])) /
+                  6;
+    }
+    return volume;
+}
+
+} // namespace
+
+TEST_CASE("marching_cubes", "[stf]")
+{
+    const auto grid = stf::GridSpec<3>::from_box({{{-1, 1}, {-1, 1}, {-1, 1}}}, {41, 37, 45});
+    const stf::Scalar spacing = 2.0 / 36;
+
+    SECTION("table")
+    {
+        const auto& table = stf::MarchingCubesTable::get();
+        REQUIRE(table.triangles(0).empty());
+        REQUIRE(table.triangles(255).empty());
+        REQUIRE(table.triangles(1).size() == 1);
+        REQUIRE(table.triangles(0b00001111).size() == 2);
+        for (size_t configuration = 1; configuration < 255; ++configuration) {
+            REQUIRE(!table.triangles(configuration).empty());
+            REQUIRE(table.triangles(configuration).size() <= 5);
+        }
+    }
+
+    SECTION("closed sphere")
+    {
+        stf::ImplicitBall<3> ball(0.5, {0.1, -0.05, 0.02});
+        const auto mesh = stf::marching_cubes<stf::Scalar>(ball, grid, {8, 3, true});
+        REQUIRE(!mesh.triangles.empty());
+        check_closed(mesh);
+
+        const stf::Scalar expected = 4.0 / 3.0 * std::numbers::pi * 0.125;
+        REQUIRE_THAT(enclosed_volume(mesh), Catch::Matchers::WithinRel(expected, 0.03));
+
+        REQUIRE(mesh.normals.size() == mesh.vertices.size());
+        for (size_t j = 0; j < mesh.vertices.size(); ++j) {
+            const auto& v = mesh.vertices[j];
+            REQUIRE(std::abs(ball.value(v)) < spacing);
+            const auto& n = mesh.normals[j];
+            REQUIRE_THAT(
+                n[0] * n[0] + n[1] * n[1] + n[2] * n[2],
+                Catch::Matchers::WithinAbs(1, 1e-9));
+            REQUIRE(n[0] * (v[0] - 0.1) + n[1] * (v[1] + 0.05) + n[2] * (v[2] - 0.02) > 0);
+        }
+    }
+
+    SECTION("independent of threads and blocks")
+    {
+        stf::ImplicitTorus torus(0.5, 0.15, {0.0, 0.1, 0.0});
+        const auto reference = stf::marching_cubes<stf::Scalar>(torus, grid, {7, 1});
+        const auto parallel = stf::marching_cubes<stf::Scalar>(torus, grid, {7, 4});
+        REQUIRE(parallel.vertices == reference.vertices);
+        REQUIRE(parallel.triangles == reference.triangles);
+
+        const auto single_block = stf::marching_cubes<stf::Scalar>(torus, grid, {64, 1});
+        REQUIRE(single_block.vertices.size() == reference.vertices.size());
+        REQUIRE(single_block.triangles.size() == reference.triangles.size());
+        check_closed(reference);
+        REQUIRE_THAT(
+            enclosed_volume(single_block),
+            Catch::Matchers::WithinRel(enclosed_volume(reference), 1e-9));
+    }
+
+    SECTION("space-time function")
+    {
+        stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0});
+        stf::Translation<3> translation({0.4, 0.0, 0.0});
+        stf::SweepFunction<3> sweep(ball, translation);
+        const stf::Scalar t = 0.5;
+        const auto mesh = stf::marching_cubes<stf::Scalar>(sweep, grid, t);
+        REQUIRE(!mesh.triangles.empty());
+        check_closed(mesh);
+        for (const auto& v : mesh.vertices) {
+            REQUIRE(std::abs(sweep.value(v, t)) < spacing);
+        }
+    }
+
+    SECTION("empty and invalid")
+    {
+        stf::ImplicitBall<3> far(0.1, {5.0, 5.0, 5.0});
+        REQUIRE(stf::marching_cubes<stf::Scalar>(far, grid).triangles.empty());
+        REQUIRE_THROWS_AS(
+            stf::marching_cubes<stf::Scalar>(far, grid, {0, 1}),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("dual_contouring", "[stf]")
+{
+    const stf::IntervalBox<3> box{{{-1, 1}, {-1, 1}, {-1, 1}}};
+
+    // Axis-aligned cube of half-size 0.5, with exact gradients.
+    const std::array<stf::Scalar, 3> center{0.013, 0.021, -0.017};
+    stf::GenericFunction<3> cube(
+        [&](std::array<stf::Scalar, 3> p) {
+            stf::Scalar d = -1;
+            for (int i = 0; i < 3; ++i) d = std::max(d, std::abs(p[i] - center[i]));
+            return d - 0.5;
+        },
+        [&](std::array<stf::Scalar, 3> p) {
+            int axis = 0;
+            for (int i = 1; i < 3; ++i) {
+                if (std::abs(p[i] - center[i]) > std::abs(p[axis] - center[axis])) axis = i;
+            }
+            std::array<stf::Scalar, 3> g{0, 0, 0};
+            g[axis] = p[axis] > center[axis] ? 1 : -1;
+            return g;
+        });
+
+    SECTION("QEF")
+    {
+        stf::QuadraticError<> qef;
+        qef.add({0.3, 0.0, 0.0}, {1, 0, 0});
+        qef.add({0.0, -0.2, 0.0}, {0, 1, 0});
+        qef.add({0.1, 0.1, 0.4}, {0, 0, 1});
+        const auto corner = qef.solve();
+        REQUIRE_THAT(corner[0], Catch::Matchers::WithinAbs(0.3, 1e-12));
+        REQUIRE_THAT(corner[1], Catch::Matchers::WithinAbs(-0.2, 1e-12));
+        REQUIRE_THAT(corner[2], Catch::Matchers::WithinAbs(0.4, 1e-12));
+        REQUIRE_THAT(qef.error(corner), Catch::Matchers::WithinAbs(0, 1e-12));
+
+        // Parallel planes leave the tangent directions at the mass point.
+        stf::QuadraticError<> flat;
+        flat.add({0.0, 0.0, 0.1}, {0, 0, 1});
+        flat.add({1.0, 0.5, 0.1}, {0, 0, 1});
+        const auto x = flat.solve();
+        REQUIRE_THAT(x[0], Catch::Matchers::WithinAbs(0.5, 1e-12));
+        REQUIRE_THAT(x[1], Catch::Matchers::WithinAbs(0.25, 1e-12));
+        REQUIRE_THAT(x[2], Catch::Matchers::WithinAbs(0.1, 1e-12));
+    }
+
+    SECTION("closed sphere")
+    {
+        stf::ImplicitBall<3> ball(0.5, {0.1, -0.05, 0.02});
+        const auto mesh = stf::dual_contouring<stf::Scalar>(ball, box, {5, 0.0, 2});
+        REQUIRE(!mesh.triangles.empty());
+        check_closed(mesh);
+        const stf::Scalar expected = 4.0 / 3.0 * std::numbers::pi * 0.125;
+        REQUIRE_THAT(enclosed_volume(mesh), Catch::Matchers::WithinRel(expected, 0.03));
+        for (const auto& v : mesh.vertices) REQUIRE(std::abs(ball.value(v)) < 0.01);
+    }
+
+    SECTION("sharp features")
+    {
+        const auto mesh = stf::dual_contouring<stf::Scalar>(cube, box, {5, 0.0, 2});
+        check_closed(mesh);
+        REQUIRE_THAT(enclosed_volume(mesh), Catch::Matchers::WithinRel(1.0, 1e-9));
+        for (int c = 0; c < 8; ++c) {
+            const std::array<stf::Scalar, 3> corner{
+                center[0] + ((c & 1) ? 0.5 : -0.5),
+                center[1] + ((c >> 1) & 1 ? 0.5 : -0.5),
+                center[2] + ((c >> 2) ? 0.5 : -0.5)};
+            auto at_corner = [&](const std::array<stf::Scalar, 3>& v) {
+                return std::abs(v[0] - corner[0]) + std::abs(v[1] - corner[1]) +
+                           std::abs(v[2] - corner[2]) <
+                       1e-9;
+            };
+            const bool found = std::any_of(mesh.vertices.begin(), mesh.vertices.end(), at_corner);
+            REQUIRE(found);
+        }
+    }
+
+    SECTION("simplification")
+    {
+        const auto full = stf::dual_contouring<stf::Scalar>(cube, box, {6, 0.0, 2});
+        const auto simplified = stf::dual_contouring<stf::Scalar>(cube, box, {6, 0.01, 2});
+        REQUIRE(simplified.triangles.size() * 10 < full.triangles.size());
+        check_closed(simplified);
+        REQUIRE_THAT(enclosed_volume(simplified), Catch::Matchers::WithinRel(1.0, 1e-9));
+    }
+
+    SECTION("independent of threads")
+    {
+        stf::ImplicitTorus torus(0.5, 0.15, {0.0, 0.1, 0.0});
+        const auto reference = stf::dual_contouring<stf::Scalar>(torus, box, {5, 0.05, 1});
+        const auto parallel = stf::dual_contouring<stf::Scalar>(torus, box, {5, 0.05, 4});
+        REQUIRE(parallel.vertices == reference.vertices);
+        REQUIRE(parallel.triangles == reference.triangles);
+    }
+
+    SECTION("space-time function")
+    {
+        stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0});
+        stf::Translation<3> translation({0.4, 0.0, 0.0});
+        stf::SweepFunction<3> sweep(ball, translation);
+        const auto mesh = stf::dual_contouring<stf::Scalar>(sweep, box, 0.5, {5});
+        REQUIRE(!mesh.triangles.empty());
+        for (const auto& v : mesh.vertices) REQUIRE(std::abs(sweep.value(v, 0.5)) < 0.01);
+    }
+
+    SECTION("invalid options")
+    {
+        REQUIRE_THROWS_AS(
+            stf::dual_contouring<stf::Scalar>(cube, box, {0}),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            stf::dual_contouring<stf::Scalar>(cube, box, {17}),
+            std::invalid_argument);
+    }
+}
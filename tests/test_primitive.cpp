@@ -3,7 +3,10 @@
 
 #include <stf/primitives/all.h>
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 template <int dim>
 void check_gradient(
@@ -17,6 +20,105 @@ void check_gradient(
     for (int i = 0; i < dim; ++i) {
         REQUIRE_THAT(grad[i], Catch::Matchers::WithinAbs(grad_fd[i], epsilon));
     }
+
+    auto eval = implicit.evaluate(pos);
+    REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(implicit.value(pos), epsilon));
+    for (int i = 0; i < dim; ++i) {
+        REQUIRE_THAT(eval.gradient[i], Catch::Matchers::WithinAbs(grad[i], epsilon));
+    }
+}
+
+template <int dim>
+void check_hessian(
+    const stf::ImplicitFunction<dim>& implicit,
+    const std::array<stf::Scalar, dim>& pos,
+    stf::Scalar epsilon = 1e-5)
+{
+    auto H = implicit.hessian(pos);
+    auto H_fd = implicit.finite_difference_hessian(pos);
+    for (int i = 0; i < dim; ++i) {
+        for (int j = 0; j < dim; ++j) {
+            REQUIRE_THAT(H[i][j], Catch::Matchers::WithinAbs(H_fd[i][j], epsilon));
+            REQUIRE_THAT(H[i][j], Catch::Matchers::WithinAbs(H[j][i], 1e-12));
+        }
+    }
+}
+
+template <int dim>
+void check_value_bounds(
+    const stf::ImplicitFunction<dim>& implicit,
+    const stf::IntervalBox<dim>& box,
+    int samples = 6)
+{
+    const auto bounds = implicit.value_bounds(box);
+    REQUIRE(bounds.lower <= bounds.upper);
+
+    // Sample a regular grid of the box, corners included.
+    int count = 1;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            const stf::Scalar s = stf::Scalar(rest % samples) / (samples - 1);
+            pos[i] = box[i].lower + s * box[i].width();
+            rest /= samples;
+        }
+        const auto value = implicit.value(pos);
+        REQUIRE(value >= bounds.lower - 1e-9);
+        REQUIRE(value <= bounds.upper + 1e-9);
+    }
+}
+
+template <int dim>
+void check_lipschitz_bound(
+    const stf::ImplicitFunction<dim>& implicit,
+    const stf::IntervalBox<dim>& box,
+    int samples = 6)
+{
+    const auto bound = implicit.lipschitz_bound(box);
+    REQUIRE(bound >= 0);
+
+    int count = 1;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            const stf::Scalar s = stf::Scalar(rest % samples) / (samples - 1);
+            pos[i] = box[i].lower + s * box[i].width();
+            rest /= samples;
+        }
+        const auto g = implicit.gradient(pos);
+        stf::Scalar norm2 = 0;
+        for (int i = 0; i < dim; ++i) norm2 += g[i] * g[i];
+        REQUIRE(std::sqrt(norm2) <= bound + 1e-9);
+    }
+}
+
+template <int dim>
+void check_bounding_box(
+    const stf::ImplicitFunction<dim>& implicit,
+    stf::Scalar level = 0,
+    int samples = 21)
+{
+    const auto box = implicit.bounding_box(level);
+
+    // Every sample of the sublevel set within [-2, 2]^dim lies in the box.
+    int count = 1;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = -2 + 4 * stf::Scalar(rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        if (implicit.value(pos) > level) continue;
+        for (int i = 0; i < dim; ++i) {
+            REQUIRE(box[i].contains(pos[i]));
+        }
+    }
 }
 
 TEST_CASE("primitive", "[stf]")
@@ -124,6 +226,93 @@ TEST_CASE("primitive", "[stf]")
         check_gradient(shape, {1, 1, 1});
     }
 
+    SECTION("n-ary union")
+    {
+        stf::ImplicitBall<3> ball_1(0.5, {-0.6, 0, 0});
+        stf::ImplicitBall<3> ball_2(0.5, {0.6, 0, 0});
+        const std::vector<std::array<stf::Scalar, 3>> points{
+            {0, 0, 0},
+            {0.5, 0, 0},
+            {0.05, 0.3, -0.1},
+            {1, 1, 1}};
+
+        auto check_blending = [&]<stf::BlendingFunction blending>() {
+            for (stf::Scalar d : {0.0, 0.2}) {
+                stf::ImplicitUnion<3, blending> binary(ball_1, ball_2, d);
+                stf::ImplicitNaryUnion<3, blending> nary({&ball_1, &ball_2}, d);
+                for (const auto& p : points) {
+                    const auto expected = binary.evaluate(p);
+                    const auto eval = nary.evaluate(p);
+                    REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, 1e-12));
+                    for (int i = 0; i < 3; ++i) {
+                        REQUIRE_THAT(
+                            eval.gradient[i],
+                            Catch::Matchers::WithinAbs(expected.gradient[i], 1e-12));
+                    }
+                    const auto H = nary.hessian(p);
+                    const auto expected_H = binary.hessian(p);
+                    for (int i = 0; i < 3; ++i) {
+                        for (int j = 0; j < 3; ++j) {
+                            REQUIRE_THAT(
+                                H[i][j],
+                                Catch::Matchers::WithinAbs(expected_H[i][j], 1e-12));
+                        }
+                    }
+                }
+            }
+        };
+        check_blending.template operator()<stf::BlendingFunction::Quadratic>();
+        check_blending.template operator()<stf::BlendingFunction::Cubic>();
+        check_blending.template operator()<stf::BlendingFunction::Quartic>();
+        check_blending.template operator()<stf::BlendingFunction::Circular>();
+
+        // A blob of small balls, with culling compared against blending every operand.
+        std::vector<std::unique_ptr<stf::ImplicitBall<3>>> balls;
+        std::vector<stf::ImplicitFunction<3>*> operands;
+        for (int i = 0; i < 200; ++i) {
+            const stf::Scalar a = 0.7 * i;
+            const stf::Scalar r = 0.2 + 0.6 * std::fmod(0.37 * i, 1.0);
+            balls.push_back(std::make_unique<stf::ImplicitBall<3>>(
+                0.05 + 0.03 * std::fmod(0.61 * i, 1.0),
+                std::array<stf::Scalar, 3>{r * std::cos(a), r * std::sin(a), 0.002 * i - 0.2}));
+            operands.push_back(balls.back().get());
+        }
+
+        using Union = stf::ImplicitUnion<3, stf::BlendingFunction::Cubic>;
+        for (stf::Scalar d : {0.0, 0.02}) {
+            stf::ImplicitNaryUnion<3, stf::BlendingFunction::Cubic> blob(operands, d);
+            REQUIRE(blob.size() == operands.size());
+
+            for (int index = 0; index < 9 * 9 * 5; ++index) {
+                const std::array<stf::Scalar, 3> p{
+                    -1.0 + 0.25 * (index % 9),
+                    -1.0 + 0.24 * (index / 9 % 9),
+                    -0.4 + 0.2 * (index / 81)};
+                std::vector<stf::Scalar> values;
+                for (const auto* f : operands) values.push_back(f->value(p));
+                std::sort(values.begin(), values.end());
+                stf::Scalar expected = values.front();
+                for (size_t i = 1; i < values.size(); ++i) {
+                    const auto b = Union::blend(expected, values[i], d);
+                    if (b.w2 == 0) break;
+                    expected = b.value;
+                }
+                REQUIRE_THAT(blob.value(p), Catch::Matchers::WithinAbs(expected, 1e-12));
+                if (d == 0) REQUIRE(blob.value(p) == values.front());
+            }
+
+            check_gradient(blob, {0.31, 0.12, -0.1});
+            check_hessian<3>(blob, {0.31, 0.12, -0.1});
+            for (stf::Scalar level : {0.0, 0.1}) check_bounding_box<3>(blob, level);
+            const stf::IntervalBox<3> box{{{0.1, 0.4}, {-0.1, 0.3}, {-0.2, 0.1}}};
+            check_value_bounds<3>(blob, box);
+            check_lipschitz_bound<3>(blob, box);
+        }
+
+        REQUIRE_THROWS_AS(stf::ImplicitNaryUnion<3>({}), std::invalid_argument);
+        REQUIRE_THROWS_AS(stf::ImplicitNaryUnion<3>({&ball_1, nullptr}), std::invalid_argument);
+    }
+
     SECTION("capsule")
     {
         stf::ImplicitCapsule<3> capsule(0.5, {0, 0, 0}, {1, 0, 0});
@@ -329,4 +518,166 @@ TEST_CASE("primitive", "[stf]")
         check_gradient(large_torus, {6.0, 0, 0});
         check_gradient(large_torus, {5.0, 0, 1.0});
     }
+
+    SECTION("generic function with automatic gradient")
+    {
+        // A torus written as a generic lambda, differentiated by dual numbers.
+        auto shape = stf::GenericFunction<3>::from_generic([](auto p) {
+            using std::sqrt;
+            auto q = sqrt(p[0] * p[0] + p[1] * p[1]) - 1.0;
+            return sqrt(q * q + p[2] * p[2]) - 0.25;
+        });
+        stf::ImplicitTorus torus(1.0, 0.25, {0, 0, 0});
+        for (std::array<stf::Scalar, 3> pos :
+             {std::array<stf::Scalar, 3>{0.6, 0.2, 0.1}, {1.3, -0.4, 0.2}, {0.1, 0.9, -0.3}}) {
+            REQUIRE_THAT(shape.value(pos), Catch::Matchers::WithinAbs(torus.value(pos), 1e-12));
+            const auto grad = shape.gradient(pos);
+            const auto expected = torus.gradient(pos);
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE_THAT(grad[i], Catch::Matchers::WithinAbs(expected[i], 1e-12));
+            }
+            check_gradient<3>(shape, pos);
+        }
+    }
+
+    SECTION("hessian")
+    {
+        for (int degree = 1; degree <= 3; ++degree) {
+            stf::ImplicitBall<3> ball(0.5, {0.1, -0.2, 0.3}, degree);
+            check_hessian<3>(ball, {0.7, 0.1, -0.2});
+            check_hessian<3>(ball, {-0.3, 0.4, 0.9});
+        }
+        stf::ImplicitBall<2> circle(0.5, {0.1, -0.2}, 2);
+        check_hessian<2>(circle, {0.4, 0.3});
+        check_hessian<2>(circle, {0.1, -0.2});
+
+        stf::ImplicitCapsule<3> capsule(0.2, {-0.5, 0, 0}, {0.5, 0.2, 0.1});
+        check_hessian<3>(capsule, {0.1, 0.5, 0.2}); // along the cylinder
+        check_hessian<3>(capsule, {-0.9, 0.1, 0.3}); // near the first cap
+        check_hessian<3>(capsule, {0.8, 0.3, -0.2}); // near the second cap
+
+        stf::Scalar sqrt2_inv = 1.0 / std::sqrt(2.0);
+        stf::ImplicitTorus torus(1.0, 0.3, {0.1, 0.2, 0.3}, {sqrt2_inv, sqrt2_inv, 0});
+        check_hessian<3>(torus, {1.0, 0, 0});
+        check_hessian<3>(torus, {0.5, 0.5, 0.3});
+        check_hessian<3>(torus, {-0.5, 0.5, 1.2});
+
+        stf::Duchon vipss(
+            {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+            {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}},
+            {17, 18, 19, 20},
+            {1, 1, 1},
+            0.5,
+            true);
+        check_hessian<3>(vipss, {1.1, 0.9, 1.2}, 1e-3);
+        check_hessian<3>(vipss, {0.6, 1.3, 0.8}, 1e-3);
+
+        stf::ImplicitBall<3> ball_1(0.5, {-0.3, 0, 0});
+        stf::ImplicitBall<3> ball_2(0.5, {0.3, 0.1, 0});
+        const std::array<stf::Scalar, 3> p{0.05, 0.4, 0.1};
+        check_hessian<3>(stf::ImplicitUnion<3>(ball_1, ball_2), {0.4, 0.4, 0.1});
+        check_hessian<3>(stf::ImplicitUnion<3>(ball_1, ball_2, 0.1), p);
+        check_hessian<3>(
+            stf::ImplicitUnion<3, stf::BlendingFunction::Cubic>(ball_1, ball_2, 0.1),
+            p);
+        check_hessian<3>(
+            stf::ImplicitUnion<3, stf::BlendingFunction::Quartic>(ball_1, ball_2, 0.1),
+            p);
+        check_hessian<3>(
+            stf::ImplicitUnion<3, stf::BlendingFunction::Circular>(ball_1, ball_2, 0.1),
+            p);
+    }
+
+    SECTION("bounding box")
+    {
+        stf::ImplicitBall<3> ball(0.5, {0.1, -0.2, 0.3});
+        stf::ImplicitBall<3> quadratic_ball(0.5, {0.1, -0.2, 0.3}, 2);
+        stf::ImplicitCapsule<3> capsule(0.2, {-0.5, 0, 0}, {0.5, 0.2, 0.1});
+        stf::ImplicitTorus torus(1.0, 0.3, {0.1, 0.2, 0.3}, {1, 1, 0});
+        stf::ImplicitUnion<3> sharp_union(ball, capsule);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Circular> smooth_union(ball, capsule, 0.2);
+
+        for (stf::Scalar level : {0.0, 0.1, -0.1}) {
+            check_bounding_box<3>(ball, level);
+            check_bounding_box<3>(quadratic_ball, level);
+            check_bounding_box<3>(capsule, level);
+            check_bounding_box<3>(torus, level);
+            check_bounding_box<3>(sharp_union, level);
+            check_bounding_box<3>(smooth_union, level);
+        }
+
+        // The ball and capsule boxes are tight.
+        const auto ball_box = ball.bounding_box();
+        REQUIRE_THAT(ball_box[0].lower, Catch::Matchers::WithinAbs(-0.4, 1e-12));
+        REQUIRE_THAT(ball_box[2].upper, Catch::Matchers::WithinAbs(0.8, 1e-12));
+        const auto capsule_box = capsule.bounding_box();
+        REQUIRE_THAT(capsule_box[1].upper, Catch::Matchers::WithinAbs(0.4, 1e-12));
+
+        // A torus lying in the xy-plane is flat along z.
+        stf::ImplicitTorus flat_torus(1.0, 0.3, {0, 0, 0}, {0, 0, 1});
+        REQUIRE_THAT(flat_torus.bounding_box()[2].upper, Catch::Matchers::WithinAbs(0.3, 1e-12));
+        REQUIRE_THAT(flat_torus.bounding_box()[0].upper, Catch::Matchers::WithinAbs(1.3, 1e-12));
+
+        // Sublevel sets below the minimum are empty.
+        REQUIRE(stf::is_empty(ball.bounding_box(-1)));
+    }
+
+    SECTION("value bounds")
+    {
+        const std::vector<stf::IntervalBox<3>> boxes{
+            {{{-0.1, 0.1}, {-0.1, 0.1}, {-0.1, 0.1}}},
+            {{{0.2, 0.9}, {-0.3, 0.4}, {0.0, 0.5}}},
+            {{{-1.5, 1.5}, {-1.5, 1.5}, {-1.5, 1.5}}},
+            {{{2.0, 2.5}, {1.0, 1.2}, {-0.4, 0.4}}}};
+
+        stf::ImplicitBall<3> ball(0.5, {0.1, -0.2, 0.3});
+        stf::ImplicitBall<3> quadratic_ball(0.5, {0.1, -0.2, 0.3}, 2);
+        stf::ImplicitCapsule<3> capsule(0.2, {-0.5, 0, 0}, {0.5, 0.2, 0.1});
+        stf::Scalar sqrt2_inv = 1.0 / std::sqrt(2.0);
+        stf::ImplicitTorus torus(1.0, 0.3, {0.1, 0.2, 0.3}, {sqrt2_inv, sqrt2_inv, 0});
+        stf::Duchon vipss(
+            {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+            {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}},
+            {17, 18, 19, 20},
+            {1, 1, 1},
+            0.5,
+            true);
+        stf::ImplicitUnion<3> sharp_union(ball, capsule);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Circular> smooth_union(ball, torus, 0.1);
+
+        for (const auto& box : boxes) {
+            check_value_bounds<3>(ball, box);
+            check_value_bounds<3>(quadratic_ball, box);
+            check_value_bounds<3>(capsule, box);
+            check_value_bounds<3>(torus, box);
+            check_value_bounds<3>(vipss, box);
+            check_value_bounds<3>(sharp_union, box);
+            check_value_bounds<3>(smooth_union, box);
+
+            check_lipschitz_bound<3>(ball, box);
+            check_lipschitz_bound<3>(quadratic_ball, box);
+            check_lipschitz_bound<3>(capsule, box);
+            check_lipschitz_bound<3>(torus, box);
+            check_lipschitz_bound<3>(vipss, box);
+            check_lipschitz_bound<3>(sharp_union, box);
+            check_lipschitz_bound<3>(smooth_union, box);
+        }
+
+        // Distance fields are 1-Lipschitz; the quadratic ball steepens away from its center.
+        REQUIRE(capsule.lipschitz_bound(boxes[2]) == 1);
+        REQUIRE(
+            quadratic_ball.lipschitz_bound(boxes[0]) < quadratic_ball.lipschitz_bound(boxes[2]));
+
+        // The ball bounds are exact: a box inside the ball is negative, a box away from it is
+        // positive, and a box straddling the sphere contains zero.
+        REQUIRE(ball.value_bounds({{{0.0, 0.2}, {-0.3, -0.1}, {0.2, 0.4}}}).upper < 0);
+        REQUIRE(ball.value_bounds(boxes[3]).lower > 0);
+        REQUIRE(ball.value_bounds(boxes[1]).contains(0));
+        REQUIRE_THAT(ball.value_bounds(boxes[2]).lower, Catch::Matchers::WithinAbs(-0.5, 1e-12));
+        REQUIRE(capsule.value_bounds(boxes[3]).lower > 0);
+        REQUIRE(sharp_union.value_bounds(boxes[3]).lower > 0);
+
+        stf::ImplicitBall<2> circle(0.5, {0.1, -0.2});
+        check_value_bounds<2>(circle, {{{0.3, 0.8}, {-0.1, 0.4}}});
+    }
 }
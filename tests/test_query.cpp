@@ -0,0 +1,309 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <stf/stf.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("raycast", "[stf]")
+{
+    // A pinhole camera at z = -2 looking along +z, one ray per pixel in row-major order.
+    const size_t width = 48;
+    const size_t n = width * width;
+    stf::ColumnBuffer<3> origins(n);
+    stf::ColumnBuffer<3> directions(n);
+    {
+        auto o = origins.columns();
+        auto d = directions.columns();
+        for (size_t k = 0; k < n; ++k) {
+            const stf::Scalar x = -0.6 + 1.2 * stf::Scalar(k % width) / stf::Scalar(width - 1);
+            const stf::Scalar y = -0.6 + 1.2 * stf::Scalar(k / width) / stf::Scalar(width - 1);
+            const stf::Scalar norm = std::sqrt(x * x + y * y + 1);
+            o[0][k] = 0;
+            o[1][k] = 0;
+            o[2][k] = -2;
+            d[0][k] = x / norm;
+            d[1][k] = y / norm;
+            d[2][k] = 1 / norm;
+        }
+    }
+    const stf::RayBatch<3> rays{origins.const_columns(), directions.const_columns()};
+
+    const std::array<stf::Scalar, 3> center{0.1, -0.05, 0.2};
+    auto sphere_distance = [&](size_t k, stf::Scalar radius) {
+        stf::Scalar b = 0, c = -radius * radius;
+        for (int i = 0; i < 3; ++i) {
+            const stf::Scalar oc = origins.column(i)[k] - center[i];
+            b += oc * directions.column(i)[k];
+            c += oc * oc;
+        }
+        const stf::Scalar discriminant = b * b - c;
+        if (discriminant < 0) return std::numeric_limits<stf::Scalar>::infinity();
+        return -b - std::sqrt(discriminant);
+    };
+
+    SECTION("sphere")
+    {
+        stf::ImplicitBall<3> ball(0.5, center);
+        const auto hits = stf::raycast<3>(ball, rays, {.tolerance = 1e-9, .num_threads = 3});
+        size_t num_hits = 0;
+        for (size_t k = 0; k < n; ++k) {
+            const stf::Scalar expected = sphere_distance(k, 0.5);
+            if (std::isinf(expected)) {
+                REQUIRE(std::isinf(hits.distances[k]));
+                REQUIRE(std::isnan(hits.normals.column(0)[k]));
+                continue;
+            }
+            ++num_hits;
+            std::array<stf::Scalar, 3> p;
+            for (int i = 0; i < 3; ++i) {
+                p[i] = origins.column(i)[k] + hits.distances[k] * directions.column(i)[k];
+            }
+            // Sphere tracing approaches from outside, slowly along grazing rays.
+            REQUIRE(hits.distances[k] <= expected);
+            REQUIRE(ball.value(p) < 1e-9);
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE_THAT(
+                    hits.normals.column(i)[k],
+                    Catch::Matchers::WithinAbs((p[i] - center[i]) / 0.5, 1e-6));
+            }
+        }
+        REQUIRE(num_hits > n / 10);
+        REQUIRE(num_hits < n);
+    }
+
+    SECTION("over-relaxation and packets")
+    {
+        stf::ImplicitTorus torus(0.4, 0.12, {0.0, 0.0, 0.0}, {0, 1, 1});
+        const auto relaxed = stf::raycast<3>(torus, rays, {.num_threads = 2});
+        const auto plain = stf::raycast<3>(torus, rays, {.relaxation = 1});
+        REQUIRE(relaxed.num_evaluations < plain.num_evaluations);
+
+        // Rays running alongside a long capsule take many small steps.
+        stf::ImplicitCapsule<3> capsule(0.1, {0.0, 0.3, -1.0}, {0.0, -0.3, 1.0});
+        const auto relaxed_capsule = stf::raycast<3>(capsule, rays);
+        const auto plain_capsule = stf::raycast<3>(capsule, rays, {.relaxation = 1});
+        REQUIRE(relaxed_capsule.num_evaluations < plain_capsule.num_evaluations);
+        size_t disagreements = 0;
+        for (size_t k = 0; k < n; ++k) {
+            // Rays grazing the surface may run out of steps with either method.
+            if (std::isinf(relaxed.distances[k]) || std::isinf(plain.distances[k])) {
+                disagreements += std::isinf(relaxed.distances[k]) != std::isinf(plain.distances[k]);
+                continue;
+            }
+            REQUIRE_THAT(
+                relaxed.distances[k],
+                Catch::Matchers::WithinAbs(plain.distances[k], 1e-5));
+        }
+        REQUIRE(disagreements < n / 100);
+
+        const auto single = stf::raycast<3>(torus, rays, {.packet_size = 1, .num_threads = 1});
+        REQUIRE(single.distances == relaxed.distances);
+    }
+
+    SECTION("non-distance function")
+    {
+        // The squared distance has a Lipschitz constant that depends on the node.
+        stf::ImplicitBall<3> ball(0.5, center, 2);
+        const auto hits = stf::raycast<3>(ball, rays, {.tolerance = 1e-9});
+        for (size_t k = 0; k < n; ++k) {
+            const stf::Scalar expected = sphere_distance(k, 0.5);
+            if (std::isinf(expected)) {
+                REQUIRE(std::isinf(hits.distances[k]));
+            } else {
+                REQUIRE(hits.distances[k] <= expected);
+                REQUIRE_THAT(hits.distances[k], Catch::Matchers::WithinAbs(expected, 1e-4));
+            }
+        }
+    }
+
+    SECTION("space-time function")
+    {
+        stf::ImplicitBall<3> ball(0.5, {0.5, -0.05, 0.2});
+        stf::Translation<3> translation({0.8, 0.0, 0.0});
+        stf::SweepFunction<3> sweep(ball, translation);
+        const auto hits = stf::raycast<3>(sweep, rays, 0.5, {.tolerance = 1e-9});
+        for (size_t k = 0; k < n; ++k) {
+            const stf::Scalar expected = sphere_distance(k, 0.5);
+            if (std::isinf(expected)) {
+                REQUIRE(std::isinf(hits.distances[k]));
+            } else {
+                REQUIRE(hits.distances[k] <= expected);
+                REQUIRE_THAT(hits.distances[k], Catch::Matchers::WithinAbs(expected, 1e-4));
+            }
+        }
+    }
+
+    SECTION("culled packets and invalid options")
+    {
+        stf::ImplicitBall<3> far(0.1, {5.0, 5.0, 5.0});
+        const auto hits = stf::raycast<3>(far, rays);
+        REQUIRE(hits.num_evaluations == 0);
+        REQUIRE(std::all_of(hits.distances.begin(), hits.distances.end(), [](auto d) {
+            return std::isinf(d);
+        }));
+
+        REQUIRE_THROWS_AS(stf::raycast<3>(far, rays, {.relaxation = 2}), std::invalid_argument);
+        REQUIRE_THROWS_AS(stf::raycast<3>(far, rays, {.packet_size = 0}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("project_to_zero_set", "[stf]")
+{
+    const size_t n = 1000;
+    stf::ColumnBuffer<3> points(n);
+    {
+        auto columns = points.columns();
+        for (size_t k = 0; k < n; ++k) {
+            const stf::Scalar s = stf::Scalar(k);
+            columns[0][k] = 0.9 * std::sin(0.71 * s);
+            columns[1][k] = 0.9 * std::cos(1.37 * s);
+            columns[2][k] = 0.9 * std::sin(2.03 * s + 0.4);
+        }
+    }
+
+    SECTION("swept ball")
+    {
+        // At t = 0.5 the ball is centered at (0.1, -0.05, 0.2) - 0.5 * (0.4, 0, 0).
+        stf::ImplicitBall<3> ball(0.4, {0.1, -0.05, 0.2});
+        stf::Translation<3> translation({0.4, 0.0, 0.0});
+        stf::SweepFunction<3> sweep(ball, translation);
+        const std::array<stf::Scalar, 3> center{-0.1, -0.05, 0.2};
+
+        stf::ColumnBuffer<3> projected = points;
+        const auto report = stf::project_to_zero_set<3>(sweep, projected.columns(), 0.5);
+        REQUIRE(report.num_converged == n);
+        REQUIRE(report.max_iterations <= 3);
+        REQUIRE(report.num_evaluations <= 4 * n);
+        for (size_t k = 0; k < n; ++k) {
+            REQUIRE(report.converged[k] == 1);
+            REQUIRE(std::abs(report.values[k]) <= 1e-10);
+            const auto p = stf::gather(points.const_columns(), k);
+            const auto q = stf::gather(projected.const_columns(), k);
+            stf::Scalar distance = 0;
+            for (int i = 0; i < 3; ++i) distance += (p[i] - center[i]) * (p[i] - center[i]);
+            distance = std::sqrt(distance);
+            for (int i = 0; i < 3; ++i) {
+                const stf::Scalar expected = center[i] + 0.4 * (p[i] - center[i]) / distance;
+                REQUIRE_THAT(q[i], Catch::Matchers::WithinAbs(expected, 1e-9));
+            }
+        }
+    }
+
+    SECTION("damped steps")
+    {
+        // Newton steps on the squared distance overshoot; damping keeps |f| decreasing.
+        stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0}, 2);
+        stf::ImplicitTorus torus(0.5, 0.15, {0.0, 0.1, 0.0});
+        for (const stf::ImplicitFunction<3>* f :
+             std::vector<const stf::ImplicitFunction<3>*>{&ball, &torus}) {
+            stf::ColumnBuffer<3> projected = points;
+            const auto report = stf::project_to_zero_set<3>(
+                *f,
+                projected.columns(),
+                {.max_step = 0.25, .batch_size = 64, .num_threads = 3});
+            REQUIRE(report.num_converged == n);
+            for (size_t k = 0; k < n; ++k) {
+                REQUIRE(std::abs(f->value(stf::gather(projected.const_columns(), k))) <= 1e-10);
+            }
+
+            stf::ColumnBuffer<3> serial = points;
+            const auto serial_report =
+                stf::project_to_zero_set<3>(*f, serial.columns(), {.max_step = 0.25});
+            REQUIRE(serial_report.iterations == report.iterations);
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE(std::equal(
+                    serial.column(i).begin(),
+                    serial.column(i).end(),
+                    projected.column(i).begin()));
+            }
+        }
+    }
+
+    SECTION("failures")
+    {
+        // The gradient vanishes at the center, and the iteration limit stops slow points.
+        stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0}, 2);
+        std::vector<stf::Scalar> x{0.0, 0.9}, y{0.0, 0.0}, z{0.0, 0.0};
+        const auto report = stf::project_to_zero_set<3>(ball, {x, y, z}, {.max_iterations = 2});
+        REQUIRE(report.num_converged == 0);
+        REQUIRE(report.iterations[0] == 0);
+        REQUIRE(report.iterations[1] == 2);
+        REQUIRE(x[0] == 0);
+        REQUIRE(x[1] < 0.9);
+        REQUIRE(report.values[1] == ball.value({x[1], 0.0, 0.0}));
+
+        std::vector<stf::Scalar> short_column{0.0};
+        REQUIRE_THROWS_AS(
+            stf::project_to_zero_set<3>(ball, {x, y, short_column}),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("minimum_clearance", "[stf]")
+{
+    // A static ball of radius 0.2 at the origin, and a ball of radius 0.1 passing by along y:
+    // its center is (0.5, 0.6 - t, 0), closest at t = 0.6 with a clearance of 0.2.
+    stf::ImplicitBall<3> fixed_ball(0.2, {0.0, 0.0, 0.0});
+    stf::ImplicitBall<3> moving_ball(0.1, {0.5, 0.6, 0.0});
+    stf::Translation<3> still({0.0, 0.0, 0.0});
+    stf::Translation<3> pass({0.0, 1.0, 0.0});
+    stf::SweepFunction<3> a(fixed_ball, still);
+    stf::SweepFunction<3> b(moving_ball, pass);
+
+    SECTION("separated")
+    {
+        const auto result = stf::minimum_clearance<3>(a, b, 0, 1, {.tolerance = 1e-4});
+        REQUIRE_THAT(result.clearance, Catch::Matchers::WithinAbs(0.2, 1e-6));
+        REQUIRE(result.lower_bound <= 0.2 + 1e-12);
+        REQUIRE(result.error <= 1e-4);
+        REQUIRE(result.error >= 0);
+        REQUIRE_THAT(result.time, Catch::Matchers::WithinAbs(0.6, 1e-3));
+        REQUIRE_THAT(result.position[0], Catch::Matchers::WithinAbs(0.3, 1e-3));
+        REQUIRE_THAT(result.position[1], Catch::Matchers::WithinAbs(0.0, 1e-3));
+        REQUIRE(result.num_nodes < 10000);
+
+        const auto parallel =
+            stf::minimum_clearance<3>(a, b, 0, 1, {.tolerance = 1e-4, .num_threads = 3});
+        REQUIRE(parallel.clearance == result.clearance);
+        REQUIRE(parallel.lower_bound == result.lower_bound);
+        REQUIRE(parallel.num_nodes == result.num_nodes);
+    }
+
+    SECTION("restricted time range")
+    {
+        // Over [0, 0.3] the closest approach is at t = 0.3, at center distance sqrt(0.34).
+        const auto result = stf::minimum_clearance<3>(a, b, 0, 0.3, {.tolerance = 1e-4});
+        REQUIRE_THAT(result.clearance, Catch::Matchers::WithinAbs(std::sqrt(0.34) - 0.3, 1e-4));
+        REQUIRE_THAT(result.time, Catch::Matchers::WithinAbs(0.3, 1e-3));
+    }
+
+    SECTION("overlap")
+    {
+        stf::ImplicitBall<3> big(0.35, {0.5, 0.6, 0.0});
+        stf::SweepFunction<3> c(big, pass);
+        const auto result = stf::minimum_clearance<3>(a, c, 0, 1);
+        REQUIRE(result.clearance < 0);
+        REQUIRE(result.lower_bound <= result.clearance);
+    }
+
+    SECTION("budget and domain")
+    {
+        const auto result = stf::minimum_clearance<3>(a, b, 0, 1, {.max_nodes = 20});
+        REQUIRE(result.num_nodes <= 20);
+        REQUIRE(result.lower_bound <= 0.2);
+        REQUIRE(result.clearance >= 0.2 - 1e-9);
+        REQUIRE(result.error == result.clearance - result.lower_bound);
+
+        stf::ExplicitForm<3> plane([](std::array<stf::Scalar, 3> p, stf::Scalar) { return p[2]; });
+        REQUIRE_THROWS_AS(stf::minimum_clearance<3>(a, plane, 0, 1), std::invalid_argument);
+        const stf::IntervalBox<3> box{{{-1, 1}, {-1, 1}, {-1, 1}}};
+        const auto bounded = stf::minimum_clearance<3>(a, plane, 0, 1, box, {.max_nodes = 2000});
+        REQUIRE(bounded.clearance < 0);
+    }
+}
@@ -0,0 +1,245 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <stf/stf.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("sample_grid", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.4, 0.0, 0.0}, {0.4, 0.2, 0.0});
+    stf::Rotation<3> rotation({0.0, 0.1, 0.0}, {1, 1, 0}, 120);
+    stf::Translation<3> translation({0.5, -0.2, 0.1});
+    stf::SweepFunction<3> sweep_ball(ball, rotation);
+    stf::SweepFunction<3> sweep_capsule(capsule, translation);
+    stf::UnionFunction<3> union_fn(sweep_ball, sweep_capsule, 0.1);
+
+    const auto grid = stf::GridSpec<3>::from_box({{{-1, 1}, {-0.8, 0.6}, {-0.5, 0.5}}}, {17, 13, 9});
+    REQUIRE(grid.size() == 17 * 13 * 9);
+
+    SECTION("grid indexing")
+    {
+        for (size_t index : {size_t(0), size_t(16), size_t(17), size_t(500), grid.size() - 1}) {
+            REQUIRE(grid.index(grid.node(index)) == index);
+        }
+        const auto last = grid.position(grid.node(grid.size() - 1));
+        REQUIRE_THAT(last[0], Catch::Matchers::WithinAbs(1, 1e-12));
+        REQUIRE_THAT(last[1], Catch::Matchers::WithinAbs(0.6, 1e-12));
+        REQUIRE_THAT(last[2], Catch::Matchers::WithinAbs(0.5, 1e-12));
+    }
+
+    SECTION("values and gradients")
+    {
+        const stf::Scalar t = 0.3;
+        std::vector<stf::Scalar> values(grid.size()), gradients(3 * grid.size());
+        stf::sample_grid<3>(union_fn, grid, t, values, gradients, {4, 100});
+
+        for (size_t k = 0; k < grid.size(); ++k) {
+            const auto p = grid.position(grid.node(k));
+            const auto expected = union_fn.evaluate(p, t);
+            REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(expected.value, 1e-12));
+            for (size_t i = 0; i < 3; ++i) {
+                REQUIRE_THAT(
+                    gradients[i * grid.size() + k],
+                    Catch::Matchers::WithinAbs(expected.gradient[i], 1e-12));
+            }
+        }
+    }
+
+    SECTION("deterministic across thread counts")
+    {
+        const auto reference = stf::sample_grid<3>(union_fn, grid, 0.7, {1, 4096});
+        for (size_t num_threads : {2, 3, 8}) {
+            REQUIRE(stf::sample_grid<3>(union_fn, grid, 0.7, {num_threads, 4096}) == reference);
+        }
+    }
+
+    SECTION("2D implicit function")
+    {
+        stf::ImplicitBall<2> circle(0.5, {0.1, -0.2});
+        const auto grid_2d = stf::GridSpec<2>::from_box({{{-1, 1}, {-1, 1}}}, {33, 21});
+        std::vector<stf::Scalar> values(grid_2d.size());
+        stf::sample_grid<2>(circle, grid_2d, values, {}, {3, 64});
+        for (size_t k = 0; k < grid_2d.size(); ++k) {
+            const auto p = grid_2d.position(grid_2d.node(k));
+            REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(circle.value(p), 1e-12));
+        }
+    }
+
+    SECTION("invalid buffers")
+    {
+        std::vector<stf::Scalar> values(grid.size() - 1);
+        REQUIRE_THROWS_AS(stf::sample_grid<3>(union_fn, grid, 0.5, values), std::invalid_argument);
+        values.resize(grid.size());
+        std::vector<stf::Scalar> gradients(grid.size());
+        REQUIRE_THROWS_AS(
+            stf::sample_grid<3>(union_fn, grid, 0.5, values, gradients),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("sample_space_time_grid", "[stf]")
+{
+    stf::ImplicitBall<2> ball(0.3, {0.1, 0.0});
+    stf::Polyline<2> polyline({{0, 0}, {0.5, 0}, {0.5, 0.5}});
+    stf::SweepFunction<2> sweep(ball, polyline);
+    const auto grid = stf::GridSpec<2>::from_box({{{-1, 1}, {-1, 1}}}, {31, 17});
+    const std::vector<stf::Scalar> times{0.0, 0.25, 0.5, 0.75, 1.0};
+
+    SECTION("slabs match sample_grid")
+    {
+        std::vector<size_t> steps;
+        std::vector<std::vector<stf::Scalar>> slabs, slab_gradients;
+        stf::sample_space_time_grid<2>(
+            sweep,
+            grid,
+            times,
+            [&](const stf::GridSlab<2>& slab) {
+                steps.push_back(slab.step);
+                REQUIRE(slab.time == times[slab.step]);
+                slabs.emplace_back(slab.values.begin(), slab.values.end());
+                slab_gradients.emplace_back(slab.gradients.begin(), slab.gradients.end());
+            },
+            true,
+            {2, 100});
+
+        REQUIRE(steps == std::vector<size_t>{0, 1, 2, 3, 4});
+        for (size_t k = 0; k < times.size(); ++k) {
+            std::vector<stf::Scalar> values(grid.size()), gradients(2 * grid.size());
+            stf::sample_grid<2>(sweep, grid, times[k], values, gradients);
+            REQUIRE(slabs[k] == values);
+            REQUIRE(slab_gradients[k] == gradients);
+        }
+    }
+
+    SECTION("raw writer")
+    {
+        std::ostringstream out;
+        stf::sample_space_time_grid<2>(sweep, grid, times, stf::RawSlabWriter<2>(out));
+        const std::string data = out.str();
+        REQUIRE(data.size() == times.size() * grid.size() * sizeof(stf::Scalar));
+
+        // The last slab is stored last.
+        const auto expected = stf::sample_grid<2>(sweep, grid, times.back());
+        std::vector<stf::Scalar> last(grid.size());
+        std::memcpy(
+            last.data(),
+            data.data() + (times.size() - 1) * grid.size() * sizeof(stf::Scalar),
+            grid.size() * sizeof(stf::Scalar));
+        REQUIRE(last == expected);
+    }
+
+    SECTION("sink errors are rethrown")
+    {
+        size_t calls = 0;
+        auto failing_sink = [&](const stf::GridSlab<2>& slab) {
+            ++calls;
+            if (slab.step == 1) throw std::runtime_error("disk full");
+        };
+        REQUIRE_THROWS_AS(
+            stf::sample_space_time_grid<2>(sweep, grid, times, failing_sink),
+            std::runtime_error);
+        REQUIRE(calls == 2);
+    }
+}
+
+TEST_CASE("sample_narrow_band", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+    stf::Translation<3> translation({0.4, -0.2, 0.1});
+    stf::SweepFunction<3> sweep(ball, translation);
+    const auto grid = stf::GridSpec<3>::from_box({{{-1, 1}, {-1, 1}, {-1, 1}}}, {61, 50, 47});
+
+    // Every node within the band must be stored with its dense value.
+    auto check = [&](const stf::SparseGrid<3>& sparse, const std::vector<stf::Scalar>& dense,
+                     stf::Scalar band) {
+        for (size_t k = 0; k < grid.size(); ++k) {
+            const auto* value = sparse.find(grid.node(k));
+            if (value != nullptr) {
+                REQUIRE(*value == dense[k]);
+            } else {
+                REQUIRE(std::abs(dense[k]) > band);
+            }
+        }
+    };
+
+    SECTION("matches dense sampling within the band")
+    {
+        const stf::Scalar t = 0.6;
+        const auto dense = stf::sample_grid<3>(sweep, grid, t);
+        for (stf::Scalar band : {0.0, 0.05}) {
+            const auto sparse = stf::sample_narrow_band<3>(sweep, grid, t, band, {8, 3});
+            check(sparse, dense, band);
+            REQUIRE(sparse.num_evaluations < sparse.dense_evaluations() / 2);
+            REQUIRE(sparse.saved_evaluations() > 0);
+        }
+    }
+
+    SECTION("deterministic across thread counts")
+    {
+        const auto reference = stf::sample_narrow_band<3>(sweep, grid, 0.2, 0.02, {4, 1});
+        const auto parallel = stf::sample_narrow_band<3>(sweep, grid, 0.2, 0.02, {4, 4});
+        REQUIRE(parallel.blocks == reference.blocks);
+        REQUIRE(parallel.num_evaluations == reference.num_evaluations);
+        for (size_t k = 0; k < reference.values.size(); ++k) {
+            REQUIRE((parallel.values[k] == reference.values[k] ||
+                     (std::isnan(parallel.values[k]) && std::isnan(reference.values[k]))));
+        }
+    }
+
+    SECTION("functions without bounds keep every block")
+    {
+        stf::ImplicitBall<3> sphere(0.5, {0.0, 0.0, 0.0});
+        stf::GenericFunction<3> generic(
+            [&](std::array<stf::Scalar, 3> p) { return sphere.value(p); },
+            [&](std::array<stf::Scalar, 3> p) { return sphere.gradient(p); });
+        const auto sparse = stf::sample_narrow_band<3>(generic, grid, 0.0, {16, 2});
+        REQUIRE(sparse.blocks.size() == 4 * 4 * 3);
+        REQUIRE(sparse.num_evaluations == grid.size());
+        std::vector<stf::Scalar> dense(grid.size());
+        stf::sample_grid<3>(generic, grid, dense);
+        check(sparse, dense, 0.0);
+    }
+
+    SECTION("invalid options")
+    {
+        REQUIRE_THROWS_AS(
+            stf::sample_narrow_band<3>(sweep, grid, 0.0, 0.1, {0, 1}),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            stf::sample_narrow_band<3>(sweep, grid, 0.0, -0.1),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("parallel_for", "[stf]")
+{
+    // Catch2 assertions are not thread-safe, so record and check afterwards.
+    std::vector<int> visits(1000, 0);
+    std::vector<size_t> threads(visits.size());
+    stf::parallel_for(visits.size(), 4, [&](size_t task, size_t thread) {
+        ++visits[task];
+        threads[task] = thread;
+    });
+    for (int v : visits) REQUIRE(v == 1);
+    for (size_t thread : threads) REQUIRE(thread < 4);
+
+    std::atomic<size_t> count{0};
+    REQUIRE_THROWS_AS(
+        stf::parallel_for(
+            100,
+            4,
+            [&](size_t task, size_t /*thread*/) {
+                ++count;
+                if (task == 10) throw std::runtime_error("task failed");
+            }),
+        std::runtime_error);
+    REQUIRE(count <= 100);
+}
@@ -3,7 +3,14 @@
 
 #include <stf/stf.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <sstream>
+#include <vector>
 
 template <int dim>
 void check_gradient(
@@ -20,6 +27,209 @@ void check_gradient(
         REQUIRE_THAT(grad[i], Catch::Matchers::WithinAbs(grad_fd[i], epsilon));
     }
     REQUIRE_THAT(dt, Catch::Matchers::WithinAbs(grad[dim], epsilon));
+
+    auto eval = fn.evaluate(pos, t);
+    REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(fn.value(pos, t), epsilon));
+    for (int i = 0; i < dim + 1; ++i) {
+        REQUIRE_THAT(eval.gradient[i], Catch::Matchers::WithinAbs(grad[i], epsilon));
+    }
+}
+
+template <int dim>
+void check_hessian(
+    const stf::SpaceTimeFunction<dim>& fn,
+    const std::array<stf::Scalar, dim>& pos,
+    const stf::Scalar t,
+    const stf::Scalar epsilon = 1e-5)
+{
+    auto H = fn.hessian(pos, t);
+    auto H_fd = fn.finite_difference_hessian(pos, t);
+    for (int i = 0; i <= dim; ++i) {
+        for (int j = 0; j <= dim; ++j) {
+            REQUIRE_THAT(H[i][j], Catch::Matchers::WithinAbs(H_fd[i][j], epsilon));
+        }
+    }
+
+    auto snapshot = fn.bind_time(t);
+    auto Hs = snapshot->hessian(pos);
+    for (int i = 0; i < dim; ++i) {
+        for (int j = 0; j < dim; ++j) {
+            REQUIRE_THAT(Hs[i][j], Catch::Matchers::WithinAbs(H[i][j], epsilon));
+        }
+    }
+}
+
+template <int dim>
+void check_value_bounds(
+    const stf::SpaceTimeFunction<dim>& fn,
+    const stf::IntervalBox<dim>& box,
+    stf::Interval<stf::Scalar> t,
+    int samples = 5)
+{
+    const auto bounds = fn.value_bounds(box, t);
+    REQUIRE(bounds.lower <= bounds.upper);
+
+    // Sample a regular grid of the space-time box, corners included.
+    int count = samples;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = box[i].lower + box[i].width() * (rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t.lower + t.width() * rest / (samples - 1);
+        const auto value = fn.value(pos, time);
+        REQUIRE(value >= bounds.lower - 1e-9);
+        REQUIRE(value <= bounds.upper + 1e-9);
+
+        // The snapshot at the sampled time bounds the same value.
+        const auto snapshot_bounds = fn.bind_time(time)->value_bounds(box);
+        REQUIRE(value >= snapshot_bounds.lower - 1e-9);
+        REQUIRE(value <= snapshot_bounds.upper + 1e-9);
+    }
+}
+
+template <int dim>
+void check_lipschitz_bound(
+    const stf::SpaceTimeFunction<dim>& fn,
+    const stf::IntervalBox<dim>& box,
+    stf::Interval<stf::Scalar> t,
+    int samples = 5)
+{
+    const auto bound = fn.lipschitz_bound(box, t);
+
+    int count = samples;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = box[i].lower + box[i].width() * (rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t.lower + t.width() * rest / (samples - 1);
+        const auto g = fn.gradient(pos, time);
+        stf::Scalar norm2 = 0;
+        for (int i = 0; i < dim; ++i) norm2 += g[i] * g[i];
+        REQUIRE(std::sqrt(norm2) <= bound.spatial + 1e-9);
+        REQUIRE(std::abs(g[dim]) <= bound.temporal + 1e-9);
+        REQUIRE(std::sqrt(norm2) <= fn.bind_time(time)->lipschitz_bound(box) + 1e-9);
+    }
+}
+
+template <int dim>
+void check_bounding_box(
+    const stf::SpaceTimeFunction<dim>& fn,
+    stf::Scalar t0,
+    stf::Scalar t1,
+    int samples = 17)
+{
+    const auto box = fn.bounding_box(t0, t1);
+
+    // Every sample of the swept interior within [-2, 2]^dim lies in the box.
+    int count = 5;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = -2 + 4 * stf::Scalar(rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t0 + (t1 - t0) * rest / 4;
+        if (fn.value(pos, time) > 0) continue;
+        for (int i = 0; i < dim; ++i) {
+            REQUIRE(box[i].contains(pos[i]));
+        }
+
+        // The snapshot at the sampled time bounds the same position.
+        const auto snapshot_box = fn.bind_time(time)->bounding_box();
+        for (int i = 0; i < dim; ++i) {
+            REQUIRE(snapshot_box[i].contains(pos[i]));
+        }
+    }
+}
+
+template <int dim>
+void check_batch(
+    const stf::SpaceTimeFunction<dim>& fn,
+    const std::vector<std::array<stf::Scalar, dim>>& points,
+    const std::vector<stf::Scalar>& times,
+    const stf::Scalar epsilon = 1e-8)
+{
+    const size_t n = points.size();
+    std::vector<stf::Scalar> coords(dim * n);
+    std::array<std::span<const stf::Scalar>, dim> pos;
+    for (int i = 0; i < dim; ++i) {
+        for (size_t k = 0; k < n; ++k) coords[i * n + k] = points[k][i];
+        pos[i] = {coords.data() + i * n, n};
+    }
+
+    std::vector<stf::Scalar> values(n), time_derivatives(n), grads((dim + 1) * n);
+    std::array<std::span<stf::Scalar>, dim + 1> grad_columns;
+    for (int i = 0; i <= dim; ++i) grad_columns[i] = {grads.data() + i * n, n};
+    fn.value_batch(pos, times, values);
+    fn.time_derivative_batch(pos, times, time_derivatives);
+    fn.gradient_batch(pos, times, grad_columns);
+
+    for (size_t k = 0; k < n; ++k) {
+        REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(fn.value(points[k], times[k]), epsilon));
+        REQUIRE_THAT(
+            time_derivatives[k],
+            Catch::Matchers::WithinAbs(fn.time_derivative(points[k], times[k]), epsilon));
+        auto grad = fn.gradient(points[k], times[k]);
+        for (int i = 0; i <= dim; ++i) {
+            REQUIRE_THAT(grad_columns[i][k], Catch::Matchers::WithinAbs(grad[i], epsilon));
+        }
+    }
+}
+
+template <int dim>
+void check_bind_time(
+    const stf::SpaceTimeFunction<dim>& fn,
+    const std::vector<std::array<stf::Scalar, dim>>& points,
+    const stf::Scalar t,
+    const stf::Scalar epsilon = 1e-8)
+{
+    const auto snapshot = fn.bind_time(t);
+
+    const size_t n = points.size();
+    std::vector<stf::Scalar> coords(dim * n);
+    std::array<std::span<const stf::Scalar>, dim> pos;
+    for (int i = 0; i < dim; ++i) {
+        for (size_t k = 0; k < n; ++k) coords[i * n + k] = points[k][i];
+        pos[i] = {coords.data() + i * n, n};
+    }
+
+    std::vector<stf::Scalar> values(n), grads(dim * n);
+    std::array<std::span<stf::Scalar>, dim> grad_columns;
+    for (int i = 0; i < dim; ++i) grad_columns[i] = {grads.data() + i * n, n};
+    snapshot->value_batch(pos, values);
+    snapshot->gradient_batch(pos, grad_columns);
+    std::vector<stf::Scalar> fused_values(n), fused_grads(dim * n);
+    std::array<std::span<stf::Scalar>, dim> fused_columns;
+    for (int i = 0; i < dim; ++i) fused_columns[i] = {fused_grads.data() + i * n, n};
+    snapshot->evaluate_batch(pos, fused_values, fused_columns);
+
+    for (size_t k = 0; k < n; ++k) {
+        const auto expected = fn.evaluate(points[k], t);
+        const auto eval = snapshot->evaluate(points[k]);
+        const auto grad = snapshot->gradient(points[k]);
+        const auto value = snapshot->value(points[k]);
+        REQUIRE_THAT(value, Catch::Matchers::WithinAbs(expected.value, epsilon));
+        REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, epsilon));
+        REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(expected.value, epsilon));
+        REQUIRE_THAT(fused_values[k], Catch::Matchers::WithinAbs(expected.value, epsilon));
+        for (int i = 0; i < dim; ++i) {
+            const auto expected_i = Catch::Matchers::WithinAbs(expected.gradient[i], epsilon);
+            REQUIRE_THAT(grad[i], expected_i);
+            REQUIRE_THAT(eval.gradient[i], expected_i);
+            REQUIRE_THAT(grad_columns[i][k], expected_i);
+            REQUIRE_THAT(fused_columns[i][k], expected_i);
+        }
+    }
 }
 
 TEST_CASE("interpolate_function", "[stf]")
@@ -103,6 +313,131 @@ TEST_CASE("union_function", "[stf]")
     }
 }
 
+TEST_CASE("nary_union_function", "[stf]")
+{
+    SECTION("two operands match the binary union")
+    {
+        stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+        stf::ImplicitCapsule<3> capsule(0.1, {-0.4, 0.0, 0.0}, {0.4, 0.2, 0.0});
+        stf::Translation<3> translation({0.5, -0.2, 0.1});
+        stf::SweepFunction<3> sweep_ball(ball, translation);
+        stf::SweepFunction<3> sweep_capsule(capsule, translation);
+
+        for (stf::Scalar d : {0.0, 0.2}) {
+            stf::UnionFunction<3> binary(sweep_ball, sweep_capsule, d);
+            stf::NaryUnionFunction<3> nary({&sweep_ball, &sweep_capsule}, d);
+            for (std::array<stf::Scalar, 3> p :
+                 {std::array<stf::Scalar, 3>{0.2, 0.3, 0.1}, {-0.3, 0.1, 0.2}, {2.0, 0.0, 0.0}}) {
+                for (stf::Scalar t : {-0.5, 0.2, 0.7}) {
+                    const auto expected = binary.evaluate(p, t);
+                    const auto eval = nary.evaluate(p, t);
+                    REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, 1e-12));
+                    for (int i = 0; i < 4; ++i) {
+                        REQUIRE_THAT(
+                            eval.gradient[i],
+                            Catch::Matchers::WithinAbs(expected.gradient[i], 1e-12));
+                    }
+                    const auto H = nary.hessian(p, t);
+                    const auto expected_H = binary.hessian(p, t);
+                    for (int i = 0; i < 4; ++i) {
+                        for (int j = 0; j < 4; ++j) {
+                            REQUIRE_THAT(
+                                H[i][j],
+                                Catch::Matchers::WithinAbs(expected_H[i][j], 1e-12));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("culling is exact")
+    {
+        // A grid of small moving balls: most are culled away from their neighbourhood.
+        stf::ImplicitBall<3> ball(0.05, {0.0, 0.0, 0.0});
+        std::vector<std::unique_ptr<stf::Translation<3>>> translations;
+        std::vector<std::unique_ptr<stf::SweepFunction<3>>> sweeps;
+        std::vector<stf::SpaceTimeFunction<3>*> operands;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                for (int k = 0; k < 2; ++k) {
+                    translations.push_back(std::make_unique<stf::Translation<3>>(
+                        std::array<stf::Scalar, 3>{0.3 * i - 0.5, 0.3 * j - 0.4, 0.2 * k}));
+                    sweeps.push_back(
+                        std::make_unique<stf::SweepFunction<3>>(ball, *translations.back()));
+                    operands.push_back(sweeps.back().get());
+                }
+            }
+        }
+
+        for (stf::Scalar d : {0.0, 0.02}) {
+            stf::NaryUnionFunction<3> nary(operands, d);
+            REQUIRE(nary.size() == operands.size());
+            REQUIRE(nary.cull_level() > 4 * d);
+
+            for (int index = 0; index < 7 * 7 * 3; ++index) {
+                const std::array<stf::Scalar, 3> p{
+                    -1.0 + 0.33 * (index % 7),
+                    -1.0 + 0.31 * (index / 7 % 7),
+                    -0.1 + 0.15 * (index / 49)};
+                for (stf::Scalar t : {-0.1, 0.0, 0.35, 0.5, 1.0}) {
+                    std::vector<stf::Scalar> values;
+                    for (const auto* f : operands) values.push_back(f->value(p, t));
+                    std::sort(values.begin(), values.end());
+                    const auto expected = stf::NaryUnionFunction<3>::fold_value(values, d);
+                    REQUIRE_THAT(nary.value(p, t), Catch::Matchers::WithinAbs(expected, 1e-12));
+                    if (d == 0) {
+                        REQUIRE(nary.value(p, t) == values.front());
+                    }
+                }
+            }
+            check_bind_time<3>(nary, {{0.1, 0.2, 0.0}, {-0.2, 0.5, 0.2}, {1.5, 0.0, 0.0}}, 0.4);
+        }
+    }
+
+    SECTION("smooth union")
+    {
+        stf::ImplicitBall<3> ball(0.2, {0.05, 0.02, 0.0});
+        stf::Translation<3> translate_x({0.4, 0.1, 0.0});
+        stf::Translation<3> translate_y({-0.1, 0.4, 0.0});
+        stf::Rotation<3> rotation({0.1, 0.0, 0.0}, {0, 0, 1}, 90);
+        stf::SweepFunction<3> sweep_x(ball, translate_x);
+        stf::SweepFunction<3> sweep_y(ball, translate_y);
+        stf::SweepFunction<3> sweep_r(ball, rotation);
+        stf::NaryUnionFunction<3> nary({&sweep_x, &sweep_y, &sweep_r}, 0.1);
+
+        // Reordering the operands does not change the union.
+        stf::NaryUnionFunction<3> reversed({&sweep_r, &sweep_y, &sweep_x}, 0.1);
+        for (std::array<stf::Scalar, 3> p :
+             {std::array<stf::Scalar, 3>{0.1, 0.1, 0.0}, {0.2, -0.1, 0.1}, {0.0, 0.3, 0.05}}) {
+            // At t = 0 the operands coincide, which is a kink of the sorted fold.
+            for (stf::Scalar t : {0.2, 0.45, 0.7}) {
+                check_gradient<3>(nary, p, t);
+                check_hessian<3>(nary, p, t);
+                REQUIRE_THAT(
+                    nary.value(p, t),
+                    Catch::Matchers::WithinAbs(reversed.value(p, t), 1e-12));
+            }
+        }
+
+        const stf::IntervalBox<3> box{{{-0.2, 0.2}, {-0.1, 0.3}, {-0.1, 0.1}}};
+        check_value_bounds<3>(nary, box, {0.2, 0.6});
+        check_lipschitz_bound<3>(nary, box, {0.2, 0.6});
+        check_bounding_box<3>(nary, 0.0, 1.0);
+        check_bounding_box<3>(nary, 0.3, 0.3);
+    }
+
+    SECTION("invalid arguments")
+    {
+        stf::ImplicitBall<2> ball(0.1, {0.0, 0.0});
+        stf::Translation<2> translation({1.0, 0.0});
+        stf::SweepFunction<2> sweep(ball, translation);
+        REQUIRE_THROWS_AS(stf::NaryUnionFunction<2>({}), std::invalid_argument);
+        REQUIRE_THROWS_AS(stf::NaryUnionFunction<2>({&sweep, nullptr}), std::invalid_argument);
+        REQUIRE_THROWS_AS(stf::NaryUnionFunction<2>({&sweep}, -0.1), std::invalid_argument);
+    }
+}
+
 TEST_CASE("offset_function", "[stf]")
 {
     SECTION("ball translation")
@@ -113,7 +448,7 @@ TEST_CASE("offset_function", "[stf]")
         stf::OffsetFunction<3> offset(
             sweep,
             [](stf::Scalar t) { return t; },
-            [](stf::Scalar t) { return 1.0; });
+            [](stf::Scalar /*t*/) { return 1.0; });
 
         REQUIRE_THAT(
             offset.value({0.0, 0.0, 0.0}, 0),
@@ -129,3 +464,717 @@ TEST_CASE("offset_function", "[stf]")
         check_gradient(offset, {0.0, 0.5, 0.0}, 1.0);
     }
 }
+
+TEST_CASE("batch_evaluation", "[stf]")
+{
+    // A mix of repeated and varying times exercises the per-time caches.
+    std::vector<std::array<stf::Scalar, 3>> points;
+    std::vector<stf::Scalar> times;
+    for (size_t i = 0; i < 40; ++i) {
+        points.push_back({0.05 * i - 1, std::sin(0.3 * i), 0.02 * i});
+        times.push_back(i < 20 ? 0.25 : 0.03 * (i - 20));
+    }
+
+    stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.5, 0.0, 0.0}, {0.5, 0.2, 0.0});
+    stf::ImplicitTorus torus(0.5, 0.1, {0, 0, 0}, {0, 1, 1});
+    stf::Translation<3> translate({0.5, 0.2, -0.1});
+    stf::Rotation<3> rotate({0.1, 0.0, 0.0}, {1, 1, 0}, 90);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Compose<3> translate_rotate(translate, rotate);
+    stf::Compose<3> scale_rotate(scale, rotate);
+
+    SECTION("sweep")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale_rotate);
+        stf::SweepFunction<3> sweep_torus(torus, translate);
+        check_batch<3>(sweep_ball, points, times);
+        check_batch<3>(sweep_capsule, points, times);
+        check_batch<3>(sweep_torus, points, times);
+    }
+
+    SECTION("vipss")
+    {
+        stf::Duchon vipss(
+            {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+            {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}},
+            {17, 18, 19, 20},
+            {0.1, 0.2, 0.3},
+            0.5,
+            true);
+        stf::SweepFunction<3> sweep(vipss, rotate);
+        check_batch<3>(sweep, points, times, 1e-6);
+    }
+
+    SECTION("composites")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale_rotate);
+        stf::UnionFunction<3> hard_union(sweep_ball, sweep_capsule);
+        stf::UnionFunction<3> smooth_union(sweep_ball, sweep_capsule, 0.1);
+        stf::OffsetFunction<3> offset(
+            smooth_union,
+            [](stf::Scalar t) { return 0.1 * t * t; },
+            [](stf::Scalar t) { return 0.2 * t; });
+        stf::InterpolateFunction<3> interpolate(
+            sweep_ball,
+            offset,
+            [](stf::Scalar t) { return t * t; },
+            [](stf::Scalar t) { return 2 * t; });
+        stf::ExplicitForm<3> explicit_form(
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) { return p[0] * p[1] - t * p[2]; },
+            nullptr,
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) {
+                return std::array<stf::Scalar, 4>{p[1], p[0], -t, -p[2]};
+            });
+        check_batch<3>(hard_union, points, times);
+        check_batch<3>(smooth_union, points, times);
+        check_batch<3>(offset, points, times);
+        check_batch<3>(interpolate, points, times);
+        check_batch<3>(explicit_form, points, times);
+    }
+}
+
+TEST_CASE("bind_time", "[stf]")
+{
+    std::vector<std::array<stf::Scalar, 3>> points;
+    for (size_t i = 0; i < 40; ++i) {
+        points.push_back({0.05 * i - 1, std::sin(0.3 * i), 0.02 * i});
+    }
+
+    stf::ImplicitBall<3> ball(0.3, {0.0, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.5, 0.0, 0.0}, {0.5, 0.2, 0.0});
+    stf::Translation<3> translate({0.5, 0.2, -0.1});
+    stf::Rotation<3> rotate({0.1, 0.0, 0.0}, {1, 1, 0}, 90);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Polyline<3> polyline({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}});
+    stf::PolyBezier<3> polybezier(
+        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {-1, 1, 0}, {-1, 0, 0}, {0, 0, 0}});
+    stf::Compose<3> translate_rotate(translate, rotate);
+    stf::Compose<3> scale_polybezier(scale, polybezier);
+
+    SECTION("sweep")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale_polybezier);
+        stf::SweepFunction<3> sweep_polyline(capsule, polyline);
+        REQUIRE(translate_rotate.is_affine());
+        REQUIRE(dynamic_cast<stf::SweepSnapshot<3>*>(sweep_ball.bind_time(0.3).get()));
+        for (stf::Scalar t : {0.0, 0.3, 0.7, 1.0}) {
+            check_bind_time<3>(sweep_ball, points, t);
+            check_bind_time<3>(sweep_capsule, points, t);
+            check_bind_time<3>(sweep_polyline, points, t);
+        }
+    }
+
+    SECTION("composites")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::UnionFunction<3> smooth_union(sweep_ball, sweep_capsule, 0.1);
+        stf::OffsetFunction<3> offset(
+            smooth_union,
+            [](stf::Scalar t) { return 0.1 * t * t; },
+            [](stf::Scalar t) { return 0.2 * t; });
+        stf::InterpolateFunction<3> interpolate(
+            sweep_ball,
+            offset,
+            [](stf::Scalar t) { return t * t; },
+            [](stf::Scalar t) { return 2 * t; });
+        stf::ExplicitForm<3> explicit_form(
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) { return p[0] * p[1] - t * p[2]; },
+            nullptr,
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) {
+                return std::array<stf::Scalar, 4>{p[1], p[0], -t, -p[2]};
+            });
+        for (stf::Scalar t : {0.0, 0.4, 1.0}) {
+            check_bind_time<3>(smooth_union, points, t);
+            check_bind_time<3>(offset, points, t);
+            check_bind_time<3>(interpolate, points, t);
+            check_bind_time<3>(explicit_form, points, t);
+        }
+    }
+}
+
+namespace {
+
+template <typename Scalar>
+struct FloatScene
+{
+    stf::ImplicitBall<3, Scalar> ball{0.3, {0.0, 0.1, 0.0}};
+    stf::ImplicitCapsule<3, Scalar> capsule{0.1, {-0.5, 0.0, 0.0}, {0.5, 0.2, 0.0}};
+    stf::BasicImplicitTorus<Scalar> torus{0.4, 0.1, {0, 0, 0}, {0, 1, 1}};
+    stf::BasicDuchon<Scalar> vipss{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+        {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}},
+        {17, 18, 19, 20}};
+    stf::ImplicitUnion<3, stf::BlendingFunction::Cubic, Scalar> blend{ball, capsule, 0.1};
+    stf::Translation<3, Scalar> translate{{0.5, 0.2, -0.1}};
+    stf::Rotation<3, Scalar> rotate{{0.1, 0.0, 0.0}, {1, 1, 0}, 90};
+    stf::Scale<3, Scalar> scale{{2.0, 0.5, 1.0}, {0.1, 0.1, 0.1}};
+    stf::Polyline<3, Scalar> polyline{{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}}};
+    stf::PolyBezier<3, Scalar> polybezier{
+        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {-1, 1, 0}, {-1, 0, 0}, {0, 0, 0}}};
+    stf::PolyBezier<3, Scalar> sampled_polybezier = stf::PolyBezier<3, Scalar>::from_samples(
+        {{0, 0, 0}, {0.5, 0.2, 0}, {0.8, 0.6, 0.1}, {0.6, 1, 0.2}});
+    stf::Compose<3, Scalar> translate_rotate{translate, rotate};
+    stf::Compose<3, Scalar> scale_polybezier{scale, polybezier};
+    stf::Compose<3, Scalar> rotate_sampled{translate_rotate, sampled_polybezier};
+    stf::SweepFunction<3, Scalar> sweep_blend{blend, rotate_sampled};
+    stf::SweepFunction<3, Scalar> sweep_torus{torus, scale_polybezier};
+    stf::SweepFunction<3, Scalar> sweep_vipss{vipss, polyline};
+    stf::UnionFunction<3, Scalar> smooth_union{sweep_blend, sweep_torus, 0.1};
+    stf::OffsetFunction<3, Scalar> offset{
+        smooth_union,
+        [](Scalar t) { return Scalar(0.1) * t; },
+        [](Scalar) { return Scalar(0.1); }};
+    stf::InterpolateFunction<3, Scalar> interpolate{offset, sweep_vipss};
+};
+
+} // namespace
+
+TEST_CASE("float_evaluation", "[stf]")
+{
+    FloatScene<double> reference;
+    FloatScene<float> scene;
+
+    for (size_t i = 0; i < 40; ++i) {
+        const std::array<double, 3> p{0.05 * i - 1, std::sin(0.3 * i), 0.02 * i};
+        const std::array<float, 3> q{float(p[0]), float(p[1]), float(p[2])};
+        const double t = (i % 5) / 4.0;
+
+        const auto expected = reference.interpolate.evaluate(p, t);
+        const auto eval = scene.interpolate.evaluate(q, float(t));
+        const double tolerance = 1e-3 * (1 + std::abs(expected.value));
+        REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, tolerance));
+        for (int k = 0; k < 4; ++k) {
+            const double scale = 1 + std::abs(expected.gradient[k]);
+            REQUIRE_THAT(
+                eval.gradient[k],
+                Catch::Matchers::WithinAbs(expected.gradient[k], 1e-2 * scale));
+        }
+
+        const auto frozen = scene.interpolate.bind_time(float(t));
+        REQUIRE_THAT(frozen->value(q), Catch::Matchers::WithinAbs(expected.value, tolerance));
+    }
+}
+
+TEST_CASE("mixed_precision", "[stf]")
+{
+    FloatScene<double> reference;
+    FloatScene<float> scene;
+    const stf::Scalar band = 0.05;
+    stf::MixedPrecisionFunction<3> fn(scene.interpolate, reference.interpolate, band);
+
+    const size_t n = 400;
+    std::vector<stf::Scalar> x(n), y(n), z(n), t(n), values(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = 0.005 * k - 1;
+        y[k] = 0.3 * std::sin(0.1 * k);
+        z[k] = 0.1 * std::cos(0.07 * k);
+        t[k] = (k % 5) / 4.0;
+    }
+    std::array<std::span<const stf::Scalar>, 3> pos{x, y, z};
+    fn.value_batch(pos, t, values);
+
+    size_t refined = 0;
+    for (size_t k = 0; k < n; ++k) {
+        const std::array<stf::Scalar, 3> p{x[k], y[k], z[k]};
+        const stf::Scalar expected = reference.interpolate.value(p, t[k]);
+        REQUIRE(values[k] == fn.value(p, t[k]));
+        if (std::abs(values[k]) < band) {
+            // Inside the band the double graph is used, so the result is exact.
+            REQUIRE(values[k] == expected);
+            ++refined;
+        } else {
+            const stf::Scalar tolerance = 1e-3 * (1 + std::abs(expected));
+            REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(expected, tolerance));
+        }
+    }
+    REQUIRE(refined > 0);
+    REQUIRE(refined < n);
+}
+
+TEST_CASE("explicit_form_autodiff", "[stf]")
+{
+    auto fn = stf::ExplicitForm<3>::from_generic([](auto p, auto t) {
+        using std::exp;
+        using std::sin;
+        return p[0] * p[1] - sin(t * p[2]) + exp(0.5 * p[0]) / (1 + t * t);
+    });
+    stf::ExplicitForm<3> reference(
+        [](std::array<stf::Scalar, 3> p, stf::Scalar t) {
+            return p[0] * p[1] - std::sin(t * p[2]) + std::exp(0.5 * p[0]) / (1 + t * t);
+        },
+        nullptr,
+        [](std::array<stf::Scalar, 3> p, stf::Scalar t) {
+            const stf::Scalar e = std::exp(0.5 * p[0]);
+            const stf::Scalar c = std::cos(t * p[2]);
+            return std::array<stf::Scalar, 4>{
+                p[1] + 0.5 * e / (1 + t * t),
+                p[0],
+                -t * c,
+                -p[2] * c - 2 * t * e / ((1 + t * t) * (1 + t * t))};
+        });
+
+    for (size_t i = 0; i < 10; ++i) {
+        const std::array<stf::Scalar, 3> p{0.1 * i - 0.5, std::sin(0.7 * i), 0.3 * i};
+        const stf::Scalar t = 0.1 * i;
+        const auto expected = reference.evaluate(p, t);
+        const auto eval = fn.evaluate(p, t);
+        const auto grad = fn.gradient(p, t);
+        REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, 1e-12));
+        REQUIRE_THAT(fn.value(p, t), Catch::Matchers::WithinAbs(expected.value, 1e-12));
+        REQUIRE_THAT(
+            fn.time_derivative(p, t),
+            Catch::Matchers::WithinAbs(expected.gradient[3], 1e-12));
+        for (int k = 0; k < 4; ++k) {
+            REQUIRE_THAT(eval.gradient[k], Catch::Matchers::WithinAbs(expected.gradient[k], 1e-12));
+            REQUIRE_THAT(grad[k], Catch::Matchers::WithinAbs(expected.gradient[k], 1e-12));
+        }
+    }
+}
+
+TEST_CASE("hessian", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.4, 0.0, 0.0}, {0.4, 0.2, 0.0});
+    stf::Rotation<3> rotation({0.0, 0.1, 0.0}, {1, 1, 0}, 120);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Translation<3> translation({0.5, -0.2, 0.1});
+    stf::Compose<3> rotate_scale(rotation, scale);
+
+    stf::SweepFunction<3> sweep_ball(ball, rotate_scale);
+    stf::SweepFunction<3> sweep_capsule(capsule, translation);
+    stf::UnionFunction<3> union_fn(sweep_ball, sweep_capsule, 0.2);
+    stf::OffsetFunction<3> offset(
+        sweep_ball,
+        [](stf::Scalar t) { return 0.1 * t * t; },
+        [](stf::Scalar t) { return 0.2 * t; });
+    stf::InterpolateFunction<3> interpolate(
+        sweep_ball,
+        sweep_capsule,
+        [](stf::Scalar t) { return t * t; },
+        [](stf::Scalar t) { return 2 * t; });
+
+    const std::vector<std::array<stf::Scalar, 3>> points{
+        {0.2, 0.3, 0.1},
+        {-0.3, 0.1, 0.2},
+        {0.05, -0.25, 0.15}};
+    for (const auto& p : points) {
+        for (stf::Scalar t : {0.2, 0.5, 0.7}) {
+            check_hessian<3>(sweep_ball, p, t);
+            check_hessian<3>(sweep_capsule, p, t);
+            check_hessian<3>(union_fn, p, t);
+            check_hessian<3>(offset, p, t);
+            check_hessian<3>(interpolate, p, t);
+        }
+    }
+
+    SECTION("blending zone")
+    {
+        // Both operands are close to each other, so the curvature of the blend contributes.
+        const std::array<stf::Scalar, 3> p{0.05, 0.25, 0.05};
+        const stf::Scalar t = 0.5;
+        const auto a = sweep_ball.value(p, t);
+        const auto b = sweep_capsule.value(p, t);
+        REQUIRE(std::abs(a - b) < 0.8);
+        check_hessian<3>(union_fn, p, t);
+    }
+}
+
+
+TEST_CASE("value_bounds", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.4, 0.0, 0.0}, {0.4, 0.2, 0.0});
+    stf::Rotation<3> rotation({0.0, 0.1, 0.0}, {1, 1, 0}, 120);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Translation<3> translation({0.5, -0.2, 0.1});
+    stf::Compose<3> rotate_scale(rotation, scale);
+
+    stf::SweepFunction<3> sweep_ball(ball, rotate_scale);
+    stf::SweepFunction<3> sweep_capsule(capsule, translation);
+    stf::UnionFunction<3> union_fn(sweep_ball, sweep_capsule, 0.2);
+    stf::OffsetFunction<3> offset(
+        sweep_ball,
+        [](stf::Scalar t) { return 0.1 * std::sin(3 * t); },
+        [](stf::Scalar t) { return 0.3 * std::cos(3 * t); },
+        [](stf::Interval<stf::Scalar> t) { return 0.1 * stf::sin(3 * t); },
+        [](stf::Interval<stf::Scalar> t) { return 0.3 * stf::cos(3 * t); });
+    stf::InterpolateFunction<3> interpolate(
+        sweep_ball,
+        sweep_capsule,
+        [](stf::Scalar t) { return t * t; },
+        [](stf::Scalar t) { return 2 * t; },
+        [](stf::Interval<stf::Scalar> t) { return stf::sqr(t); },
+        [](stf::Interval<stf::Scalar> t) { return 2 * t; });
+    auto static_union = stf::make_function(stf::make_union(
+        stf::make_sweep(ball, stf::compose(rotation, scale)),
+        stf::make_sweep(capsule, translation),
+        0.2));
+
+    const std::vector<stf::IntervalBox<3>> boxes{
+        {{{0.0, 0.2}, {-0.1, 0.1}, {-0.1, 0.1}}},
+        {{{-0.5, 0.5}, {-0.5, 0.5}, {-0.5, 0.5}}},
+        {{{0.3, 0.6}, {0.2, 0.4}, {-0.2, 0.1}}}};
+    const std::vector<stf::Interval<stf::Scalar>> times{{0, 1}, {0.2, 0.3}, {0.5, 0.5}};
+    for (const auto& box : boxes) {
+        for (const auto& t : times) {
+            check_value_bounds<3>(sweep_ball, box, t);
+            check_value_bounds<3>(sweep_capsule, box, t);
+            check_value_bounds<3>(union_fn, box, t);
+            check_value_bounds<3>(offset, box, t);
+            check_value_bounds<3>(interpolate, box, t);
+            check_value_bounds<3>(static_union, box, t);
+
+            check_lipschitz_bound<3>(sweep_ball, box, t);
+            check_lipschitz_bound<3>(sweep_capsule, box, t);
+            check_lipschitz_bound<3>(union_fn, box, t);
+            check_lipschitz_bound<3>(offset, box, t);
+            check_lipschitz_bound<3>(interpolate, box, t);
+            check_lipschitz_bound<3>(static_union, box, t);
+        }
+    }
+
+    SECTION("culling")
+    {
+        // A box far from the swept shapes cannot contain the zero set.
+        const stf::IntervalBox<3> far{{{3.0, 3.5}, {3.0, 3.5}, {3.0, 3.5}}};
+        REQUIRE(union_fn.value_bounds(far, {0, 1}).lower > 0);
+        REQUIRE(static_union.value_bounds(far, {0, 1}).lower > 0);
+        REQUIRE(offset.value_bounds(far, {0, 1}).lower > 0);
+
+        // A box inside the ball for the whole time interval is strictly inside.
+        const stf::IntervalBox<3> inside{{{0.05, 0.15}, {-0.05, 0.05}, {-0.05, 0.05}}};
+        REQUIRE(sweep_ball.value_bounds(inside, {0, 0.05}).upper < 0);
+    }
+
+    SECTION("oscillating offset")
+    {
+        // Eight samples of cos(32 pi t) over [0, 1] all equal 1, yet it reaches -1 at t = 1/32.
+        constexpr stf::Scalar frequency = 32 * std::numbers::pi;
+        auto wave = [](stf::Scalar t) { return std::cos(frequency * t); };
+        auto wave_derivative = [](stf::Scalar t) { return -frequency * std::sin(frequency * t); };
+        stf::OffsetFunction<3> opaque(sweep_ball, wave, wave_derivative);
+        stf::OffsetFunction<3> bounded(
+            sweep_ball,
+            wave,
+            wave_derivative,
+            [](stf::Interval<stf::Scalar> t) { return stf::cos(frequency * t); },
+            [](stf::Interval<stf::Scalar> t) { return -frequency * stf::sin(frequency * t); });
+
+        const std::array<stf::Scalar, 3> p{0.1, 0.0, 0.0};
+        const stf::Scalar trough = opaque.value(p, 1.0 / 32);
+        for (const auto* fn : {&opaque, &bounded}) {
+            REQUIRE(fn->value_bounds(boxes[0], {0, 1}).contains(trough));
+            REQUIRE(fn->lipschitz_bound(boxes[0], {0, 1}).temporal >= frequency);
+            REQUIRE(fn->bounding_box(0, 1)[0].contains(0.1));
+        }
+        REQUIRE(!opaque.value_bounds(boxes[0], {0, 1}).is_finite());
+        REQUIRE(bounded.value_bounds(boxes[0], {0, 1}).is_finite());
+        check_value_bounds<3>(bounded, boxes[1], {0, 1}, 33);
+        check_lipschitz_bound<3>(bounded, boxes[0], {0, 1});
+    }
+
+    SECTION("lipschitz")
+    {
+        // The capsule is a distance field moved rigidly, so only its speed is non-trivial.
+        const auto L = sweep_capsule.lipschitz_bound(boxes[1], {0, 1});
+        REQUIRE_THAT(L.spatial, Catch::Matchers::WithinAbs(1, 1e-12));
+        REQUIRE_THAT(L.temporal, Catch::Matchers::WithinAbs(std::sqrt(0.3), 1e-12));
+        REQUIRE(static_union.lipschitz_bound(boxes[0], {0, 1}).spatial ==
+                union_fn.lipschitz_bound(boxes[0], {0, 1}).spatial);
+    }
+
+    SECTION("unbounded default")
+    {
+        stf::ExplicitForm<3> explicit_form(
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) { return p[0] - t; });
+        const auto bounds = explicit_form.value_bounds(boxes[0], {0, 1});
+        REQUIRE(!bounds.is_finite());
+        REQUIRE(bounds.contains(0));
+        REQUIRE(std::isinf(explicit_form.lipschitz_bound(boxes[0], {0, 1}).spatial));
+    }
+}
+
+TEST_CASE("bounding_box", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.1, 0.0, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.4, 0.0, 0.0}, {0.4, 0.2, 0.0});
+    stf::Rotation<3> rotation({0.0, 0.1, 0.0}, {1, 1, 0}, 120);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Translation<3> translation({0.5, -0.2, 0.1});
+    stf::Compose<3> rotate_scale(rotation, scale);
+    stf::Polyline<3> polyline({{0, 0, 0}, {0.5, 0, 0}, {0.5, 0.5, 0}}, false);
+
+    stf::SweepFunction<3> sweep_ball(ball, rotate_scale);
+    stf::SweepFunction<3> sweep_capsule(capsule, translation);
+    stf::SweepFunction<3> polyline_ball(ball, polyline);
+    stf::UnionFunction<3> union_fn(sweep_ball, sweep_capsule, 0.2);
+    stf::OffsetFunction<3> offset(
+        sweep_ball,
+        [](stf::Scalar t) { return -0.1 * std::sin(3 * t); },
+        [](stf::Scalar t) { return -0.3 * std::cos(3 * t); },
+        [](stf::Interval<stf::Scalar> t) { return -0.1 * stf::sin(3 * t); },
+        [](stf::Interval<stf::Scalar> t) { return -0.3 * stf::cos(3 * t); });
+    stf::InterpolateFunction<3> interpolate(sweep_ball, sweep_capsule);
+    auto static_union = stf::make_function(stf::make_union(
+        stf::make_sweep(ball, stf::compose(rotation, scale)),
+        stf::make_sweep(capsule, translation),
+        0.2));
+
+    for (auto [t0, t1] : {std::pair{0.0, 1.0}, {0.2, 0.4}, {0.5, 0.5}}) {
+        check_bounding_box<3>(sweep_ball, t0, t1);
+        check_bounding_box<3>(sweep_capsule, t0, t1);
+        check_bounding_box<3>(polyline_ball, t0, t1);
+        check_bounding_box<3>(union_fn, t0, t1);
+        check_bounding_box<3>(offset, t0, t1);
+        check_bounding_box<3>(interpolate, t0, t1);
+        check_bounding_box<3>(static_union, t0, t1);
+    }
+
+    SECTION("tight for translations")
+    {
+        // The ball moves from x = 0.1 to x = 0.6 along the first polyline segment.
+        const auto box = polyline_ball.bounding_box(0, 0.5);
+        REQUIRE_THAT(box[0].lower, Catch::Matchers::WithinAbs(-0.2, 1e-12));
+        REQUIRE_THAT(box[0].upper, Catch::Matchers::WithinAbs(0.9, 1e-12));
+        REQUIRE_THAT(box[1].upper, Catch::Matchers::WithinAbs(0.3, 1e-12));
+    }
+
+    SECTION("unbounded default")
+    {
+        stf::ExplicitForm<3> explicit_form(
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) { return p[0] - t; });
+        const auto box = explicit_form.bounding_box(0, 1);
+        REQUIRE(!box[0].is_finite());
+    }
+}
+
+TEST_CASE("swept_envelope", "[stf]")
+{
+    // A ball translated along a segment sweeps a capsule.
+    stf::ImplicitBall<3> ball(0.2, {0.4, 0.0, 0.1});
+    stf::Translation<3> translation({0.8, 0.0, 0.0});
+    stf::SweepFunction<3> sweep(ball, translation);
+    stf::ImplicitCapsule<3> capsule(0.2, {0.4, 0.0, 0.1}, {-0.4, 0.0, 0.1});
+    const auto grid = stf::GridSpec<3>::from_box({{{-1, 1}, {-0.5, 0.5}, {-0.5, 0.5}}}, {21, 9, 7});
+
+    SECTION("minimum over time")
+    {
+        for (const auto& p : std::vector<std::array<stf::Scalar, 3>>{
+                 {0.0, 0.0, 0.0},
+                 {0.7, 0.3, 0.1},
+                 {-0.9, -0.2, 0.4},
+                 {0.1, 0.5, -0.3}}) {
+            const auto result = stf::minimize_over_time<3>(sweep, p, 0, 1, NAN);
+            REQUIRE_THAT(result.value, Catch::Matchers::WithinAbs(capsule.value(p), 1e-9));
+            REQUIRE_THAT(
+                sweep.value(p, result.time),
+                Catch::Matchers::WithinAbs(result.value, 1e-12));
+        }
+    }
+
+    SECTION("grid")
+    {
+        const auto envelope = stf::sample_swept_envelope<3>(sweep, grid, 0, 1, {.num_threads = 3});
+        for (size_t k = 0; k < grid.size(); ++k) {
+            const auto p = grid.position(grid.node(k));
+            REQUIRE_THAT(envelope.values[k], Catch::Matchers::WithinAbs(capsule.value(p), 1e-9));
+            REQUIRE(envelope.times[k] >= 0);
+            REQUIRE(envelope.times[k] <= 1);
+        }
+
+        // Neighboring nodes warm-start each other; isolated nodes do not.
+        const auto cold = stf::sample_swept_envelope<3>(sweep, grid, 0, 1, {.tile_size = 1});
+        REQUIRE(cold.values == envelope.values);
+        REQUIRE(envelope.num_evaluations < cold.num_evaluations);
+
+        std::ostringstream out;
+        envelope.write(out);
+        REQUIRE(out.str().size() == grid.size() * sizeof(stf::Scalar));
+    }
+
+    SECTION("non-monotonic motion")
+    {
+        stf::ImplicitBall<3> small(0.1, {0.3, 0.0, 0.0});
+        stf::Rotation<3> rotation({0.0, 0.0, 0.0}, {0, 0, 1}, 540);
+        stf::SweepFunction<3> spin(small, rotation);
+        const auto envelope = stf::sample_swept_envelope<3>(spin, grid, 0, 1);
+        for (size_t k = 0; k < grid.size(); ++k) {
+            const auto p = grid.position(grid.node(k));
+            stf::Scalar dense = std::numeric_limits<stf::Scalar>::infinity();
+            for (int j = 0; j <= 2000; ++j) dense = std::min(dense, spin.value(p, j / 2000.0));
+            REQUIRE(envelope.values[k] <= dense + 1e-9);
+            REQUIRE(envelope.values[k] >= dense - 1e-5);
+        }
+    }
+
+    SECTION("cutoff")
+    {
+        const auto exact = stf::sample_swept_envelope<3>(sweep, grid, 0, 1);
+        const auto banded = stf::sample_swept_envelope<3>(sweep, grid, 0, 1, {.cutoff = 0.1});
+        REQUIRE(banded.num_evaluations < exact.num_evaluations / 2);
+        for (size_t k = 0; k < grid.size(); ++k) {
+            if (std::abs(exact.values[k]) <= 0.1) {
+                REQUIRE_THAT(banded.values[k], Catch::Matchers::WithinAbs(exact.values[k], 1e-9));
+            } else if (exact.values[k] > 0.1) {
+                REQUIRE(banded.values[k] > 0.1);
+                REQUIRE(banded.values[k] <= exact.values[k]);
+            } else {
+                REQUIRE(banded.values[k] < -0.1);
+            }
+        }
+    }
+
+    SECTION("implicit function")
+    {
+        stf::SweptEnvelopeFunction<3> swept(sweep, 0, 1);
+        const std::array<stf::Scalar, 3> p{0.1, 0.25, -0.05};
+        REQUIRE_THAT(swept.value(p), Catch::Matchers::WithinAbs(capsule.value(p), 1e-9));
+        const auto g = swept.gradient(p);
+        const auto expected = capsule.gradient(p);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE_THAT(g[i], Catch::Matchers::WithinAbs(expected[i], 1e-6));
+        }
+
+        const auto bounds = swept.value_bounds({{{0.9, 1.0}, {0.9, 1.0}, {0.9, 1.0}}});
+        REQUIRE(bounds.lower > 0);
+
+        const auto mesh = stf::marching_cubes<stf::Scalar>(swept, grid);
+        REQUIRE(!mesh.triangles.empty());
+        for (const auto& v : mesh.vertices) REQUIRE(std::abs(capsule.value(v)) < 0.02);
+    }
+}
+
+TEST_CASE("first_contact_time", "[stf]")
+{
+    // The ball center moves from (0.4, 0, 0.1) to (-0.4, 0, 0.1).
+    stf::ImplicitBall<3> ball(0.2, {0.4, 0.0, 0.1});
+    stf::Translation<3> translation({0.8, 0.0, 0.0});
+    stf::SweepFunction<3> sweep(ball, translation);
+    auto expected_time = [](const std::array<stf::Scalar, 3>& p) {
+        const stf::Scalar d[3] = {p[0] - 0.4, p[1], p[2] - 0.1};
+        const stf::Scalar c = d[0] * d[0] + d[1] * d[1] + d[2] * d[2] - 0.04;
+        if (c <= 0) return stf::Scalar(0);
+        const stf::Scalar b = 0.8 * d[0];
+        const stf::Scalar discriminant = b * b - 0.64 * c;
+        const stf::Scalar t = (-b - std::sqrt(std::max<stf::Scalar>(discriminant, 0))) / 0.64;
+        return discriminant < 0 || t < 0 || t > 1 ? stf::Scalar(NAN) : t;
+    };
+
+    SECTION("single point")
+    {
+        for (const auto& p : std::vector<std::array<stf::Scalar, 3>>{
+                 {0.0, 0.0, 0.1},
+                 {-0.35, 0.1, 0.0},
+                 {0.1, -0.15, 0.2},
+                 {0.45, 0.0, 0.1}}) {
+            const auto result = stf::first_contact_time<3>(sweep, p, 0, 1);
+            REQUIRE_THAT(result.time, Catch::Matchers::WithinAbs(expected_time(p), 1e-8));
+            REQUIRE(sweep.value(p, result.time) <= 0);
+            const auto g = sweep.gradient(p, result.time);
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE_THAT(result.gradient[i], Catch::Matchers::WithinAbs(g[i], 1e-12));
+            }
+            REQUIRE(result.evaluations < 30);
+        }
+
+        const auto miss = stf::first_contact_time<3>(sweep, {0.0, 0.5, 0.1}, 0, 1);
+        REQUIRE(std::isnan(miss.time));
+        REQUIRE(std::isnan(miss.gradient[0]));
+    }
+
+    SECTION("batch")
+    {
+        const size_t n = 2000;
+        stf::ColumnBuffer<3> positions(n);
+        auto columns = positions.columns();
+        for (size_t k = 0; k < n; ++k) {
+            columns[0][k] = -1 + 2 * stf::Scalar(k) / stf::Scalar(n);
+            columns[1][k] = 0.25 * std::sin(0.37 * stf::Scalar(k));
+            columns[2][k] = 0.1 + 0.2 * std::cos(0.61 * stf::Scalar(k));
+        }
+        std::vector<stf::Scalar> times(n);
+        stf::ColumnBuffer<4> gradients(n);
+        const size_t evaluations = stf::first_contact_time_batch<3>(
+            sweep,
+            positions.const_columns(),
+            0,
+            1,
+            times,
+            gradients.columns(),
+            {.num_threads = 3, .batch_size = 64});
+        REQUIRE(evaluations < 10 * n);
+
+        size_t hits = 0;
+        for (size_t k = 0; k < n; ++k) {
+            const auto p = stf::gather(positions.const_columns(), k);
+            const stf::Scalar expected = expected_time(p);
+            if (std::isnan(expected)) {
+                REQUIRE(std::isnan(times[k]));
+                continue;
+            }
+            ++hits;
+            REQUIRE_THAT(times[k], Catch::Matchers::WithinAbs(expected, 1e-8));
+            const auto g = sweep.gradient(p, times[k]);
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE_THAT(gradients.column(i)[k], Catch::Matchers::WithinAbs(g[i], 1e-12));
+            }
+        }
+        REQUIRE(hits > n / 10);
+
+        std::vector<stf::Scalar> serial(n);
+        stf::first_contact_time_batch<3>(
+            sweep,
+            positions.const_columns(),
+            0,
+            1,
+            serial,
+            {},
+            {.num_threads = 1});
+        for (size_t k = 0; k < n; ++k) {
+            REQUIRE((serial[k] == times[k] || (std::isnan(serial[k]) && std::isnan(times[k]))));
+        }
+    }
+
+    SECTION("non-monotonic motion")
+    {
+        stf::ImplicitBall<3> small(0.1, {0.3, 0.0, 0.0});
+        stf::Rotation<3> rotation({0.0, 0.0, 0.0}, {0, 0, 1}, 540);
+        stf::SweepFunction<3> spin(small, rotation);
+        const auto grid =
+            stf::GridSpec<3>::from_box({{{-0.5, 0.5}, {-0.5, 0.5}, {0, 0}}}, {21, 21, 1});
+        for (size_t k = 0; k < grid.size(); ++k) {
+            const auto p = grid.position(grid.node(k));
+            const auto result = stf::first_contact_time<3>(spin, p, 0, 1);
+            stf::Scalar scan = NAN;
+            for (int j = 0; j <= 2000; ++j) {
+                if (spin.value(p, j / 2000.0) <= 0) {
+                    scan = j / 2000.0;
+                    break;
+                }
+            }
+            if (std::isnan(result.time)) {
+                REQUIRE(std::isnan(scan));
+                continue;
+            }
+            REQUIRE(spin.value(p, result.time) <= 0);
+            if (!std::isnan(scan)) REQUIRE(result.time <= scan + 1e-9);
+        }
+    }
+
+    SECTION("invalid")
+    {
+        std::vector<stf::Scalar> times(1);
+        std::vector<stf::Scalar> x{0}, y{0}, z{0, 1};
+        REQUIRE_THROWS_AS(
+            stf::first_contact_time_batch<3>(sweep, {x, y, z}, 0, 1, times),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            stf::first_contact_time<3>(sweep, {0, 0, 0}, 1, 0),
+            std::invalid_argument);
+    }
+}
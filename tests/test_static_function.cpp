@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <stf/static_function.h>
+#include <stf/stf.h>
+
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Shear x by t y², which is not affine in position.
+class Bend : public stf::Transform<3>
+{
+public:
+    std::array<stf::Scalar, 3> transform(std::array<stf::Scalar, 3> pos, stf::Scalar t)
+        const override
+    {
+        return {pos[0] + t * pos[1] * pos[1], pos[1], pos[2]};
+    }
+
+    std::array<stf::Scalar, 3> velocity(std::array<stf::Scalar, 3> pos, stf::Scalar /*t*/)
+        const override
+    {
+        return {pos[1] * pos[1], 0, 0};
+    }
+
+    std::array<std::array<stf::Scalar, 3>, 3> position_Jacobian(
+        std::array<stf::Scalar, 3> pos,
+        stf::Scalar t) const override
+    {
+        return {{{1, 2 * t * pos[1], 0}, {0, 1, 0}, {0, 0, 1}}};
+    }
+};
+
+void check_static(
+    const stf::SpaceTimeFunction<3>& fn,
+    const stf::SpaceTimeFunction<3>& reference,
+    size_t n = 64)
+{
+    std::vector<stf::Scalar> x(n), y(n), z(n), t(n), values(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = std::sin(0.37 * k);
+        y[k] = std::cos(0.11 * k) * 0.8;
+        z[k] = 0.01 * k - 0.3;
+        t[k] = (k % 9) / 8.0;
+    }
+    std::array<std::span<const stf::Scalar>, 3> pos{x, y, z};
+    fn.value_batch(pos, t, values);
+
+    for (size_t k = 0; k < n; ++k) {
+        const std::array<stf::Scalar, 3> p{x[k], y[k], z[k]};
+        REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(reference.value(p, t[k]), 1e-12));
+
+        const auto eval = fn.evaluate(p, t[k]);
+        const auto expected = reference.evaluate(p, t[k]);
+        REQUIRE_THAT(eval.value, Catch::Matchers::WithinAbs(expected.value, 1e-12));
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE_THAT(eval.gradient[i], Catch::Matchers::WithinAbs(expected.gradient[i], 1e-12));
+        }
+        REQUIRE_THAT(
+            fn.time_derivative(p, t[k]),
+            Catch::Matchers::WithinAbs(expected.gradient[3], 1e-12));
+
+        const auto H = fn.hessian(p, t[k]);
+        const auto H_expected = reference.hessian(p, t[k]);
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                REQUIRE_THAT(H[i][j], Catch::Matchers::WithinAbs(H_expected[i][j], 1e-9));
+            }
+        }
+
+        const auto snapshot = fn.bind_time(t[k]);
+        const auto snapshot_eval = snapshot->evaluate(p);
+        REQUIRE_THAT(snapshot_eval.value, Catch::Matchers::WithinAbs(expected.value, 1e-12));
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE_THAT(
+                snapshot_eval.gradient[i],
+                Catch::Matchers::WithinAbs(expected.gradient[i], 1e-12));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("static_function", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.0, 0.1, 0.0});
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.5, 0.0, 0.0}, {0.5, 0.2, 0.0});
+    stf::Translation<3> translate({0.5, 0.2, -0.1});
+    stf::Rotation<3> rotate({0.1, 0.0, 0.0}, {1, 1, 0}, 90);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+
+    SECTION("sweep")
+    {
+        stf::Compose<3> translate_rotate(translate, rotate);
+        stf::SweepFunction<3> reference(ball, translate_rotate);
+
+        auto sweep = stf::make_sweep(ball, stf::compose(translate, rotate));
+        static_assert(decltype(sweep)::dim == 3);
+        auto fn = stf::make_function(sweep);
+        check_static(fn, reference);
+        REQUIRE(dynamic_cast<stf::SweepSnapshot<3>*>(fn.bind_time(0.3).get()));
+    }
+
+    SECTION("union")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::UnionFunction<3> reference(sweep_ball, sweep_capsule, 0.1);
+
+        auto fn = stf::make_function(
+            stf::make_union(stf::make_sweep(ball, rotate), stf::make_sweep(capsule, scale), 0.1));
+        check_static(fn, reference);
+        REQUIRE_THAT(fn.node().smooth_distance(), Catch::Matchers::WithinAbs(0.1, 1e-12));
+        REQUIRE(dynamic_cast<stf::UnionSnapshot<3>*>(fn.bind_time(0.3).get()));
+    }
+
+    SECTION("non-affine sweep")
+    {
+        Bend bend;
+        stf::SweepFunction<3> reference(ball, bend);
+
+        auto fn = stf::make_function(stf::make_sweep(ball, bend));
+        check_static(fn, reference);
+        using Node = std::remove_cvref_t<decltype(fn.node())>;
+        REQUIRE(dynamic_cast<stf::StaticSnapshot<Node>*>(fn.bind_time(0.3).get()));
+    }
+
+    SECTION("operands are copied")
+    {
+        auto fn = stf::make_function(stf::make_sweep(ball, translate));
+        const std::array<stf::Scalar, 3> p{0.2, 0.3, 0.1};
+        const stf::Scalar before = fn.value(p, 0.5);
+        translate = stf::Translation<3>({-1.0, 0.0, 0.0});
+        REQUIRE_THAT(fn.value(p, 0.5), Catch::Matchers::WithinAbs(before, 1e-12));
+    }
+
+    SECTION("float")
+    {
+        stf::ImplicitBall<3, float> ball_f(0.3f, {0.0f, 0.1f, 0.0f});
+        stf::Rotation<3, float> rotate_f({0.1f, 0.0f, 0.0f}, {1, 1, 0}, 90);
+        auto sweep = stf::make_sweep(ball_f, rotate_f);
+        static_assert(std::is_same_v<decltype(sweep)::Scalar, float>);
+
+        stf::SweepFunction<3> reference(ball, rotate);
+        const auto value = stf::make_function(sweep).value({0.2f, 0.3f, 0.1f}, 0.5f);
+        const auto expected = reference.value({0.2, 0.3, 0.1}, 0.5);
+        REQUIRE_THAT(value, Catch::Matchers::WithinAbs(expected, 1e-5));
+
+        // The Hessian is analytic, so it stays accurate in float away from the origin.
+        stf::Translation<3, float> translate_f({0.5f, 0.2f, -0.1f});
+        stf::SweepFunction<3> translated_reference(ball, translate);
+        const auto translated = stf::make_function(stf::make_sweep(ball_f, translate_f));
+        for (const stf::Scalar x : {0.7, 3.0}) {
+            const auto H = translated.hessian({float(x), 0.3f, 0.1f}, 0.5f);
+            const auto H_expected = translated_reference.hessian({x, 0.3, 0.1}, 0.5);
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    REQUIRE_THAT(H[i][j], Catch::Matchers::WithinAbs(H_expected[i][j], 1e-5));
+                }
+            }
+        }
+
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::UnionFunction<3> union_reference(reference, sweep_capsule, 0.1);
+        stf::ImplicitCapsule<3, float> capsule_f(0.1f, {-0.5f, 0.0f, 0.0f}, {0.5f, 0.2f, 0.0f});
+        stf::Scale<3, float> scale_f({2.0f, 0.5f, 1.0f}, {0.1f, 0.1f, 0.1f});
+        auto union_fn = stf::make_function(
+            stf::make_union(sweep, stf::make_sweep(capsule_f, scale_f), 0.1f));
+        REQUIRE_THAT(
+            union_fn.value({0.2f, 0.3f, 0.1f}, 0.5f),
+            Catch::Matchers::WithinAbs(union_reference.value({0.2, 0.3, 0.1}, 0.5), 1e-5));
+    }
+}
@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <stf/stf.h>
+#include <stf/tape.h>
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+void check_tape(const stf::SpaceTimeFunction<3>& fn, size_t n = 600)
+{
+    stf::Tape<3> tape(fn);
+
+    std::vector<stf::Scalar> x(n), y(n), z(n), t(n), values(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = std::sin(0.37 * k);
+        y[k] = std::cos(0.11 * k) * 0.8;
+        z[k] = 0.002 * k - 0.5;
+        t[k] = k < n / 2 ? 0.3 : (k % 7) / 6.0;
+    }
+    std::array<std::span<const stf::Scalar>, 3> pos{x, y, z};
+    tape.value_batch(pos, t, values);
+
+    for (size_t k = 0; k < n; ++k) {
+        REQUIRE_THAT(values[k], Catch::Matchers::WithinAbs(fn.value({x[k], y[k], z[k]}, t[k]), 1e-9));
+    }
+    REQUIRE_THAT(
+        tape.value({x[1], y[1], z[1]}, t[1]),
+        Catch::Matchers::WithinAbs(fn.value({x[1], y[1], z[1]}, t[1]), 1e-9));
+}
+
+template <typename Scalar>
+bool has_op(const stf::Tape<3, Scalar>& tape, stf::TapeOp op)
+{
+    return std::any_of(
+        tape.instructions().begin(),
+        tape.instructions().end(),
+        [&](const auto& inst) { return inst.op == op; });
+}
+
+} // namespace
+
+TEST_CASE("tape", "[stf]")
+{
+    stf::ImplicitBall<3> ball(0.3, {0.0, 0.1, 0.0});
+    stf::ImplicitBall<3> quadratic_ball(0.2, {0.2, 0.0, 0.1}, 2);
+    stf::ImplicitCapsule<3> capsule(0.1, {-0.5, 0.0, 0.0}, {0.5, 0.2, 0.0});
+    stf::ImplicitTorus torus(0.4, 0.1, {0, 0, 0}, {0, 1, 1});
+    stf::Translation<3> translate({0.5, 0.2, -0.1});
+    stf::Rotation<3> rotate({0.1, 0.0, 0.0}, {1, 1, 0}, 90);
+    stf::Scale<3> scale({2.0, 0.5, 1.0}, {0.1, 0.1, 0.1});
+    stf::Polyline<3> polyline({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}});
+    stf::Compose<3> translate_rotate(translate, rotate);
+    stf::Compose<3> scale_polyline(scale, polyline);
+
+    SECTION("sweeps")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::SweepFunction<3> sweep_torus(torus, scale_polyline);
+        stf::SweepFunction<3> sweep_quadratic(quadratic_ball, rotate);
+        check_tape(sweep_ball);
+        check_tape(sweep_capsule);
+        check_tape(sweep_torus);
+        check_tape(sweep_quadratic);
+
+        stf::Tape<3> tape(sweep_ball);
+        REQUIRE(tape.instructions().size() == 3);
+        REQUIRE(tape.instructions()[0].op == stf::TapeOp::Translate);
+        REQUIRE(tape.instructions()[1].op == stf::TapeOp::Rotate);
+        REQUIRE(tape.instructions()[2].op == stf::TapeOp::Ball);
+    }
+
+    SECTION("implicit unions")
+    {
+        stf::ImplicitUnion<3> hard(ball, capsule);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Quadratic> quadratic(ball, capsule, 0.1);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Cubic> cubic(quadratic, torus, 0.1);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Quartic> quartic(cubic, ball, 0.05);
+        stf::ImplicitUnion<3, stf::BlendingFunction::Circular> circular(quartic, capsule, 0.2);
+        stf::SweepFunction<3> sweep_hard(hard, rotate);
+        stf::SweepFunction<3> sweep_circular(circular, translate_rotate);
+        check_tape(sweep_hard);
+        check_tape(sweep_circular);
+
+        std::vector<stf::ImplicitFunction<3>*> operands{&ball, &capsule, &quadratic_ball};
+        stf::ImplicitNaryUnion<3> nary_hard(operands);
+        stf::ImplicitNaryUnion<3, stf::BlendingFunction::Quadratic> nary_quadratic(operands, 0.1);
+        stf::ImplicitNaryUnion<3, stf::BlendingFunction::Cubic> nary_cubic(operands, 0.1);
+        stf::ImplicitNaryUnion<3, stf::BlendingFunction::Quartic> nary_quartic(operands, 0.05);
+        stf::ImplicitNaryUnion<3, stf::BlendingFunction::Circular> nary_circular(operands, 0.2);
+        for (stf::ImplicitFunction<3>* nary :
+             std::initializer_list<stf::ImplicitFunction<3>*>{
+                 &nary_hard,
+                 &nary_quadratic,
+                 &nary_cubic,
+                 &nary_quartic,
+                 &nary_circular}) {
+            stf::SweepFunction<3> sweep(*nary, translate_rotate);
+            check_tape(sweep);
+            stf::Tape<3> tape(sweep);
+            REQUIRE(!has_op(tape, stf::TapeOp::ImplicitCall));
+        }
+    }
+
+    SECTION("space-time operators")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::UnionFunction<3> hard_union(sweep_ball, sweep_capsule);
+        stf::UnionFunction<3> smooth_union(hard_union, sweep_capsule, 0.1);
+        stf::OffsetFunction<3> offset(
+            smooth_union,
+            [](stf::Scalar t) { return 0.1 * t; },
+            [](stf::Scalar) { return 0.1; });
+        stf::ExplicitForm<3> explicit_form(
+            [](std::array<stf::Scalar, 3> p, stf::Scalar t) { return p[0] * p[1] - t; });
+        stf::InterpolateFunction<3> interpolate(offset, explicit_form);
+        check_tape(interpolate);
+
+        // Deep unions reuse registers instead of growing the register file.
+        std::vector<std::unique_ptr<stf::UnionFunction<3>>> chain;
+        chain.push_back(std::make_unique<stf::UnionFunction<3>>(sweep_ball, sweep_capsule));
+        for (int i = 0; i < 50; ++i) {
+            chain.push_back(std::make_unique<stf::UnionFunction<3>>(*chain.back(), sweep_ball));
+        }
+        check_tape(*chain.back());
+        stf::Tape<3> tape(*chain.back());
+        REQUIRE(tape.num_registers() < 20);
+    }
+
+    SECTION("n-ary unions")
+    {
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::SweepFunction<3> sweep_quadratic(quadratic_ball, rotate);
+        stf::NaryUnionFunction<3> sharp({&sweep_ball, &sweep_capsule, &sweep_quadratic});
+        stf::NaryUnionFunction<3> smooth({&sweep_ball, &sweep_capsule, &sweep_quadratic}, 0.1);
+        check_tape(sharp);
+        check_tape(smooth);
+
+        stf::Tape<3> sharp_tape(sharp);
+        REQUIRE(has_op(sharp_tape, stf::TapeOp::Min));
+        REQUIRE(!has_op(sharp_tape, stf::TapeOp::FunctionCall));
+        stf::Tape<3> smooth_tape(smooth);
+        REQUIRE(has_op(smooth_tape, stf::TapeOp::NaryUnion));
+        REQUIRE(!has_op(smooth_tape, stf::TapeOp::FunctionCall));
+    }
+
+    SECTION("nested tapes")
+    {
+        // The inner tape runs inside a call instruction of the outer one, while the outer tape
+        // holds this thread's workspace.
+        stf::SweepFunction<3> sweep_ball(ball, translate_rotate);
+        stf::SweepFunction<3> sweep_capsule(capsule, scale);
+        stf::SweepFunction<3> sweep_quadratic(quadratic_ball, rotate);
+        stf::NaryUnionFunction<3> smooth({&sweep_ball, &sweep_capsule, &sweep_quadratic}, 0.1);
+        stf::Tape<3> inner(smooth);
+        stf::ExplicitForm<3> wrapped(
+            [&](std::array<stf::Scalar, 3> p, stf::Scalar t) { return inner.value(p, t) + 0.05; });
+        stf::NaryUnionFunction<3> outer({&wrapped, &sweep_capsule, &sweep_quadratic}, 0.1);
+        check_tape(outer);
+    }
+
+    SECTION("float")
+    {
+        stf::ImplicitBall<3, float> ball_f(0.3f, {0.0f, 0.1f, 0.0f});
+        stf::ImplicitCapsule<3, float> capsule_f(0.1f, {-0.5f, 0.0f, 0.0f}, {0.5f, 0.2f, 0.0f});
+        stf::Rotation<3, float> rotate_f({0.1f, 0.0f, 0.0f}, {1, 1, 0}, 90);
+        stf::Scale<3, float> scale_f({2.0f, 0.5f, 1.0f}, {0.1f, 0.1f, 0.1f});
+        stf::SweepFunction<3, float> sweep_ball(ball_f, rotate_f);
+        stf::SweepFunction<3, float> sweep_capsule(capsule_f, scale_f);
+        stf::NaryUnionFunction<3, float> smooth({&sweep_ball, &sweep_capsule}, 0.1f);
+        stf::UnionFunction<3, float> sharp(smooth, sweep_ball);
+
+        stf::Tape<3, float> tape(sharp);
+        REQUIRE(has_op(tape, stf::TapeOp::NaryUnion));
+        REQUIRE(!has_op(tape, stf::TapeOp::FunctionCall));
+        for (int k = 0; k < 50; ++k) {
+            const std::array<float, 3> p{
+                float(std::sin(0.37 * k)),
+                float(std::cos(0.11 * k) * 0.8),
+                float(0.02 * k - 0.5)};
+            const float t = float(k % 7) / 6;
+            REQUIRE_THAT(tape.value(p, t), Catch::Matchers::WithinAbs(sharp.value(p, t), 1e-5));
+        }
+    }
+
+#ifdef STF_YAML_PARSER_ENABLED
+    SECTION("parsed unions")
+    {
+        const std::string yaml = R"(
+type: union
+dimension: 3
+smooth_distance: 0.1
+nary: true
+functions:
+  - type: sweep
+    primitive: {type: ball, radius: 0.3, center: [0.0, 0.1, 0.0]}
+    transform: {type: translation, vector: [0.5, 0.2, -0.1]}
+  - type: sweep
+    primitive: {type: capsule, radius: 0.1, start: [-0.5, 0.0, 0.0], end: [0.5, 0.2, 0.0]}
+    transform: {type: translation, vector: [-0.2, 0.3, 0.0]}
+  - type: sweep
+    primitive: {type: ball, radius: 0.2, center: [0.2, 0.0, 0.1]}
+    transform: {type: translation, vector: [0.0, -0.4, 0.2]}
+)";
+        const auto fn = stf::YamlParser<3>::parse_from_string(yaml);
+        check_tape(*fn);
+
+        stf::Tape<3> tape(*fn);
+        REQUIRE(has_op(tape, stf::TapeOp::NaryUnion));
+        REQUIRE(!has_op(tape, stf::TapeOp::FunctionCall));
+
+        const std::string implicit_yaml = R"(
+type: sweep
+dimension: 3
+primitive:
+  type: implicit_union
+  smooth_distance: 0.1
+  blending: cubic
+  nary: true
+  primitives:
+    - {type: ball, radius: 0.3, center: [0.0, 0.1, 0.0]}
+    - {type: ball, radius: 0.2, center: [0.4, 0.0, 0.0]}
+    - {type: capsule, radius: 0.1, start: [-0.5, 0.0, 0.0], end: [0.5, 0.2, 0.0]}
+transform: {type: translation, vector: [0.5, 0.2, -0.1]}
+)";
+        const auto implicit_fn = stf::YamlParser<3>::parse_from_string(implicit_yaml);
+        check_tape(*implicit_fn);
+
+        stf::Tape<3> implicit_tape(*implicit_fn);
+        REQUIRE(has_op(implicit_tape, stf::TapeOp::NaryUnion));
+        REQUIRE(!has_op(implicit_tape, stf::TapeOp::ImplicitCall));
+    }
+#endif
+}
@@ -3,6 +3,8 @@
 
 #include <stf/transforms/all.h>
 
+#include <vector>
+
 template <int dim>
 void check_velocity(
     const stf::Transform<dim>& transform,
@@ -18,6 +20,25 @@ void check_velocity(
     }
 }
 
+template <int dim>
+void check_evaluate(
+    const stf::Transform<dim>& transform,
+    const std::array<stf::Scalar, dim>& pos,
+    stf::Scalar t)
+{
+    auto e = transform.evaluate(pos, t);
+    auto p = transform.transform(pos, t);
+    auto v = transform.velocity(pos, t);
+    auto J = transform.position_Jacobian(pos, t);
+    for (int i = 0; i < dim; ++i) {
+        REQUIRE_THAT(e.position[i], Catch::Matchers::WithinAbs(p[i], 1e-12));
+        REQUIRE_THAT(e.velocity[i], Catch::Matchers::WithinAbs(v[i], 1e-12));
+        for (int j = 0; j < dim; ++j) {
+            REQUIRE_THAT(e.jacobian[i][j], Catch::Matchers::WithinAbs(J[i][j], 1e-12));
+        }
+    }
+}
+
 template <int dim>
 void check_jacobian(
     const stf::Transform<dim>& transform,
@@ -30,6 +51,130 @@ void check_jacobian(
         for (int j = 0; j < dim; ++j) {
             REQUIRE_THAT(J[i][j], Catch::Matchers::WithinAbs(J_fd[i][j], 1e-6));
         }
+    check_evaluate<dim>(transform, pos, t);
+}
+
+template <int dim>
+void check_hessian(
+    const stf::Transform<dim>& transform,
+    const std::array<stf::Scalar, dim>& pos,
+    stf::Scalar t,
+    stf::Scalar epsilon = 1e-5)
+{
+    auto H = transform.hessian(pos, t);
+    auto H_fd = transform.finite_difference_hessian(pos, t);
+    for (int i = 0; i < dim; ++i)
+        for (int a = 0; a <= dim; ++a)
+            for (int b = 0; b <= dim; ++b) {
+                REQUIRE_THAT(H[i][a][b], Catch::Matchers::WithinAbs(H_fd[i][a][b], epsilon));
+            }
+}
+
+template <int dim>
+void check_transform_bounds(
+    const stf::Transform<dim>& transform,
+    const stf::IntervalBox<dim>& box,
+    stf::Interval<stf::Scalar> t,
+    int samples = 5)
+{
+    const auto bounds = transform.transform_bounds(box, t);
+
+    // Sample a regular grid of the space-time box, corners included.
+    int count = samples;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = box[i].lower + box[i].width() * (rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t.lower + t.width() * rest / (samples - 1);
+        const auto p = transform.transform(pos, time);
+        for (int i = 0; i < dim; ++i) {
+            REQUIRE(p[i] >= bounds[i].lower - 1e-9);
+            REQUIRE(p[i] <= bounds[i].upper + 1e-9);
+        }
+    }
+}
+
+template <int dim>
+void check_lipschitz_bound(
+    const stf::Transform<dim>& transform,
+    const stf::IntervalBox<dim>& box,
+    stf::Interval<stf::Scalar> t,
+    int samples = 5)
+{
+    const auto bound = transform.lipschitz_bound(box, t);
+
+    int count = samples;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = box[i].lower + box[i].width() * (rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t.lower + t.width() * rest / (samples - 1);
+
+        const auto v = transform.velocity(pos, time);
+        stf::Scalar speed2 = 0;
+        for (int i = 0; i < dim; ++i) speed2 += v[i] * v[i];
+        REQUIRE(std::sqrt(speed2) <= bound.temporal + 1e-9);
+
+        // Spectral norm of the Jacobian by power iteration on JᵀJ.
+        const auto J = transform.position_Jacobian(pos, time);
+        std::array<stf::Scalar, dim> x;
+        x.fill(1);
+        stf::Scalar norm = 0;
+        for (int iteration = 0; iteration < 50; ++iteration) {
+            std::array<stf::Scalar, dim> Jx{}, y{};
+            for (int i = 0; i < dim; ++i) {
+                for (int j = 0; j < dim; ++j) Jx[i] += J[i][j] * x[j];
+            }
+            for (int i = 0; i < dim; ++i) {
+                for (int j = 0; j < dim; ++j) y[i] += J[j][i] * Jx[j];
+            }
+            stf::Scalar y_norm = 0;
+            for (int i = 0; i < dim; ++i) y_norm += y[i] * y[i];
+            y_norm = std::sqrt(y_norm);
+            if (y_norm == 0) break;
+            for (int i = 0; i < dim; ++i) x[i] = y[i] / y_norm;
+            norm = std::sqrt(y_norm);
+        }
+        REQUIRE(norm <= bound.spatial + 1e-9);
+    }
+}
+
+template <int dim>
+void check_inverse_transform_bounds(
+    const stf::Transform<dim>& transform,
+    const stf::IntervalBox<dim>& box,
+    stf::Interval<stf::Scalar> t,
+    int samples = 13)
+{
+    const auto bounds = transform.inverse_transform_bounds(box, t);
+
+    // Every sampled position mapped into the box at a sampled time lies in the bounds.
+    int count = 5;
+    for (int i = 0; i < dim; ++i) count *= samples;
+    for (int index = 0; index < count; ++index) {
+        std::array<stf::Scalar, dim> pos;
+        int rest = index;
+        for (int i = 0; i < dim; ++i) {
+            pos[i] = -3 + 6 * stf::Scalar(rest % samples) / (samples - 1);
+            rest /= samples;
+        }
+        const stf::Scalar time = t.lower + t.width() * rest / 4;
+        const auto p = transform.transform(pos, time);
+        bool inside = true;
+        for (int i = 0; i < dim; ++i) inside = inside && box[i].contains(p[i]);
+        if (!inside) continue;
+        for (int i = 0; i < dim; ++i) {
+            REQUIRE(bounds[i].contains(pos[i]));
+        }
+    }
 }
 
 TEST_CASE("transform", "[stf]")
@@ -60,6 +205,24 @@ TEST_CASE("transform", "[stf]")
         check_jacobian(rotation, {1, 1}, 0.75);
     }
 
+    SECTION("Scale and translation")
+    {
+        stf::Scale<3> scale({2.0, 0.5, 1.5}, {0.1, 0.2, 0.3});
+        stf::Translation<3> translation({1, -2, 0.5});
+        stf::Compose<3> compose(scale, translation);
+
+        auto p = scale.transform({1.1, 0.2, 0.3}, 1);
+        REQUIRE_THAT(p[0], Catch::Matchers::WithinAbs(2.1, 1e-6));
+        for (auto t : {0.0, 0.5, 1.0}) {
+            check_velocity(scale, {1, 2, 3}, t);
+            check_jacobian(scale, {1, 2, 3}, t);
+            check_velocity(translation, {1, 2, 3}, t);
+            check_jacobian(translation, {1, 2, 3}, t);
+            check_velocity(compose, {1, 2, 3}, t);
+            check_jacobian(compose, {1, 2, 3}, t);
+        }
+    }
+
     SECTION("Compose")
     {
         stf::Translation<3> translation({1, 0, 0});
@@ -371,4 +534,96 @@ TEST_CASE("transform", "[stf]")
             check_jacobian(transform, {0, 0, 0}, 0.75);
         }
     }
+
+    SECTION("hessian")
+    {
+        stf::Translation<3> translation({1, 0.5, 0});
+        stf::Rotation<3> rotation({0.1, 0.2, 0}, {1, 1, 0.5}, 120);
+        stf::Rotation<2> rotation_2d({0.1, 0.2}, {0, 0}, 90);
+        stf::Scale<3> scale({2, 0.5, 1.5}, {0.1, 0, 0});
+        stf::Compose<3> compose(rotation, scale);
+        stf::Compose<3> compose_2(scale, rotation);
+        stf::Polyline<3> polyline({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}});
+        stf::PolyBezier<3> bezier(
+            {{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}, {-1, 1, 1}, {-1, 0, 1}, {0, 0, 1}},
+            false);
+
+        for (stf::Scalar t : {0.1, 0.4, 0.8}) {
+            check_hessian<3>(translation, {1, 2, 3}, t);
+            check_hessian<3>(rotation, {0.3, -0.2, 0.5}, t);
+            check_hessian<2>(rotation_2d, {0.3, -0.2}, t);
+            check_hessian<3>(scale, {0.3, -0.2, 0.5}, t);
+            check_hessian<3>(compose, {0.3, -0.2, 0.5}, t);
+            check_hessian<3>(compose_2, {0.3, -0.2, 0.5}, t);
+            check_hessian<3>(polyline, {0.3, -0.2, 0.5}, t);
+            check_hessian<3>(bezier, {0.3, -0.2, 0.5}, t, 1e-4);
+        }
+    }
+
+    SECTION("transform bounds")
+    {
+        stf::Translation<3> translation({1, 0.5, 0});
+        stf::Rotation<3> rotation({0.1, 0.2, 0}, {1, 1, 0.5}, 120);
+        stf::Rotation<2> rotation_2d({0.1, 0.2}, {0, 0}, 90);
+        stf::Scale<3> scale({2, 0.5, 1.5}, {0.1, 0, 0});
+        stf::Compose<3> compose(rotation, scale);
+        stf::Polyline<3> polyline({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}});
+        stf::Polyline<3> straight_polyline({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}}, false);
+        const std::vector<std::array<stf::Scalar, 3>> control_points{
+            {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}, {-1, 1, 1}, {-1, 0, 1}, {0, 0, 1}};
+        stf::PolyBezier<3> bezier(control_points, false);
+        stf::PolyBezier<3> tangent_bezier(control_points, true);
+
+        const stf::IntervalBox<3> box{{{0.2, 0.4}, {-0.3, -0.1}, {0.4, 0.6}}};
+        const std::vector<stf::Interval<stf::Scalar>> times{{0, 1}, {0.1, 0.3}, {0.45, 0.55}};
+        for (const auto& t : times) {
+            check_transform_bounds<3>(translation, box, t);
+            check_transform_bounds<3>(rotation, box, t);
+            check_transform_bounds<2>(rotation_2d, {{{0.2, 0.4}, {-0.3, -0.1}}}, t);
+            check_transform_bounds<3>(scale, box, t);
+            check_transform_bounds<3>(compose, box, t);
+            check_transform_bounds<3>(polyline, box, t);
+            check_transform_bounds<3>(straight_polyline, box, t);
+            check_transform_bounds<3>(bezier, box, t);
+            check_transform_bounds<3>(tangent_bezier, box, t);
+
+            check_lipschitz_bound<3>(translation, box, t);
+            check_lipschitz_bound<3>(rotation, box, t);
+            check_lipschitz_bound<2>(rotation_2d, {{{0.2, 0.4}, {-0.3, -0.1}}}, t);
+            check_lipschitz_bound<3>(scale, box, t);
+            check_lipschitz_bound<3>(compose, box, t);
+            check_lipschitz_bound<3>(polyline, box, t);
+            check_lipschitz_bound<3>(straight_polyline, box, t);
+            check_lipschitz_bound<3>(bezier, box, t);
+            check_lipschitz_bound<3>(tangent_bezier, box, t);
+
+            const stf::IntervalBox<3> target{{{-1.0, 1.0}, {-0.5, 1.0}, {-1.0, 0.5}}};
+            check_inverse_transform_bounds<3>(translation, target, t);
+            check_inverse_transform_bounds<3>(rotation, target, t);
+            check_inverse_transform_bounds<2>(rotation_2d, {{{-1.0, 1.0}, {-0.5, 1.0}}}, t);
+            check_inverse_transform_bounds<3>(scale, target, t);
+            check_inverse_transform_bounds<3>(compose, target, t);
+            check_inverse_transform_bounds<3>(polyline, target, t);
+            check_inverse_transform_bounds<3>(straight_polyline, target, t);
+            check_inverse_transform_bounds<3>(bezier, target, t);
+            check_inverse_transform_bounds<3>(tangent_bezier, target, t);
+        }
+
+        // Pulling a box back through a translation at a single time moves it backwards.
+        const auto pulled = translation.inverse_transform_bounds(box, {1, 1});
+        REQUIRE_THAT(pulled[0].lower, Catch::Matchers::WithinAbs(-0.8, 1e-12));
+        REQUIRE_THAT(pulled[1].upper, Catch::Matchers::WithinAbs(-0.6, 1e-12));
+
+        // Rigid motions preserve distances, and the speed of a translation is its length.
+        REQUIRE(rotation.lipschitz_bound(box, {0, 1}).spatial == 1);
+        REQUIRE(std::isfinite(tangent_bezier.lipschitz_bound(box, {0.1, 0.3}).temporal));
+        REQUIRE_THAT(
+            translation.lipschitz_bound(box, {0, 1}).temporal,
+            Catch::Matchers::WithinAbs(std::sqrt(1.25), 1e-12));
+
+        // A translation over a degenerate time interval maps the box exactly.
+        const auto moved = translation.transform_bounds(box, {0.5, 0.5});
+        REQUIRE_THAT(moved[0].lower, Catch::Matchers::WithinAbs(0.7, 1e-12));
+        REQUIRE_THAT(moved[1].upper, Catch::Matchers::WithinAbs(0.15, 1e-12));
+    }
 }
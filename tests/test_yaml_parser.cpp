@@ -1602,6 +1602,15 @@ smooth_distance: 0.3
         
         Scalar value = func->value(pos, t);
         REQUIRE(std::isfinite(value));
+
+        // Smooth unions load as a chain of binary unions, ((f1 ∪ f2) ∪ f3).
+        const std::array<Scalar, 3> off_axis = {0.2, 0.25, 0.1};
+        REQUIRE(func->value(off_axis, t) == Catch::Approx(0.063542495189).epsilon(1e-9));
+
+        // `nary: true` opts into the order-independent fold, which differs from the chain.
+        auto nary_func = YamlParser<3>::parse_from_string(yaml_content + "nary: true\n");
+        REQUIRE(nary_func->value(off_axis, t) == Catch::Approx(0.070014645697).epsilon(1e-9));
+        REQUIRE(nary_func->value(pos, t) == Catch::Approx(value));
     }
 }
 
@@ -1722,6 +1731,10 @@ transform:
         
         Scalar value = func->value(pos, t);
         REQUIRE(std::isfinite(value));
+
+        // Smooth implicit unions load as a chain of binary unions; the flat fold would give
+        // -0.221380057471 here.
+        REQUIRE(value == Catch::Approx(-0.232470039082).epsilon(1e-9));
     }
     
     SECTION("Implicit union with default parameters") {